@@ -21,6 +21,8 @@
 // efficiency calculation.
 // prototype version by S.Arcelli silvia.arcelli@cern.ch
 ///////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+
 #include "AliCFCutBase.h"
 #include "AliCFManager.h"
 
@@ -39,6 +41,7 @@ AliCFManager::AliCFManager() :
   //
   // ctor
   //
+  fPlanValid[kEvtLevel] = fPlanValid[kPartLevel] = kFALSE;
 }
 //_____________________________________________________________________________
 AliCFManager::AliCFManager(const Char_t* name, const Char_t* title) : 
@@ -53,6 +56,7 @@ AliCFManager::AliCFManager(const Char_t* name, const Char_t* title) :
    //
    // ctor
    //
+  fPlanValid[kEvtLevel] = fPlanValid[kPartLevel] = kFALSE;
 }
 //_____________________________________________________________________________
 AliCFManager::AliCFManager(const AliCFManager& c) : 
@@ -67,6 +71,7 @@ AliCFManager::AliCFManager(const AliCFManager& c) :
    //
    //copy ctor
    //
+  fPlanValid[kEvtLevel] = fPlanValid[kPartLevel] = kFALSE;
 }
 //_____________________________________________________________________________
 AliCFManager& AliCFManager::operator=(const AliCFManager& c)
@@ -84,6 +89,7 @@ AliCFManager& AliCFManager::operator=(const AliCFManager& c)
   this->fPartContainer=c.fPartContainer;
   this->fEvtCutList=c.fEvtCutList;
   this->fPartCutList=c.fPartCutList;
+  fPlanValid[kEvtLevel] = fPlanValid[kPartLevel] = kFALSE;
   return *this ;
 }
 
@@ -104,15 +110,7 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
     AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
     return kTRUE;
   }
-  if(!fPartCutList[isel])return kTRUE;
-  TObjArrayIter iter(fPartCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
-  }
-  return kTRUE;
+  return CheckCuts(kPartLevel,isel,obj,selcuts);
 }
 
 //_____________________________________________________________________________
@@ -125,17 +123,175 @@ Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &se
     AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepEvt));
       return kTRUE;
   }
-  if(!fEvtCutList[isel])return kTRUE;
-  TObjArrayIter iter(fEvtCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+  return CheckCuts(kEvtLevel,isel,obj,selcuts);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckCuts(Int_t level, Int_t isel, TObject *obj, const TString &selcuts) const {
+  //
+  // check the selected cuts of step isel, in the order of the list
+  //
+
+  UpdatePlan(level,selcuts,isel,isel);
+  const std::vector<Int_t> &start = fPlanStart[level];
+  for (Int_t i=start[isel]; i<start[isel+1]; i++) {
+    if (!fPlanCuts[level][fPlanEntries[level][i]]->IsSelected(obj)) return kFALSE;
   }
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+void AliCFManager::UpdatePlan(Int_t level, const TString &selcuts, Int_t firstStep, Int_t lastStep) const {
+  //
+  // recompile the cut plan unless it is up to date for the steps
+  // firstStep..lastStep : the setters invalidate it when lists are set,
+  // only the cuts in the lists of these steps have to be compared, since
+  // cuts can be replaced in a list after it was passed
+  //
+
+  if (fPlanValid[level] && fPlanSelCuts[level]==selcuts) {
+    TObjArray **lists = (level==kPartLevel ? fPartCutList : fEvtCutList);
+    const std::vector<Int_t> &contentStart = fPlanContentStart[level];
+    const std::vector<TObject*> &contents = fPlanContents[level];
+    Bool_t valid = kTRUE;
+    for (Int_t isel=firstStep; valid && isel<=lastStep; isel++) {
+      TObjArray *list = (lists ? lists[isel] : 0);
+      Int_t first = contentStart[isel];
+      Int_t size = contentStart[isel+1]-first;
+      if (!list) continue; // stays empty until a setter invalidates the plan
+      valid = (list->GetEntriesFast()==size);
+      for (Int_t i=0; valid && i<size; i++) valid = (list->UncheckedAt(i)==contents[first+i]);
+    }
+    if (valid) return;
+  }
+  CompilePlan(level,selcuts);
+}
+
+//_____________________________________________________________________________
+void AliCFManager::CompilePlan(Int_t level, const TString &selcuts) const {
+  //
+  // compile the cut plan of the event or particle level : the cut names
+  // are compared once here instead of for every checked object
+  //
+
+  Int_t nstep = (level==kPartLevel ? fNStepPart : fNStepEvt);
+  TObjArray **lists = (level==kPartLevel ? fPartCutList : fEvtCutList);
+  if (nstep>64) AliWarning(Form("Only the first 64 of the %d selection steps are in the cut masks",nstep));
+
+  std::vector<AliCFCutBase*> &cuts = fPlanCuts[level];
+  std::vector<Int_t> &start = fPlanStart[level];
+  std::vector<Int_t> &entries = fPlanEntries[level];
+  std::vector<Int_t> &contentStart = fPlanContentStart[level];
+  std::vector<TObject*> &contents = fPlanContents[level];
+  cuts.clear();
+  entries.clear();
+  contents.clear();
+  start.assign(1,0);
+  contentStart.assign(1,0);
+  for (Int_t isel=0; isel<nstep; isel++) {
+    if (lists && lists[isel]) {
+      for (Int_t i=0; i<lists[isel]->GetEntriesFast(); i++) contents.push_back(lists[isel]->UncheckedAt(i));
+      TObjArrayIter iter(lists[isel]);
+      AliCFCutBase *cut = 0;
+      while ( (cut = (AliCFCutBase*)iter.Next()) ) {
+        if (!CompareStrings(cut->GetName(),selcuts)) continue;
+        Int_t index = std::find(cuts.begin(),cuts.end(),cut) - cuts.begin();
+        if (index == (Int_t)cuts.size()) cuts.push_back(cut);
+        entries.push_back(index);
+      }
+    }
+    start.push_back(entries.size());
+    contentStart.push_back(contents.size());
+  }
+  fPlanResults[level].assign(cuts.size(),-1);
+  fPlanSelCuts[level] = selcuts;
+  fPlanValid[level] = kTRUE;
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::GetCutsMask(Int_t level, TObject *obj, const TString &selcuts, Bool_t cumulative, Int_t firstStep, Int_t lastStep) const {
+  //
+  // mask of the steps firstStep..lastStep passed by obj, each cut being
+  // checked at most once
+  //
+
+  Int_t nstep = (level==kPartLevel ? fNStepPart : fNStepEvt);
+  if (nstep>64) nstep = 64;
+  if (firstStep<0) firstStep = 0;
+  if (lastStep<0 || lastStep>=nstep) lastStep = nstep-1;
+  if (firstStep>lastStep) return 0;
+  UpdatePlan(level,selcuts,firstStep,lastStep);
+  const std::vector<Int_t> &start = fPlanStart[level];
+  const std::vector<Int_t> &entries = fPlanEntries[level];
+  std::vector<Char_t> &results = fPlanResults[level];
+  std::fill(results.begin(),results.end(),-1);
+
+  ULong64_t mask = 0;
+  for (Int_t isel=firstStep; isel<=lastStep; isel++) {
+    Bool_t passed = kTRUE;
+    for (Int_t i=start[isel]; passed && i<start[isel+1]; i++) {
+      Char_t &result = results[entries[i]];
+      if (result<0) result = fPlanCuts[level][entries[i]]->IsSelected(obj);
+      passed = result;
+    }
+    if (passed) mask |= (1ULL<<isel);
+    else if (cumulative) break;
+  }
+  return mask;
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::GetEventCutsMask(TObject *obj, const TString &selcuts, Bool_t cumulative, Int_t firstStep, Int_t lastStep) const {
+  //
+  // mask of the event-level selection steps passed by obj
+  //
+
+  return GetCutsMask(kEvtLevel,obj,selcuts,cumulative,firstStep,lastStep);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::GetParticleCutsMask(TObject *obj, const TString &selcuts, Bool_t cumulative, Int_t firstStep, Int_t lastStep) const {
+  //
+  // mask of the particle-level selection steps passed by obj
+  //
+
+  return GetCutsMask(kPartLevel,obj,selcuts,cumulative,firstStep,lastStep);
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::FillEventContainer(const Double_t *var, TObject *obj, Double_t weight, Bool_t cumulative, const TString &selcuts, Int_t firstStep, Int_t lastStep) const {
+  //
+  // fill the event container at the steps passed by obj, returns the cut mask
+  //
+
+  ULong64_t mask = GetEventCutsMask(obj,selcuts,cumulative,firstStep,lastStep);
+  if (!fEvtContainer) {
+    AliWarning("No event container defined");
+    return mask;
+  }
+  for (Int_t istep=0; istep<fEvtContainer->GetNStep() && istep<64; istep++) {
+    if (mask & (1ULL<<istep)) fEvtContainer->Fill(var,istep,weight);
+  }
+  return mask;
+}
+
+//_____________________________________________________________________________
+ULong64_t AliCFManager::FillParticleContainer(const Double_t *var, TObject *obj, Double_t weight, Bool_t cumulative, const TString &selcuts, Int_t firstStep, Int_t lastStep) const {
+  //
+  // fill the particle container at the steps passed by obj, returns the cut mask
+  //
+
+  ULong64_t mask = GetParticleCutsMask(obj,selcuts,cumulative,firstStep,lastStep);
+  if (!fPartContainer) {
+    AliWarning("No particle container defined");
+    return mask;
+  }
+  for (Int_t istep=0; istep<fPartContainer->GetNStep() && istep<64; istep++) {
+    if (mask & (1ULL<<istep)) fPartContainer->Fill(var,istep,weight);
+  }
+  return mask;
+}
+
 //_____________________________________________________________________________
 void  AliCFManager::SetMCEventInfo(const TObject *obj) const {
 
@@ -243,6 +399,7 @@ void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fEvtCutList[isel] = array;
+  fPlanValid[kEvtLevel] = kFALSE;
 }
 
 //_____________________________________________________________________________
@@ -267,4 +424,5 @@ void AliCFManager::SetParticleCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fPartCutList[isel] = array;
+  fPlanValid[kPartLevel] = kFALSE;
 }
@@ -24,11 +24,15 @@
 // now the number of steps are fixed by the particle/event containers themselves.
 //
 
+#include <vector>
+
 #include "TNamed.h"
 #include "AliCFContainer.h"
 #include "AliLog.h"
 
 //____________________________________________________________________________
+class AliCFCutBase;
+
 class AliCFManager : public TNamed 
 {
  public :
@@ -78,8 +82,8 @@ class AliCFManager : public TNamed
   }
   
   //Set the number of steps (already done if you have defined your containers)
-  virtual void SetNStepEvent   (Int_t nstep) {fNStepEvt  = nstep;}
-  virtual void SetNStepParticle(Int_t nstep) {fNStepPart = nstep;}
+  virtual void SetNStepEvent   (Int_t nstep) {fNStepEvt  = nstep; fPlanValid[kEvtLevel]  = kFALSE;}
+  virtual void SetNStepParticle(Int_t nstep) {fNStepPart = nstep; fPlanValid[kPartLevel] = kFALSE;}
 
   //Setter for event-level selection cut list at selection step isel
   virtual void SetEventCutsList(Int_t isel, TObjArray* array) ;
@@ -116,6 +120,17 @@ class AliCFManager : public TNamed
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
 
+  //Cut masks: bit isel is set if obj passes selection step isel, for the
+  //steps firstStep..lastStep (up to the last one if lastStep<0). Each cut is
+  //checked at most once per call, even if it appears in several steps.
+  //If cumulative, the steps after the first failed one are not checked.
+  //The Fill methods fill the container at the steps of the mask.
+
+  virtual ULong64_t GetEventCutsMask   (TObject *obj, const TString &selcuts="all", Bool_t cumulative=kFALSE, Int_t firstStep=0, Int_t lastStep=-1) const;
+  virtual ULong64_t GetParticleCutsMask(TObject *obj, const TString &selcuts="all", Bool_t cumulative=kFALSE, Int_t firstStep=0, Int_t lastStep=-1) const;
+  virtual ULong64_t FillEventContainer   (const Double_t *var, TObject *obj, Double_t weight=1., Bool_t cumulative=kTRUE, const TString &selcuts="all", Int_t firstStep=0, Int_t lastStep=-1) const;
+  virtual ULong64_t FillParticleContainer(const Double_t *var, TObject *obj, Double_t weight=1., Bool_t cumulative=kTRUE, const TString &selcuts="all", Int_t firstStep=0, Int_t lastStep=-1) const;
+
  private:
   
   //number of steps
@@ -130,7 +145,25 @@ class AliCFManager : public TNamed
   //Particle-level selections
   TObjArray **fPartCutList ; //[fNStepPart] arrays of cuts for each particle-selection level
 
+  //Cut plans: for each level, the distinct cuts of the lists and, for each
+  //step, the indices of the cuts selected by selcuts. Invalidated by the
+  //setters, recompiled when the selected cuts or the cuts in the lists of
+  //the checked steps change.
+  enum {kEvtLevel=0, kPartLevel, kNLevels};
+  mutable std::vector<AliCFCutBase*> fPlanCuts[kNLevels];    //! distinct cuts
+  mutable std::vector<Int_t>         fPlanStart[kNLevels];   //! first entry of each step in fPlanEntries
+  mutable std::vector<Int_t>         fPlanEntries[kNLevels]; //! indices in fPlanCuts of the cuts to check at each step
+  mutable std::vector<Int_t>         fPlanContentStart[kNLevels]; //! first entry of each step in fPlanContents
+  mutable std::vector<TObject*>      fPlanContents[kNLevels];//! entries of the lists when compiled
+  mutable std::vector<Char_t>        fPlanResults[kNLevels]; //! results of the cuts for the current object (-1 = not checked)
+  mutable TString                    fPlanSelCuts[kNLevels]; //! selected cuts when compiled
+  mutable Bool_t                     fPlanValid[kNLevels];   //! plan compiled
+
   Bool_t CompareStrings(const TString  &cutname,const TString  &selcuts) const;
+  void   UpdatePlan(Int_t level, const TString &selcuts, Int_t firstStep, Int_t lastStep) const;
+  void   CompilePlan(Int_t level, const TString &selcuts) const;
+  Bool_t CheckCuts(Int_t level, Int_t isel, TObject *obj, const TString &selcuts) const;
+  ULong64_t GetCutsMask(Int_t level, TObject *obj, const TString &selcuts, Bool_t cumulative, Int_t firstStep, Int_t lastStep) const;
 
   ClassDef(AliCFManager,2);
 };
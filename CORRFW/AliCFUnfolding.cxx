@@ -57,6 +57,12 @@
 // found in AliCFUnfolding::CalculateCorrelatedErrors()                //
 // Author: marta.verweij@cern.ch                                       //
 //                                                                     //
+// Without smoothing, the iterations run on sparse matrices built once //
+// from the conditional matrix, with the same results as on the        //
+// THnSparse (::SetUseSparseMatrices(kFALSE) to use the THnSparse).    //
+// The randomized unfoldings of the error calculation can be run in    //
+// several threads : ::SetNThreads(n), n=0 for the number of cores.    //
+//                                                                     //
 // An optional possibility is to smooth the unfolded spectrum at the   //
 // end of each iteration, either using a fit function                  //
 // (only if #dimensions <=3)                                           //
@@ -93,9 +99,259 @@
 #include "TH3D.h"
 #include "TRandom3.h"
 
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
+
 
 ClassImp(AliCFUnfolding)
 
+namespace {
+
+  //______________________________________________________________
+  // Sparse matrix engine of the bayesian unfolding (see AliCFUnfolding::UnfoldWithSparseMatrices)
+  //
+  // The cells of the measured (M) and true (T) spaces are numbered, and the response
+  // is kept as one entry per bin of the conditional matrix, in the order of the bins,
+  // indexed by M (compressed rows) and by T (compressed columns).
+  // Sums are done in the order of the bins, and values are rounded as when they are
+  // stored in the THnSparse, so that the results are the same as with the THnSparse.
+  //
+
+  struct Response {
+    Int_t                 nM, nT;                       // number of measured and true cells
+    std::vector<Int_t>    m, t;                         // cells of each entry
+    std::vector<Double_t> cond;                         // conditional probability of each entry
+    std::vector<Long64_t> rowStart, rowEntries;         // entries of each measured cell
+    std::vector<Long64_t> colStart, colEntries;         // entries of each true cell
+    Bool_t                floatResponse, floatTrue, floatMeasured; // float storage of the inverse response, true and measured spectra
+  };
+
+  struct State {
+    std::vector<Double_t> prior, priorTimesEff, estMeasured, invResponse, unfolded;
+    std::vector<Char_t>   inPrior;                      // true cells with a prior bin
+    std::vector<Int_t>    priorBins;                    // true cells of the prior bins, in the order of the bins
+    std::vector<Char_t>   invSet;                       // entries set in the inverse response
+    std::vector<Long64_t> firstEst, firstUnfolded;      // entry which created the bin of each cell, -1 if none
+    Bool_t                iterated;                     // at least one iteration was done
+    Bool_t                priorUpdated;                 // the prior was replaced by an unfolded spectrum
+  };
+
+  Int_t StorageType(const THnSparse* h) {
+    // 0 for double contents, 1 for float contents, -1 otherwise
+    if (h->IsA() == THnSparseD::Class()) return 0;
+    if (h->IsA() == THnSparseF::Class()) return 1;
+    return -1;
+  }
+
+  inline Double_t Store(Double_t value, Bool_t isFloat) {
+    // value as read back after storing it in a THnSparse
+    return isFloat ? (Double_t)(Float_t)value : value;
+  }
+
+  Long64_t CellKey(const Int_t* coord, const std::vector<Int_t>& nCells) {
+    // global index of a cell (under/overflow included), -1 if out of range
+    Long64_t key = 0;
+    for (Int_t i=nCells.size()-1; i>=0; i--) {
+      if (coord[i]<0 || coord[i]>=nCells[i]) return -1;
+      key = key*nCells[i] + coord[i];
+    }
+    return key;
+  }
+
+  Bool_t BinCells(const THnSparse* h, const std::vector<Int_t>& nCells, std::map<Long64_t,Int_t>& ids,
+                  std::vector<Int_t>& coords, Bool_t add, std::vector<Int_t>& cells) {
+    // cell of each bin of a spectrum; new cells are numbered if 'add', otherwise set to -1
+    Int_t n = nCells.size();
+    std::vector<Int_t> coord(n);
+    cells.resize(h->GetNbins());
+    for (Long64_t iBin=0; iBin<h->GetNbins(); iBin++) {
+      h->GetBinContent(iBin,&coord[0]);
+      cells[iBin] = -1;
+      Long64_t key = CellKey(&coord[0],nCells);
+      if (key<0) {
+        if (add) return kFALSE;
+        continue;
+      }
+      std::map<Long64_t,Int_t>::const_iterator it = ids.find(key);
+      if (it != ids.end()) cells[iBin] = it->second;
+      else if (add) {
+        cells[iBin] = ids.size();
+        ids[key] = cells[iBin];
+        coords.insert(coords.end(),coord.begin(),coord.end());
+      }
+    }
+    return kTRUE;
+  }
+
+  void Values(const THnSparse* h, const std::vector<Int_t>& cells, Int_t nCells, std::vector<Double_t>& values) {
+    // contents of a spectrum in its cells, 0 where there is no bin
+    values.assign(nCells,0.);
+    for (Long64_t iBin=0; iBin<(Long64_t)cells.size(); iBin++) {
+      if (cells[iBin]>=0) values[cells[iBin]] = h->GetBinContent(iBin);
+    }
+  }
+
+  void Compress(const std::vector<Int_t>& cell, Int_t nCells, std::vector<Long64_t>& start, std::vector<Long64_t>& entries) {
+    // entries of each cell, in increasing order
+    Long64_t nEntries = cell.size();
+    start.assign(nCells+1,0);
+    for (Long64_t b=0; b<nEntries; b++) start[cell[b]+1]++;
+    for (Int_t i=0; i<nCells; i++) start[i+1] += start[i];
+    entries.resize(nEntries);
+    std::vector<Long64_t> next(start.begin(),start.end()-1);
+    for (Long64_t b=0; b<nEntries; b++) entries[next[cell[b]]++] = b;
+  }
+
+  void BinOrder(const std::vector<Long64_t>& first, std::vector<Int_t>& cells) {
+    // cells with a bin, in the order in which the bins were created
+    cells.clear();
+    for (Int_t i=0; i<(Int_t)first.size(); i++) if (first[i]>=0) cells.push_back(i);
+    std::sort(cells.begin(),cells.end(),[&first](Int_t a, Int_t b) {return first[a]<first[b];});
+  }
+
+  void SetPrior(State& s, const THnSparse* prior, const std::vector<Int_t>& cells, Int_t nT) {
+    // prior from a THnSparse
+    s.prior.assign(nT,0.);
+    s.inPrior.assign(nT,0);
+    s.priorBins = cells;
+    for (Long64_t iBin=0; iBin<(Long64_t)cells.size(); iBin++) {
+      s.prior[cells[iBin]] = prior->GetBinContent(iBin);
+      s.inPrior[cells[iBin]] = 1;
+    }
+    s.priorUpdated = kFALSE;
+  }
+
+  void ResetPrior(State& s, const State& orig) {
+    s.prior = orig.prior;
+    s.inPrior = orig.inPrior;
+    s.priorBins = orig.priorBins;
+    s.priorUpdated = kFALSE;
+  }
+
+  void UpdatePrior(State& s) {
+    // the unfolded spectrum becomes the prior
+    s.prior = s.unfolded;
+    BinOrder(s.firstUnfolded,s.priorBins);
+    s.inPrior.assign(s.prior.size(),0);
+    for (UInt_t i=0; i<s.priorBins.size(); i++) s.inPrior[s.priorBins[i]] = 1;
+    s.priorUpdated = kTRUE;
+  }
+
+  Double_t Iterate(const Response& r, State& s, const std::vector<Double_t>& eff, const std::vector<Double_t>& measured, Bool_t warn) {
+    //
+    // One bayes iteration : CreateEstMeasured(), CreateInvResponse(), CreateUnfolded(),
+    // returns GetConvergence(). AliLog is not thread safe, hence 'warn'.
+    //
+
+    s.iterated = kTRUE;
+    for (Int_t iT=0; iT<r.nT; iT++) s.priorTimesEff[iT] = (s.inPrior[iT] ? Store(s.prior[iT]*eff[iT],r.floatTrue) : 0.);
+
+    // M(i) = SUM_k { COND(i,k) * T(k) * E(k) }
+    for (Int_t iM=0; iM<r.nM; iM++) {
+      Double_t sum = 0.;
+      Long64_t first = -1;
+      for (Long64_t k=r.rowStart[iM]; k<r.rowStart[iM+1]; k++) {
+        Long64_t b = r.rowEntries[k];
+        Double_t fill = r.cond[b] * s.priorTimesEff[r.t[b]];
+        if (fill>0.) {
+          sum = Store(sum+fill,r.floatMeasured);
+          if (first<0) first = b;
+        }
+      }
+      s.estMeasured[iM] = sum;
+      s.firstEst[iM] = first;
+    }
+
+    // INV(i,j) = COND(i,j) * T(j) * E(j) / M(i)
+    Long64_t nEntries = r.cond.size();
+    for (Long64_t b=0; b<nEntries; b++) {
+      Double_t estMeasuredValue = s.estMeasured[r.m[b]];
+      Double_t fill = (estMeasuredValue>0. ? r.cond[b] * s.priorTimesEff[r.t[b]] / estMeasuredValue : 0.);
+      if (fill>0. || s.invResponse[b]>0.) {
+        s.invResponse[b] = Store(fill,r.floatResponse);
+        s.invSet[b] = 1;
+      }
+    }
+
+    // T(i) = SUM_k { INV(k,i) * M(k) } / E(i)
+    for (Int_t iT=0; iT<r.nT; iT++) {
+      Double_t effValue = eff[iT];
+      Double_t sum = 0.;
+      Long64_t first = -1;
+      for (Long64_t k=r.colStart[iT]; k<r.colStart[iT+1]; k++) {
+        Long64_t b = r.colEntries[k];
+        Double_t fill = (effValue>0. ? s.invResponse[b] * measured[r.m[b]] / effValue : 0.);
+        if (fill>0.) {
+          sum = Store(sum+fill,r.floatTrue);
+          if (first<0) first = b;
+        }
+      }
+      s.unfolded[iT] = sum;
+      s.firstUnfolded[iT] = first;
+    }
+
+    Double_t convergence = 0.;
+    for (UInt_t i=0; i<s.priorBins.size(); i++) {
+      Double_t priorValue   = s.prior[s.priorBins[i]];
+      Double_t currentValue = s.unfolded[s.priorBins[i]];
+      if (priorValue > 0.)
+        convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+      else if (warn)
+        AliWarningGeneral("AliCFUnfolding",Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue));
+    }
+    return convergence;
+  }
+
+  void RandomizedUnfoldings(const Response& r, State& s, const State& priorOrig, Int_t nIterations,
+                            const std::vector<std::vector<Double_t> >& eff, const std::vector<std::vector<Double_t> >& measured,
+                            Int_t first, Int_t last, Bool_t warn, const std::vector<Int_t>& finalCells,
+                            std::vector<std::vector<Double_t> >& unfoldedFinal, std::vector<Double_t>& convergence) {
+    // unfoldings [first,last) of CalculateCorrelatedErrors(), keeping the unfolded values in the final bins
+    for (Int_t i=first; i<last; i++) {
+      ResetPrior(s,priorOrig);
+      for (Int_t iIterBayes=0; iIterBayes<nIterations; iIterBayes++) {
+        convergence[i] = Iterate(r,s,eff[i],measured[i],warn);
+        UpdatePrior(s);
+      }
+      for (UInt_t j=0; j<finalCells.size(); j++) unfoldedFinal[i][j] = (finalCells[j]>=0 ? s.unfolded[finalCells[j]] : 0.);
+    }
+  }
+
+  void FillSpectrum(THnSparse* h, const std::vector<Double_t>& values, const std::vector<Int_t>& cells, const std::vector<Int_t>& coords, Int_t n) {
+    // refills a spectrum, creating the bins in the given order, with errors set to zero
+    h->Reset();
+    for (UInt_t i=0; i<cells.size(); i++) {
+      const Int_t* coord = &coords[cells[i]*n];
+      h->SetBinContent(coord,values[cells[i]]);
+      h->SetBinError(coord,0.);
+    }
+  }
+
+  void WriteState(const State& s, const std::vector<Int_t>& coordsM, const std::vector<Int_t>& coordsT, Int_t n,
+                  THnSparse* estMeasured, THnSparse* invResponse, THnSparse* unfolded, THnSparse*& prior) {
+    // THnSparse as left by the same iterations done on them
+    for (Long64_t b=0; b<(Long64_t)s.invSet.size(); b++) {
+      if (!s.invSet[b]) continue;
+      invResponse->SetBinContent(b,s.invResponse[b]);
+      invResponse->SetBinError(b,0.);
+    }
+    if (!s.iterated) return;
+    std::vector<Int_t> cells;
+    BinOrder(s.firstEst,cells);
+    FillSpectrum(estMeasured,s.estMeasured,cells,coordsM,n);
+    if (s.priorUpdated) {
+      FillSpectrum(unfolded,s.prior,s.priorBins,coordsT,n);
+      delete prior;
+      prior = (THnSparse*)unfolded->Clone();
+      prior->SetTitle("Prior");
+    }
+    BinOrder(s.firstUnfolded,cells);
+    FillSpectrum(unfolded,s.unfolded,cells,coordsT,n);
+  }
+}
+
 //______________________________________________________________
 
 AliCFUnfolding::AliCFUnfolding() :
@@ -130,7 +386,9 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseSparseMatrices(kTRUE),
+  fNThreads(1)
 {
   //
   // default constructor
@@ -174,7 +432,9 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseSparseMatrices(kTRUE),
+  fNThreads(1)
 {
   //
   // named constructor
@@ -349,6 +609,11 @@ void AliCFUnfolding::Unfold() {
   // it calculates the unfolded spectrum from the response matrix, measured spectrum and efficiency
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
+  // Unless smoothing is used, the whole procedure (including the correlated errors)
+  // runs on sparse matrices, see UnfoldWithSparseMatrices()
+  //
+
+  if (fUseSparseMatrices && !fUseSmoothing && fNCalcCorrErrors == 0 && UnfoldWithSparseMatrices()) return;
 
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
@@ -483,8 +748,16 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     FillDeltaUnfoldedProfile();
   }
 
+  SetCorrelatedErrors();
+}
+
+//______________________________________________________________
+void AliCFUnfolding::SetCorrelatedErrors() {
+  //
   // Get statistical errors for final unfolded spectrum
   // ie. spread of each pt bin in fDeltaUnfoldedP
+  //
+
   Double_t meanx2 = 0.;
   Double_t mean = 0.;
   Double_t checksigma = 0.;
@@ -512,22 +785,22 @@ void AliCFUnfolding::CreateRandomizedDist() {
   //
 
   for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
-    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fResponseOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fResponseOrig->GetBinContent(iBin); //used as mean
+    Double_t err = fResponseOrig->GetBinError(iBin);   //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomResponse->SetBinContent(iBin,ran);
   }
   for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
-    Double_t val = fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fEfficiencyOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fEfficiencyOrig->GetBinContent(iBin); //used as mean
+    Double_t err = fEfficiencyOrig->GetBinError(iBin);   //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomEfficiency->SetBinContent(iBin,ran);
   }
   for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
-    Double_t val = fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fMeasuredOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fMeasuredOrig->GetBinContent(iBin); //used as mean
+    Double_t err = fMeasuredOrig->GetBinError(iBin);   //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomMeasured->SetBinContent(iBin,ran);
@@ -545,8 +818,24 @@ void AliCFUnfolding::FillDeltaUnfoldedProfile() {
   //  mean_{n+1} = (n*mean_n + value_{n+1}) / (n+1)
   // sigma_{n+1} = sqrt { 1/(n+1) * [ n*sigma_n^2 + (n^2+n)*(mean_{n+1}-mean_n)^2 ] }    (can this be optimized?)
 
+  Long_t nBins = fUnfoldedFinal->GetNbins();
+  Double_t* delta = new Double_t[nBins];
+  for (Long_t iBin=0; iBin<nBins; iBin++) {
+    delta[iBin] = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M) - fUnfolded->GetBinContent(fCoordinatesN_M);
+  }
+  FillDeltaUnfoldedProfile(delta);
+  delete [] delta;
+}
+
+//______________________________________________________________
+void AliCFUnfolding::FillDeltaUnfoldedProfile(const Double_t* delta) {
+  //
+  // Updates the delta profile given the deltas of each bin of fUnfoldedFinal (see above)
+  //
+
   for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
-    Double_t deltaInBin   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M) - fUnfolded->GetBinContent(fCoordinatesN_M);
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M);
+    Double_t deltaInBin   = delta[iBin];
     Double_t entriesInBin = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_M);
     //AliDebug(2,Form("%e %e ==> delta = %e\n",fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M),fUnfolded->GetBinContent(iBin),deltaInBin));
 
@@ -862,3 +1151,207 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::UnfoldWithSparseMatrices() {
+  //
+  // Same as Unfold() followed by CalculateCorrelatedErrors(), with the response
+  // converted once into sparse matrices (compressed rows and columns) and the spectra
+  // into arrays : each iteration is a few loops over the entries of the response
+  // instead of hash lookups in the THnSparse.
+  // The randomized inputs are drawn in sequence, then the randomized unfoldings are
+  // run in fNThreads threads. They depend on each other only through inverse response
+  // entries which are left unchanged, which needs negative values in the inputs :
+  // in that case they are run in sequence.
+  // The results and the final state of the THnSparse are the same as with Unfold().
+  // Returns kFALSE, having done nothing, if the histograms are not THnSparseF/D
+  // or if their bins do not fit in the binning of the response.
+  //
+
+  const Int_t n = fNVariables;
+  Int_t typeResponse = StorageType(fInverseResponse);
+  Int_t typeTrue     = StorageType(fUnfolded);
+  Int_t typeMeasured = StorageType(fMeasuredEstimate);
+  if (typeResponse<0 || typeTrue<0 || typeMeasured<0 ||
+      StorageType(fPrior) != typeTrue || StorageType(fPriorOrig) != typeTrue ||
+      fConditional->GetNbins() != fInverseResponse->GetNbins()) return kFALSE;
+
+  std::vector<Int_t> nCellsM(n), nCellsT(n);
+  Double_t sizeM = 1., sizeT = 1.;
+  for (Int_t iVar=0; iVar<n; iVar++) {
+    nCellsM[iVar] = fConditional->GetAxis(iVar)  ->GetNbins() + 2;
+    nCellsT[iVar] = fConditional->GetAxis(n+iVar)->GetNbins() + 2;
+    sizeM *= nCellsM[iVar];
+    sizeT *= nCellsT[iVar];
+  }
+  if (sizeM > 1.e18 || sizeT > 1.e18) return kFALSE;
+
+  // number the cells and build the matrices
+  Response r;
+  std::map<Long64_t,Int_t> idM, idT;
+  std::vector<Int_t> coordsM, coordsT;
+  Long64_t nEntries = fConditional->GetNbins();
+  r.m.resize(nEntries);
+  r.t.resize(nEntries);
+  r.cond.resize(nEntries);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    r.cond[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    Long64_t keyM = CellKey(fCoordinatesN_M,nCellsM);
+    Long64_t keyT = CellKey(fCoordinatesN_T,nCellsT);
+    if (keyM<0 || keyT<0) return kFALSE;
+    std::map<Long64_t,Int_t>::const_iterator it = idM.find(keyM);
+    if (it == idM.end()) {
+      it = idM.insert(std::make_pair(keyM,(Int_t)idM.size())).first;
+      coordsM.insert(coordsM.end(),fCoordinatesN_M,fCoordinatesN_M+n);
+    }
+    r.m[iBin] = it->second;
+    it = idT.find(keyT);
+    if (it == idT.end()) {
+      it = idT.insert(std::make_pair(keyT,(Int_t)idT.size())).first;
+      coordsT.insert(coordsT.end(),fCoordinatesN_T,fCoordinatesN_T+n);
+    }
+    r.t[iBin] = it->second;
+  }
+  std::vector<Int_t> priorCells, priorOrigCells, effCells, measuredCells;
+  if (!BinCells(fPrior,    nCellsT,idT,coordsT,kTRUE,priorCells) ||
+      !BinCells(fPriorOrig,nCellsT,idT,coordsT,kTRUE,priorOrigCells)) return kFALSE;
+  BinCells(fEfficiency,nCellsT,idT,coordsT,kFALSE,effCells);
+  BinCells(fMeasured,  nCellsM,idM,coordsM,kFALSE,measuredCells);
+
+  r.nM = idM.size();
+  r.nT = idT.size();
+  r.floatResponse = (typeResponse == 1);
+  r.floatTrue     = (typeTrue     == 1);
+  r.floatMeasured = (typeMeasured == 1);
+  Compress(r.m,r.nM,r.rowStart,r.rowEntries);
+  Compress(r.t,r.nT,r.colStart,r.colEntries);
+
+  State s;
+  s.priorTimesEff.assign(r.nT,0.);
+  s.unfolded.assign(r.nT,0.);
+  s.firstUnfolded.assign(r.nT,-1);
+  s.estMeasured.assign(r.nM,0.);
+  s.firstEst.assign(r.nM,-1);
+  s.invResponse.resize(nEntries);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) s.invResponse[iBin] = fInverseResponse->GetBinContent(iBin);
+  s.invSet.assign(nEntries,0);
+  s.iterated = kFALSE;
+  SetPrior(s,fPrior,priorCells,r.nT);
+
+  std::vector<Double_t> eff, measured;
+  Values(fEfficiency,effCells,r.nT,eff);
+  Values(fMeasured,measuredCells,r.nM,measured);
+
+  // bayes iterations
+  Int_t iIterBayes     = 0 ;
+  Double_t convergence = 0.;
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+    convergence = Iterate(r,s,eff,measured,kTRUE);
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+    if (fMaxConvergence>0. && convergence<fMaxConvergence) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+    UpdatePrior(s);
+  }
+  WriteState(s,coordsM,coordsT,n,fMeasuredEstimate,fInverseResponse,fUnfolded,fPrior);
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+
+  // correlated errors
+  Int_t nTrials = fNRandomIterations;
+  if (nTrials>0) {
+    State priorOrig;
+    SetPrior(priorOrig,fPriorOrig,priorOrigCells,r.nT);
+
+    std::vector<Int_t> finalCells, randomEffCells, randomMeasuredCells;
+    BinCells(fUnfoldedFinal,   nCellsT,idT,coordsT,kFALSE,finalCells);
+    BinCells(fRandomEfficiency,nCellsT,idT,coordsT,kFALSE,randomEffCells);
+    BinCells(fRandomMeasured,  nCellsM,idM,coordsM,kFALSE,randomMeasuredCells);
+
+    // randomized inputs, drawn in the same sequence as in CalculateCorrelatedErrors()
+    std::vector<std::vector<Double_t> > randomEff(nTrials), randomMeasured(nTrials);
+    for (Int_t i=0; i<nTrials; i++) {
+      CreateRandomizedDist();
+      Values(fRandomEfficiency,randomEffCells,r.nT,randomEff[i]);
+      Values(fRandomMeasured,randomMeasuredCells,r.nM,randomMeasured[i]);
+    }
+
+    // with no negative value, every entry of the inverse response is set at
+    // the first iteration, and an unfolding does not depend on the previous one
+    Bool_t independent = kTRUE;
+    for (Long64_t b=0; b<nEntries && independent; b++) {
+      if (!(r.cond[b]>=0.) || !(s.invResponse[b]>=0.)) independent = kFALSE;
+    }
+    for (Int_t iT=0; iT<r.nT && independent; iT++) {
+      if (!(priorOrig.prior[iT]>=0.)) independent = kFALSE;
+      for (Int_t i=0; i<nTrials; i++) if (!(randomEff[i][iT]>=0.)) independent = kFALSE;
+    }
+
+    Int_t nThreads = (fNThreads>0 ? fNThreads : (Int_t)std::thread::hardware_concurrency());
+    if (nThreads>1 && !independent) {
+      AliInfo("Negative values in the inputs : the randomized unfoldings are run in sequence");
+      nThreads = 1;
+    }
+    if (nThreads<1) nThreads = 1;
+    if (nThreads>nTrials) nThreads = nTrials;
+
+    std::vector<State> states(nThreads,s);
+    std::vector<std::vector<Double_t> > unfoldedFinal(nTrials,std::vector<Double_t>(finalCells.size(),0.));
+    std::vector<Double_t> trialConvergence(nTrials,0.);
+    if (nThreads==1) {
+      RandomizedUnfoldings(r,states[0],priorOrig,fMaxNumIterations,randomEff,randomMeasured,0,nTrials,kTRUE,
+                           finalCells,unfoldedFinal,trialConvergence);
+    }
+    else {
+      std::vector<std::thread> threads;
+      for (Int_t iThread=0; iThread<nThreads; iThread++) {
+        Int_t first = (Long64_t)nTrials*iThread/nThreads;
+        Int_t last  = (Long64_t)nTrials*(iThread+1)/nThreads;
+        threads.push_back(std::thread(RandomizedUnfoldings,std::cref(r),std::ref(states[iThread]),std::cref(priorOrig),
+                                      fMaxNumIterations,std::cref(randomEff),std::cref(randomMeasured),first,last,kFALSE,
+                                      std::cref(finalCells),std::ref(unfoldedFinal),std::ref(trialConvergence)));
+      }
+      for (Int_t iThread=0; iThread<nThreads; iThread++) threads[iThread].join();
+    }
+
+    // delta profile, in the order of the unfoldings
+    std::vector<Double_t> delta(finalCells.size());
+    for (Int_t i=0; i<nTrials; i++) {
+      for (UInt_t j=0; j<finalCells.size(); j++) delta[j] = fUnfoldedFinal->GetBinContent(j) - unfoldedFinal[i][j];
+      FillDeltaUnfoldedProfile(delta.data());
+      AliInfo(Form("=======================\nUnfolding of randomized distribution finished at iteration %d with convergence %e \n",fMaxNumIterations,trialConvergence[i]));
+    }
+
+    // state after the last unfolding
+    State& last = states.back();
+    for (Int_t iThread=0; iThread<nThreads-1; iThread++) {
+      for (Long64_t b=0; b<nEntries; b++) last.invSet[b] |= states[iThread].invSet[b];
+    }
+    if (!last.priorUpdated) {
+      delete fPrior;
+      fPrior = (THnSparse*) fPriorOrig->Clone();
+    }
+    WriteState(last,coordsM,coordsT,n,fMeasuredEstimate,fInverseResponse,fUnfolded,fPrior);
+
+    if (fResponse) delete fResponse ;
+    fResponse = (THnSparse*) fRandomResponse->Clone();
+    fResponse->SetTitle("Response");
+    if (fEfficiency) delete fEfficiency ;
+    fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
+    fEfficiency->SetTitle("Efficiency");
+    if (fMeasured)   delete fMeasured   ;
+    fMeasured = (THnSparse*) fRandomMeasured->Clone();
+    fMeasured->SetTitle("Measured");
+  }
+
+  SetCorrelatedErrors();
+
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+  return kTRUE;
+}
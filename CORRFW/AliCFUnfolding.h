@@ -36,6 +36,8 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetUseSparseMatrices(Bool_t b = kTRUE) {fUseSparseMatrices = b;} // iterate on sparse matrices instead of the THnSparse (default)
+  void SetNThreads(Int_t n = 1) {fNThreads = n;}                        // threads for the randomized unfoldings (0 = number of cores)
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -111,6 +113,8 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Bool_t         fUseSparseMatrices; // Unfold with the sparse matrix engine when possible
+  Int_t          fNThreads;          // Number of threads for the randomized unfoldings
 
 
   // functions
@@ -130,9 +134,14 @@ class AliCFUnfolding : public TNamed {
   void     CalculateCorrelatedErrors(); // Calculates correlated errors for the final unfolded spectrum
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
+  void     FillDeltaUnfoldedProfile(const Double_t* delta); // Fills the fDeltaUnfoldedP profile with the deltas of the fUnfoldedFinal bins
+  void     SetCorrelatedErrors();       // Sets the errors of fUnfoldedFinal from the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* sparse matrix engine */
+  Bool_t   UnfoldWithSparseMatrices();  // Unfold() and CalculateCorrelatedErrors() on sparse matrices, kFALSE if not applicable
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -154,18 +154,11 @@ void AliCFSingleTrackTask::UserExec(Option_t *)
   for (Int_t ipart=0; ipart<fMCEvent->GetNumberOfTracks(); ipart++) { 
     AliMCParticle *mcPart  = (AliMCParticle*)fMCEvent->GetTrack(ipart);
 
-    //check the MC-level cuts
-    if (!fCFManager->CheckParticleCuts(AliCFManager::kPartGenCuts,mcPart)) continue;
-
     containerInput[0] = (Float_t)mcPart->Pt();
     containerInput[1] = mcPart->Eta() ;
-    //fill the container for Gen-level selection
-    fCFManager->GetParticleContainer()->Fill(containerInput,kStepGenerated);
-
-    //check the Acceptance-level cuts
-    if (!fCFManager->CheckParticleCuts(AliCFManager::kPartAccCuts,mcPart)) continue;
-    //fill the container for Acceptance-level selection
-    fCFManager->GetParticleContainer()->Fill(containerInput,kStepReconstructible);
+    //check the MC-level then the Acceptance-level cuts, and fill the container
+    //for Gen-level and Acceptance-level selection
+    fCFManager->FillParticleContainer(containerInput,mcPart,1.,kTRUE,"all",AliCFManager::kPartGenCuts,AliCFManager::kPartAccCuts);
   }    
 
   //Now go to rec level
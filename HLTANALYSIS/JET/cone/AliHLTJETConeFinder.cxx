@@ -285,6 +285,17 @@ Int_t AliHLTJETConeFinder::FindConeJets() {
     
     AliHLTJETConeJetCandidate* jet = reinterpret_cast<AliHLTJETConeJetCandidate*> ((*jetCandidates)[iter]);
     
+    // -- Whole cells : use the running sums of the grid
+    if ( jet->GetUseWholeCell() ) {
+      Float_t aSums[] = { 0., 0., 0. };
+      Int_t   nTracks = 0;
+
+      if ( ! fGrid->GetConeSums( jet->GetSeedEtaIdx(), jet->GetSeedPhiIdx(), aSums, nTracks ) ) {
+	jet->AddConeSums( aSums, nTracks );
+	continue;
+      }
+    }
+
     // -- Set iterator for cells around seed
     fGrid->SetCellIter( jet->GetSeedEtaIdx(), jet->GetSeedPhiIdx() ); 
 
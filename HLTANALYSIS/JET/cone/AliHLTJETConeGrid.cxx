@@ -28,6 +28,8 @@
 // or
 // visit http://web.ift.uib.no/~kjeks/doc/alice-hlt   
 
+#include <algorithm>
+
 #include "AliHLTJETConeGrid.h"
 #include "AliHLTJETConeEtaPhiCell.h"
 
@@ -46,6 +48,18 @@ ClassImp(AliHLTJETConeGrid)
 AliHLTJETConeGrid::AliHLTJETConeGrid()
   : 
   fGrid(NULL),
+  fCellPt(),
+  fCellEta(),
+  fCellPhi(),
+  fCellNTracks(),
+  fFilledCells(),
+  fRowSumPt(),
+  fRowSumEta(),
+  fRowSumPhi(),
+  fRowSumNTracks(),
+  fFilledRows(),
+  fRowFilled(),
+  fRowSumsValid(kTRUE),
   fEtaMin(-0.9),
   fEtaMax(0.9),
   fPhiMin(0.0),
@@ -121,6 +135,24 @@ Int_t AliHLTJETConeGrid::Initialize() {
     iResult = 1;
   }
 
+  // -- Setup flat cell arrays and running sums, kept for all events
+  fCellPt.assign( fNBins, 0. );
+  fCellEta.assign( fNBins, 0. );
+  fCellPhi.assign( fNBins, 0. );
+  fCellNTracks.assign( fNBins, 0 );
+  fFilledCells.clear();
+  fFilledCells.reserve( fNBins );
+
+  Int_t nRowSums = fPhiNGridBins * ( fEtaNGridBins + 1 );
+  fRowSumPt.assign( nRowSums, 0. );
+  fRowSumEta.assign( nRowSums, 0. );
+  fRowSumPhi.assign( nRowSums, 0. );
+  fRowSumNTracks.assign( nRowSums, 0 );
+  fFilledRows.clear();
+  fFilledRows.reserve( fPhiNGridBins );
+  fRowFilled.assign( fPhiNGridBins, kFALSE );
+  fRowSumsValid = kTRUE;
+
   return iResult;
 }
 
@@ -131,6 +163,30 @@ void AliHLTJETConeGrid::Reset() {
   if ( fGrid )
     fGrid->Clear("C");
 
+  // -- Clear only the filled cells and rows
+  for ( std::vector<Int_t>::const_iterator iter = fFilledCells.begin(); iter != fFilledCells.end(); ++iter ) {
+    fCellPt[*iter]      = 0.;
+    fCellEta[*iter]     = 0.;
+    fCellPhi[*iter]     = 0.;
+    fCellNTracks[*iter] = 0;
+  }
+  fFilledCells.clear();
+
+  for ( std::vector<Int_t>::const_iterator iter = fFilledRows.begin(); iter != fFilledRows.end(); ++iter ) {
+    Int_t first = (*iter) * ( fEtaNGridBins + 1 );
+    Int_t last  = first + fEtaNGridBins + 1;
+
+    std::fill( fRowSumPt.begin() + first,      fRowSumPt.begin() + last,      0. );
+    std::fill( fRowSumEta.begin() + first,     fRowSumEta.begin() + last,     0. );
+    std::fill( fRowSumPhi.begin() + first,     fRowSumPhi.begin() + last,     0. );
+    std::fill( fRowSumNTracks.begin() + first, fRowSumNTracks.begin() + last, 0 );
+
+    fRowFilled[*iter] = kFALSE;
+  }
+  fFilledRows.clear();
+
+  fRowSumsValid = kTRUE;
+
   return;
 }
 
@@ -170,6 +226,8 @@ Int_t AliHLTJETConeGrid::FillTrack( TParticle* particle, const Float_t* aEtaPhi,
     (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxPrimary]]))->AddTrack(particle);
   }
 
+  FillFlatCell( aGridIdx[kIdxPrimary], aGridIdx[kIdxPhiPrimary] );
+
   // ---------------------------
   // -- Fill track in outter region
   // ---------------------------
@@ -187,6 +245,8 @@ Int_t AliHLTJETConeGrid::FillTrack( TParticle* particle, const Float_t* aEtaPhi,
     else {
       (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxOutter]]))->AddTrack(particle);
     }
+
+    FillFlatCell( aGridIdx[kIdxOutter], aGridIdx[kIdxPhiOutter] );
   }
 
   return 0;
@@ -221,6 +281,8 @@ Int_t AliHLTJETConeGrid::FillTrack( AliESDtrack *esdTrack, const Float_t* aEtaPh
   else {
     (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxPrimary]]))->AddTrack(esdTrack);
   }
+
+  FillFlatCell( aGridIdx[kIdxPrimary], aGridIdx[kIdxPhiPrimary] );
    
   // ---------------------------
   // -- Fill track in outter region
@@ -239,6 +301,8 @@ Int_t AliHLTJETConeGrid::FillTrack( AliESDtrack *esdTrack, const Float_t* aEtaPh
     else {
       (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxOutter]]))->AddTrack(esdTrack);
     }
+
+    FillFlatCell( aGridIdx[kIdxOutter], aGridIdx[kIdxPhiOutter] );
   }
   
   return 0;
@@ -295,12 +359,112 @@ void AliHLTJETConeGrid::SetCellIter( const Int_t etaIdx, const Int_t phiIdx ) {
   return;
 }
 
+// #################################################################################
+Int_t AliHLTJETConeGrid::GetConeSums( const Int_t etaIdx, const Int_t phiIdx, 
+				      Float_t* aSums, Int_t &nTracks ) {
+  // see header file for class documentation
+
+  Int_t etaIdxMin = etaIdx - fEtaNRBins;
+  Int_t etaIdxMax = etaIdx + fEtaNRBins;
+  Int_t phiIdxMin = phiIdx - fPhiNRBins;
+  Int_t phiIdxMax = phiIdx + fPhiNRBins;
+
+  // -- Cells outside of the grid are left to NextCell
+  if ( etaIdxMin < 0 || etaIdxMax >= fEtaNGridBins || 
+       phiIdxMin < 0 || phiIdxMax >= fPhiNGridBins )
+    return 1;
+
+  if ( ! fRowSumsValid )
+    FillRowSums();
+
+  Double_t pt  = 0.;
+  Double_t eta = 0.;
+  Double_t phi = 0.;
+  nTracks = 0;
+
+  // -- One difference of running sums per phi row
+  for ( Int_t iter = phiIdxMin; iter <= phiIdxMax; iter++ ) {
+    if ( ! fRowFilled[iter] )
+      continue;
+
+    Int_t first = iter * ( fEtaNGridBins + 1 ) + etaIdxMin;
+    Int_t last  = iter * ( fEtaNGridBins + 1 ) + etaIdxMax + 1;
+
+    pt      += fRowSumPt[last]      - fRowSumPt[first];
+    eta     += fRowSumEta[last]     - fRowSumEta[first];
+    phi     += fRowSumPhi[last]     - fRowSumPhi[first];
+    nTracks += fRowSumNTracks[last] - fRowSumNTracks[first];
+  }
+
+  aSums[kIdxEta] = eta;
+  aSums[kIdxPhi] = phi;
+  aSums[kIdxPt]  = pt;
+
+  return 0;
+}
+
 /*
  * ---------------------------------------------------------------------------------
  *                             Helper - private
  * ---------------------------------------------------------------------------------
  */
 
+//##################################################################################
+void AliHLTJETConeGrid::FillFlatCell( Int_t cellIdx, Int_t phiIdx ) {
+  // see header file for class documentation
+
+  AliHLTJETConeEtaPhiCell* cell = reinterpret_cast<AliHLTJETConeEtaPhiCell*> (fGrid->UncheckedAt(cellIdx));
+
+  // -- First track in cell / row
+  if ( ! fCellNTracks[cellIdx] ) {
+    fFilledCells.push_back( cellIdx );
+
+    if ( ! fRowFilled[phiIdx] ) {
+      fRowFilled[phiIdx] = kTRUE;
+      fFilledRows.push_back( phiIdx );
+    }
+  }
+
+  fCellPt[cellIdx]      = cell->GetPt();
+  fCellEta[cellIdx]     = cell->GetEta();
+  fCellPhi[cellIdx]     = cell->GetPhi();
+  fCellNTracks[cellIdx] = cell->GetNTracks();
+
+  fRowSumsValid = kFALSE;
+
+  return;
+}
+
+//##################################################################################
+void AliHLTJETConeGrid::FillRowSums() {
+  // see header file for class documentation
+
+  // -- Rows not filled in this event keep their zero sums
+  for ( std::vector<Int_t>::const_iterator iter = fFilledRows.begin(); iter != fFilledRows.end(); ++iter ) {
+
+    const Float_t* cellPt      = &fCellPt[(*iter) * fEtaNGridBins];
+    const Float_t* cellEta     = &fCellEta[(*iter) * fEtaNGridBins];
+    const Float_t* cellPhi     = &fCellPhi[(*iter) * fEtaNGridBins];
+    const Int_t*   cellNTracks = &fCellNTracks[(*iter) * fEtaNGridBins];
+
+    Double_t* sumPt      = &fRowSumPt[(*iter) * ( fEtaNGridBins + 1 )];
+    Double_t* sumEta     = &fRowSumEta[(*iter) * ( fEtaNGridBins + 1 )];
+    Double_t* sumPhi     = &fRowSumPhi[(*iter) * ( fEtaNGridBins + 1 )];
+    Int_t*    sumNTracks = &fRowSumNTracks[(*iter) * ( fEtaNGridBins + 1 )];
+
+    for ( Int_t idx = 0; idx < fEtaNGridBins; idx++ ) {
+      sumPt[idx+1]      = sumPt[idx]      + cellPt[idx];
+      sumEta[idx+1]     = sumEta[idx]     + cellEta[idx];
+      sumPhi[idx+1]     = sumPhi[idx]     + cellPhi[idx];
+      sumNTracks[idx+1] = sumNTracks[idx] + cellNTracks[idx];
+    }
+  }
+
+  fRowSumsValid = kTRUE;
+
+  return;
+}
+
 //##################################################################################
 Int_t AliHLTJETConeGrid::GetCellIndex( const Float_t* aEtaPhi, Int_t* aGridIdx ) {
   // see header file for class documentation
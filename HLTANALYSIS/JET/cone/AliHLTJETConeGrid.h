@@ -22,6 +22,8 @@
 // visit http://web.ift.uib.no/~kjeks/doc/alice-hlt
 
 
+#include <vector>
+
 #include "TClonesArray.h"
 #include "TParticle.h"
 
@@ -34,6 +36,13 @@
  * @class  AliHLTJETConeGrid
  * Eta-Phi grid of the cone finder
  *
+ * Next to the cells, the summed (eta,phi,pt) and number of tracks of 
+ * every cell are kept in flat arrays, with running sums along eta for
+ * every phi row. The sums of a whole-cell cone around a seed are then 
+ * given by one difference per phi row, see GetConeSums().
+ * Only the cells and rows filled in an event are cleared in Reset(),
+ * the arrays are allocated once in Initialize().
+ *
  * @ingroup alihlt_jet_cone
  */
 
@@ -132,6 +141,19 @@ public:
    */
   void SetCellIter( const Int_t etaIdx, const Int_t phiIdx );
 
+  /** Sum the cells around a seed, as whole cells
+   *  Same cells as iterated with SetCellIter/NextCell,
+   *  summed using the running sums of the phi rows.
+   *  @param etaIdx   Eta index of seed
+   *  @param phiIdx   Phi index of seed
+   *  @param aSums    array to be filled with summed (eta,phi,pt) 
+   *  @param nTracks  filled with summed number of tracks
+   *  @return 0 on sucess, 1 if the cells exceed the grid 
+   *          -> use NextCell then
+   */
+  Int_t GetConeSums( const Int_t etaIdx, const Int_t phiIdx, 
+		     Float_t* aSums, Int_t &nTracks );
+
 
   /** Check if there is an object at cellIdx in fGrid
    *  @param   cellIdx    CellIdx where there coulf be an object
@@ -175,6 +197,15 @@ private:
    */
   Int_t GetCellIndex( const Float_t* aEtaPhi, Int_t* aGridIdx );
 
+  /** Copy the sums of a cell into the flat arrays
+   *  @param cellIdx  1D index of the cell
+   *  @param phiIdx   phi index of the cell
+   */
+  void FillFlatCell( Int_t cellIdx, Int_t phiIdx );
+
+  /** Compute the running sums along eta of the filled phi rows */
+  void FillRowSums();
+
   /*
    * ---------------------------------------------------------------------------------
    *                             Members - private
@@ -186,6 +217,46 @@ private:
   /** Search Grid */
   TClonesArray*  fGrid;                    //! transient
 
+  // -- Flat cell arrays - set via Initialize(), idx = eta + phi * fEtaNGridBins
+
+  /** Summed pt of cells */
+  std::vector<Float_t>  fCellPt;           //! transient
+
+  /** Summed eta of cells */
+  std::vector<Float_t>  fCellEta;          //! transient
+
+  /** Summed phi of cells */
+  std::vector<Float_t>  fCellPhi;          //! transient
+
+  /** Number of tracks of cells */
+  std::vector<Int_t>    fCellNTracks;      //! transient
+
+  /** Cells filled in the current event */
+  std::vector<Int_t>    fFilledCells;      //! transient
+
+  // -- Running sums along eta, ( fEtaNGridBins + 1 ) per phi row
+
+  /** Running sum of pt */
+  std::vector<Double_t> fRowSumPt;         //! transient
+
+  /** Running sum of eta */
+  std::vector<Double_t> fRowSumEta;        //! transient
+
+  /** Running sum of phi */
+  std::vector<Double_t> fRowSumPhi;        //! transient
+
+  /** Running sum of number of tracks */
+  std::vector<Int_t>    fRowSumNTracks;    //! transient
+
+  /** Phi rows filled in the current event */
+  std::vector<Int_t>    fFilledRows;       //! transient
+
+  /** Flag per phi row if filled in the current event */
+  std::vector<Bool_t>   fRowFilled;        //! transient
+
+  /** Running sums are up to date */
+  Bool_t                fRowSumsValid;     //! transient
+
   // -- Grid boundaries in eta and phi - set via setter
 
   /** Minimum eta */
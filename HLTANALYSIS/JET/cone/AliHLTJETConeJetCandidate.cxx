@@ -169,6 +169,21 @@ Int_t AliHLTJETConeJetCandidate::AddCell( AliHLTJETConeEtaPhiCell* cell ) {
   return 0;
 }
 
+//##################################################################################
+void AliHLTJETConeJetCandidate::AddConeSums( const Float_t* aSums, Int_t nTracks ) {
+  // see header file for class documentation
+
+  fPt  += aSums[kIdxPt];
+  fPhi += aSums[kIdxPhi];
+  fEta += aSums[kIdxEta];
+  fNTracks += nTracks;
+
+  HLTDebug("Cone : eta: %f - phi: %f - pt: %f - nTracks: %d .", 
+	   aSums[kIdxEta], aSums[kIdxPhi], aSums[kIdxPt], nTracks );
+
+  return;
+}
+
 /*
  * ---------------------------------------------------------------------------------
  *                                Sort of JetCandidates 
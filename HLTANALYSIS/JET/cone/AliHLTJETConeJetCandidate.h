@@ -92,6 +92,9 @@ public:
   /** Get Et of jet */
   Float_t       GetEt()            { return fPt; }  
 
+  /** Get if whole cells are added */
+  Bool_t        GetUseWholeCell()  { return fUseWholeCell; }
+
   /*
    * ---------------------------------------------------------------------------------
    *                                     Process 
@@ -104,6 +107,13 @@ public:
    */
   Int_t AddCell( AliHLTJETConeEtaPhiCell* cell );
 
+  /** Add summed whole cells to JetCandidate 
+   *  see AliHLTJETConeGrid::GetConeSums
+   *  @param aSums   summed (eta,phi,pt) of the cells
+   *  @param nTracks summed number of tracks of the cells
+   */
+  void AddConeSums( const Float_t* aSums, Int_t nTracks );
+
 
 
   /* XXXXXXXXXX
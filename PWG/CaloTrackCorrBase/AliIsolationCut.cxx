@@ -15,6 +15,8 @@
 
 // --- ROOT system ---
 #include <TObjArray.h>
+#include <algorithm>
+#include <vector>
 
 // --- AliRoot system ---
 #include "AliCaloTrackParticleCorrelation.h"
@@ -54,8 +56,32 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fConeIndexCellSize(0.1),
+fIndexCTS(0),                fIndexNe(0),
+fIndexEvent(-1),             fIndexPartInCone(-1),
+fIndexTMRejected(0),         fNIndexed(0),
+fIdxPt(),                    fIdxEta(),
+fIdxPhi(),                   fIdxType(),
+fIdxSource(),                fIdxID(),
+fIdxHasID(),
+fNEtaCells(0),               fNPhiCells(0),
+fIdxEtaMin(0),               fIdxCellEta(0),
+fIdxCellPhi(0),
+fCellStart(),                fCellEntries(),
+fStripEta(),                 fStripEtaSum(),
+fStripPhi(),                 fStripPhiSum(),
+fIDOrder(),                  fIDSorted(),
+fNLocal(0),
+fLocal(),                    fLocalRad(),
+fLocalExcluded(),            fLocalOrder()
 {
+  for(Int_t i = 0; i < 3; i++)
+  {
+    fTypeStart[i] = 0;
+    fIDStart  [i] = 0;
+  }
+  
   InitParameters();
 }
 
@@ -422,7 +448,6 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
                                         Float_t & coneptsum, Float_t & ptLead,
                                         Bool_t  & isolated)
 {
-  Float_t ptC   = pCandidate->Pt() ;
   Float_t phiC  = pCandidate->Phi() ;
   if ( phiC < 0 ) phiC+=TMath::TwoPi();
   Float_t etaC  = pCandidate->Eta() ;
@@ -447,6 +472,55 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   AliDebug(1,Form("Candidate pT %2.2f, eta %2.2f, phi %2.2f, cone %1.2f, thres %2.2f, Fill AOD? %d",
                   pCandidate->Pt(), pCandidate->Eta(), pCandidate->Phi()*TMath::RadToDeg(), fConeSize,fPtThreshold,bFillAOD));
   
+  Float_t sums[kNConeSums];
+  
+  // --------------------------------
+  // Use the eta-phi index of the event if it was built for these lists.
+  // --------------------------------
+  
+  if ( IsConeIndexOf(plCTS, plNe, reader) )
+  {
+    ConeSumsFromIndex(pCandidate, 1, &fConeSize, sums);
+    
+    if ( sums[kConePtLead] < ptLead ) sums[kConePtLead] = ptLead;
+    ptLead = sums[kConePtLead];
+    
+    //Add reference arrays to AOD when filling AODs only, in the order of the input lists
+    if ( bFillAOD )
+    {
+      std::vector<Int_t> inCone[2];
+      for(Int_t k = 0; k < fNLocal; k++)
+      {
+        Int_t e = fLocal[k];
+        if ( fLocalExcluded[k] || fLocalRad[k] >= fConeSize || !fIdxHasID[e] ) continue ;
+        if ( TMath::Abs(fIdxPhi[e]-phiC) > TMath::PiOver2() ) continue ;
+        inCone[fIdxType[e]].push_back(fIdxSource[e]);
+      }
+      
+      for(Int_t itype = 0; itype < 2; itype++)
+      {
+        if ( inCone[itype].empty() ) continue ;
+        
+        std::sort(inCone[itype].begin(), inCone[itype].end());
+        
+        TObjArray * refs = new TObjArray(0);
+        TString tempo(aodArrayRefName)  ;
+        tempo += (itype == 0 ? "Tracks" : "Clusters") ;
+        refs->SetName(tempo);
+        refs->SetOwner(kFALSE);
+        
+        TObjArray * list = (itype == 0 ? plCTS : plNe);
+        for(UInt_t i = 0; i < inCone[itype].size(); i++) refs->Add(list->At(inCone[itype][i]));
+        
+        pCandidate->AddObjArray(refs);
+      }
+    }
+    
+    CheckIsolation(pCandidate, reader, sums, n, nfrac, coneptsum, isolated);
+    
+    return;
+  }
+  
   //Initialize the array with refrences
   TObjArray * refclusters  = 0x0;
   TObjArray * reftracks    = 0x0;
@@ -762,6 +836,52 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
     if(reftracks)	  pCandidate->AddObjArray(reftracks);
   }
   
+  sums[kConeSumTrack]      = coneptsumTrack;
+  sums[kConeSumCluster]    = coneptsumCluster;
+  sums[kConePtLead]        = ptLead;
+  sums[kEtaBandSumTrack]   = etaBandPtSumTrack;
+  sums[kPhiBandSumTrack]   = phiBandPtSumTrack;
+  sums[kEtaBandSumCluster] = etaBandPtSumCluster;
+  sums[kPhiBandSumCluster] = phiBandPtSumCluster;
+  
+  CheckIsolation(pCandidate, reader, sums, n, nfrac, coneptsum, isolated);
+}
+
+//_________________________________________________________________________________
+/// Decide on the isolation of the candidate from its cone sums, see coneSums,
+/// with the current cone size, thresholds and isolation method.
+///
+/// \param pCandidate: particle identified as isolation candidate.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param sums: cone and UE band sums, kNConeSums values.
+/// \param n: number of tracks/clusters above threshold in cone, output.
+/// \param nfrac: 1 if fraction pT cluster-track / pT trigger in cone avobe threshold, output.
+/// \param coneptsum: total momentum energy in cone (track+cluster), output.
+/// \param isolated: final bool with decission on isolation of candidate particle.
+//_________________________________________________________________________________
+void AliIsolationCut::CheckIsolation(AliCaloTrackParticleCorrelation * pCandidate,
+                                     AliCaloTrackReader * reader,
+                                     const Float_t * sums,
+                                     Int_t & n, Int_t & nfrac, Float_t & coneptsum,
+                                     Bool_t & isolated)
+{
+  Float_t ptC   = pCandidate->Pt() ;
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t coneptsumTrack      = sums[kConeSumTrack];
+  Float_t coneptsumCluster    = sums[kConeSumCluster];
+  Float_t ptLead              = sums[kConePtLead];
+  Float_t etaBandPtSumTrack   = sums[kEtaBandSumTrack];
+  Float_t phiBandPtSumTrack   = sums[kPhiBandSumTrack];
+  Float_t etaBandPtSumCluster = sums[kEtaBandSumCluster];
+  Float_t phiBandPtSumCluster = sums[kPhiBandSumCluster];
+  
+  n         = 0 ;
+  nfrac     = 0 ;
+  isolated  = kFALSE;
+  
   coneptsum = coneptsumCluster + coneptsumTrack;
   
   // *Now*, just check the leading particle in the cone if the threshold is passed
@@ -878,6 +998,462 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   }
 }
 
+//_________________________________________________________________________________
+/// Fill the eta-phi index of the tracks and clusters of the event, used by
+/// MakeIsolationCut() and MakeSeveralConesSums() for the candidates of the event
+/// when called with the same lists. The candidate independent selections
+/// (particle type in cone, track matched clusters) are applied here.
+/// Call ResetConeIndex() before the lists are deleted.
+///
+/// \param plCTS: list of tracks.
+/// \param plNe: list of calorimeter clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matches.
+//_________________________________________________________________________________
+void AliIsolationCut::BuildConeIndex(TObjArray * plCTS, TObjArray * plNe,
+                                     AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  ResetConeIndex();
+  
+  Int_t nTracks   = 0;
+  Int_t nClusters = 0;
+  if ( plCTS && (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged) ) nTracks   = plCTS->GetEntriesFast();
+  if ( plNe  && (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged) ) nClusters = plNe ->GetEntriesFast();
+  
+  Int_t nMax = nTracks+nClusters;
+  if ( fIdxPt.GetSize() < nMax )
+  {
+    fIdxPt        .Set(nMax);
+    fIdxEta       .Set(nMax);
+    fIdxPhi       .Set(nMax);
+    fIdxType      .Set(nMax);
+    fIdxSource    .Set(nMax);
+    fIdxID        .Set(nMax);
+    fIdxHasID     .Set(nMax);
+    fCellEntries  .Set(nMax);
+    fStripEta     .Set(nMax);
+    fStripEtaSum  .Set(nMax);
+    fStripPhi     .Set(nMax);
+    fStripPhiSum  .Set(nMax);
+    fIDOrder      .Set(nMax);
+    fIDSorted     .Set(nMax);
+    fLocal        .Set(nMax);
+    fLocalRad     .Set(nMax);
+    fLocalExcluded.Set(nMax);
+    fLocalOrder   .Set(nMax);
+  }
+  
+  Float_t pt  = 0;
+  Float_t eta = 0;
+  Float_t phi = 0;
+  
+  // Tracks, as in MakeIsolationCut
+  fTypeStart[0] = 0;
+  for(Int_t ipr = 0; ipr < nTracks; ipr++)
+  {
+    TObject * obj = plCTS->At(ipr);
+    if ( !obj ) continue ;
+    
+    AliVTrack * track = dynamic_cast<AliVTrack*>(obj) ;
+    Int_t  id    = 0;
+    Bool_t hasID = kFALSE;
+    if ( track )
+    {
+      id    = reader->GetTrackID(track) ;
+      hasID = kTRUE;
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      pt  = fTrackVector.Pt();
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi() ;
+    }
+    else
+    {// Mixed event stored in AliCaloTrackParticles
+      AliCaloTrackParticle * trackmix = dynamic_cast<AliCaloTrackParticle*>(obj) ;
+      if ( !trackmix )
+      {
+        AliWarning("Wrong track data type, continue");
+        continue;
+      }
+      pt  = trackmix->Pt();
+      eta = trackmix->Eta();
+      phi = trackmix->Phi() ;
+    }
+    
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+    
+    fIdxPt    [fNIndexed] = pt;
+    fIdxEta   [fNIndexed] = eta;
+    fIdxPhi   [fNIndexed] = phi;
+    fIdxType  [fNIndexed] = 0;
+    fIdxSource[fNIndexed] = ipr;
+    fIdxID    [fNIndexed] = id;
+    fIdxHasID [fNIndexed] = hasID;
+    fNIndexed++;
+  }
+  
+  // Clusters, as in MakeIsolationCut
+  fTypeStart[1] = fNIndexed;
+  for(Int_t ipr = 0; ipr < nClusters; ipr++)
+  {
+    TObject * obj = plNe->At(ipr);
+    if ( !obj ) continue ;
+    
+    AliVCluster * calo = dynamic_cast<AliVCluster *>(obj) ;
+    Int_t  id    = 0;
+    Bool_t hasID = kFALSE;
+    if ( calo )
+    {
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+      
+      // Skip matched clusters with tracks in case of neutral+charged analysis
+      if ( fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged &&
+           pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+      
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+      
+      id    = calo->GetID();
+      hasID = kTRUE;
+      pt    = fMomentum.Pt()  ;
+      eta   = fMomentum.Eta() ;
+      phi   = fMomentum.Phi() ;
+    }
+    else
+    {// Mixed event stored in AliCaloTrackParticles
+      AliCaloTrackParticle * calomix = dynamic_cast<AliCaloTrackParticle*>(obj) ;
+      if ( !calomix )
+      {
+        AliWarning("Wrong calo data type, continue");
+        continue;
+      }
+      pt  = calomix->Pt();
+      eta = calomix->Eta();
+      phi = calomix->Phi() ;
+    }
+    
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+    
+    fIdxPt    [fNIndexed] = pt;
+    fIdxEta   [fNIndexed] = eta;
+    fIdxPhi   [fNIndexed] = phi;
+    fIdxType  [fNIndexed] = 1;
+    fIdxSource[fNIndexed] = ipr;
+    fIdxID    [fNIndexed] = id;
+    fIdxHasID [fNIndexed] = hasID;
+    fNIndexed++;
+  }
+  fTypeStart[2] = fNIndexed;
+  
+  // Eta-phi cells, entries ordered by cell with a counting sort
+  const Int_t kMaxCells = 256; // per dimension
+  Float_t cellSize = fConeIndexCellSize > 0 ? fConeIndexCellSize : 0.1;
+  Float_t etaMin = 0, etaMax = 0;
+  for(Int_t e = 0; e < fNIndexed; e++)
+  {
+    if ( e == 0 || fIdxEta[e] < etaMin ) etaMin = fIdxEta[e];
+    if ( e == 0 || fIdxEta[e] > etaMax ) etaMax = fIdxEta[e];
+  }
+  fNEtaCells  = TMath::Min(kMaxCells, Int_t((etaMax-etaMin)/cellSize)+1);
+  fNPhiCells  = TMath::Max(1, TMath::Min(kMaxCells, Int_t(TMath::TwoPi()/cellSize)));
+  fIdxEtaMin  = etaMin;
+  fIdxCellEta = TMath::Max(cellSize, (etaMax-etaMin)/fNEtaCells*1.0001f);
+  fIdxCellPhi = TMath::TwoPi()/fNPhiCells;
+  
+  Int_t nCells = fNEtaCells*fNPhiCells;
+  if ( fCellStart.GetSize() < nCells+1 ) fCellStart.Set(nCells+1);
+  for(Int_t c = 0; c <= nCells; c++) fCellStart[c] = 0;
+  
+  for(Int_t e = 0; e < fNIndexed; e++)
+  {
+    Int_t ieta = TMath::Min(fNEtaCells-1, Int_t((fIdxEta[e]-fIdxEtaMin)/fIdxCellEta));
+    Int_t iphi = TMath::Min(fNPhiCells-1, Int_t(fIdxPhi[e]/fIdxCellPhi));
+    fCellStart[ieta*fNPhiCells+iphi+1]++;
+  }
+  for(Int_t c = 0; c < nCells; c++) fCellStart[c+1] += fCellStart[c];
+  
+  TArrayI fill(nCells);
+  for(Int_t c = 0; c < nCells; c++) fill[c] = fCellStart[c];
+  for(Int_t e = 0; e < fNIndexed; e++)
+  {
+    Int_t ieta = TMath::Min(fNEtaCells-1, Int_t((fIdxEta[e]-fIdxEtaMin)/fIdxCellEta));
+    Int_t iphi = TMath::Min(fNPhiCells-1, Int_t(fIdxPhi[e]/fIdxCellPhi));
+    fCellEntries[fill[ieta*fNPhiCells+iphi]++] = e;
+  }
+  
+  // Per type: eta and phi sorted with cumulated pT for the UE bands, IDs sorted for the candidate daughters
+  Int_t * order = fLocalOrder.GetArray();
+  fIDStart[0] = 0;
+  for(Int_t itype = 0; itype < 2; itype++)
+  {
+    Int_t first = fTypeStart[itype];
+    Int_t m     = fTypeStart[itype+1]-first;
+    
+    if ( m > 0 ) TMath::Sort(m, fIdxEta.GetArray()+first, order, kFALSE);
+    for(Int_t k = 0; k < m; k++)
+    {
+      fStripEta   [first+k] = fIdxEta[first+order[k]];
+      fStripEtaSum[first+k] = (k > 0 ? fStripEtaSum[first+k-1] : 0.) + fIdxPt[first+order[k]];
+    }
+    
+    if ( m > 0 ) TMath::Sort(m, fIdxPhi.GetArray()+first, order, kFALSE);
+    for(Int_t k = 0; k < m; k++)
+    {
+      fStripPhi   [first+k] = fIdxPhi[first+order[k]];
+      fStripPhiSum[first+k] = (k > 0 ? fStripPhiSum[first+k-1] : 0.) + fIdxPt[first+order[k]];
+    }
+    
+    Int_t nID = 0;
+    for(Int_t e = first; e < first+m; e++)
+    {
+      if ( fIdxHasID[e] ) fIDSorted[fIDStart[itype]+nID++] = fIdxID[e];
+    }
+    if ( nID > 0 ) TMath::Sort(nID, fIDSorted.GetArray()+fIDStart[itype], order, kFALSE);
+    Int_t k = 0;
+    for(Int_t e = first; e < first+m; e++)
+    {
+      if ( fIdxHasID[e] ) fLocal[k++] = e; // entries with ID, in the order used for fIDSorted
+    }
+    for(k = 0; k < nID; k++) fIDOrder[fIDStart[itype]+k] = fLocal[order[k]];
+    for(k = 0; k < nID; k++) fIDSorted[fIDStart[itype]+k] = fIdxID[fIDOrder[fIDStart[itype]+k]];
+    fIDStart[itype+1] = fIDStart[itype]+nID;
+  }
+  
+  fIndexCTS        = plCTS;
+  fIndexNe         = plNe;
+  fIndexEvent      = reader->GetEventNumber();
+  fIndexPartInCone = fPartInCone;
+  fIndexTMRejected = fIsTMClusterInConeRejected;
+  
+  AliDebug(1,Form("Cone index with %d tracks and %d clusters in %d x %d cells",
+                  fTypeStart[1], fTypeStart[2]-fTypeStart[1], fNEtaCells, fNPhiCells));
+}
+
+//_________________________________________________________________________________
+/// Forget the cone index, it keeps pointers to the lists of the event.
+//_________________________________________________________________________________
+void AliIsolationCut::ResetConeIndex()
+{
+  fIndexCTS   = 0;
+  fIndexNe    = 0;
+  fIndexEvent = -1;
+  fNIndexed   = 0;
+  fNLocal     = 0;
+}
+
+//_________________________________________________________________________________
+/// \return kTRUE if the cone index was built for these lists in the current event
+/// and with the current selection of particles in cone.
+//_________________________________________________________________________________
+Bool_t AliIsolationCut::IsConeIndexOf(TObjArray * plCTS, TObjArray * plNe, AliCaloTrackReader * reader) const
+{
+  if ( fIndexEvent < 0 || !reader ) return kFALSE;
+  
+  return ( plCTS == fIndexCTS && plNe == fIndexNe &&
+           reader->GetEventNumber()   == fIndexEvent &&
+           fPartInCone                == fIndexPartInCone &&
+           fIsTMClusterInConeRejected == fIndexTMRejected );
+}
+
+//_________________________________________________________________________________
+/// Cone and UE band sums around the candidate for several cone sizes at once,
+/// see coneSums. The particles close to the candidate are taken from the cone
+/// index and swept once in order of distance to the candidate. If the cone index
+/// is not the one of the lists it is built for this call only.
+///
+/// \param plCTS: list of tracks.
+/// \param plNe: list of calorimeter clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matches.
+/// \param pCandidate: particle identified as isolation candidate.
+/// \param nCones: number of cone sizes.
+/// \param coneSizes: cone sizes.
+/// \param sums: output, kNConeSums values per cone, sums[icone*kNConeSums+k].
+//_________________________________________________________________________________
+void AliIsolationCut::MakeSeveralConesSums(TObjArray * plCTS, TObjArray * plNe,
+                                           AliCaloTrackReader * reader, AliCaloPID * pid,
+                                           AliCaloTrackParticleCorrelation * pCandidate,
+                                           Int_t nCones, const Float_t * coneSizes, Float_t * sums)
+{
+  if ( nCones <= 0 ) return;
+  
+  Bool_t ownIndex = !IsConeIndexOf(plCTS, plNe, reader);
+  if ( ownIndex ) BuildConeIndex(plCTS, plNe, reader, pid);
+  
+  ConeSumsFromIndex(pCandidate, nCones, coneSizes, sums);
+  
+  if ( ownIndex ) ResetConeIndex();
+}
+
+//_________________________________________________________________________________
+/// Collect the index entries within radius of the candidate, plus the
+/// candidate daughters, in fLocal. Entries closer than fDistMinToTrigger
+/// and the daughters are flagged as excluded.
+/// \return number of collected entries.
+//_________________________________________________________________________________
+Int_t AliIsolationCut::CollectFromConeIndex(AliCaloTrackParticleCorrelation * pCandidate, Float_t radius)
+{
+  fNLocal = 0;
+  if ( fNIndexed == 0 ) return 0;
+  
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Int_t ieta0 = TMath::Max(0,            Int_t(TMath::Floor((etaC-radius-fIdxEtaMin)/fIdxCellEta)));
+  Int_t ieta1 = TMath::Min(fNEtaCells-1, Int_t(TMath::Floor((etaC+radius-fIdxEtaMin)/fIdxCellEta)));
+  
+  Int_t iphi0 = 0;
+  Int_t nphi  = fNPhiCells;
+  if ( 2*radius < TMath::TwoPi() )
+  {
+    iphi0 = Int_t(TMath::Floor((phiC-radius)/fIdxCellPhi));
+    nphi  = TMath::Min(fNPhiCells, Int_t(TMath::Floor((phiC+radius)/fIdxCellPhi))-iphi0+1);
+  }
+  
+  for(Int_t ieta = ieta0; ieta <= ieta1; ieta++)
+  {
+    for(Int_t k = 0; k < nphi; k++)
+    {
+      Int_t iphi = ((iphi0+k)%fNPhiCells+fNPhiCells)%fNPhiCells;
+      Int_t cell = ieta*fNPhiCells+iphi;
+      for(Int_t i = fCellStart[cell]; i < fCellStart[cell+1]; i++)
+      {
+        Int_t   e   = fCellEntries[i];
+        Float_t rad = Radius(etaC, phiC, fIdxEta[e], fIdxPhi[e]);
+        if ( rad > radius ) continue ;
+        
+        fLocal        [fNLocal] = e;
+        fLocalRad     [fNLocal] = rad;
+        fLocalExcluded[fNLocal] = (rad < fDistMinToTrigger);
+        fNLocal++;
+      }
+    }
+  }
+  
+  // Do not count the candidate or its daughters, tracks only for track candidates
+  for(Int_t itype = 0; itype < 2; itype++)
+  {
+    if ( itype == 0 && pCandidate->GetDetectorTag() != AliFiducialCut::kCTS ) continue ;
+    
+    Int_t nLabels = (itype == 0 ? 4 : 2);
+    const Int_t * ids = fIDSorted.GetArray();
+    for(Int_t il = 0; il < nLabels; il++)
+    {
+      Int_t label = (itype == 0 ? pCandidate->GetTrackLabel(il) : pCandidate->GetCaloLabel(il));
+      
+      const Int_t * first = std::lower_bound(ids+fIDStart[itype], ids+fIDStart[itype+1], label);
+      const Int_t * last  = std::upper_bound(first,               ids+fIDStart[itype+1], label);
+      for(const Int_t * p = first; p < last; p++)
+      {
+        Int_t e = fIDOrder[p-ids];
+        Int_t k = 0;
+        while ( k < fNLocal && fLocal[k] != e ) k++;
+        if ( k == fNLocal )
+        {
+          fLocal   [fNLocal] = e;
+          fLocalRad[fNLocal] = Radius(etaC, phiC, fIdxEta[e], fIdxPhi[e]);
+          fNLocal++;
+        }
+        fLocalExcluded[k] = 1;
+      }
+    }
+  }
+  
+  return fNLocal;
+}
+
+//_________________________________________________________________________________
+/// Cone and UE band sums for several cone sizes from the cone index.
+/// The cone sums follow from one sweep over the collected entries sorted by
+/// distance; the bands are the strips |eta-etaC| < R (phi band) and
+/// |phi-phiC| < R (eta band) of the whole index, from the cumulated pT,
+/// minus the entries inside the cone or excluded.
+//_________________________________________________________________________________
+void AliIsolationCut::ConeSumsFromIndex(AliCaloTrackParticleCorrelation * pCandidate,
+                                        Int_t nCones, const Float_t * coneSizes, Float_t * sums)
+{
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t maxR = 0;
+  for(Int_t icone = 0; icone < nCones; icone++) maxR = TMath::Max(maxR, coneSizes[icone]);
+  
+  Int_t nLocal = CollectFromConeIndex(pCandidate, TMath::Max(maxR, fDistMinToTrigger));
+  if ( nLocal > 0 ) TMath::Sort(nLocal, fLocalRad.GetArray(), fLocalOrder.GetArray(), kFALSE);
+  
+  TArrayI coneOrder(nCones);
+  TMath::Sort(nCones, coneSizes, coneOrder.GetArray(), kFALSE);
+  
+  Double_t coneptsum[2] = { 0., 0. };
+  Float_t  ptLead = 0;
+  Int_t    j = 0;
+  for(Int_t ic = 0; ic < nCones; ic++)
+  {
+    Int_t   icone = coneOrder[ic];
+    Float_t r     = coneSizes[icone];
+    
+    // ** For the isolated particle **, closer than r and at the same side of the candidate
+    for( ; j < nLocal; j++)
+    {
+      Int_t k = fLocalOrder[j];
+      if ( fLocalRad[k] >= r ) break;
+      if ( fLocalExcluded[k] ) continue ;
+      
+      Int_t e = fLocal[k];
+      if ( TMath::Abs(fIdxPhi[e]-phiC) > TMath::PiOver2() ) continue ;
+      
+      coneptsum[fIdxType[e]] += fIdxPt[e];
+      if ( ptLead < fIdxPt[e] ) ptLead = fIdxPt[e];
+    }
+    
+    // ** For the background out of cone **
+    Float_t etaMin = etaC-r, etaMax = etaC+r;
+    Float_t phiMin = phiC-r, phiMax = phiC+r;
+    Double_t phiBand[2], etaBand[2];
+    for(Int_t itype = 0; itype < 2; itype++)
+    {
+      phiBand[itype] = StripSum(fStripEta, fStripEtaSum, fTypeStart[itype], fTypeStart[itype+1], etaMin, etaMax);
+      etaBand[itype] = StripSum(fStripPhi, fStripPhiSum, fTypeStart[itype], fTypeStart[itype+1], phiMin, phiMax);
+    }
+    for(Int_t k = 0; k < nLocal; k++)
+    {
+      if ( !fLocalExcluded[k] && fLocalRad[k] > r ) continue ;
+      
+      Int_t e = fLocal[k];
+      if ( fIdxEta[e] > etaMin && fIdxEta[e] < etaMax ) phiBand[fIdxType[e]] -= fIdxPt[e];
+      if ( fIdxPhi[e] > phiMin && fIdxPhi[e] < phiMax ) etaBand[fIdxType[e]] -= fIdxPt[e];
+    }
+    
+    Float_t * cone = sums + icone*kNConeSums;
+    cone[kConeSumTrack]      = coneptsum[0];
+    cone[kConeSumCluster]    = coneptsum[1];
+    cone[kConePtLead]        = ptLead;
+    cone[kEtaBandSumTrack]   = etaBand[0];
+    cone[kPhiBandSumTrack]   = phiBand[0];
+    cone[kEtaBandSumCluster] = etaBand[1];
+    cone[kPhiBandSumCluster] = phiBand[1];
+  }
+}
+
+//_________________________________________________________________________________
+/// \return sum of pT of the entries first <= i < last with min < x[i] < max,
+/// x sorted and cumPt cumulated from first.
+//_________________________________________________________________________________
+Double_t AliIsolationCut::StripSum(const TArrayF & x, const TArrayD & cumPt, Int_t first, Int_t last,
+                                   Float_t min, Float_t max) const
+{
+  if ( last <= first ) return 0.;
+  
+  const Float_t * a = x.GetArray();
+  Int_t lo = std::upper_bound(a+first, a+last, min)-a;
+  Int_t hi = std::lower_bound(a+first, a+last, max)-a;
+  if ( hi <= lo ) return 0.;
+  
+  return cumPt[hi-1] - (lo > first ? cumPt[lo-1] : 0.);
+}
+
 //_____________________________________________________
 /// Print some relevant parameters set for the analysis.
 //_____________________________________________________
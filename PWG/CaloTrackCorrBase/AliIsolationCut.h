@@ -22,6 +22,9 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
 
 // --- ANALYSIS system ---
 class AliCaloTrackParticleCorrelation ;
@@ -43,6 +46,11 @@ class AliIsolationCut : public TObject {
 
   enum partInCone { kNeutralAndCharged=0, kOnlyNeutral=1, kOnlyCharged=2 } ;
 
+  /// Content of the cone sums, per cone size, see MakeSeveralConesSums().
+  enum coneSums   { kConeSumTrack=0, kConeSumCluster=1, kConePtLead=2,
+                    kEtaBandSumTrack=3, kPhiBandSumTrack=4, kEtaBandSumCluster=5, kPhiBandSumCluster=6,
+                    kNConeSums=7 } ;
+
   // Main Methods
 
   void       InitParameters() ;
@@ -59,6 +67,24 @@ class AliIsolationCut : public TObject {
                               AliCaloTrackParticleCorrelation  * pCandidate, TString aodObjArrayName,
                               Int_t &n, Int_t & nfrac, Float_t &ptSum, Float_t &ptLead, Bool_t & isolated) ;
 
+  void       CheckIsolation(AliCaloTrackParticleCorrelation * pCandidate, AliCaloTrackReader * reader,
+                            const Float_t * sums,
+                            Int_t & n, Int_t & nfrac, Float_t & coneptsum, Bool_t & isolated) ;
+
+  // Eta-phi index of the tracks and clusters of the event, for fast cone searches
+
+  void       BuildConeIndex(TObjArray * plCTS, TObjArray * plNe,
+                            AliCaloTrackReader * reader, AliCaloPID * pid) ;
+
+  void       ResetConeIndex() ;
+
+  Bool_t     IsConeIndexOf(TObjArray * plCTS, TObjArray * plNe, AliCaloTrackReader * reader) const ;
+
+  void       MakeSeveralConesSums(TObjArray * plCTS, TObjArray * plNe,
+                                  AliCaloTrackReader * reader, AliCaloPID * pid,
+                                  AliCaloTrackParticleCorrelation * pCandidate,
+                                  Int_t nCones, const Float_t * coneSizes, Float_t * sums) ;
+
   void       Print(const Option_t * opt) const ;
 
   Float_t    Radius(Float_t etaCandidate, Float_t phiCandidate, Float_t eta, Float_t phi) const ;
@@ -96,6 +122,7 @@ class AliIsolationCut : public TObject {
   Int_t      GetDebug()               const { return fDebug          ; }
   Bool_t     GetFracIsThresh()        const { return fFracIsThresh   ; }
   Float_t    GetMinDistToTrigger()    const { return fDistMinToTrigger ; }
+  Float_t    GetConeIndexCellSize()   const { return fConeIndexCellSize ; }
 
   void       SetConeSize(Float_t r)                            { fConeSize          = r    ; }
   void       SetPtThreshold(Float_t pt)                        { fPtThreshold       = pt   ; }
@@ -109,9 +136,18 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+  void       SetConeIndexCellSize(Float_t size)                { fConeIndexCellSize = size ; }
     
  private:
 
+  Int_t      CollectFromConeIndex(AliCaloTrackParticleCorrelation * pCandidate, Float_t radius) ;
+
+  void       ConeSumsFromIndex(AliCaloTrackParticleCorrelation * pCandidate,
+                               Int_t nCones, const Float_t * coneSizes, Float_t * sums) ;
+
+  Double_t   StripSum(const TArrayF & x, const TArrayD & cumPt, Int_t first, Int_t last,
+                      Float_t min, Float_t max) const ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -140,6 +176,76 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  Float_t    fConeIndexCellSize; ///<  Size in eta and phi of the cells of the cone index.
+
+  // Cone index, rebuilt every event. Entries of type 0 are tracks, of type 1 clusters.
+
+  TObjArray * fIndexCTS;         //!<! Track list of the cone index.
+
+  TObjArray * fIndexNe;          //!<! Cluster list of the cone index.
+
+  Int_t      fIndexEvent;        //!<! Event number of the cone index, -1 if not built.
+
+  Int_t      fIndexPartInCone;   //!<! fPartInCone when the cone index was built.
+
+  Bool_t     fIndexTMRejected;   //!<! fIsTMClusterInConeRejected when the cone index was built.
+
+  Int_t      fNIndexed;          //!<! Number of entries in the cone index.
+
+  TArrayF    fIdxPt;             //!<! Entry pT.
+
+  TArrayF    fIdxEta;            //!<! Entry eta.
+
+  TArrayF    fIdxPhi;            //!<! Entry phi, in [0,2pi].
+
+  TArrayI    fIdxType;           //!<! Entry type, 0 track, 1 cluster.
+
+  TArrayI    fIdxSource;         //!<! Entry index in its track or cluster list.
+
+  TArrayI    fIdxID;             //!<! Track or cluster ID compared with the candidate labels.
+
+  TArrayI    fIdxHasID;          //!<! 1 if the entry is a track or cluster (not a mixed event particle).
+
+  Int_t      fNEtaCells;         //!<! Number of eta cells.
+
+  Int_t      fNPhiCells;         //!<! Number of phi cells.
+
+  Float_t    fIdxEtaMin;         //!<! Lower eta edge of the cells.
+
+  Float_t    fIdxCellEta;        //!<! Eta size of the cells.
+
+  Float_t    fIdxCellPhi;        //!<! Phi size of the cells.
+
+  TArrayI    fCellStart;         //!<! First entry of each cell in fCellEntries, [fNEtaCells*fNPhiCells+1].
+
+  TArrayI    fCellEntries;       //!<! Entries sorted by cell.
+
+  Int_t      fTypeStart[3];      //!<! Range of each type in the strip and ID arrays.
+
+  TArrayF    fStripEta;          //!<! Entry eta, sorted per type.
+
+  TArrayD    fStripEtaSum;       //!<! Cumulated pT in the order of fStripEta.
+
+  TArrayF    fStripPhi;          //!<! Entry phi, sorted per type.
+
+  TArrayD    fStripPhiSum;       //!<! Cumulated pT in the order of fStripPhi.
+
+  TArrayI    fIDOrder;           //!<! Entries sorted by ID, per type.
+
+  TArrayI    fIDSorted;          //!<! IDs in the order of fIDOrder.
+
+  Int_t      fIDStart[3];        //!<! Range of each type in fIDOrder.
+
+  Int_t      fNLocal;            //!<! Number of entries close to the current candidate.
+
+  TArrayI    fLocal;             //!<! Entries close to the current candidate.
+
+  TArrayF    fLocalRad;          //!<! Distance of the fLocal entries to the candidate.
+
+  TArrayI    fLocalExcluded;     //!<! 1 if the fLocal entry is not counted for the candidate.
+
+  TArrayI    fLocalOrder;        //!<! fLocal sorted by distance.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +253,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
@@ -59,7 +59,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fSetter(0),
   fSaveCutsFlag(0),
   fSaveAODZDC(0),
-  fSaveVzero(0)
+  fSaveVzero(0),
+  fTrackLayout(AliNanoAODReplicator::kRowTracks)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -75,7 +76,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fSetter(0),
    fSaveCutsFlag(saveCutsFlag),
    fSaveAODZDC(0),
-   fSaveVzero(0)
+   fSaveVzero(0),
+   fTrackLayout(AliNanoAODReplicator::kRowTracks)
 
 {
   // Constructor
@@ -132,6 +134,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   rep->SetCustomSetter(fSetter);
   if (fSaveVzero) rep->SetVzero(1);
   if (fSaveAODZDC) rep->SetAODZDC(1);
+  rep->SetTrackLayout(fTrackLayout);
     
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
   
@@ -55,6 +55,7 @@ public:
   void  SetVarListHead (TString var                     ) { fVarListHead = var;}
   void  ReplicatorSaveVzero(Bool_t var ) {fSaveVzero=var;}
   void  ReplicatorSaveAODZDC(Bool_t var ) {fSaveAODZDC=var;}
+  void  ReplicatorTrackLayout(Int_t var ) {fTrackLayout=var;} // see AliNanoAODReplicator::ETrackLayout
     
 private:
   Int_t fMCMode; // true if processing monte carlo. if > 1 not all MC particles are filtered
@@ -69,12 +70,13 @@ private:
   Bool_t fSaveCutsFlag; // If true, the event and track cuts are saved to disk. Can only be set in the constructor.
   Bool_t fSaveVzero; // if kTRUE AliAODVZERO will be saved in AliAODEvent
   Bool_t fSaveAODZDC;  // if kTRUE AliAODZDC will be saved in AliAODEvent
+  Int_t fTrackLayout; // tracks written as rows and/or columns (AliNanoAODReplicator::ETrackLayout)
 
   
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
     
-  ClassDef(AliAnalysisTaskNanoAODFilter, 2); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 3); // example of analysis
 };
 
 #endif
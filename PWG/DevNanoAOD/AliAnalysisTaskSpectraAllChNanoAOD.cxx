@@ -182,6 +182,7 @@ void AliAnalysisTaskSpectraAllChNanoAOD::UserExec(Option_t *)
   AliNanoAODHeader * headNano = dynamic_cast<AliNanoAODHeader*>((TObject*)fAOD->GetHeader());
   
   Bool_t isNano = (headNano != 0);
+  if(isNano) AliNanoAODTrack::UpdateMappingCache(); // the track getters read the cached mapping indices
  
   if(!isNano) {
     if(!fEventCuts->IsSelected(fAOD,fTrackCuts))return;//event selection
@@ -49,6 +49,7 @@ class AliAODRecoDecay;
 #include "AliPIDResponse.h"
 #include <iostream>
 #include <cassert>
+#include <vector>
 #include "AliESDtrack.h"
 #include "TObjArray.h"
 #include "AliAnalysisFilter.h"
@@ -75,6 +76,7 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODTrackColumn.h"
 
 using std::cout;
 using std::endl;
@@ -99,7 +101,11 @@ AliAODBranchReplicator(),
   fAodZDC(0x0),
   fNumberOfHeaderParam(0),
   fSaveAODZDC(0),
-  fSaveVzero(0){
+  fSaveVzero(0),
+  fTrackLayout(kRowTracks),
+  fTrackColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -126,11 +132,16 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fAodZDC(0x0),
   fNumberOfHeaderParam(0),
   fSaveAODZDC(0),
-  fSaveVzero(0)
+  fSaveVzero(0),
+  fTrackLayout(kRowTracks),
+  fTrackColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0)
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
   fNTracksVariables = tm->GetSize();  
+  AliNanoAODTrack::UpdateMappingCache(kTRUE);
   //  tm->Print();
     
   for (Int_t i=0; i < fVarListHeader.Length(); i++){
@@ -145,7 +156,9 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
 {
   // dtor
   delete fTrackCut;
+  if (fList && !fList->FindObject(fTracks)) delete fTracks; // not written, see GetList
   delete fList;
+  delete fTrackColumns;
 }
 
 //_____________________________________________________________________________
@@ -413,6 +426,34 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
 }
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillTrackColumns()
+{
+  // Transpose the tracks of the event into the columns: each variable
+  // of the mapping is written contiguously for all tracks
+
+  const Int_t ntracks = fTracks->GetEntriesFast();
+  const Int_t nvars = fTrackColumns->GetEntriesFast();
+
+  std::vector<Float_t*> columns(nvars);
+  for (Int_t index = 0; index < nvars; index++) {
+    AliNanoAODTrackColumn * column = static_cast<AliNanoAODTrackColumn*>(fTrackColumns->UncheckedAt(index));
+    column->Resize(ntracks);
+    columns[index] = column->GetFloatData();
+  }
+  fLabelColumn->Resize(ntracks);
+  fChargeColumn->Resize(ntracks);
+  Int_t * labels = fLabelColumn->GetIntData();
+  Int_t * charges = fChargeColumn->GetIntData();
+
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+    for (Int_t index = 0; index < nvars; index++) columns[index][itrack] = track->GetVar(index);
+    labels[itrack] = track->GetLabel();
+    charges[itrack] = track->Charge();
+  }
+}
+
 // //_____________________________________________________________________________
 TList* AliNanoAODReplicator::GetList() const
 {
@@ -423,9 +464,25 @@ TList* AliNanoAODReplicator::GetList() const
       fList = new TList;
       fList->SetOwner(kTRUE);
 
+      // The track objects are also needed for the columns (custom
+      // setter, MC label remapping), they are just not written
       fTracks = new TClonesArray("AliNanoAODTrack");      
       fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);    
+      if (fTrackLayout & kRowTracks) fList->Add(fTracks);    
+
+      if (fTrackLayout & kColumnTracks) {
+        AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+        fTrackColumns = new TObjArray(mapping->GetSize());
+        for (Int_t index = 0; index < mapping->GetSize(); index++) {
+          AliNanoAODTrackColumn * column = new AliNanoAODTrackColumn(AliNanoAODTrackColumn::BranchName(mapping->GetVarName(index)));
+          fTrackColumns->AddAt(column, index);
+          fList->Add(column);
+        }
+        fLabelColumn = new AliNanoAODTrackColumn(AliNanoAODTrackColumn::LabelBranchName(), AliNanoAODTrackColumn::kIntColumn);
+        fChargeColumn = new AliNanoAODTrackColumn(AliNanoAODTrackColumn::ChargeBranchName(), AliNanoAODTrackColumn::kIntColumn);
+        fList->Add(fLabelColumn);
+        fList->Add(fChargeColumn);
+      }
 
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -498,7 +555,10 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   }
 
   const Int_t entries = source.GetNumberOfTracks();
-  if(entries<=0) return;
+  if(entries<=0) {
+    if ( fTrackColumns ) FillTrackColumns(); // no tracks, but not the columns of the previous event either
+    return;
+  }
 
   for(Int_t j=0; j<entries; j++){
     
@@ -552,6 +612,11 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   if ( fMCMode > 0 ) {
     FilterMC(source);      
   }
+
+  // Columns last, after the MC labels were remapped
+  if ( fTrackColumns ) {
+    FillTrackColumns();
+  }
   
 
 }
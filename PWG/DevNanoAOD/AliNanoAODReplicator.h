@@ -57,12 +57,18 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class TObjArray;
+class AliNanoAODTrackColumn;
 
 class TH1F;
 
 class AliNanoAODReplicator : public AliAODBranchReplicator
 {
  public:
+
+  // How the tracks are written: one AliNanoAODTrack object per track
+  // (rows), one AliNanoAODTrackColumn per variable (columns), or both
+  enum ETrackLayout { kRowTracks = BIT(0), kColumnTracks = BIT(1) };
   
   AliNanoAODReplicator();
   AliNanoAODReplicator(const char* name,
@@ -98,6 +104,9 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   
   void SetNumberOfHaederParam(Int_t var){fNumberOfHeaderParam=var;}
 
+  void  SetTrackLayout(Int_t layout) { fTrackLayout = layout; } // combination of ETrackLayout, before GetList is called
+  Int_t GetTrackLayout() const { return fTrackLayout; }
+
 
  private:
 
@@ -106,6 +115,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  void FillTrackColumns();
  
 
  private:
@@ -138,13 +148,18 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   Int_t fSaveAODZDC;  // if kTRUE AliAODZDC will be saved in AliAODEvent
   Int_t fSaveVzero;  // if kTRUE AliAODVZERO will be saved in AliAODEvent
 
+  Int_t fTrackLayout; // ETrackLayout bits: tracks written as rows and/or columns
+  mutable TObjArray* fTrackColumns; //! column of each variable of the mapping (owned by fList)
+  mutable AliNanoAODTrackColumn* fLabelColumn; //! track labels (owned by fList)
+  mutable AliNanoAODTrackColumn* fChargeColumn; //! track charges (owned by fList)
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,2) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,3) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -33,6 +33,93 @@
 
 ClassImp(AliNanoAODTrack)
 
+Int_t              AliNanoAODTrack::fgMappingIndex[AliNanoAODTrack::kNMappingIndices];
+std::vector<Int_t> AliNanoAODTrack::fgMappingSource;
+const AliNanoAODTrackMapping * AliNanoAODTrack::fgMappingCachedFor = 0;
+
+//______________________________________________________________________________
+void AliNanoAODTrack::CacheMappingIndices()
+{
+  // Resolve the indices of the standard variables in the current
+  // mapping, and for each index of the mapping the standard variable
+  // stored there (-1 for custom variables)
+
+  static const char * kVarNames[kNMappingIndices] = {
+    "pt", "phi", "theta", "chi2perNDF", "posx", "posy", "posz",
+    "posDCAx", "posDCAy", "pDCAx", "pDCAy", "pDCAz", "RAtAbsorberEnd",
+    "TPCncls", "id", "TPCnclsF", "TPCNCrossedRows", "TrackPhiOnEMCal",
+    "TrackEtaOnEMCal", "TrackPtOnEMCal", "ITSsignal", "TPCsignal",
+    "TPCsignalTuned", "TPCsignalN", "TPCmomentum", "TPCTgl", "TOFsignal",
+    "integratedLength", "TOFsignalTuned", "HMPIDsignal", "HMPIDoccupancy",
+    "TRDsignal", "TRDChi2", "TRDnSlices", "IsMuonTrack", "TPCnclsS",
+    "FilterMap", "covmat0"
+  };
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+
+  fgMappingIndex[kIdxPt]               = mapping->GetPt();
+  fgMappingIndex[kIdxPhi]              = mapping->GetPhi();
+  fgMappingIndex[kIdxTheta]            = mapping->GetTheta();
+  fgMappingIndex[kIdxChi2PerNDF]       = mapping->GetChi2PerNDF();
+  fgMappingIndex[kIdxPosX]             = mapping->GetPosX();
+  fgMappingIndex[kIdxPosY]             = mapping->GetPosY();
+  fgMappingIndex[kIdxPosZ]             = mapping->GetPosZ();
+  fgMappingIndex[kIdxPosDCAx]          = mapping->GetPosDCAx();
+  fgMappingIndex[kIdxPosDCAy]          = mapping->GetPosDCAy();
+  fgMappingIndex[kIdxPDCAx]            = mapping->GetPDCAX();
+  fgMappingIndex[kIdxPDCAy]            = mapping->GetPDCAY();
+  fgMappingIndex[kIdxPDCAz]            = mapping->GetPDCAZ();
+  fgMappingIndex[kIdxRAtAbsorberEnd]   = mapping->GetRAtAbsorberEnd();
+  fgMappingIndex[kIdxTPCncls]          = mapping->GetTPCncls();
+  fgMappingIndex[kIdxID]               = mapping->Getid();
+  fgMappingIndex[kIdxTPCnclsF]         = mapping->GetTPCnclsF();
+  fgMappingIndex[kIdxTPCNCrossedRows]  = mapping->GetTPCNCrossedRows();
+  fgMappingIndex[kIdxTrackPhiOnEMCal]  = mapping->GetTrackPhiOnEMCal();
+  fgMappingIndex[kIdxTrackEtaOnEMCal]  = mapping->GetTrackEtaOnEMCal();
+  fgMappingIndex[kIdxTrackPtOnEMCal]   = mapping->GetTrackPtOnEMCal();
+  fgMappingIndex[kIdxITSsignal]        = mapping->GetITSsignal();
+  fgMappingIndex[kIdxTPCsignal]        = mapping->GetTPCsignal();
+  fgMappingIndex[kIdxTPCsignalTuned]   = mapping->GetTPCsignalTuned();
+  fgMappingIndex[kIdxTPCsignalN]       = mapping->GetTPCsignalN();
+  fgMappingIndex[kIdxTPCmomentum]      = mapping->GetTPCmomentum();
+  fgMappingIndex[kIdxTPCTgl]           = mapping->GetTPCTgl();
+  fgMappingIndex[kIdxTOFsignal]        = mapping->GetTOFsignal();
+  fgMappingIndex[kIdxIntegratedLength] = mapping->GetintegratedLenght();
+  fgMappingIndex[kIdxTOFsignalTuned]   = mapping->GetTOFsignalTuned();
+  fgMappingIndex[kIdxHMPIDsignal]      = mapping->GetHMPIDsignal();
+  fgMappingIndex[kIdxHMPIDoccupancy]   = mapping->GetHMPIDoccupancy();
+  fgMappingIndex[kIdxTRDsignal]        = mapping->GetTRDsignal();
+  fgMappingIndex[kIdxTRDChi2]          = mapping->GetTRDChi2();
+  fgMappingIndex[kIdxTRDnSlices]       = mapping->GetTRDnSlices();
+  fgMappingIndex[kIdxIsMuonTrack]      = mapping->GetIsMuonTrack();
+  fgMappingIndex[kIdxTPCnclsS]         = mapping->GetTPCnclsS();
+  fgMappingIndex[kIdxFilterMap]        = mapping->GetFilterMap();
+  fgMappingIndex[kIdxCovMat0]          = mapping->GetCovMat(0);
+
+  fgMappingSource.assign(mapping->GetSize(), -1);
+  for (Int_t index = 0; index<mapping->GetSize(); index++) {
+    TString varString = mapping->GetVarName(index);
+    for (Int_t ivar = 0; ivar<kNMappingIndices; ivar++) {
+      if (varString == kVarNames[ivar]) {
+        fgMappingSource[index] = ivar;
+        break;
+      }
+    }
+  }
+
+  fgMappingCachedFor = mapping;
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODTrack::UpdateMappingCache(Bool_t force)
+{
+  // Resolve the cached indices again if the current mapping is not the
+  // one they were resolved for. Returns kTRUE if they were.
+  if (!force && fgMappingCachedFor == AliNanoAODTrackMapping::GetInstance()) return kFALSE;
+  CacheMappingIndices();
+  return kTRUE;
+}
+
 
 //______________________________________________________________________________
 AliNanoAODTrack::AliNanoAODTrack() : 
@@ -72,58 +159,61 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
   AliNanoAODTrackMapping::GetInstance(vars);
 
   // Create internal structure
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-
-  for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
-    TString varString = AliNanoAODTrackMapping::GetInstance()->GetVarName(index);
-
-    if     (varString == "pt"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()               , aodTrack->Pt()                      );
-    else if(varString == "phi"                    ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()              , aodTrack->Phi()                     );
-    else if(varString == "theta"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()            , aodTrack->Theta()                   );
-    else if(varString == "chi2perNDF"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()       , aodTrack->Chi2perNDF()              );  
-    else if(varString == "posx" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()             , position[0]                         );
-    else if(varString == "posy" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()             , position[1]                         );
-    else if(varString == "posz" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()             , position[2]                         );
-    else if(varString == "posDCAx"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()          , aodTrack->XAtDCA()                  );
-    else if(varString == "posDCAy"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()          , aodTrack->YAtDCA()                  );
-    else if(varString == "pDCAx"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()            , aodTrack->PxAtDCA()                 );
-    else if(varString == "pDCAy"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()            , aodTrack->PyAtDCA()                 );
-    else if(varString == "pDCAz"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()            , aodTrack->PzAtDCA()                 );
-    else if(varString == "RAtAbsorberEnd"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()   , aodTrack->GetRAtAbsorberEnd()       );
-    else if(varString == "TPCncls"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()          , aodTrack->GetTPCNcls()              );
-    else if(varString == "id"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->Getid()               , aodTrack->GetID()                   );
-    else if(varString == "TPCnclsF"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()         , aodTrack->GetTPCNclsF()             );
-    else if(varString == "TPCNCrossedRows"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()  , aodTrack->GetTPCNCrossedRows()      );
-    else if(varString == "TrackPhiOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()  , aodTrack->GetTrackPhiOnEMCal()      );
-    else if(varString == "TrackEtaOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()  , aodTrack->GetTrackEtaOnEMCal()      );
-    else if(varString == "TrackPtOnEMCal"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()   , aodTrack->GetTrackPtOnEMCal()       );
-    else if(varString == "ITSsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()        , aodTrack->GetITSsignal()            );
-    else if(varString == "TPCsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()        , aodTrack->GetTPCsignal()            );
-    else if(varString == "TPCsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()   , aodTrack->GetTPCsignalTunedOnData() );
-    else if(varString == "TPCsignalN"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()       , aodTrack->GetTPCsignalN()           );
-    else if(varString == "TPCmomentum"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()      , aodTrack->GetTPCmomentum()          );
-    else if(varString == "TPCTgl"                 ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()           , aodTrack->GetTPCTgl()               );
-    else if(varString == "TOFsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()        , aodTrack->GetTOFsignal()            );
-    else if(varString == "integratedLength"       ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetintegratedLenght() , aodTrack->GetIntegratedLength()     );
-    else if(varString == "TOFsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()   , aodTrack->GetTOFsignalTunedOnData() );
-    else if(varString == "HMPIDsignal"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()      , aodTrack->GetHMPIDsignal()          );
-    else if(varString == "HMPIDoccupancy"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()   , aodTrack->GetHMPIDoccupancy()       );
-    else if(varString == "TRDsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()        , aodTrack->GetTRDsignal()            );
-    else if(varString == "TRDChi2"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()          , aodTrack->GetTRDchi2()              );
-    else if(varString == "TRDnSlices"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()       , aodTrack->GetNumberOfTRDslices()    );  
-    else if(varString == "IsMuonTrack"             ) {
-        if (aodTrack->IsMuonTrack()) SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 1.);
-        else SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 0.);
-    }
-    else if(varString == "TPCnclsS"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS()         , aodTrack->GetTPCnclsS()             );
-    else if(varString == "FilterMap"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()        , aodTrack->GetFilterMap()            );
-    else if(varString == "covmat0"                 ) {
+  const Int_t size = AliNanoAODTrackMapping::GetInstance()->GetSize();
+  AllocateInternalStorage(size);
+
+  // The variable behind each index of the mapping is resolved once in
+  // CacheMappingIndices, no string comparisons per track
+  UpdateMappingCache();
+  for (Int_t index = 0; index<size; index++) {
+    switch (fgMappingSource[index]) {
+    case kIdxPt                 : SetVar(index, aodTrack->Pt()                      ); break;
+    case kIdxPhi                : SetVar(index, aodTrack->Phi()                     ); break;
+    case kIdxTheta              : SetVar(index, aodTrack->Theta()                   ); break;
+    case kIdxChi2PerNDF         : SetVar(index, aodTrack->Chi2perNDF()              ); break;
+    case kIdxPosX               : if (isPosAvailable) SetVar(index, position[0]     ); break;
+    case kIdxPosY               : if (isPosAvailable) SetVar(index, position[1]     ); break;
+    case kIdxPosZ               : if (isPosAvailable) SetVar(index, position[2]     ); break;
+    case kIdxPosDCAx            : SetVar(index, aodTrack->XAtDCA()                  ); break;
+    case kIdxPosDCAy            : SetVar(index, aodTrack->YAtDCA()                  ); break;
+    case kIdxPDCAx              : SetVar(index, aodTrack->PxAtDCA()                 ); break;
+    case kIdxPDCAy              : SetVar(index, aodTrack->PyAtDCA()                 ); break;
+    case kIdxPDCAz              : SetVar(index, aodTrack->PzAtDCA()                 ); break;
+    case kIdxRAtAbsorberEnd     : SetVar(index, aodTrack->GetRAtAbsorberEnd()       ); break;
+    case kIdxTPCncls            : SetVar(index, aodTrack->GetTPCNcls()              ); break;
+    case kIdxID                 : SetVar(index, aodTrack->GetID()                   ); break;
+    case kIdxTPCnclsF           : SetVar(index, aodTrack->GetTPCNclsF()             ); break;
+    case kIdxTPCNCrossedRows    : SetVar(index, aodTrack->GetTPCNCrossedRows()      ); break;
+    case kIdxTrackPhiOnEMCal    : SetVar(index, aodTrack->GetTrackPhiOnEMCal()      ); break;
+    case kIdxTrackEtaOnEMCal    : SetVar(index, aodTrack->GetTrackEtaOnEMCal()      ); break;
+    case kIdxTrackPtOnEMCal     : SetVar(index, aodTrack->GetTrackPtOnEMCal()       ); break;
+    case kIdxITSsignal          : SetVar(index, aodTrack->GetITSsignal()            ); break;
+    case kIdxTPCsignal          : SetVar(index, aodTrack->GetTPCsignal()            ); break;
+    case kIdxTPCsignalTuned     : SetVar(index, aodTrack->GetTPCsignalTunedOnData() ); break;
+    case kIdxTPCsignalN         : SetVar(index, aodTrack->GetTPCsignalN()           ); break;
+    case kIdxTPCmomentum        : SetVar(index, aodTrack->GetTPCmomentum()          ); break;
+    case kIdxTPCTgl             : SetVar(index, aodTrack->GetTPCTgl()               ); break;
+    case kIdxTOFsignal          : SetVar(index, aodTrack->GetTOFsignal()            ); break;
+    case kIdxIntegratedLength   : SetVar(index, aodTrack->GetIntegratedLength()     ); break;
+    case kIdxTOFsignalTuned     : SetVar(index, aodTrack->GetTOFsignalTunedOnData() ); break;
+    case kIdxHMPIDsignal        : SetVar(index, aodTrack->GetHMPIDsignal()          ); break;
+    case kIdxHMPIDoccupancy     : SetVar(index, aodTrack->GetHMPIDoccupancy()       ); break;
+    case kIdxTRDsignal          : SetVar(index, aodTrack->GetTRDsignal()            ); break;
+    case kIdxTRDChi2            : SetVar(index, aodTrack->GetTRDchi2()              ); break;
+    case kIdxTRDnSlices         : SetVar(index, aodTrack->GetNumberOfTRDslices()    ); break;
+    case kIdxIsMuonTrack        : SetVar(index, aodTrack->IsMuonTrack() ? 1. : 0.   ); break;
+    case kIdxTPCnclsS           : SetVar(index, aodTrack->GetTPCnclsS()             ); break;
+    case kIdxFilterMap          : SetVar(index, aodTrack->GetFilterMap()            ); break;
+    case kIdxCovMat0            : {
         Double_t covMatrix[21];
-        Bool_t covmatrix = aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
+        aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
         for(Int_t i=0;i<21;i++){
             SetVar(AliNanoAODTrackMapping::GetInstance()->GetCovMat(i)       , covMatrix[i]                        );
         }
         index+=20;
+        break;
+    }
+    default                     : break; // custom variables are set by AliNanoAODCustomSetter
     }
   }
 
@@ -165,7 +255,7 @@ AliNanoAODTrack::AliNanoAODTrack(const char * vars) :
 
   // Create internal structure
   AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-
+  UpdateMappingCache(); // for the setters
 
 }
 
@@ -202,8 +292,9 @@ AliNanoAODTrack::AliNanoAODTrack(const AliNanoAODTrack& trk) :
   // Copy constructor
   // std::cout << "Copy Ctor" << std::endl;
   
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
-  for (Int_t isize = 0; isize<AliNanoAODTrackMapping::GetInstance()->GetSize(); isize++) {
+  const Int_t size = AliNanoAODTrackMapping::GetInstance()->GetSize();
+  AllocateInternalStorage(size);
+  for (Int_t isize = 0; isize<size; isize++) {
     SetVar(isize, trk.GetVar(isize));    
   }
 
@@ -345,18 +436,18 @@ template <typename T> void AliNanoAODTrack::SetP(const T *p, const Bool_t cartes
       Double_t pt2 = p[0]*p[0] + p[1]*p[1];
       Double_t pp  = TMath::Sqrt(pt2 + p[2]*p[2]);
         
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt() ,TMath::Sqrt(pt2)); // pt
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi() , (pt2 != 0.) ? TMath::Pi()+TMath::ATan2(-p[1], -p[0]) : -999); // phi
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta() , (pp != 0.) ? TMath::ACos(p[2] / pp) : -999.); // theta
+      SetVar(MappingIndex(kIdxPt) ,TMath::Sqrt(pt2)); // pt
+      SetVar(MappingIndex(kIdxPhi) , (pt2 != 0.) ? TMath::Pi()+TMath::ATan2(-p[1], -p[0]) : -999); // phi
+      SetVar(MappingIndex(kIdxTheta) , (pp != 0.) ? TMath::ACos(p[2] / pp) : -999.); // theta
     } else {
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()      , p[0]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()     , p[1]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()   , p[2]);  
+      SetVar(MappingIndex(kIdxPt)      , p[0]);  
+      SetVar(MappingIndex(kIdxPhi)     , p[1]);  
+      SetVar(MappingIndex(kIdxTheta)   , p[2]);  
     }
   } else {
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()      , p[0]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()     , p[1]);  
-      SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()   , p[2]);  
+      SetVar(MappingIndex(kIdxPt)      , p[0]);  
+      SetVar(MappingIndex(kIdxPhi)     , p[1]);  
+      SetVar(MappingIndex(kIdxTheta)   , p[2]);  
   }
 }
 
@@ -398,9 +489,9 @@ void AliNanoAODTrack::SetDCA(Double_t d, Double_t z)
   // where the same variable is used to store DCA or position,
   // according to the value of the bit kIsDCA. We can probably get rid
   // of this in the special track.
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX(), d);
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY(), z);
-  SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ(), 0);
+  SetVar(MappingIndex(kIdxPosX), d);
+  SetVar(MappingIndex(kIdxPosY), z);
+  SetVar(MappingIndex(kIdxPosZ), 0);
   SetBit(AliAODTrack::kIsDCA);
 }
 
@@ -432,7 +523,7 @@ Bool_t AliNanoAODTrack::PropagateToDCA(const AliVVertex *vtx,
   // return kFALSE is something went wrong
 
   // allowed only for tracks inside the beam pipe
-  Float_t xstart2 = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())+GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+  Float_t xstart2 = GetVar(MappingIndex(kIdxPosX))*GetVar(MappingIndex(kIdxPosX))+GetVar(MappingIndex(kIdxPosY))*GetVar(MappingIndex(kIdxPosY));
 
   if(xstart2 > 3.*3.) { // outside beampipe radius
     AliError("This method can be used only for propagation inside the beam pipe");
@@ -483,12 +574,12 @@ Bool_t AliNanoAODTrack::GetXYZAt(Double_t x, Double_t b, Double_t *r) const
   //maybe some of this code can be moved to AliVTrack to avoid code duplication
   const double kSafe = 1e-5;
   Double_t alpha=0.0;
-  Double_t radPos2 = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX())+GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY())*GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+  Double_t radPos2 = GetVar(MappingIndex(kIdxPosX))*GetVar(MappingIndex(kIdxPosX))+GetVar(MappingIndex(kIdxPosY))*GetVar(MappingIndex(kIdxPosY));
   Double_t radMax  = 45.; // approximately ITS outer radius
   if (radPos2 < radMax*radMax) { // inside the ITS     
     alpha = TMath::ATan2(Py(),Px());
   } else { // outside the ITS
-    Float_t phiPos = TMath::Pi()+TMath::ATan2(-GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()), -GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()));
+    Float_t phiPos = TMath::Pi()+TMath::ATan2(-GetVar(MappingIndex(kIdxPosY)), -GetVar(MappingIndex(kIdxPosX)));
      alpha = 
      TMath::DegToRad()*(20*((((Int_t)(phiPos*TMath::RadToDeg()))/20))+10);
   }
@@ -507,7 +598,7 @@ Bool_t AliNanoAODTrack::GetXYZAt(Double_t x, Double_t b, Double_t *r) const
   }
   
   // Get the vertex of origin and the momentum
-  TVector3 ver(GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()), GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()), GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()));
+  TVector3 ver(GetVar(MappingIndex(kIdxPosX)), GetVar(MappingIndex(kIdxPosY)), GetVar(MappingIndex(kIdxPosZ)));
   TVector3 mom(Px(),Py(),Pz());
   //
   // avoid momenta along axis
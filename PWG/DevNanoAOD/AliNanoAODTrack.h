@@ -71,6 +71,20 @@ class AliNanoAODTrack : public AliVTrack, public AliNanoAODStorage {
 public:
   
   using TObject::ClassName;
+
+  // Standard variables whose index in AliNanoAODTrackMapping is cached,
+  // so that the accessors do not go through the mapping for every call
+  enum EMappingIndex {
+    kIdxPt, kIdxPhi, kIdxTheta, kIdxChi2PerNDF, kIdxPosX, kIdxPosY, kIdxPosZ,
+    kIdxPosDCAx, kIdxPosDCAy, kIdxPDCAx, kIdxPDCAy, kIdxPDCAz, kIdxRAtAbsorberEnd,
+    kIdxTPCncls, kIdxID, kIdxTPCnclsF, kIdxTPCNCrossedRows, kIdxTrackPhiOnEMCal,
+    kIdxTrackEtaOnEMCal, kIdxTrackPtOnEMCal, kIdxITSsignal, kIdxTPCsignal,
+    kIdxTPCsignalTuned, kIdxTPCsignalN, kIdxTPCmomentum, kIdxTPCTgl, kIdxTOFsignal,
+    kIdxIntegratedLength, kIdxTOFsignalTuned, kIdxHMPIDsignal, kIdxHMPIDoccupancy,
+    kIdxTRDsignal, kIdxTRDChi2, kIdxTRDnSlices, kIdxIsMuonTrack, kIdxTPCnclsS,
+    kIdxFilterMap, kIdxCovMat0,
+    kNMappingIndices
+  };
   
   AliNanoAODTrack();
   AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars);
@@ -86,13 +100,13 @@ public:
   
   // kinematics
   virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
-  virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
-  virtual Double_t Theta()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
+  virtual Double_t Phi()       const { return GetVar(MappingIndex(kIdxPhi));   }
+  virtual Double_t Theta()     const { return GetVar(MappingIndex(kIdxTheta)); }
   
   virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
   virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
   virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
-  virtual Double_t Pt() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()); }
+  virtual Double_t Pt() const { return GetVar(MappingIndex(kIdxPt)); }
   virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
   virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
 
@@ -101,8 +115,8 @@ public:
   virtual Double_t Zv() const { return GetProdVertex() ? GetProdVertex()->GetZ() : -999.; }
   virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0] = Xv(); x[1] = Yv(); x[2] = Zv(); return kTRUE; }
 
-  Double_t Chi2perNDF()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()); }  
-  UShort_t GetTPCNcls()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()); } // FIXME: should this be short?
+  Double_t Chi2perNDF()  const { return GetVar(MappingIndex(kIdxChi2PerNDF)); }  
+  UShort_t GetTPCNcls()  const { return GetVar(MappingIndex(kIdxTPCncls)); } // FIXME: should this be short?
 
   virtual Double_t M() const { AliFatal("Not Implemented"); return -1; }
   Double_t M(AliAODTrack::AODTrkPID_t pid) const;
@@ -151,7 +165,7 @@ public:
 
   
   template <typename T> Bool_t GetPosition(T *x) const {
-    x[0]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()); x[1]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()); x[2]=GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ());
+    x[0]=GetVar(MappingIndex(kIdxPosX)); x[1]=GetVar(MappingIndex(kIdxPosY)); x[2]=GetVar(MappingIndex(kIdxPosZ));
     return TestBit(AliAODTrack::kIsDCA);}
 
   // FIXME: only allocate if listed?
@@ -175,32 +189,32 @@ public:
   // void RemoveCovMatrix() {delete fCovMatrix; fCovMatrix=NULL;}
 
   Bool_t IsMuonTrack() const {
-  if (GetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack())==1) return kTRUE ; 
+  if (GetVar(MappingIndex(kIdxIsMuonTrack))==1) return kTRUE ; 
   else return kFALSE;
   } 
 
-  Double_t XAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()); }
-  Double_t YAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()); }
+  Double_t XAtDCA() const { return GetVar(MappingIndex(kIdxPosDCAx)); }
+  Double_t YAtDCA() const { return GetVar(MappingIndex(kIdxPosDCAy)); }
   Double_t ZAtDCA() const { 
-    if (IsMuonTrack())  return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ());
-    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+    if (IsMuonTrack())  return GetVar(MappingIndex(kIdxPosZ));
+    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(MappingIndex(kIdxPosY));
      else return -999.; }
 
   Bool_t   XYZAtDCA(Double_t x[3]) const { x[0] = XAtDCA(); x[1] = YAtDCA(); x[2] = ZAtDCA(); return kTRUE; }
   
   Double_t DCA() const { 
     if (IsMuonTrack()) return TMath::Sqrt(XAtDCA()*XAtDCA() + YAtDCA()*YAtDCA());
-    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()); // FIXME: Why does this return posX?
+    else if (TestBit(AliAODTrack::kIsDCA)) return GetVar(MappingIndex(kIdxPosX)); // FIXME: Why does this return posX?
     else return -999.; }
 
   
-  Double_t PxAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()); }
-  Double_t PyAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()); }
-  Double_t PzAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()); }
+  Double_t PxAtDCA() const { return GetVar(MappingIndex(kIdxPDCAx)); }
+  Double_t PyAtDCA() const { return GetVar(MappingIndex(kIdxPDCAy)); }
+  Double_t PzAtDCA() const { return GetVar(MappingIndex(kIdxPDCAz)); }
   Double_t PAtDCA() const { return TMath::Sqrt(PxAtDCA()*PxAtDCA() + PyAtDCA()*PyAtDCA() + PzAtDCA()*PzAtDCA()); }
   Bool_t   PxPyPzAtDCA(Double_t p[3]) const { p[0] = PxAtDCA(); p[1] = PyAtDCA(); p[2] = PzAtDCA(); return kTRUE; }
   
-  Double_t GetRAtAbsorberEnd() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()); }
+  Double_t GetRAtAbsorberEnd() const { return GetVar(MappingIndex(kIdxRAtAbsorberEnd)); }
   
   // For this whole block of cluster maps I could simply define a cluster map in the int array. For the moment comment all maps. Maybe not neede 
   UChar_t  GetITSClusterMap() const       { AliFatal("Not Implemented"); return 0;};
@@ -210,7 +224,7 @@ public:
   // UInt_t   GetMUONClusterMap() const      { return (fITSMuonClusterMap&0x3ff0000)>>16; } // 
   // UInt_t   GetITSMUONClusterMap() const   { return fITSMuonClusterMap; }
   
-   Bool_t  TestFilterBit(UInt_t filterBit) const {return (Bool_t) ((filterBit & UInt_t(GetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()))) != 0);}
+   Bool_t  TestFilterBit(UInt_t filterBit) const {return (Bool_t) ((filterBit & UInt_t(GetVar(MappingIndex(kIdxFilterMap)))) != 0);}
   // Bool_t  TestFilterMask(UInt_t filterMask) const {return (Bool_t) ((filterMask & fFilterMap) == filterMask);}
   // void    SetFilterMap(UInt_t i){fFilterMap = i;}
   // UInt_t  GetFilterMap() const {return fFilterMap;}
@@ -228,12 +242,12 @@ public:
   // void    SetTPCSharedMap(const TBits amap) {fTPCSharedMap = amap;}
   // void    SetTPCFitMap(const TBits amap) {fTPCFitMap = amap;}
   // 
-  void    SetTPCPointsF(UShort_t  findable){fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()] = findable;}
-  void    SetTPCNCrossedRows(UInt_t n)     {fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()] = n;}
+  void    SetTPCPointsF(UShort_t  findable){fVars[MappingIndex(kIdxTPCnclsF)] = findable;}
+  void    SetTPCNCrossedRows(UInt_t n)     {fVars[MappingIndex(kIdxTPCNCrossedRows)] = n;}
 
-  UShort_t GetTPCNclsF() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF());}
-  UShort_t GetTPCnclsS() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS());}
-  UShort_t GetTPCNCrossedRows()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows());}
+  UShort_t GetTPCNclsF() const { return GetVar(MappingIndex(kIdxTPCnclsF));}
+  UShort_t GetTPCnclsS() const { return GetVar(MappingIndex(kIdxTPCnclsS));}
+  UShort_t GetTPCNCrossedRows()  const { return GetVar(MappingIndex(kIdxTPCNCrossedRows));}
   Float_t  GetTPCFoundFraction() const { return GetTPCNCrossedRows()>0 ? float(GetTPCNcls())/GetTPCNCrossedRows() : 0;}
 
   // Calorimeter Cluster
@@ -242,11 +256,11 @@ public:
   // void SetEMCALcluster(Int_t index) {fCaloIndex=index;}
   // Bool_t IsEMCAL() const {return fFlags&kEMCALmatch;}
 
-  Double_t GetTrackPhiOnEMCal() const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal());}
-  Double_t GetTrackEtaOnEMCal() const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal());}
-  Double_t GetTrackPtOnEMCal() const  {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal());}
+  Double_t GetTrackPhiOnEMCal() const {return GetVar(MappingIndex(kIdxTrackPhiOnEMCal));}
+  Double_t GetTrackEtaOnEMCal() const {return GetVar(MappingIndex(kIdxTrackEtaOnEMCal));}
+  Double_t GetTrackPtOnEMCal() const  {return GetVar(MappingIndex(kIdxTrackPtOnEMCal));}
   Double_t GetTrackPOnEMCal() const {return TMath::Abs(GetTrackEtaOnEMCal()) < 1 ? GetTrackPtOnEMCal()*TMath::CosH(GetTrackEtaOnEMCal()) : -999;}
-  void SetTrackPhiEtaPtOnEMCal(Double_t phi,Double_t eta,Double_t pt) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()]=phi;fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()]=eta;fVars[AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()]=pt;}
+  void SetTrackPhiEtaPtOnEMCal(Double_t phi,Double_t eta,Double_t pt) {fVars[MappingIndex(kIdxTrackPhiOnEMCal)]=phi;fVars[MappingIndex(kIdxTrackEtaOnEMCal)]=eta;fVars[MappingIndex(kIdxTrackPtOnEMCal)]=pt;}
 
   //  Int_t GetPHOScluster() const {return fCaloIndex;} // TODO: int array
   //  void SetPHOScluster(Int_t index) {fCaloIndex=index;}
@@ -254,21 +268,21 @@ public:
 
   //pid signal interface
   //TODO you can remove the PID object
-  Double_t  GetITSsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal());}
-  Double_t  GetTPCsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal());}
-  Double_t  GetTPCsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned());}
-  void      SetTPCsignalTunedOnData(Double_t signal) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()] = signal;}
-  UShort_t  GetTPCsignalN()      const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN());}// FIXME: what is this?
+  Double_t  GetITSsignal()       const { return GetVar(MappingIndex(kIdxITSsignal));}
+  Double_t  GetTPCsignal()       const { return GetVar(MappingIndex(kIdxTPCsignal));}
+  Double_t  GetTPCsignalTunedOnData() const { return GetVar(MappingIndex(kIdxTPCsignalTuned));}
+  void      SetTPCsignalTunedOnData(Double_t signal) {fVars[MappingIndex(kIdxTPCsignalTuned)] = signal;}
+  UShort_t  GetTPCsignalN()      const { return GetVar(MappingIndex(kIdxTPCsignalN));}// FIXME: what is this?
   //  virtual AliTPCdEdxInfo* GetTPCdEdxInfo() const {return fDetPid?fDetPid->GetTPCdEdxInfo():0;} // FIXME: is this needed?
-  Double_t  GetTPCmomentum()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()); }
-  Double_t  GetTPCTgl()          const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl());      } // FIXME: what is this?
-  Double_t  GetTOFsignal()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal());   } 
+  Double_t  GetTPCmomentum()     const { return GetVar(MappingIndex(kIdxTPCmomentum)); }
+  Double_t  GetTPCTgl()          const { return GetVar(MappingIndex(kIdxTPCTgl));      } // FIXME: what is this?
+  Double_t  GetTOFsignal()       const { return GetVar(MappingIndex(kIdxTOFsignal));   } 
   Double_t  GetIntegratedLength() const { AliFatal("Not implemented"); return 0;} // TODO: implement track lenght
   void      SetIntegratedLength(Double_t/* l*/) {AliFatal("Not implemented");}
-  Double_t  GetTOFsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned());}
-  void      SetTOFsignalTunedOnData(Double_t signal) {fVars[AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()] = signal;}
-  Double_t  GetHMPIDsignal()      const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal());}; 
-  Double_t  GetHMPIDoccupancy()  const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy());}; 
+  Double_t  GetTOFsignalTunedOnData() const { return GetVar(MappingIndex(kIdxTOFsignalTuned));}
+  void      SetTOFsignalTunedOnData(Double_t signal) {fVars[MappingIndex(kIdxTOFsignalTuned)] = signal;}
+  Double_t  GetHMPIDsignal()      const {return GetVar(MappingIndex(kIdxHMPIDsignal));}; 
+  Double_t  GetHMPIDoccupancy()  const {return GetVar(MappingIndex(kIdxHMPIDoccupancy));}; 
   
       
   
@@ -288,10 +302,10 @@ public:
   Double_t  GetTRDmomentum(Int_t /*plane*/, Double_t */*sp*/=0x0) const {AliFatal("Not Implemented"); return 0;};
   // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
-  Double_t  GetTRDsignal()         const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal());}
-  Double_t  GetTRDchi2()           const {return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2());}
+  Double_t  GetTRDsignal()         const {return GetVar(MappingIndex(kIdxTRDsignal));}
+  Double_t  GetTRDchi2()           const {return GetVar(MappingIndex(kIdxTRDChi2));}
   UChar_t   GetTRDncls()           const {return GetTRDncls(-1);}
-  Int_t     GetNumberOfTRDslices() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()); }
+  Int_t     GetNumberOfTRDslices() const { return GetVar(MappingIndex(kIdxTRDnSlices)); }
 
   const AliAODEvent* GetAODEvent() const {return fAODEvent;}// FIXME: change to special event type
   void SetAODEvent(const AliAODEvent* ptr){fAODEvent = ptr;}
@@ -324,20 +338,20 @@ public:
 
 
 
-  void SetOneOverPt(Double_t oneOverPt) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPt()] = 1. / oneOverPt; }
-  void SetPt(Double_t pt) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPt()] = pt; };
-  void SetPhi(Double_t phi) { fVars[AliNanoAODTrackMapping::GetInstance()->GetPhi()] = phi; }
-  void SetTheta(Double_t theta) { fVars[AliNanoAODTrackMapping::GetInstance()->GetTheta()] = theta; }
+  void SetOneOverPt(Double_t oneOverPt) { fVars[MappingIndex(kIdxPt)] = 1. / oneOverPt; }
+  void SetPt(Double_t pt) { fVars[MappingIndex(kIdxPt)] = pt; };
+  void SetPhi(Double_t phi) { fVars[MappingIndex(kIdxPhi)] = phi; }
+  void SetTheta(Double_t theta) { fVars[MappingIndex(kIdxTheta)] = theta; }
   template <typename T> void SetP(const T *p, Bool_t cartesian = kTRUE);// TODO: WHAT IS THIS FOR?
   void SetP() {AliFatal("Not Implemented");}
 
-  void SetXYAtDCA(Double_t x, Double_t y) {fVars[AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()] = x;  fVars[AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()]= y;}
-  void SetPxPyPzAtDCA(Double_t pX, Double_t pY, Double_t pZ) {fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAX()] = pX; fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAY()] = pY; fVars[AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()] = pZ;}
+  void SetXYAtDCA(Double_t x, Double_t y) {fVars[MappingIndex(kIdxPosDCAx)] = x;  fVars[MappingIndex(kIdxPosDCAy)]= y;}
+  void SetPxPyPzAtDCA(Double_t pX, Double_t pY, Double_t pZ) {fVars[MappingIndex(kIdxPDCAx)] = pX; fVars[MappingIndex(kIdxPDCAy)] = pY; fVars[MappingIndex(kIdxPDCAz)] = pZ;}
   
-void SetRAtAbsorberEnd(Double_t r) { fVars[AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()] = r; }
+void SetRAtAbsorberEnd(Double_t r) { fVars[MappingIndex(kIdxRAtAbsorberEnd)] = r; }
   
   void SetCharge(Short_t q) { fCharge = q; }
-void SetChi2perNDF(Double_t chi2perNDF) { fVars[AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()] = chi2perNDF; }
+void SetChi2perNDF(Double_t chi2perNDF) { fVars[MappingIndex(kIdxChi2PerNDF)] = chi2perNDF; }
 
   // void SetITSClusterMap(UChar_t itsClusMap)                 { fITSMuonClusterMap = (fITSMuonClusterMap&0xffffff00)|(((UInt_t)itsClusMap)&0xff); }
   // void SetHitsPatternInTrigCh(UShort_t hitsPatternInTrigCh) { fITSMuonClusterMap = (fITSMuonClusterMap&0xffff00ff)|((((UInt_t)hitsPatternInTrigCh)&0xff)<<8); }
@@ -369,10 +383,25 @@ void SetChi2perNDF(Double_t chi2perNDF) { fVars[AliNanoAODTrackMapping::GetInsta
   virtual Int_t    GetNcls(Int_t /*idet*/) const {AliFatal("Not Implemented"); return 0;}; 
   virtual const Double_t *PID() const {AliFatal("Not Implemented"); return 0;}; 
 
+  // Index of a standard variable in the mapping (as returned by the
+  // AliNanoAODTrackMapping getters), read from a table filled by
+  // UpdateMappingCache(). Whoever creates or loads a mapping calls that
+  // once per event or file: the constructors from AOD tracks, the
+  // replicator, AliNanoAODTrackColumnReader::Load and the tasks reading
+  // nanoAOD tracks. It re-resolves the table only if the mapping instance
+  // changed (or if forced, e.g. for a mapping changed in place).
+  static Int_t  MappingIndex(EMappingIndex var) { return fgMappingIndex[var]; }
+  static Bool_t UpdateMappingCache(Bool_t force = kFALSE);
+
 
 
 private :
 
+  static void CacheMappingIndices();
+
+  static Int_t              fgMappingIndex[kNMappingIndices]; // index of the standard variables in the mapping
+  static std::vector<Int_t> fgMappingSource;                  // standard variable at each index of the mapping, -1 if custom
+  static const AliNanoAODTrackMapping * fgMappingCachedFor;   // mapping the two tables above were filled from, 0 if none
 
 
   // Momentum & position
@@ -417,22 +446,22 @@ void AliNanoAODTrack::SetPosition(const T *x, const Bool_t dca)
     if (!dca) {
       ResetBit(AliAODTrack::kIsDCA);
 
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = x[0];
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = x[1];
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = x[2];
+      fVars[MappingIndex(kIdxPosX)] = x[0];
+      fVars[MappingIndex(kIdxPosY)] = x[1];
+      fVars[MappingIndex(kIdxPosZ)] = x[2];
     } else {
       SetBit(AliAODTrack::kIsDCA);
       // don't know any better yet
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = -999.;
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = -999.;
-      fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = -999.;
+      fVars[MappingIndex(kIdxPosX)] = -999.;
+      fVars[MappingIndex(kIdxPosY)] = -999.;
+      fVars[MappingIndex(kIdxPosZ)] = -999.;
     }
   } else {
     ResetBit(AliAODTrack::kIsDCA);
 
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosX()] = -999.;
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosY()] = -999.;
-    fVars[AliNanoAODTrackMapping::GetInstance()->GetPosZ()] = -999.;
+    fVars[MappingIndex(kIdxPosX)] = -999.;
+    fVars[MappingIndex(kIdxPosY)] = -999.;
+    fVars[MappingIndex(kIdxPosZ)] = -999.;
   }
 }
 
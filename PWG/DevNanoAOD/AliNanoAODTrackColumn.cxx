@@ -0,0 +1,59 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Column of the columnar NanoAOD track layout
+//-------------------------------------------------------------------------
+
+#include "AliNanoAODTrackColumn.h"
+
+ClassImp(AliNanoAODTrackColumn)
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn() :
+  TNamed(),
+  fType(kFloatColumn),
+  fFloats(),
+  fInts()
+{
+  // default constructor, used when reading
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn(const char * name, EColumnType type) :
+  TNamed(name, name),
+  fType(type),
+  fFloats(),
+  fInts()
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::Clear(Option_t * /*opt*/)
+{
+  // drop the tracks of the event, keeping the allocated memory
+  fFloats.clear();
+  fInts.clear();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::Resize(Int_t ntracks)
+{
+  // make room for the given number of tracks
+  if (fType == kIntColumn) fInts.resize(ntracks);
+  else                     fFloats.resize(ntracks);
+}
@@ -0,0 +1,84 @@
+#ifndef AliNanoAODTrackColumn_H
+#define AliNanoAODTrackColumn_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Column of the columnar NanoAOD track layout
+//     One variable of all the tracks of an event, stored contiguously.
+//     AliNanoAODReplicator writes one column per variable of the
+//     track mapping, plus the label and the charge of the tracks, each
+//     as its own branch "tracks_<variable>" of the nanoAOD tree, so a
+//     reader only needs to read the branches it uses.
+//     Variables are stored as floats (the precision of the Double32_t
+//     row storage on file), labels and charges as integers.
+//     See AliNanoAODTrackColumnReader for the analysis side.
+//-------------------------------------------------------------------------
+
+#include "TNamed.h"
+#include "TString.h"
+
+#include <vector>
+
+//______________________________________________________________________________
+template <typename T> class AliNanoAODColumnSpan {
+  // Read-only view of a column: pointer to the first track and number of tracks
+public:
+  AliNanoAODColumnSpan(const T * data = 0, Int_t size = 0) : fData(data), fSize(size) {;}
+
+  const T * Data()  const { return fData; }
+  Int_t     Size()  const { return fSize; }
+  Bool_t    IsValid() const { return fData != 0 || fSize == 0; }
+  const T & operator[](Int_t i) const { return fData[i]; }
+  const T * begin() const { return fData; }
+  const T * end()   const { return fData + fSize; }
+
+private:
+  const T * fData; // first entry
+  Int_t     fSize; // number of entries
+};
+
+//______________________________________________________________________________
+class AliNanoAODTrackColumn : public TNamed {
+
+public:
+
+  enum EColumnType { kFloatColumn, kIntColumn };
+
+  typedef AliNanoAODColumnSpan<Float_t> FloatSpan_t;
+  typedef AliNanoAODColumnSpan<Int_t>   IntSpan_t;
+
+  AliNanoAODTrackColumn();
+  AliNanoAODTrackColumn(const char * name, EColumnType type = kFloatColumn);
+  virtual ~AliNanoAODTrackColumn() {;}
+
+  virtual void Clear(Option_t * opt = "");
+
+  EColumnType GetType() const { return EColumnType(fType); }
+  Int_t  GetSize() const { return fType == kIntColumn ? Int_t(fInts.size()) : Int_t(fFloats.size()); }
+  void   Resize(Int_t ntracks);
+
+  // writing
+  Float_t * GetFloatData() { return fFloats.empty() ? 0 : &fFloats[0]; }
+  Int_t *   GetIntData()   { return fInts.empty()   ? 0 : &fInts[0];   }
+
+  // reading
+  FloatSpan_t Floats() const { return FloatSpan_t(fFloats.empty() ? 0 : &fFloats[0], fFloats.size()); }
+  IntSpan_t   Ints()   const { return IntSpan_t(fInts.empty() ? 0 : &fInts[0], fInts.size()); }
+
+  // name of the column (and branch) holding the given track variable
+  static TString BranchName(const char * var) { return TString::Format("tracks_%s", var); }
+  static const char * LabelBranchName()  { return "tracks_label"; }
+  static const char * ChargeBranchName() { return "tracks_charge"; }
+
+private:
+
+  Int_t                fType;   // EColumnType
+  std::vector<Float_t> fFloats; // values of a float column, one per track
+  std::vector<Int_t>   fInts;   // values of an integer column, one per track
+
+  ClassDef(AliNanoAODTrackColumn, 1); // one variable of the tracks of a nanoAOD event
+};
+
+#endif
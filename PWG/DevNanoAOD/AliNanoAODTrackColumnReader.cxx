@@ -0,0 +1,147 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Column access to the tracks of a nanoAOD event
+//-------------------------------------------------------------------------
+
+#include "TClonesArray.h"
+#include "AliLog.h"
+#include "AliAODEvent.h"
+#include "AliNanoAODTrackMapping.h"
+
+#include "AliNanoAODTrackColumnReader.h"
+
+ClassImp(AliNanoAODTrackColumnReader)
+
+//______________________________________________________________________________
+AliNanoAODTrackColumnReader::AliNanoAODTrackColumnReader() :
+  TObject(),
+  fEvent(0),
+  fMapping(0),
+  fTracks(0),
+  fColumns(),
+  fColumnar(kFALSE),
+  fNTracks(0),
+  fNLoaded(0),
+  fGathered(),
+  fGatheredStamp()
+{
+  // constructor
+  for (Int_t i = 0; i < kNIntColumns; i++) {
+    fIntColumns[i] = 0;
+    fGatheredIntsStamp[i] = -1;
+  }
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODTrackColumnReader::GetColumnIndex(const char * var)
+{
+  // index of a (standard or custom) variable in the mapping
+  return AliNanoAODTrackMapping::GetInstance()->GetVarIndex(var);
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODTrackColumnReader::Load(const AliAODEvent * event)
+{
+  // Set up the columns of a new event. The spans returned for the
+  // previous event are invalid afterwards.
+  fNLoaded++;
+  fNTracks = 0;
+  if (!event) return kFALSE;
+  // a new file may come with a different mapping
+  AliNanoAODTrack::UpdateMappingCache();
+  if (event != fEvent || AliNanoAODTrackMapping::GetInstance() != fMapping) ConnectEvent(event);
+
+  if (fColumnar)   fNTracks = fIntColumns[kLabels]->GetSize();
+  else if (fTracks) fNTracks = fTracks->GetEntriesFast();
+  else return kFALSE;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumnReader::ConnectEvent(const AliAODEvent * event)
+{
+  // look up the columns (or the row tracks) in the event; the objects
+  // stay the same from one event to the next
+  fEvent = event;
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  fMapping = mapping;
+  const Int_t nvars = mapping->GetSize();
+
+  fColumns.assign(nvars, (AliNanoAODTrackColumn*)0);
+  for (Int_t index = 0; index < nvars; index++) {
+    TString name = AliNanoAODTrackColumn::BranchName(mapping->GetVarName(index));
+    fColumns[index] = dynamic_cast<AliNanoAODTrackColumn*>(event->FindListObject(name));
+  }
+  fIntColumns[kLabels]  = dynamic_cast<AliNanoAODTrackColumn*>(event->FindListObject(AliNanoAODTrackColumn::LabelBranchName()));
+  fIntColumns[kCharges] = dynamic_cast<AliNanoAODTrackColumn*>(event->FindListObject(AliNanoAODTrackColumn::ChargeBranchName()));
+  fColumnar = fIntColumns[kLabels] != 0;
+  fTracks = dynamic_cast<TClonesArray*>(event->FindListObject("tracks"));
+
+  fGathered.assign(nvars, std::vector<Float_t>());
+  fGatheredStamp.assign(nvars, -1);
+  for (Int_t i = 0; i < kNIntColumns; i++) fGatheredIntsStamp[i] = -1;
+
+  AliInfo(Form("%s track layout, %d variables", fColumnar ? "column" : "row", nvars));
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::FloatSpan_t AliNanoAODTrackColumnReader::Column(Int_t index)
+{
+  // column of the variable at the given index of the mapping
+  if (index < 0 || index >= Int_t(fColumns.size())) {
+    AliFatal(Form("Variable index %d not in the track mapping (or Load not called)", index));
+    return AliNanoAODTrackColumn::FloatSpan_t();
+  }
+  if (fColumns[index]) return fColumns[index]->Floats();
+  if (!fTracks) {
+    AliError(Form("No column for variable %s and no row tracks in the event", AliNanoAODTrackMapping::GetInstance()->GetVarName(index)));
+    return AliNanoAODTrackColumn::FloatSpan_t();
+  }
+
+  // row layout: gather the variable once per event
+  std::vector<Float_t> & column = fGathered[index];
+  if (fGatheredStamp[index] != fNLoaded) {
+    column.resize(fNTracks);
+    for (Int_t itrack = 0; itrack < fNTracks; itrack++)
+      column[itrack] = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetVar(index);
+    fGatheredStamp[index] = fNLoaded;
+  }
+  return AliNanoAODTrackColumn::FloatSpan_t(column.empty() ? 0 : &column[0], fNTracks);
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::IntSpan_t AliNanoAODTrackColumnReader::IntColumn(Int_t which)
+{
+  // labels or charges of the tracks
+  if (fIntColumns[which]) return fIntColumns[which]->Ints();
+  if (!fTracks) {
+    AliError(Form("No %s column and no row tracks in the event", which == kLabels ? "label" : "charge"));
+    return AliNanoAODTrackColumn::IntSpan_t();
+  }
+
+  std::vector<Int_t> & column = fGatheredInts[which];
+  if (fGatheredIntsStamp[which] != fNLoaded) {
+    column.resize(fNTracks);
+    for (Int_t itrack = 0; itrack < fNTracks; itrack++) {
+      AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+      column[itrack] = which == kLabels ? track->GetLabel() : track->Charge();
+    }
+    fGatheredIntsStamp[which] = fNLoaded;
+  }
+  return AliNanoAODTrackColumn::IntSpan_t(column.empty() ? 0 : &column[0], fNTracks);
+}
@@ -0,0 +1,82 @@
+#ifndef AliNanoAODTrackColumnReader_H
+#define AliNanoAODTrackColumnReader_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Column access to the tracks of a nanoAOD event
+//     Gives the tracks of an event as contiguous arrays, one per
+//     variable, so analysis loops can run over plain arrays:
+//
+//       static const Int_t kNSigma = AliNanoAODTrackColumnReader::GetColumnIndex("cstNSigmaTPCPi");
+//       reader.Load(aodEvent);
+//       AliNanoAODTrackColumn::FloatSpan_t pt = reader.StandardColumn(AliNanoAODTrack::kIdxPt);
+//       AliNanoAODTrackColumn::FloatSpan_t ns = reader.Column(kNSigma);
+//       for (Int_t i = 0; i < reader.GetNTracks(); i++) { ... pt[i] ... ns[i] ... }
+//
+//     If the event was written in the columnar layout (see
+//     AliNanoAODTrackColumn) the spans point directly to the branches
+//     of the tree. Otherwise the requested columns are gathered once
+//     per event from the AliNanoAODTrack objects of the "tracks" array.
+//     The column objects are looked up only when the event object or
+//     the track mapping changes, not for every event.
+//-------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumn.h"
+
+#include <vector>
+
+class AliAODEvent;
+class TClonesArray;
+
+class AliNanoAODTrackColumnReader : public TObject {
+
+public:
+
+  AliNanoAODTrackColumnReader();
+  virtual ~AliNanoAODTrackColumnReader() {;}
+
+  Bool_t Load(const AliAODEvent * event); // call once per event, kFALSE if there are no nanoAOD tracks
+  Int_t  GetNTracks() const { return fNTracks; }
+  Bool_t IsColumnar() const { return fColumnar; }
+
+  // columns by index in AliNanoAODTrackMapping, by name or for a standard variable
+  AliNanoAODTrackColumn::FloatSpan_t Column(Int_t index);
+  AliNanoAODTrackColumn::FloatSpan_t Column(const char * var) { return Column(GetColumnIndex(var)); }
+  AliNanoAODTrackColumn::FloatSpan_t StandardColumn(AliNanoAODTrack::EMappingIndex var) { return Column(AliNanoAODTrack::MappingIndex(var)); }
+  AliNanoAODTrackColumn::IntSpan_t   Labels()  { return IntColumn(kLabels); }
+  AliNanoAODTrackColumn::IntSpan_t   Charges() { return IntColumn(kCharges); }
+
+  // index of a variable in the mapping; a name lookup, to be cached by the caller
+  static Int_t GetColumnIndex(const char * var);
+
+private:
+
+  enum { kLabels, kCharges, kNIntColumns };
+
+  AliNanoAODTrackColumnReader(const AliNanoAODTrackColumnReader&);
+  AliNanoAODTrackColumnReader& operator=(const AliNanoAODTrackColumnReader&);
+
+  void ConnectEvent(const AliAODEvent * event);
+  AliNanoAODTrackColumn::IntSpan_t IntColumn(Int_t which);
+
+  const AliAODEvent *                 fEvent;          //! event the columns were looked up in
+  const AliNanoAODTrackMapping *      fMapping;        //! mapping the columns were looked up for
+  TClonesArray *                      fTracks;         //! row tracks of the event, if any
+  std::vector<AliNanoAODTrackColumn*> fColumns;        //! stored column of each mapping index, 0 if not stored
+  AliNanoAODTrackColumn *             fIntColumns[kNIntColumns]; //! stored label and charge columns
+  Bool_t                              fColumnar;       //! event has the columnar layout
+  Int_t                               fNTracks;        //! number of tracks of the current event
+  Long64_t                            fNLoaded;        //! number of Load calls, stamps the gathered columns
+  std::vector<std::vector<Float_t> >  fGathered;       //! columns gathered from the row tracks
+  std::vector<Long64_t>               fGatheredStamp;  //! value of fNLoaded when each column was gathered
+  std::vector<Int_t>                  fGatheredInts[kNIntColumns];      //! labels and charges gathered from the row tracks
+  Long64_t                            fGatheredIntsStamp[kNIntColumns]; //! value of fNLoaded when they were gathered
+
+  ClassDef(AliNanoAODTrackColumnReader, 1); // column access to nanoAOD tracks
+};
+
+#endif
@@ -43,6 +43,7 @@
 
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorEngine.h"
 #include "AliFlowAnalysisWithMixedHarmonics.h"
 
 class TH1;
@@ -86,6 +87,7 @@ fWeightsList(NULL),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
+fUseSharedQvectors(kTRUE),
 fUseParticleWeights(NULL),
 fPhiWeights(NULL),
 fPtWeights(NULL),
@@ -231,15 +233,40 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
- // Start loop over data:
- for(Int_t i=0;i<nPrim;i++) 
+ // Without weights Q_{n,k} and S_{p,k} are taken from the Q-vector engine shared by all flow methods:
+ Bool_t bSharedQvectors = fUseSharedQvectors && !fUsePhiWeights && !fUsePtWeights && !fUseEtaWeights;
+ if(bSharedQvectors)
+ {
+  AliFlowQVectorEngine *qve = anEvent->GetQVectorEngine();
+  qve->Require(6*fHarmonic,3);
+  qve->Fill(anEvent);
+  for(Int_t m=0;m<6;m++) 
+  {
+   for(Int_t k=0;k<4;k++)
+   {
+    (*fReQnk)(m,k) = qve->ReQ((m+1)*fHarmonic,k); 
+    (*fImQnk)(m,k) = qve->ImQ((m+1)*fHarmonic,k); 
+   } 
+  }
+  for(Int_t p=0;p<4;p++)
+  {
+   for(Int_t k=0;k<4;k++)
+   {     
+    (*fSpk)(p,k) = qve->SumOfWeights(k);
+   }
+  }
+ } // end of if(bSharedQvectors)
+
+ // Start loop over data (only needed for POIs when Q-vectors are shared):
+ Int_t nLoop = (bSharedQvectors && !fEvaluateDifferential3pCorrelator) ? 0 : nPrim;
+ for(Int_t i=0;i<nLoop;i++) 
  { 
   aftsTrack=anEvent->GetTrack(i);
   if(aftsTrack)
   {
    if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue; // consider only tracks which are either RPs or POIs
    Int_t n = fHarmonic; 
-   if(aftsTrack->InRPSelection()) // checking RP condition:
+   if(aftsTrack->InRPSelection() && !bSharedQvectors) // checking RP condition:
    {    
     dPhi = aftsTrack->Phi();
     dPt  = aftsTrack->Pt();
@@ -398,7 +425,7 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
      cout<<" WARNING (MH): No particle! (i.e. aftsTrack is a NULL pointer in Make().)"<<endl;
      cout<<endl;       
     }
- } // end of for(Int_t i=0;i<nPrim;i++) 
+ } // end of for(Int_t i=0;i<nLoop;i++) 
 
  // Calculate the final expressions for S_{p,k}:
  for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
@@ -134,6 +134,8 @@ class AliFlowAnalysisWithMixedHarmonics
   Bool_t GetUsePtWeights() const {return this->fUsePtWeights;};
   void SetUseEtaWeights(Bool_t const uEtaW) {this->fUseEtaWeights = uEtaW;};
   Bool_t GetUseEtaWeights() const {return this->fUseEtaWeights;};
+  void SetUseSharedQvectors(Bool_t const usqv) {this->fUseSharedQvectors = usqv;};
+  Bool_t GetUseSharedQvectors() const {return this->fUseSharedQvectors;};
   void SetUseParticleWeights(TProfile* const uPW) {this->fUseParticleWeights = uPW;};
   TProfile* GetUseParticleWeights() const {return this->fUseParticleWeights;};
   void SetPhiWeights(TH1F* const histPhiWeights) {this->fPhiWeights = histPhiWeights;};
@@ -265,6 +267,7 @@ class AliFlowAnalysisWithMixedHarmonics
   Bool_t fUsePhiWeights; // use phi weights
   Bool_t fUsePtWeights; // use pt weights
   Bool_t fUseEtaWeights; // use eta weights
+  Bool_t fUseSharedQvectors; // take Q_{n,k} and S_{p,k} from the Q-vector engine shared by all flow methods (only without weights)
   TProfile *fUseParticleWeights; // profile with three bins to hold values of fUsePhiWeights, fUsePtWeights and fUseEtaWeights
   TH1F *fPhiWeights; // histogram holding phi weights
   TH1D *fPtWeights; // histogram holding phi weights
@@ -24,6 +24,8 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliFlowQVectorEngine.h"
+#include "AliFlowGenericCorrelator.h"
 
 using std::endl;
 using std::cout;
@@ -64,6 +66,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fUseSharedQvectors(kTRUE),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -80,6 +83,8 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseCorrelatorCache(kTRUE),
+ fGenericCorrelator(NULL),
  // 4.) Event-by-event cumulants:
  fEbECumulantsList(NULL),
  fEbECumulantsFlagsPro(NULL),
@@ -154,6 +159,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
   this->InitializeArraysForSymmetryPlanes();
   this->InitializeArraysForNestedLoops(); 
   this->InitializeArraysForEtaGaps(); 
+  fGenericCorrelator = new AliFlowGenericCorrelator();
 
   // c) Determine seed for gRandom:
   delete gRandom;
@@ -169,6 +175,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fGenericCorrelator;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -305,6 +312,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::Make(AliFlowEventSimple *anEv
  
  // e) Fill Q-vector components:
  if(fCalculateQvector||fCalculateDiffQvectors){this->FillQvector(anEvent);}
+ if(fCalculateQvector && fUseCorrelatorCache){this->LoadGenericCorrelator(fGenericCorrelator);}
 
  // f) Calculate multi-particle correlations from Q-vector components:
  if(fCalculateCorrelations){this->CalculateCorrelations(anEvent);}
@@ -972,6 +980,14 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(c
   } // if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
  } // for(UInt_t t=0;t<=TString(string).Length();t++)
 
+ if(fUseCorrelatorCache && fGenericCorrelator && fGenericCorrelator->IsLoaded() && whichCorr>=1 && whichCorr<=8)
+ {
+  // Numerator and denominator of all requested correlations are evaluated with shared sub-terms:
+  Int_t zero[8] = {0,0,0,0,0,0,0,0};
+  TComplex c = fGenericCorrelator->Correlator(whichCorr,numerator ? n : zero);
+  return (!numerator || bRealPart) ? c.Re() : c.Im();
+ }
+
  switch(whichCorr)
  {
   case 1:
@@ -1327,6 +1343,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CrossCheckWithNestedLoops(Ali
 
  this->ResetQvector();
  this->FillQvector(anEvent);
+ if(fUseCorrelatorCache){this->LoadGenericCorrelator(fGenericCorrelator);}
 
  if(TMath::Abs(One(0).Re())>0.)
  {
@@ -2000,6 +2017,26 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
  Int_t nCounterRPs = 0;
+
+ // Without RP weights, random RP selection and skipped intervals the Q-vector does not depend
+ // on the settings of this class, so it is taken from the Q-vector engine shared by all flow methods:
+ Bool_t bSharedQvectors = fUseSharedQvectors && fCalculateQvector && !fSelectRandomlyRPs && !fSkipSomeIntervals
+                          && !fUseWeights[0][0] && !fUseWeights[0][1] && !fUseWeights[0][2];
+ if(bSharedQvectors)
+ {
+  AliFlowQVectorEngine *qve = anEvent->GetQVectorEngine();
+  qve->Require(fMaxHarmonic*fMaxCorrelator,fMaxCorrelator);
+  qve->Fill(anEvent);
+  for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+  {
+   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+   {
+    fQvector[h][wp] = qve->Q(h,wp);
+   } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
+  } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+  if(!fCalculateDiffQvectors){return;} // track loop is only needed for p- and q-vectors
+ } // if(bSharedQvectors)
+
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
   AliFlowTrackSimple *pTrack = NULL;
@@ -2018,7 +2055,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
   if(!(pTrack->InRPSelection() || pTrack->InPOISelection())){printf("\n AAAARGH: pTrack is neither RP nor POI !!!!"); continue;}
 
-  if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  if(pTrack->InRPSelection() && !bSharedQvectors) // fill Q-vector components only with reference particles
   {
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
@@ -3875,11 +3912,30 @@ void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
    }
   } 
  } 
+ if(fGenericCorrelator){fGenericCorrelator->Reset();}
 
 } // void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithMultiparticleCorrelations::LoadGenericCorrelator(AliFlowGenericCorrelator *gc)
+{
+ // Load Q-vector components of the current event into the generic correlator.
+ // Rows of fQvector are as long as declared, whatever fMaxCorrelator is. 
+
+ TString sMethodName = "AliFlowAnalysisWithMultiparticleCorrelations::LoadGenericCorrelator(AliFlowGenericCorrelator *gc)";
+ const Int_t nRows = sizeof(fQvector)/sizeof(fQvector[0]);
+ const Int_t nColumns = sizeof(fQvector[0])/sizeof(fQvector[0][0]);
+ if(fMaxCorrelator >= nColumns || fMaxHarmonic*fMaxCorrelator >= nRows)
+ {
+  Fatal(sMethodName.Data(),"fMaxHarmonic = %d and fMaxCorrelator = %d do not fit in fQvector[%d][%d]",fMaxHarmonic,fMaxCorrelator,nRows,nColumns);
+ }
+ gc->Load(&fQvector[0][0],fMaxHarmonic*fMaxCorrelator+1,fMaxCorrelator+1,nColumns);
+
+} // void AliFlowAnalysisWithMultiparticleCorrelations::LoadGenericCorrelator(AliFlowGenericCorrelator *gc)
+
+//=======================================================================================================================
+
 TComplex AliFlowAnalysisWithMultiparticleCorrelations::Q(Int_t n, Int_t wp)
 {
  // Using the fact that Q{-n,p} = Q{n,p}^*. 
@@ -4129,6 +4185,8 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Seven(Int_t n1, Int_t n2,
 
  Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
 
+ if(fUseCorrelatorCache && fGenericCorrelator && fGenericCorrelator->IsLoaded()){return fGenericCorrelator->Correlator(7,harmonic);}
+
  TComplex seven = Recursion(7,harmonic); 
 
  return seven;
@@ -4143,6 +4201,8 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Eight(Int_t n1, Int_t n2,
 
  Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
 
+ if(fUseCorrelatorCache && fGenericCorrelator && fGenericCorrelator->IsLoaded()){return fGenericCorrelator->Correlator(8,harmonic);}
+
  TComplex eight = Recursion(8,harmonic); 
 
  return eight;
@@ -5061,6 +5121,24 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t*
 
 //=======================================================================================================================
 
+TComplex AliFlowAnalysisWithMultiparticleCorrelations::GenericCorrelator(Int_t n, const Int_t* harmonics, const Int_t* powers)
+{
+ // Generic n-particle correlator (n <= 8) for arbitrary harmonics and weight powers (default 1), not normalized.
+ // Sub-terms are memoized within the event and shared with all other correlations.
+ // With the cache switched off the correlator is evaluated from scratch on every call.
+
+ if(fGenericCorrelator && fGenericCorrelator->IsLoaded()){return fGenericCorrelator->Correlator(n,harmonics,powers);}
+
+ // No memoization: evaluate directly from the current fQvector:
+ AliFlowGenericCorrelator gc;
+ gc.SetUseCache(kFALSE);
+ this->LoadGenericCorrelator(&gc);
+ return gc.Correlator(n,harmonics,powers);
+
+} // TComplex AliFlowAnalysisWithMultiparticleCorrelations::GenericCorrelator(Int_t n, const Int_t* harmonics, const Int_t* powers)
+
+//=======================================================================================================================
+
 TComplex AliFlowAnalysisWithMultiparticleCorrelations::OneDiff(Int_t n1)
 {
  // Generic differential one-particle correlation <exp[i(n1*psi1)]>.
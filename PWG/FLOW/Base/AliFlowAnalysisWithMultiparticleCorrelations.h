@@ -31,6 +31,8 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 
+class AliFlowGenericCorrelator;
+
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
   AliFlowAnalysisWithMultiparticleCorrelations();
@@ -86,6 +88,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
    virtual void CalculateSymmetryPlanes(AliFlowEventSimple *anEvent);
    virtual void CalculateEtaGaps(AliFlowEventSimple *anEvent);
    virtual void ResetQvector();
+   virtual void LoadGenericCorrelator(AliFlowGenericCorrelator *gc);
    virtual void CrossCheckWithNestedLoops(AliFlowEventSimple *anEvent);
    virtual void CrossCheckDiffWithNestedLoops(AliFlowEventSimple *anEvent);
 
@@ -160,6 +163,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t GetCalculateQvector() const {return this->fCalculateQvector;};
   void SetCalculateDiffQvectors(Bool_t cdqv) {this->fCalculateDiffQvectors = cdqv;};
   Bool_t GetCalculateDiffQvectors() const {return this->fCalculateDiffQvectors;};
+  void SetUseSharedQvectors(Bool_t usqv) {this->fUseSharedQvectors = usqv;};
+  Bool_t GetUseSharedQvectors() const {return this->fUseSharedQvectors;};
 
   //  5.3.) Correlations:
   void SetCorrelationsList(TList* const cl) {this->fCorrelationsList = cl;};
@@ -188,6 +193,9 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t GetCalculateOnlyCos() const {return this->fCalculateOnlyCos;};
   void SetCalculateOnlySin(Bool_t cos) {this->fCalculateOnlySin = cos;};
   Bool_t GetCalculateOnlySin() const {return this->fCalculateOnlySin;};
+  void SetUseCorrelatorCache(Bool_t ucc) {this->fUseCorrelatorCache = ucc;};
+  Bool_t GetUseCorrelatorCache() const {return this->fUseCorrelatorCache;};
+  AliFlowGenericCorrelator* GetGenericCorrelator() const {return this->fGenericCorrelator;};
 
   //  5.4.) Event-by-event cumulants:
   void SetEbECumulantsList(TList* const ebecl) {this->fEbECumulantsList = ebecl;};
@@ -315,6 +323,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   virtual Double_t CastStringToCorrelation(const char *string, Bool_t numerator);
   virtual Double_t Covariance(const char *x, const char *y, TProfile2D *profile2D, Bool_t bUnbiasedEstimator = kFALSE);
   virtual TComplex Recursion(Int_t n, Int_t* harmonic, Int_t mult = 1, Int_t skip = 0); // Credits: Kristjan Gulbrandsen (gulbrand@nbi.dk) 
+  virtual TComplex GenericCorrelator(Int_t n, const Int_t* harmonics, const Int_t* powers = NULL); // any n <= 8, memoized within the event
   virtual void CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D);
   static void DumpPointsForDurham(TGraphErrors *ge);
   static void DumpPointsForDurham(TH1D *h);
@@ -383,6 +392,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
   TComplex fQvector[49][9];      // Q-vector components [fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1]  
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
+  Bool_t fUseSharedQvectors;     // take Q-vector components from the Q-vector engine shared by all flow methods (only without RP weights)
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
 
@@ -403,6 +413,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateOnlyForSC;         // calculate only correlations needed for 'standard candles'
   Bool_t fCalculateOnlyCos;           // calculate only 'cos' correlations
   Bool_t fCalculateOnlySin;           // calculate only 'sin' correlations
+  Bool_t fUseCorrelatorCache;         // evaluate correlations with the memoized generic correlator (sub-terms shared between correlations)
+  AliFlowGenericCorrelator *fGenericCorrelator; //! memoized correlators built from fQvector of the current event
 
   // 4.) Event-by-event cumulants:
   TList *fEbECumulantsList;         // list to hold all e-b-e cumulants objects
@@ -476,7 +488,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,8);
 
 };
 
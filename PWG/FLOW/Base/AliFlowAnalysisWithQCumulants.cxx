@@ -42,11 +42,16 @@
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorEngine.h"
+#include "AliFlowBootstrapMoments.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
 
+#include <thread>
+#include <vector>
+
 class TH1;
 class TH2;
 class TGraph;
@@ -67,6 +72,48 @@ class TVector;
 using std::endl;
 using std::cout;
 using std::flush;
+
+namespace {
+
+//================================================================================================================
+
+void BootstrapCumulants(Int_t binFirst, Int_t binLast, Int_t nSubsamples, Bool_t poisson,
+                        const Double_t *correlations, Double_t *cumulants, Double_t *mean, Double_t *error)
+{
+ // QC{2}, QC{4}, QC{6}, QC{8} of the cells (bin, subsample) for bins [binFirst,binLast), from 
+ // <2>, <4>, <6>, <8> at index (bin*nSubsamples+subsample)*4+i, and their mean and error over 
+ // subsamples at index bin*4+i. Touches only its own bins, so blocks of bins can run concurrently.
+
+ for(Int_t mb=binFirst;mb<binLast;mb++)
+ {
+  for(Int_t ss=0;ss<nSubsamples;ss++)
+  {
+   const Double_t *c = correlations+(mb*nSubsamples+ss)*4;
+   Double_t *qc = cumulants+(mb*nSubsamples+ss)*4;
+   Double_t two = c[0], four = c[1], six = c[2], eight = c[3];
+   qc[0] = qc[1] = qc[2] = qc[3] = 0.;
+   if(TMath::Abs(two) > 0.){qc[0] = two;} 
+   if(TMath::Abs(four) > 0.){qc[1] = four-2.*pow(two,2.);} 
+   if(TMath::Abs(six) > 0.){qc[2] = six-9.*two*four+12.*pow(two,3.);} 
+   if(TMath::Abs(eight) > 0.){qc[3] = eight-16.*two*six-18.*pow(four,2.)+144.*pow(two,2.)*four-144.*pow(two,4.);}  
+  } // end of for(Int_t ss=0;ss<nSubsamples;ss++)
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   Double_t sum = 0.;
+   for(Int_t ss=0;ss<nSubsamples;ss++){sum += cumulants[(mb*nSubsamples+ss)*4+co];}
+   Double_t m = nSubsamples>0 ? sum/nSubsamples : 0.;
+   Double_t sumOfSquares = 0.;
+   for(Int_t ss=0;ss<nSubsamples;ss++){sumOfSquares += pow(cumulants[(mb*nSubsamples+ss)*4+co]-m,2.);}
+   Double_t spread = nSubsamples>1 ? TMath::Sqrt(sumOfSquares/(nSubsamples-1)) : 0.;
+   mean[mb*4+co] = m;
+   error[mb*4+co] = (poisson || nSubsamples<1) ? spread : spread/TMath::Sqrt(1.*nSubsamples);
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
+ } // end of for(Int_t mb=binFirst;mb<binLast;mb++)
+
+} // end of void BootstrapCumulants(...)
+
+} // end of namespace
+
 ClassImp(AliFlowAnalysisWithQCumulants)
 
 AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants(): 
@@ -134,6 +181,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseSharedQvectors(kTRUE),
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
@@ -233,8 +281,14 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUseBootstrapVsM(kFALSE),
  fnSubsamples(10),
  fRandom(NULL),
+ fUseBootstrapMoments(kFALSE),
+ fUseBootstrapPoisson(kFALSE),
+ fBootstrapNThreads(1),
  fBootstrapCorrelations(NULL),
- fBootstrapCumulants(NULL)
+ fBootstrapMoments(NULL),
+ fBootstrapMomentsVsM(NULL),
+ fBootstrapCumulants(NULL),
+ fBootstrapCumulantsSpread(NULL)
  {
   // constructor  
   
@@ -379,7 +433,33 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
- for(Int_t i=0;i<nPrim;i++) 
+ // Without phi, pt and eta weights Q_{n,k} and S_{p,k} do not depend on this method's settings,
+ // so they are taken from the Q-vector engine of the event, which is filled only once for all methods:
+ Bool_t bSharedQvectors = fUseSharedQvectors && fExactNoRPs<=0 && !fUsePhiWeights && !fUsePtWeights && !fUseEtaWeights;
+ if(bSharedQvectors)
+ {
+  AliFlowQVectorEngine *qve = anEvent->GetQVectorEngine();
+  qve->Require(12*n,8);
+  qve->Fill(anEvent,fUseTrackWeights);
+  for(Int_t m=0;m<12;m++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fReQ)(m,k) = qve->ReQ((m+1)*n,k); 
+    (*fImQ)(m,k) = qve->ImQ((m+1)*n,k); 
+   } 
+  }
+  for(Int_t p=0;p<8;p++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {     
+    (*fSpk)(p,k) = qve->SumOfWeights(k);
+   }
+  } 
+ } // end of if(bSharedQvectors)
+ // The track loop is still needed for differential flow:
+ Int_t nLoop = (bSharedQvectors && !fCalculateDiffFlow && !fCalculate2DDiffFlow) ? 0 : nPrim;
+ for(Int_t i=0;i<nLoop;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
   aftsTrack=anEvent->GetTrack(i);
@@ -410,7 +490,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      wTrack = aftsTrack->Weight(); 
     }
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    for(Int_t m=0;m<12 && !bSharedQvectors;m++) // to be improved - hardwired 6 
     {
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
@@ -419,7 +499,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      } 
     }
     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
+    for(Int_t p=0;p<8 && !bSharedQvectors;p++)
     {
      for(Int_t k=0;k<9;k++)
      {     
@@ -546,7 +626,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
- } // end of for(Int_t i=0;i<nPrim;i++) 
+ } // end of for(Int_t i=0;i<nLoop;i++) 
 
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
@@ -763,6 +843,11 @@ void AliFlowAnalysisWithQCumulants::Finish()
  fUseBootstrap = (Bool_t)fBootstrapFlags->GetBinContent(1); 
  fUseBootstrapVsM = (Bool_t)fBootstrapFlags->GetBinContent(2); 
  fnSubsamples = (Int_t)fBootstrapFlags->GetBinContent(3); 
+ if(fBootstrapFlags->GetNbinsX()>=5) // files written before the moments and the Poisson bootstrap have only 3 flags
+ {
+  fUseBootstrapMoments = (Bool_t)fBootstrapFlags->GetBinContent(4); 
+  fUseBootstrapPoisson = (Bool_t)fBootstrapFlags->GetBinContent(5); 
+ }
 
  // d) Calculate reference cumulants (not corrected for detector effects):
  this->FinalizeCorrelationsIntFlow();
@@ -2780,7 +2865,7 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  // a) Book profile to hold all flags for bootstrap;
  TString bootstrapFlagsName = "fBootstrapFlags";
  bootstrapFlagsName += fAnalysisLabel->Data();
- fBootstrapFlags = new TProfile(bootstrapFlagsName.Data(),"Flags for bootstrap",3,0,3);
+ fBootstrapFlags = new TProfile(bootstrapFlagsName.Data(),"Flags for bootstrap",5,0,5);
  fBootstrapFlags->SetTickLength(-0.01,"Y");
  fBootstrapFlags->SetMarkerStyle(25);
  fBootstrapFlags->SetLabelSize(0.04);
@@ -2789,6 +2874,8 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  fBootstrapFlags->GetXaxis()->SetBinLabel(1,"fUseBootstrap");
  fBootstrapFlags->GetXaxis()->SetBinLabel(2,"fUseBootstrapVsM");
  fBootstrapFlags->GetXaxis()->SetBinLabel(3,"fnSubsamples");
+ fBootstrapFlags->GetXaxis()->SetBinLabel(4,"fUseBootstrapMoments");
+ fBootstrapFlags->GetXaxis()->SetBinLabel(5,"fUseBootstrapPoisson");
  fBootstrapList->Add(fBootstrapFlags);
 
  // b) Book local random generator:
@@ -2803,19 +2890,28 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  if(fUseBootstrap)
  {
   // ....
-  TString bootstrapCorrelationsName = "fBootstrapCorrelations";
-  bootstrapCorrelationsName += fAnalysisLabel->Data();
-  fBootstrapCorrelations = new TProfile2D(bootstrapCorrelationsName.Data(),"Bootstrap Correlations",4,0.,4.,fnSubsamples,0,fnSubsamples); // x-axis => <2>, <4>, <6>, <8>; y-axis => subsample # 
-  fBootstrapCorrelations->SetStats(kFALSE);
-  for(Int_t ci=0;ci<4;ci++) // correlation index
+  if(fUseBootstrapMoments)
   {
-   fBootstrapCorrelations->GetXaxis()->SetBinLabel(ci+1,correlationFlag[ci].Data());
-  } // end of for(Int_t ci=0;ci<4;ci++) // correlation index
-  for(Int_t ss=0;ss<fnSubsamples;ss++)
-  {
-   fBootstrapCorrelations->GetYaxis()->SetBinLabel(ss+1,Form("#%d",ss));
-  } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
-  fBootstrapProfilesList->Add(fBootstrapCorrelations);
+   TString bootstrapMomentsName = "fBootstrapMoments";
+   bootstrapMomentsName += fAnalysisLabel->Data();
+   fBootstrapMoments = new AliFlowBootstrapMoments(bootstrapMomentsName.Data(),"Bootstrap Correlations",4,fnSubsamples); // observables => <2>, <4>, <6>, <8>
+   fBootstrapProfilesList->Add(fBootstrapMoments);
+  } else
+    {
+     TString bootstrapCorrelationsName = "fBootstrapCorrelations";
+     bootstrapCorrelationsName += fAnalysisLabel->Data();
+     fBootstrapCorrelations = new TProfile2D(bootstrapCorrelationsName.Data(),"Bootstrap Correlations",4,0.,4.,fnSubsamples,0,fnSubsamples); // x-axis => <2>, <4>, <6>, <8>; y-axis => subsample # 
+     fBootstrapCorrelations->SetStats(kFALSE);
+     for(Int_t ci=0;ci<4;ci++) // correlation index
+     {
+      fBootstrapCorrelations->GetXaxis()->SetBinLabel(ci+1,correlationFlag[ci].Data());
+     } // end of for(Int_t ci=0;ci<4;ci++) // correlation index
+     for(Int_t ss=0;ss<fnSubsamples;ss++)
+     {
+      fBootstrapCorrelations->GetYaxis()->SetBinLabel(ss+1,Form("#%d",ss));
+     } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
+     fBootstrapProfilesList->Add(fBootstrapCorrelations);
+    } // end of else of if(fUseBootstrapMoments)
   // ....
   TString bootstrapCumulantsName = "fBootstrapCumulants";
   bootstrapCumulantsName += fAnalysisLabel->Data();
@@ -2830,6 +2926,16 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
    fBootstrapCumulants->GetYaxis()->SetBinLabel(ss+1,Form("#%d",ss));
   } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
   fBootstrapResultsList->Add(fBootstrapCumulants);
+  // ....
+  TString bootstrapCumulantsSpreadName = "fBootstrapCumulantsSpread";
+  bootstrapCumulantsSpreadName += fAnalysisLabel->Data();
+  fBootstrapCumulantsSpread = new TH1D(bootstrapCumulantsSpreadName.Data(),"Bootstrap Cumulants, mean and spread of subsamples",4,0.,4.); // x-axis => QC{2}, QC{4}, QC{6}, QC{8}
+  fBootstrapCumulantsSpread->SetStats(kFALSE);
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   fBootstrapCumulantsSpread->GetXaxis()->SetBinLabel(co+1,cumulantFlag[co].Data());
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
+  fBootstrapResultsList->Add(fBootstrapCumulantsSpread);
  } // end of if(fUseBootstrap)
 
  // d) Book all bootstrap objects 'vs M':
@@ -2847,21 +2953,30 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
  if(fUseBootstrapVsM)
  {
   // ....
-  TString bootstrapCorrelationsVsMName = "fBootstrapCorrelationsVsM";
-  bootstrapCorrelationsVsMName += fAnalysisLabel->Data();
-  for(Int_t ci=0;ci<4;ci++) // correlation index
+  if(fUseBootstrapMoments)
   {
-   fBootstrapCorrelationsVsM[ci] = new TProfile2D(Form("%s, %s",bootstrapCorrelationsVsMName.Data(),correlationFlag[ci].Data()),
-                                       Form("Bootstrap Correlations Vs. M, %s",correlationFlag[ci].Data()),
-                                       fnBinsMult,fMinMult,fMaxMult,fnSubsamples,0,fnSubsamples); // index => <2>, <4>, <6>, <8>; x-axis => multiplicity; y-axis => subsample # 
-   fBootstrapCorrelationsVsM[ci]->SetStats(kFALSE);
-   fBootstrapCorrelationsVsM[ci]->GetXaxis()->SetTitle(sMultiplicity.Data());
-   for(Int_t ss=0;ss<fnSubsamples;ss++)
-   {
-    fBootstrapCorrelationsVsM[ci]->GetYaxis()->SetBinLabel(ss+1,Form("#%d",ss));
-   } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
-   fBootstrapProfilesList->Add(fBootstrapCorrelationsVsM[ci]);
-  } // end of for(Int_t ci=0;ci<4;ci++) // correlation index 
+   TString bootstrapMomentsVsMName = "fBootstrapMomentsVsM";
+   bootstrapMomentsVsMName += fAnalysisLabel->Data();
+   fBootstrapMomentsVsM = new AliFlowBootstrapMoments(bootstrapMomentsVsMName.Data(),"Bootstrap Correlations Vs. M",4,fnSubsamples,fnBinsMult,fMinMult,fMaxMult); // observables => <2>, <4>, <6>, <8>; bins => multiplicity
+   fBootstrapProfilesList->Add(fBootstrapMomentsVsM);
+  } else
+    {
+     TString bootstrapCorrelationsVsMName = "fBootstrapCorrelationsVsM";
+     bootstrapCorrelationsVsMName += fAnalysisLabel->Data();
+     for(Int_t ci=0;ci<4;ci++) // correlation index
+     {
+      fBootstrapCorrelationsVsM[ci] = new TProfile2D(Form("%s, %s",bootstrapCorrelationsVsMName.Data(),correlationFlag[ci].Data()),
+                                          Form("Bootstrap Correlations Vs. M, %s",correlationFlag[ci].Data()),
+                                          fnBinsMult,fMinMult,fMaxMult,fnSubsamples,0,fnSubsamples); // index => <2>, <4>, <6>, <8>; x-axis => multiplicity; y-axis => subsample # 
+      fBootstrapCorrelationsVsM[ci]->SetStats(kFALSE);
+      fBootstrapCorrelationsVsM[ci]->GetXaxis()->SetTitle(sMultiplicity.Data());
+      for(Int_t ss=0;ss<fnSubsamples;ss++)
+      {
+       fBootstrapCorrelationsVsM[ci]->GetYaxis()->SetBinLabel(ss+1,Form("#%d",ss));
+      } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
+      fBootstrapProfilesList->Add(fBootstrapCorrelationsVsM[ci]);
+     } // end of for(Int_t ci=0;ci<4;ci++) // correlation index 
+    } // end of else of if(fUseBootstrapMoments)
   // ....
   TString bootstrapCumulantsVsMName = "fBootstrapCumulantsVsM";
   bootstrapCumulantsVsMName += fAnalysisLabel->Data();
@@ -2878,6 +2993,18 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
    } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
    fBootstrapResultsList->Add(fBootstrapCumulantsVsM[co]);
   } // end of for(Int_t co=0;co<4;co++) // correlation index 
+  // ....
+  TString bootstrapCumulantsSpreadVsMName = "fBootstrapCumulantsSpreadVsM";
+  bootstrapCumulantsSpreadVsMName += fAnalysisLabel->Data();
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   fBootstrapCumulantsSpreadVsM[co] = new TH1D(Form("%s, %s",bootstrapCumulantsSpreadVsMName.Data(),cumulantFlag[co].Data()),
+                                       Form("Bootstrap Cumulants Vs. M, mean and spread of subsamples, %s",cumulantFlag[co].Data()),
+                                       fnBinsMult,fMinMult,fMaxMult); // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity
+   fBootstrapCumulantsSpreadVsM[co]->SetStats(kFALSE);
+   fBootstrapCumulantsSpreadVsM[co]->GetXaxis()->SetTitle(sMultiplicity.Data());
+   fBootstrapResultsList->Add(fBootstrapCumulantsSpreadVsM[co]);
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
  } // end of if(fUseBootstrapVsM)
 
 } // end of void AliFlowAnalysisWithQCumulants::BookEverythingForBootstrap()
@@ -3625,6 +3752,7 @@ void AliFlowAnalysisWithQCumulants::InitializeArraysForBootstrap()
  {
   fBootstrapCorrelationsVsM[ci] = NULL;    
   fBootstrapCumulantsVsM[ci] = NULL;
+  fBootstrapCumulantsSpreadVsM[ci] = NULL;
  }
 
 } // end of void AliFlowAnalysisWithQCumulants::InitializeArraysForBootstrap()
@@ -4915,21 +5043,36 @@ void AliFlowAnalysisWithQCumulants::CalculateIntFlowCorrelations()
  // Bootstrap:
  if(fUseBootstrap||fUseBootstrapVsM)
  {
-  Double_t nSampleNo = 1.*fRandom->Integer(fnSubsamples) + 0.5;
-  if(fUseBootstrap)
-  {
-   fBootstrapCorrelations->Fill(0.5,nSampleNo,two1n1n,mWeight2p); 
-   fBootstrapCorrelations->Fill(1.5,nSampleNo,four1n1n1n1n,mWeight4p);
-   fBootstrapCorrelations->Fill(2.5,nSampleNo,six1n1n1n1n1n1n,mWeight6p); 
-   fBootstrapCorrelations->Fill(3.5,nSampleNo,eight1n1n1n1n1n1n1n1n,mWeight8p); 
-  } // end of if(fUseBootstrap)
-  if(fUseBootstrapVsM)
-  {
-   fBootstrapCorrelationsVsM[0]->Fill(dMultiplicityBin,nSampleNo,two1n1n,mWeight2p); 
-   fBootstrapCorrelationsVsM[1]->Fill(dMultiplicityBin,nSampleNo,four1n1n1n1n,mWeight4p); 
-   fBootstrapCorrelationsVsM[2]->Fill(dMultiplicityBin,nSampleNo,six1n1n1n1n1n1n,mWeight6p); 
-   fBootstrapCorrelationsVsM[3]->Fill(dMultiplicityBin,nSampleNo,eight1n1n1n1n1n1n1n1n,mWeight8p); 
-  } // end of if(fUseBootstrapVsM) 
+  // Event goes with weight 1 to one random subsample, or (Poisson) with weight k ~ Poisson(1) to each subsample:
+  Int_t ssFirst = 0;
+  Int_t ssLast = fnSubsamples-1;
+  if(!fUseBootstrapPoisson){ssFirst = ssLast = fRandom->Integer(fnSubsamples);}
+  Double_t correlations[4] = {two1n1n,four1n1n1n1n,six1n1n1n1n1n1n,eight1n1n1n1n1n1n1n1n};
+  Double_t weights[4] = {mWeight2p,mWeight4p,mWeight6p,mWeight8p};
+  Int_t mb = (fUseBootstrapVsM && fUseBootstrapMoments) ? fBootstrapMomentsVsM->FindBin(dMultiplicityBin) : -1;
+  for(Int_t ss=ssFirst;ss<=ssLast;ss++)
+  {
+   Double_t k = 1.;
+   if(fUseBootstrapPoisson)
+   {
+    k = (Double_t)fRandom->Poisson(1.);
+    if(k==0.){continue;}
+   }
+   Double_t nSampleNo = 1.*ss + 0.5;
+   for(Int_t ci=0;ci<4;ci++) // correlation index
+   {
+    if(fUseBootstrap)
+    {
+     if(fUseBootstrapMoments){fBootstrapMoments->Fill(0,ss,ci,correlations[ci],k*weights[ci]);}
+     else{fBootstrapCorrelations->Fill(ci+0.5,nSampleNo,correlations[ci],k*weights[ci]);}
+    } // end of if(fUseBootstrap)
+    if(fUseBootstrapVsM)
+    {
+     if(fUseBootstrapMoments){if(mb>=0){fBootstrapMomentsVsM->Fill(mb,ss,ci,correlations[ci],k*weights[ci]);}}
+     else{fBootstrapCorrelationsVsM[ci]->Fill(dMultiplicityBin,nSampleNo,correlations[ci],k*weights[ci]);}
+    } // end of if(fUseBootstrapVsM) 
+   } // end of for(Int_t ci=0;ci<4;ci++) // correlation index
+  } // end of for(Int_t ss=ssFirst;ss<=ssLast;ss++)
  } // end of if(fUseBootstrap||fUseBootstrapVsM)
 
  return;
@@ -14758,79 +14901,97 @@ void AliFlowAnalysisWithQCumulants::CalculateCumulantsIntFlow()
 void AliFlowAnalysisWithQCumulants::CalculateCumulantsForBootstrap()
 {
  // Calculate cumulants for bootstrap.
+ 
+ // The correlations of all cells (bin, subsample) are copied to flat arrays, the cumulants of
+ // the cells and their mean and spread over subsamples are evaluated in fBootstrapNThreads
+ // threads (each taking a contiguous block of bins), and the histograms are filled here afterwards.
+ // The error of the mean is the spread over subsamples divided by sqrt(#SS) for disjoint 
+ // subsamples, and the spread itself for Poisson bootstrap, where every SS sees all events.
+
+ Int_t nThreads = fBootstrapNThreads;
+ if(nThreads<=0){nThreads = std::thread::hardware_concurrency();}
+ if(nThreads<=0){nThreads = 1;}
 
  if(fUseBootstrap)
  {
+  std::vector<Double_t> correlations(fnSubsamples*4);
   for(Int_t ss=0;ss<fnSubsamples;ss++)
   {
-   // Correlations:
-   Double_t two = fBootstrapCorrelations->GetBinContent(fBootstrapCorrelations->GetBin(1,ss+1)); 
-   Double_t four = fBootstrapCorrelations->GetBinContent(fBootstrapCorrelations->GetBin(2,ss+1)); 
-   Double_t six = fBootstrapCorrelations->GetBinContent(fBootstrapCorrelations->GetBin(3,ss+1)); 
-   Double_t eight = fBootstrapCorrelations->GetBinContent(fBootstrapCorrelations->GetBin(4,ss+1)); 
-   // Q-cumulants:
-   Double_t qc2 = 0.; // QC{2}
-   Double_t qc4 = 0.; // QC{4}
-   Double_t qc6 = 0.; // QC{6}
-   Double_t qc8 = 0.; // QC{8}
-   if(TMath::Abs(two) > 0.){qc2 = two;} 
-   if(TMath::Abs(four) > 0.){qc4 = four-2.*pow(two,2.);} 
-   if(TMath::Abs(six) > 0.){qc6 = six-9.*two*four+12.*pow(two,3.);} 
-   if(TMath::Abs(eight) > 0.){qc8 = eight-16.*two*six-18.*pow(four,2.)+144.*pow(two,2.)*four-144.*pow(two,4.);}  
-   fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(1,ss+1),qc2); 
-   fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(2,ss+1),qc4); 
-   fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(3,ss+1),qc6); 
-   fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(4,ss+1),qc8); 
-   /*
-   if(qc2>=0.){fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(1,ss+1),pow(qc2,0.5));}
-   if(qc4<=0.){fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(2,ss+1),pow(-1.*qc4,1./4.));} 
-   if(qc6>=0.){fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(3,ss+1),pow((1./4.)*qc6,1./6.));}
-   if(qc8<=0.){fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(4,ss+1),pow((-1./33.)*qc8,1./8.));}  
-   cout<<"Subsample #"<<ss<<":"<<endl;   
-   cout<<"v2{2} = "<<pow(qc2,0.5)<<endl;
-   cout<<"v2{4} = "<<pow(-1.*qc4,1./4.)<<endl;
-   cout<<"v2{6} = "<<pow((1./4.)*qc6,1./6.)<<endl;
-   cout<<"v2{8} = "<<pow((-1./33.)*qc8,1./8.)<<endl;
-   cout<<endl;
-   */
+   for(Int_t ci=0;ci<4;ci++) // correlation index
+   {
+    correlations[ss*4+ci] = fUseBootstrapMoments ? fBootstrapMoments->GetMean(0,ss,ci)
+                            : fBootstrapCorrelations->GetBinContent(fBootstrapCorrelations->GetBin(ci+1,ss+1));
+   }
   } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
+  std::vector<Double_t> cumulants(fnSubsamples*4);
+  Double_t mean[4] = {0.};
+  Double_t error[4] = {0.};
+  BootstrapCumulants(0,1,fnSubsamples,fUseBootstrapPoisson,&correlations[0],&cumulants[0],mean,error);
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   for(Int_t ss=0;ss<fnSubsamples;ss++)
+   {
+    fBootstrapCumulants->SetBinContent(fBootstrapCumulants->GetBin(co+1,ss+1),cumulants[ss*4+co]); 
+   }
+   if(fBootstrapCumulantsSpread)
+   {
+    fBootstrapCumulantsSpread->SetBinContent(co+1,mean[co]);
+    fBootstrapCumulantsSpread->SetBinError(co+1,error[co]);
+   }
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
  } // end of if(fUseBootstrap)
 
  if(fUseBootstrapVsM)  
  {
-  for(Int_t mb=1;mb<=fnBinsMult;mb++)
+  Int_t nBins = fUseBootstrapMoments ? fBootstrapMomentsVsM->GetNBins() : fBootstrapCorrelationsVsM[0]->GetNbinsX();
+  std::vector<Double_t> correlations(nBins*fnSubsamples*4);
+  for(Int_t mb=0;mb<nBins;mb++)
   {
    for(Int_t ss=0;ss<fnSubsamples;ss++) 
    {
-    // Correlations:
-    Double_t two = fBootstrapCorrelationsVsM[0]->GetBinContent(fBootstrapCorrelationsVsM[0]->GetBin(mb,ss+1)); 
-    Double_t four = fBootstrapCorrelationsVsM[1]->GetBinContent(fBootstrapCorrelationsVsM[1]->GetBin(mb,ss+1)); 
-    Double_t six = fBootstrapCorrelationsVsM[2]->GetBinContent(fBootstrapCorrelationsVsM[2]->GetBin(mb,ss+1)); 
-    Double_t eight = fBootstrapCorrelationsVsM[3]->GetBinContent(fBootstrapCorrelationsVsM[3]->GetBin(mb,ss+1)); 
-    // Q-cumulants:
-    Double_t qc2 = 0.; // QC{2}
-    Double_t qc4 = 0.; // QC{4}
-    Double_t qc6 = 0.; // QC{6}
-    Double_t qc8 = 0.; // QC{8}
-    if(TMath::Abs(two) > 0.){qc2 = two;} 
-    if(TMath::Abs(four) > 0.){qc4 = four-2.*pow(two,2.);} 
-    if(TMath::Abs(six) > 0.){qc6 = six-9.*two*four+12.*pow(two,3.);} 
-    if(TMath::Abs(eight) > 0.){qc8 = eight-16.*two*six-18.*pow(four,2.)+144.*pow(two,2.)*four-144.*pow(two,4.);}  
-    fBootstrapCumulantsVsM[0]->SetBinContent(fBootstrapCumulantsVsM[0]->GetBin(mb,ss+1),qc2); 
-    fBootstrapCumulantsVsM[1]->SetBinContent(fBootstrapCumulantsVsM[1]->GetBin(mb,ss+1),qc4); 
-    fBootstrapCumulantsVsM[2]->SetBinContent(fBootstrapCumulantsVsM[2]->GetBin(mb,ss+1),qc6); 
-    fBootstrapCumulantsVsM[3]->SetBinContent(fBootstrapCumulantsVsM[3]->GetBin(mb,ss+1),qc8);     
-    /*
-    if(qc2>=0.){fBootstrapCumulantsVsM[0]->SetBinContent(fBootstrapCumulantsVsM[0]->GetBin(mb,ss+1),pow(qc2,0.5));}
-    if(qc4<=0.){fBootstrapCumulantsVsM[1]->SetBinContent(fBootstrapCumulantsVsM[1]->GetBin(mb,ss+1),pow(-1.*qc4,1./4.));} 
-    if(qc6>=0.){fBootstrapCumulantsVsM[2]->SetBinContent(fBootstrapCumulantsVsM[2]->GetBin(mb,ss+1),pow((1./4.)*qc6,1./6.));}
-    if(qc8<=0.){fBootstrapCumulantsVsM[3]->SetBinContent(fBootstrapCumulantsVsM[3]->GetBin(mb,ss+1),pow((-1./33.)*qc8,1./8.));}  
-    */    
+    for(Int_t ci=0;ci<4;ci++) // correlation index
+    {
+     correlations[(mb*fnSubsamples+ss)*4+ci] = fUseBootstrapMoments ? fBootstrapMomentsVsM->GetMean(mb,ss,ci)
+                                               : fBootstrapCorrelationsVsM[ci]->GetBinContent(fBootstrapCorrelationsVsM[ci]->GetBin(mb+1,ss+1));
+    }
    } // end of for(Int_t ss=0;ss<fnSubsamples;ss++)
-  } // end of for(Int_t mb=1;mb<=fnBinsMult;mb++)
+  } // end of for(Int_t mb=0;mb<nBins;mb++)
+  std::vector<Double_t> cumulants(nBins*fnSubsamples*4);
+  std::vector<Double_t> mean(nBins*4);
+  std::vector<Double_t> error(nBins*4);
+  nThreads = TMath::Min(nThreads,nBins);
+  if(nThreads>1)
+  {
+   std::vector<std::thread> threads;
+   for(Int_t t=0;t<nThreads;t++)
+   {
+    Int_t first = (nBins*t)/nThreads;
+    Int_t last = (nBins*(t+1))/nThreads;
+    threads.push_back(std::thread(BootstrapCumulants,first,last,fnSubsamples,fUseBootstrapPoisson,
+                                  &correlations[0],&cumulants[0],&mean[0],&error[0]));
+   }
+   for(Int_t t=0;t<nThreads;t++){threads[t].join();}
+  } else
+    {
+     BootstrapCumulants(0,nBins,fnSubsamples,fUseBootstrapPoisson,&correlations[0],&cumulants[0],&mean[0],&error[0]);
+    }
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   for(Int_t mb=0;mb<nBins;mb++)
+   {
+    for(Int_t ss=0;ss<fnSubsamples;ss++) 
+    {
+     fBootstrapCumulantsVsM[co]->SetBinContent(fBootstrapCumulantsVsM[co]->GetBin(mb+1,ss+1),cumulants[(mb*fnSubsamples+ss)*4+co]); 
+    }
+    if(fBootstrapCumulantsSpreadVsM[co])
+    {
+     fBootstrapCumulantsSpreadVsM[co]->SetBinContent(mb+1,mean[mb*4+co]);
+     fBootstrapCumulantsSpreadVsM[co]->SetBinError(mb+1,error[mb*4+co]);
+    }
+   } // end of for(Int_t mb=0;mb<nBins;mb++)
+  } // end of for(Int_t co=0;co<4;co++) // cumulant order
  } // end of if(fUseBootstrapVsM) 
 
-
  return;
 
 } // end of void AliFlowAnalysisWithQCumulants::CalculateCumulantsForBootstrap()
@@ -18092,6 +18253,8 @@ void AliFlowAnalysisWithQCumulants::StoreBootstrapFlags()
  fBootstrapFlags->Fill(0.5,(Int_t)fUseBootstrap);
  fBootstrapFlags->Fill(1.5,(Int_t)fUseBootstrapVsM);
  fBootstrapFlags->Fill(2.5,(Int_t)fnSubsamples);
+ fBootstrapFlags->Fill(3.5,(Int_t)fUseBootstrapMoments);
+ fBootstrapFlags->Fill(4.5,(Int_t)fUseBootstrapPoisson);
 
 } // end of void AliFlowAnalysisWithQCumulants::StoreBootstrapFlags()
 
@@ -20642,6 +20805,11 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
   fUseBootstrap = (Bool_t)fBootstrapFlags->GetBinContent(1); 
   fUseBootstrapVsM = (Bool_t)fBootstrapFlags->GetBinContent(2); 
   fnSubsamples = (Int_t)fBootstrapFlags->GetBinContent(3); 
+  if(fBootstrapFlags->GetNbinsX()>=5)
+  {
+   fUseBootstrapMoments = (Bool_t)fBootstrapFlags->GetBinContent(4); 
+   fUseBootstrapPoisson = (Bool_t)fBootstrapFlags->GetBinContent(5); 
+  }
  } else 
    {
     cout<<"WARNING: bootstrapFlags is NULL in AFAWQC::GPFMHH() !!!!"<<endl;
@@ -20677,17 +20845,33 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
  TString cumulantFlag[4] = {"QC{2}","QC{4}","QC{6}","QC{8}"};
  if(fUseBootstrap)
  { 
-  TString bootstrapCorrelationsName = "fBootstrapCorrelations";
-  bootstrapCorrelationsName += fAnalysisLabel->Data();
-  TProfile2D *pBootstrapCorrelations = dynamic_cast<TProfile2D*>(fBootstrapProfilesList->FindObject(bootstrapCorrelationsName.Data()));
-  if(pBootstrapCorrelations) 
+  if(fUseBootstrapMoments)
   {
-   this->SetBootstrapCorrelations(pBootstrapCorrelations);
-  } else 
+   TString bootstrapMomentsName = "fBootstrapMoments";
+   bootstrapMomentsName += fAnalysisLabel->Data();
+   AliFlowBootstrapMoments *pBootstrapMoments = dynamic_cast<AliFlowBootstrapMoments*>(fBootstrapProfilesList->FindObject(bootstrapMomentsName.Data()));
+   if(pBootstrapMoments) 
+   {
+    this->SetBootstrapMoments(pBootstrapMoments);
+   } else 
+     {
+      cout<<"WARNING: pBootstrapMoments is NULL in AFAWQC::GPFB() !!!!"<<endl; 
+      exit(0);
+     }                                   
+  } else
     {
-     cout<<"WARNING: pBootstrapCorrelations is NULL in AFAWQC::GPFB() !!!!"<<endl; 
-     exit(0);
-    }                                   
+     TString bootstrapCorrelationsName = "fBootstrapCorrelations";
+     bootstrapCorrelationsName += fAnalysisLabel->Data();
+     TProfile2D *pBootstrapCorrelations = dynamic_cast<TProfile2D*>(fBootstrapProfilesList->FindObject(bootstrapCorrelationsName.Data()));
+     if(pBootstrapCorrelations) 
+     {
+      this->SetBootstrapCorrelations(pBootstrapCorrelations);
+     } else 
+       {
+        cout<<"WARNING: pBootstrapCorrelations is NULL in AFAWQC::GPFB() !!!!"<<endl; 
+        exit(0);
+       }                                   
+    } // end of else of if(fUseBootstrapMoments)
   TString bootstrapCumulantsName = "fBootstrapCumulants";
   bootstrapCumulantsName += fAnalysisLabel->Data();
   TH2D *pBootstrapCumulants = dynamic_cast<TH2D*>(fBootstrapResultsList->FindObject(bootstrapCumulantsName.Data()));
@@ -20699,26 +20883,46 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
      cout<<"WARNING: pBootstrapCumulants is NULL in AFAWQC::GPFB() !!!!"<<endl; 
      exit(0);
     }                                   
+  // not in files written before it was introduced, then only the cumulants of the SS are calculated:
+  TString bootstrapCumulantsSpreadName = "fBootstrapCumulantsSpread";
+  bootstrapCumulantsSpreadName += fAnalysisLabel->Data();
+  this->SetBootstrapCumulantsSpread(dynamic_cast<TH1D*>(fBootstrapResultsList->FindObject(bootstrapCumulantsSpreadName.Data())));
  } // end of if(fUseBootstrap)
 
  // e) Get pointers to remaining bootstrap profiles and histograms 'vs M':
  if(fUseBootstrapVsM)
  { 
-  TString bootstrapCorrelationsVsMName = "fBootstrapCorrelationsVsM";
-  bootstrapCorrelationsVsMName += fAnalysisLabel->Data();
-  for(Int_t ci=0;ci<4;ci++) // correlation index
+  if(fUseBootstrapMoments)
   {
-   TProfile2D *pBootstrapCorrelationsVsM = dynamic_cast<TProfile2D*>(fBootstrapProfilesList->FindObject(Form("%s, %s",bootstrapCorrelationsVsMName.Data(),correlationFlag[ci].Data())));
-   if(pBootstrapCorrelationsVsM)
+   TString bootstrapMomentsVsMName = "fBootstrapMomentsVsM";
+   bootstrapMomentsVsMName += fAnalysisLabel->Data();
+   AliFlowBootstrapMoments *pBootstrapMomentsVsM = dynamic_cast<AliFlowBootstrapMoments*>(fBootstrapProfilesList->FindObject(bootstrapMomentsVsMName.Data()));
+   if(pBootstrapMomentsVsM) 
    {
-    this->SetBootstrapCorrelationsVsM(pBootstrapCorrelationsVsM,ci);
+    this->SetBootstrapMomentsVsM(pBootstrapMomentsVsM);
    } else 
      {
-      cout<<"WARNING: pBootstrapCorrelationsVsM is NULL in AFAWQC::GPFB() !!!!"<<endl; 
-      cout<<"ci = "<<ci<<endl;
+      cout<<"WARNING: pBootstrapMomentsVsM is NULL in AFAWQC::GPFB() !!!!"<<endl; 
       exit(0);
      }                                   
-  } // end of for(Int_t ci=0;ci<4;ci++)
+  } else
+    {
+     TString bootstrapCorrelationsVsMName = "fBootstrapCorrelationsVsM";
+     bootstrapCorrelationsVsMName += fAnalysisLabel->Data();
+     for(Int_t ci=0;ci<4;ci++) // correlation index
+     {
+      TProfile2D *pBootstrapCorrelationsVsM = dynamic_cast<TProfile2D*>(fBootstrapProfilesList->FindObject(Form("%s, %s",bootstrapCorrelationsVsMName.Data(),correlationFlag[ci].Data())));
+      if(pBootstrapCorrelationsVsM)
+      {
+       this->SetBootstrapCorrelationsVsM(pBootstrapCorrelationsVsM,ci);
+      } else 
+        {
+         cout<<"WARNING: pBootstrapCorrelationsVsM is NULL in AFAWQC::GPFB() !!!!"<<endl; 
+         cout<<"ci = "<<ci<<endl;
+         exit(0);
+        }                                   
+     } // end of for(Int_t ci=0;ci<4;ci++)
+    } // end of else of if(fUseBootstrapMoments)
   TString bootstrapCumulantsVsMName = "fBootstrapCumulantsVsM";
   bootstrapCumulantsVsMName += fAnalysisLabel->Data();
   for(Int_t co=0;co<4;co++) // correlation index
@@ -20734,6 +20938,12 @@ void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
       exit(0);
      }                                   
   } // end of for(Int_t co=0;co<4;co++)
+  TString bootstrapCumulantsSpreadVsMName = "fBootstrapCumulantsSpreadVsM";
+  bootstrapCumulantsSpreadVsMName += fAnalysisLabel->Data();
+  for(Int_t co=0;co<4;co++) // cumulant order
+  {
+   this->SetBootstrapCumulantsSpreadVsM(dynamic_cast<TH1D*>(fBootstrapResultsList->FindObject(Form("%s, %s",bootstrapCumulantsSpreadVsMName.Data(),cumulantFlag[co].Data()))),co);
+  } // end of for(Int_t co=0;co<4;co++)
  } // end of if(fUseBootstrapVsM)
 
 } // end of void AliFlowAnalysisWithQCumulants::GetPointersForBootstrap()
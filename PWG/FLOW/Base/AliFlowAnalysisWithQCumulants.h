@@ -25,6 +25,7 @@ class TFile;
 class TGraph;
 
 class TH1;
+class TH1D;
 class TProfile;
 class TProfile2D;
 class TDirectoryFile;
@@ -34,6 +35,7 @@ class AliFlowVector;
 
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
+class AliFlowBootstrapMoments;
 
 //================================================================================================================
 
@@ -287,6 +289,8 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t GetFillProfilesVsMUsingWeights() const {return this->fFillProfilesVsMUsingWeights;};
   void SetUseQvectorTerms(Bool_t const uqvt){this->fUseQvectorTerms = uqvt;if(uqvt){this->fStoreControlHistograms = kTRUE;}};
   Bool_t GetUseQvectorTerms() const {return this->fUseQvectorTerms;};
+  void SetUseSharedQvectors(Bool_t const usqv){this->fUseSharedQvectors = usqv;};
+  Bool_t GetUseSharedQvectors() const {return this->fUseSharedQvectors;};
 
   // Reference flow profiles:
   void SetAvMultiplicity(TProfile* const avMultiplicity) {this->fAvMultiplicity = avMultiplicity;};
@@ -549,6 +553,20 @@ class AliFlowAnalysisWithQCumulants{
   TH2D* GetBootstrapCumulants() const {return this->fBootstrapCumulants;}; 
   void SetBootstrapCumulantsVsM(TH2D* const bcpVsM, Int_t const qvti) {this->fBootstrapCumulantsVsM[qvti] = bcpVsM;};
   TH2D* GetBootstrapCumulantsVsM(Int_t qvti) const {return this->fBootstrapCumulantsVsM[qvti];};
+  void SetUseBootstrapMoments(Bool_t const ubm) {this->fUseBootstrapMoments = ubm;};
+  Bool_t GetUseBootstrapMoments() const {return this->fUseBootstrapMoments;};
+  void SetUseBootstrapPoisson(Bool_t const ubp) {this->fUseBootstrapPoisson = ubp;};
+  Bool_t GetUseBootstrapPoisson() const {return this->fUseBootstrapPoisson;};
+  void SetBootstrapNThreads(Int_t const nt) {this->fBootstrapNThreads = nt;};
+  Int_t GetBootstrapNThreads() const {return this->fBootstrapNThreads;};
+  void SetBootstrapMoments(AliFlowBootstrapMoments* const bm) {this->fBootstrapMoments = bm;};
+  AliFlowBootstrapMoments* GetBootstrapMoments() const {return this->fBootstrapMoments;};
+  void SetBootstrapMomentsVsM(AliFlowBootstrapMoments* const bmVsM) {this->fBootstrapMomentsVsM = bmVsM;};
+  AliFlowBootstrapMoments* GetBootstrapMomentsVsM() const {return this->fBootstrapMomentsVsM;};
+  void SetBootstrapCumulantsSpread(TH1D* const bcs) {this->fBootstrapCumulantsSpread = bcs;};
+  TH1D* GetBootstrapCumulantsSpread() const {return this->fBootstrapCumulantsSpread;};
+  void SetBootstrapCumulantsSpreadVsM(TH1D* const bcsVsM, Int_t const qvti) {this->fBootstrapCumulantsSpreadVsM[qvti] = bcsVsM;};
+  TH1D* GetBootstrapCumulantsSpreadVsM(Int_t qvti) const {return this->fBootstrapCumulantsSpreadVsM[qvti];};
 
  private:
   
@@ -627,6 +645,7 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t fUse2DHistograms; // use TH2D instead of TProfile to improve numerical stability in reference flow calculation 
   Bool_t fFillProfilesVsMUsingWeights; // if the width of multiplicity bin is 1, weights are not needed  
   Bool_t fUseQvectorTerms; // use TH2D with separate Q-vector terms instead of TProfile to improve numerical stability in reference flow calculation 
+  Bool_t fUseSharedQvectors; // take Q_{n,k} and S_{p,k} from the Q-vector engine shared by all flow methods (only without phi, pt and eta weights)
 
   //  3c.) event-by-event quantities:
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
@@ -840,14 +859,21 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t fUseBootstrapVsM; // use bootstrap to estimate statistical spread for results vs M
   Int_t fnSubsamples; // number of subsamples (SS), by default 10
   TRandom3 *fRandom; // local random generator
+  Bool_t fUseBootstrapMoments; // accumulate the correlations in AliFlowBootstrapMoments instead of TProfile2D's
+  Bool_t fUseBootstrapPoisson; // online bootstrap: each event enters every SS with a Poisson(1) weight instead of one random SS
+  Int_t fBootstrapNThreads; // threads for the cumulants of the SS in Finish() (0 => one per core, by default 1)
   //  11c) profiles: 
   TProfile2D *fBootstrapCorrelations; // x-axis => <2>, <4>, <6>, <8>; y-axis => subsample # 
   TProfile2D *fBootstrapCorrelationsVsM[4]; // index => <2>, <4>, <6>, <8>; x-axis => multiplicity; y-axis => subsample # 
+  AliFlowBootstrapMoments *fBootstrapMoments; // observables => <2>, <4>, <6>, <8>; one bin (replaces fBootstrapCorrelations)
+  AliFlowBootstrapMoments *fBootstrapMomentsVsM; // observables => <2>, <4>, <6>, <8>; bins => multiplicity (replaces fBootstrapCorrelationsVsM)
   //  11d) histograms:  
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
+  TH1D *fBootstrapCumulantsSpread; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; mean over SS, error from the spread of SS
+  TH1D *fBootstrapCumulantsSpreadVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; mean over SS, error from the spread of SS
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 6);
 
 };
 
@@ -0,0 +1,110 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowBootstrapMoments.h"
+#include "TCollection.h"
+
+//********************************************************************
+// AliFlowBootstrapMoments:                                          *
+// Per-subsample weighted moments for bootstrap error estimation.    *
+//********************************************************************
+
+ClassImp(AliFlowBootstrapMoments)
+
+//________________________________________________________________________
+
+AliFlowBootstrapMoments::AliFlowBootstrapMoments():
+  TNamed(),
+  fNObservables(0),
+  fNSubsamples(0),
+  fNBins(0),
+  fMin(0.),
+  fMax(1.),
+  fSumW(),
+  fSumWX()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowBootstrapMoments::AliFlowBootstrapMoments(const char* name, const char* title, Int_t nObservables, Int_t nSubsamples,
+                                                 Int_t nBins, Double_t min, Double_t max):
+  TNamed(name,title),
+  fNObservables(nObservables),
+  fNSubsamples(nSubsamples),
+  fNBins(nBins),
+  fMin(min),
+  fMax(max),
+  fSumW(nBins*nSubsamples*nObservables),
+  fSumWX(nBins*nSubsamples*nObservables)
+{
+  // constructor
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowBootstrapMoments::FindBin(Double_t x) const
+{
+  // bin of the axis containing x, with the convention of TAxis::FindBin shifted by one
+  if (x<fMin || x>=fMax) return -1;
+  Int_t bin = Int_t(fNBins*(x-fMin)/(fMax-fMin));
+  return bin<fNBins ? bin : fNBins-1;
+}
+
+//________________________________________________________________________
+
+Double_t AliFlowBootstrapMoments::GetMean(Int_t bin, Int_t subsample, Int_t observable) const
+{
+  // weighted mean of a cell
+  Int_t i = Index(bin,subsample,observable);
+  return fSumW[i]!=0. ? fSumWX[i]/fSumW[i] : 0.;
+}
+
+//________________________________________________________________________
+
+void AliFlowBootstrapMoments::Reset(Option_t* /*option*/)
+{
+  // clear all cells
+  fSumW.Reset();
+  fSumWX.Reset();
+}
+
+//________________________________________________________________________
+
+Long64_t AliFlowBootstrapMoments::Merge(TCollection* list)
+{
+  // add the sums of the objects in list, which must have the same layout
+  if (!list) return 0;
+  TIter next(list);
+  Long64_t nMerged = 0;
+  while (TObject* obj = next())
+  {
+    AliFlowBootstrapMoments* other = dynamic_cast<AliFlowBootstrapMoments*>(obj);
+    if (!other) continue;
+    if (other->fNObservables!=fNObservables || other->fNSubsamples!=fNSubsamples || other->fNBins!=fNBins)
+    {
+      Error("Merge","%s: different layout, not merged",GetName());
+      continue;
+    }
+    for (Int_t i=0; i<fSumW.GetSize(); i++)
+    {
+      fSumW[i] += other->fSumW[i];
+      fSumWX[i] += other->fSumWX[i];
+    }
+    nMerged++;
+  }
+  return nMerged;
+}
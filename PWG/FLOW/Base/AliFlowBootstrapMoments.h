@@ -0,0 +1,71 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWBOOTSTRAPMOMENTS_H
+#define ALIFLOWBOOTSTRAPMOMENTS_H
+
+#include "TNamed.h"
+#include "TArrayD.h"
+
+class TCollection;
+
+//********************************************************************
+// AliFlowBootstrapMoments:                                          *
+// Weighted first moments <x> = sum(w*x)/sum(w) of a few observables *
+// (e.g. <2>, <4>, <6>, <8>) for each subsample and each bin of an   *
+// equidistant axis (e.g. multiplicity). Holds only sum(w) and       *
+// sum(w*x) per cell, without the under/overflow, error and label    *
+// bookkeeping of a TProfile2D per observable. Mergeable, so it can  *
+// be put in the output list of an analysis task.                    *
+//********************************************************************
+
+class AliFlowBootstrapMoments: public TNamed {
+
+ public:
+
+  AliFlowBootstrapMoments();
+  AliFlowBootstrapMoments(const char* name, const char* title, Int_t nObservables, Int_t nSubsamples,
+                          Int_t nBins=1, Double_t min=0., Double_t max=1.);
+  virtual ~AliFlowBootstrapMoments() {}
+
+  Int_t    FindBin(Double_t x) const;           // 0..nBins-1, -1 outside of the axis
+  void     Fill(Int_t bin, Int_t subsample, Int_t observable, Double_t x, Double_t w=1.);
+  void     Reset(Option_t* option="");
+  virtual Long64_t Merge(TCollection* list);
+
+  Int_t    GetNObservables() const              { return fNObservables; }
+  Int_t    GetNSubsamples() const               { return fNSubsamples; }
+  Int_t    GetNBins() const                     { return fNBins; }
+  Double_t GetMin() const                       { return fMin; }
+  Double_t GetMax() const                       { return fMax; }
+  Double_t GetSumOfWeights(Int_t bin, Int_t subsample, Int_t observable) const { return fSumW[Index(bin,subsample,observable)]; }
+  Double_t GetMean(Int_t bin, Int_t subsample, Int_t observable) const; // 0 for an empty cell, as TProfile
+
+ private:
+
+  AliFlowBootstrapMoments(const AliFlowBootstrapMoments& other);
+  AliFlowBootstrapMoments& operator=(const AliFlowBootstrapMoments& other);
+
+  Int_t    Index(Int_t bin, Int_t subsample, Int_t observable) const { return (bin*fNSubsamples+subsample)*fNObservables+observable; }
+
+  Int_t    fNObservables;       // number of observables per cell
+  Int_t    fNSubsamples;        // number of subsamples
+  Int_t    fNBins;              // number of bins of the axis
+  Double_t fMin;                // lower edge of the axis
+  Double_t fMax;                // upper edge of the axis
+  TArrayD  fSumW;               // sum(w), index (bin*nSubsamples+subsample)*nObservables+observable
+  TArrayD  fSumWX;              // sum(w*x), same index
+
+  ClassDef(AliFlowBootstrapMoments,1)
+};
+
+inline void AliFlowBootstrapMoments::Fill(Int_t bin, Int_t subsample, Int_t observable, Double_t x, Double_t w)
+{
+  // add the value x with weight w to a cell
+  Int_t i = Index(bin,subsample,observable);
+  fSumW[i] += w;
+  fSumWX[i] += w*x;
+}
+
+#endif
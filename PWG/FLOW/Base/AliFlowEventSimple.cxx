@@ -42,6 +42,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQVectorEngine.h"
 #include "TRandom.h"
 
 using std::cout;
@@ -87,6 +88,7 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fQVectorEngine(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -146,6 +148,7 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fQVectorEngine(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -209,6 +212,7 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fQVectorEngine(NULL),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -322,6 +326,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  delete fQVectorEngine;
 }
 
 //-----------------------------------------------------------------------
@@ -374,7 +379,7 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
 
   for (Int_t i=0; i<nParticles; i++)
   {
-    AliFlowTrackSimple* track = new AliFlowTrackSimple();
+    AliFlowTrackSimple* track = MakeNewTrack();
     track->SetPhi( gRandom->Uniform(phiMin,phiMax) );
     track->SetEta( gRandom->Uniform(etaMin,etaMax) );
     track->SetPt( ptDist->GetRandom() );
@@ -477,14 +482,30 @@ void AliFlowEventSimple::TrackAdded()
 //-----------------------------------------------------------------------
 AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
 {
-   AliFlowTrackSimple *t=dynamic_cast<AliFlowTrackSimple *>(fTrackCollection->RemoveAt(fNumberOfTracks));
+   //return a cleared track for the next slot, reusing the one left
+   //there by a previous event (see ClearFast()) if possible
+   AliFlowTrackSimple *t=NULL;
+   if (fNumberOfTracks < fTrackCollection->GetEntriesFast())
+   {
+      t=dynamic_cast<AliFlowTrackSimple *>(fTrackCollection->RemoveAt(fNumberOfTracks));
+   }
    if( !t ) {  // If there was no track at the end of the list then create a new track
       t=new AliFlowTrackSimple();
    }
+   else t->Clear();
 
    return t;
 }
 
+//-----------------------------------------------------------------------
+AliFlowQVectorEngine* AliFlowEventSimple::GetQVectorEngine()
+{
+  //the Q-vector engine of this event, shared by all flow methods
+  //so that Q-vectors are built only once per event
+  if (!fQVectorEngine) fQVectorEngine = new AliFlowQVectorEngine();
+  return fQVectorEngine;
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -893,6 +914,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fQVectorEngine(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
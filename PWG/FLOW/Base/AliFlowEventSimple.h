@@ -25,6 +25,7 @@ class TF1;
 class TF2;
 class AliFlowTrackSimple;
 class AliFlowTrackSimpleCuts;
+class AliFlowQVectorEngine;
 
 class AliFlowEventSimple: public TObject {
 
@@ -117,6 +118,8 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  AliFlowQVectorEngine* GetQVectorEngine();            // Q-vectors shared by all flow methods analysing this event
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -204,6 +207,7 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  AliFlowQVectorEngine*   fQVectorEngine;             //! shared Q-vector builder, created on demand
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
@@ -0,0 +1,300 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowGenericCorrelator.h"
+#include "AliFlowQVectorEngine.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowGenericCorrelator:                                         *
+// Memoized generic framework multi-particle correlators.            *
+//********************************************************************
+
+ClassImp(AliFlowGenericCorrelator)
+
+namespace {
+  // a (harmonic,power) pair is coded in 16 bits: 10 bits for harmonic+512, 6 bits for the power;
+  // code 0 is never produced and pads the keys of correlators with less than 8 particles
+  const Int_t kHarmonicOffset = 512;
+  const Int_t kPowerBits = 6;
+  const Int_t kMaxCodedPower = (1<<kPowerBits)-1;
+  const Int_t kInitialCapacity = 1024;
+
+  inline UShort_t Code(Int_t h, Int_t p) { return (UShort_t)(((h+kHarmonicOffset)<<kPowerBits)|p); }
+  inline Int_t CodeHarmonic(UShort_t code) { return (code>>kPowerBits)-kHarmonicOffset; }
+  inline Int_t CodePower(UShort_t code) { return code&kMaxCodedPower; }
+  inline UShort_t CodeSum(UShort_t a, UShort_t b)
+  {
+    return Code(CodeHarmonic(a)+CodeHarmonic(b),CodePower(a)+CodePower(b));
+  }
+  inline void SortCodes(Int_t n, UShort_t* codes)
+  {
+    // insertion sort, n <= 8
+    for (Int_t i=1; i<n; i++)
+    {
+      UShort_t c = codes[i];
+      Int_t j = i-1;
+      while (j>=0 && codes[j]>c) { codes[j+1] = codes[j]; j--; }
+      codes[j+1] = c;
+    }
+  }
+}
+
+//________________________________________________________________________
+
+AliFlowGenericCorrelator::AliFlowGenericCorrelator():
+  TObject(),
+  fNHarmonics(0),
+  fNPowers(0),
+  fReQ(),
+  fImQ(),
+  fUseCache(kTRUE),
+  fCapacity(0),
+  fNEntries(0),
+  fGeneration(1),
+  fKeys(),
+  fValues(),
+  fStamps()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowGenericCorrelator::~AliFlowGenericCorrelator()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Load(const TComplex* qvector, Int_t nHarmonics, Int_t nPowers, Int_t stride)
+{
+  // copy the Q-vector table of the current event, qvector[h*stride+p] = Q_{h,p},
+  // the rows of qvector can be longer than nPowers (stride 0 means nPowers)
+  if (stride==0) stride = nPowers;
+  if (nHarmonics>kHarmonicOffset || nPowers>kMaxCodedPower+1 || stride<nPowers)
+  {
+    Error("Load","Q-vector table %d x %d too large",nHarmonics,nPowers);
+    fNHarmonics = 0;
+    return;
+  }
+  fNHarmonics = nHarmonics;
+  fNPowers = nPowers;
+  if (fReQ.GetSize()<nHarmonics*nPowers) { fReQ.Set(nHarmonics*nPowers); fImQ.Set(nHarmonics*nPowers); }
+  for (Int_t h=0; h<nHarmonics; h++)
+  {
+    for (Int_t p=0; p<nPowers; p++)
+    {
+      fReQ[h*nPowers+p] = qvector[h*stride+p].Re();
+      fImQ[h*nPowers+p] = qvector[h*stride+p].Im();
+    }
+  }
+  Invalidate();
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Load(const AliFlowQVectorEngine* engine)
+{
+  // copy the Q-vectors held by engine
+  Int_t nHarmonics = engine->GetMaxHarmonic()+1;
+  Int_t nPowers = TMath::Min(engine->GetMaxPower()+1,kMaxCodedPower+1);
+  if (nHarmonics>kHarmonicOffset)
+  {
+    Error("Load","Q-vector table %d x %d too large",nHarmonics,nPowers);
+    fNHarmonics = 0;
+    return;
+  }
+  fNHarmonics = nHarmonics;
+  fNPowers = nPowers;
+  if (fReQ.GetSize()<nHarmonics*nPowers) { fReQ.Set(nHarmonics*nPowers); fImQ.Set(nHarmonics*nPowers); }
+  for (Int_t h=0; h<nHarmonics; h++)
+  {
+    for (Int_t p=0; p<nPowers; p++)
+    {
+      fReQ[h*nPowers+p] = engine->ReQ(h,p);
+      fImQ[h*nPowers+p] = engine->ImQ(h,p);
+    }
+  }
+  Invalidate();
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Invalidate()
+{
+  // forget all memoized correlators; the table is kept, its slots are
+  // emptied by moving to the next generation
+  fNEntries = 0;
+  if (++fGeneration==kMaxInt)
+  {
+    fStamps.Reset();
+    fGeneration = 1;
+  }
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Correlator(Int_t n, const Int_t* harmonics, const Int_t* powers)
+{
+  // n-particle correlator with harmonics h_1..h_n and weight powers p_1..p_n (all 1 by default)
+  if (n==0) return TComplex(1.,0.);
+  if (n<0 || n>kMaxOrder)
+  {
+    Error("Correlator","%d-particle correlators are not supported",n);
+    return TComplex(0.,0.);
+  }
+
+  // every Q-vector reached by the recursion has |h| <= sum|h_j| and p <= sum p_j
+  Int_t sumH = 0, sumP = 0;
+  for (Int_t j=0; j<n; j++)
+  {
+    Int_t p = powers ? powers[j] : 1;
+    if (p<0) { Error("Correlator","negative weight power %d",p); return TComplex(0.,0.); }
+    sumH += TMath::Abs(harmonics[j]);
+    sumP += p;
+  }
+  if (sumH>=fNHarmonics || sumP>=fNPowers)
+  {
+    Error("Correlator","Q-vector table (%d harmonics, %d powers) too small for sum|h| = %d, sum p = %d",fNHarmonics,fNPowers,sumH,sumP);
+    return TComplex(0.,0.);
+  }
+  UShort_t codes[kMaxOrder];
+  for (Int_t j=0; j<n; j++)
+  {
+    codes[j] = Code(harmonics[j],powers ? powers[j] : 1);
+  }
+  SortCodes(n,codes);
+  return Evaluate(n,codes);
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Correlators(Int_t nTuples, Int_t n, const Int_t* harmonics, TComplex* results)
+{
+  // n-particle correlators (unit weight powers) for nTuples harmonic tuples stored back to back;
+  // sub-terms common to the tuples are computed once
+  for (Int_t t=0; t<nTuples; t++)
+  {
+    results[t] = Correlator(n,harmonics+t*n);
+  }
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Evaluate(Int_t n, const UShort_t* codes)
+{
+  // correlator of the sorted codes; removing the last pair a gives
+  //   S(P) = Q(a)*S(P\a) - sum_{b in P\a} S(P\{a,b} + {a+b}),
+  // identical pairs b give identical terms and are counted once with their multiplicity
+  UShort_t a = codes[n-1];
+  if (n==1) return Q(CodeHarmonic(a),CodePower(a));
+
+  Long64_t key0 = 0, key1 = 0;
+  if (fUseCache)
+  {
+    for (Int_t j=0; j<n && j<4; j++) key0 |= (Long64_t)(((ULong64_t)codes[j])<<(16*j));
+    for (Int_t j=4; j<n; j++) key1 |= (Long64_t)(((ULong64_t)codes[j])<<(16*(j-4)));
+    Int_t slot = Slot(key0,key1);
+    if (slot>=0 && fStamps[slot]==fGeneration)
+    {
+      return TComplex(fValues[2*slot],fValues[2*slot+1]);
+    }
+  }
+
+  TComplex value = Q(CodeHarmonic(a),CodePower(a))*Evaluate(n-1,codes);
+  UShort_t merged[kMaxOrder];
+  for (Int_t j=0; j<n-1; j++)
+  {
+    if (j>0 && codes[j]==codes[j-1]) continue;
+    Int_t multiplicity = 1;
+    while (j+multiplicity<n-1 && codes[j+multiplicity]==codes[j]) multiplicity++;
+    Int_t m = 0;
+    for (Int_t k=0; k<n-1; k++)
+    {
+      if (k!=j) merged[m++] = codes[k];
+    }
+    merged[m++] = CodeSum(a,codes[j]);
+    SortCodes(m,merged);
+    if (multiplicity==1) value -= Evaluate(m,merged);
+    else value -= Double_t(multiplicity)*Evaluate(m,merged);
+  }
+
+  if (fUseCache) Store(key0,key1,value);
+  return value;
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowGenericCorrelator::Slot(Long64_t key0, Long64_t key1) const
+{
+  // slot holding the key, or the empty slot where it would be stored (-1 if no table yet)
+  if (fCapacity==0) return -1;
+  ULong64_t hash = (ULong64_t)key0*0x9E3779B97F4A7C15ULL ^ (ULong64_t)key1*0xC2B2AE3D27D4EB4FULL;
+  hash ^= hash>>29;
+  Int_t mask = fCapacity-1;
+  Int_t slot = (Int_t)(hash&(ULong64_t)mask);
+  while (fStamps[slot]==fGeneration)
+  {
+    if (fKeys[2*slot]==key0 && fKeys[2*slot+1]==key1) return slot;
+    slot = (slot+1)&mask;
+  }
+  return slot;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Store(Long64_t key0, Long64_t key1, const TComplex& value)
+{
+  // memoize value; the table is kept at most half full
+  if (2*(fNEntries+1)>fCapacity) Grow();
+  Int_t slot = Slot(key0,key1);
+  if (fStamps[slot]!=fGeneration) fNEntries++;
+  fStamps[slot] = fGeneration;
+  fKeys[2*slot] = key0;
+  fKeys[2*slot+1] = key1;
+  fValues[2*slot] = value.Re();
+  fValues[2*slot+1] = value.Im();
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Grow()
+{
+  // double the hash table and re-insert the entries of the current event
+  TArrayL64 keys(fKeys);
+  TArrayD values(fValues);
+  TArrayI stamps(fStamps);
+  Int_t capacity = fCapacity;
+
+  fCapacity = capacity>0 ? 2*capacity : kInitialCapacity;
+  fKeys.Set(2*fCapacity);
+  fValues.Set(2*fCapacity);
+  fStamps.Set(fCapacity);
+  fStamps.Reset();
+  fNEntries = 0;
+  for (Int_t i=0; i<capacity; i++)
+  {
+    if (stamps[i]!=fGeneration) continue;
+    Int_t slot = Slot(keys[2*i],keys[2*i+1]);
+    fStamps[slot] = fGeneration;
+    fKeys[2*slot] = keys[2*i];
+    fKeys[2*slot+1] = keys[2*i+1];
+    fValues[2*slot] = values[2*i];
+    fValues[2*slot+1] = values[2*i+1];
+    fNEntries++;
+  }
+}
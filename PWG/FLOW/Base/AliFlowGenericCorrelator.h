@@ -0,0 +1,86 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWGENERICCORRELATOR_H
+#define ALIFLOWGENERICCORRELATOR_H
+
+#include "TObject.h"
+#include "TComplex.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
+
+class AliFlowQVectorEngine;
+
+//********************************************************************
+// AliFlowGenericCorrelator:                                         *
+// Generic framework multi-particle correlators                      *
+//   sum_{k1!=k2!=...!=kn} prod_j w_kj^pj exp(i*hj*phi_kj)            *
+// from Q-vectors Q_{h,p}, for arbitrary tuples of up to 8 particles.*
+// A correlator over the set P of (harmonic,power) pairs follows     *
+// from removing one pair a:                                         *
+//   S(P) = Q(a)*S(P\a) - sum_{b in P\a} S(P\{a,b} + {a+b})           *
+// Every S(P) is memoized per event under a canonical (sorted) key,  *
+// so sub-terms shared between requested tuples, the cos/sin parts   *
+// and the all-zero-harmonics weights are evaluated only once.       *
+//********************************************************************
+
+class AliFlowGenericCorrelator: public TObject {
+
+ public:
+
+  enum { kMaxOrder=8 };
+
+  AliFlowGenericCorrelator();
+  virtual ~AliFlowGenericCorrelator();
+
+  // Q-vectors of the current event; clears the memoized correlators:
+  void     Load(const TComplex* qvector, Int_t nHarmonics, Int_t nPowers, Int_t stride=0); // qvector[h*stride+p], h,p >= 0, stride nPowers if 0
+  void     Load(const AliFlowQVectorEngine* engine);
+  void     Invalidate();                     // forget memoized results (Q-vectors changed)
+  void     Reset() { fNHarmonics=0; Invalidate(); } // drop the Q-vectors as well
+
+  // Correlators (not normalized, divide by the one with all harmonics zero):
+  TComplex Correlator(Int_t n, const Int_t* harmonics, const Int_t* powers=NULL);
+  void     Correlators(Int_t nTuples, Int_t n, const Int_t* harmonics, TComplex* results); // harmonics[t*n+j]
+
+  void     SetUseCache(Bool_t use)           { fUseCache = use; }
+  Bool_t   GetUseCache() const               { return fUseCache; }
+  Int_t    GetNumberOfCachedTerms() const    { return fNEntries; }
+  Bool_t   IsLoaded() const                  { return fNHarmonics>0; }
+
+ private:
+
+  AliFlowGenericCorrelator(const AliFlowGenericCorrelator& other);
+  AliFlowGenericCorrelator& operator=(const AliFlowGenericCorrelator& other);
+
+  TComplex Q(Int_t h, Int_t p) const;
+  TComplex Evaluate(Int_t n, const UShort_t* codes);
+  Int_t    Slot(Long64_t key0, Long64_t key1) const;
+  void     Store(Long64_t key0, Long64_t key1, const TComplex& value);
+  void     Grow();
+
+  Int_t     fNHarmonics;   // number of harmonics in the Q-vector table (0..fNHarmonics-1)
+  Int_t     fNPowers;      // number of weight powers in the Q-vector table (0..fNPowers-1)
+  TArrayD   fReQ;          //! Re[Q_{h,p}], index h*fNPowers+p
+  TArrayD   fImQ;          //! Im[Q_{h,p}], index h*fNPowers+p
+  Bool_t    fUseCache;     // memoize correlators within the event
+  Int_t     fCapacity;     // number of slots in the hash table (power of 2)
+  Int_t     fNEntries;     // number of occupied slots in the current event
+  Int_t     fGeneration;   // slots stamped with another generation are empty
+  TArrayL64 fKeys;         //! [2*fCapacity] packed canonical (harmonic,power) codes
+  TArrayD   fValues;       //! [2*fCapacity] memoized Re and Im
+  TArrayI   fStamps;       //! [fCapacity] generation stamp of each slot
+
+  ClassDef(AliFlowGenericCorrelator,1)
+};
+
+inline TComplex AliFlowGenericCorrelator::Q(Int_t h, Int_t p) const
+{
+  // Q_{h,p}, using Q_{-h,p} = Q_{h,p}^*
+  if (h>=0) return TComplex(fReQ[h*fNPowers+p],fImQ[h*fNPowers+p]);
+  return TComplex(fReQ[-h*fNPowers+p],-fImQ[-h*fNPowers+p]);
+}
+
+#endif
@@ -0,0 +1,237 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorEngine.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Shared per-event Q-vector builder for the flow methods.           *
+//********************************************************************
+
+ClassImp(AliFlowQVectorEngine)
+
+namespace {
+  const Int_t kBlockSize = 32; // tracks processed together in the vectorized loops
+  const Int_t kMaxPower = 15;  // highest supported weight power
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine():
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fReQ(1),
+  fImQ(1),
+  fPhi(),
+  fWeight(),
+  fNTracks(0),
+  fFilled(kFALSE),
+  fUnitWeights(kTRUE),
+  fEvent(NULL),
+  fEventTrackWeights(kFALSE)
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine(Int_t maxHarmonic, Int_t maxPower):
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fReQ(1),
+  fImQ(1),
+  fPhi(),
+  fWeight(),
+  fNTracks(0),
+  fFilled(kFALSE),
+  fUnitWeights(kTRUE),
+  fEvent(NULL),
+  fEventTrackWeights(kFALSE)
+{
+  // constructor reserving harmonics 0..maxHarmonic and weight powers 0..maxPower
+  Require(maxHarmonic,maxPower);
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::~AliFlowQVectorEngine()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::Require(Int_t maxHarmonic, Int_t maxPower)
+{
+  // make sure harmonics up to maxHarmonic and weight powers up to maxPower
+  // are available; the range never shrinks so that several methods with
+  // different needs can share the engine
+  if (maxPower>kMaxPower)
+  {
+    Warning("Require","weight power %d not supported, using %d",maxPower,kMaxPower);
+    maxPower = kMaxPower;
+  }
+  if (maxHarmonic<=fMaxHarmonic && maxPower<=fMaxPower) return;
+  fMaxHarmonic = TMath::Max(maxHarmonic,fMaxHarmonic);
+  fMaxPower = TMath::Max(maxPower,fMaxPower);
+  fReQ.Set((fMaxHarmonic+1)*(fMaxPower+1));
+  fImQ.Set((fMaxHarmonic+1)*(fMaxPower+1));
+  fFilled = kFALSE;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::Reset()
+{
+  // zero all Q-vector components
+  fReQ.Reset();
+  fImQ.Reset();
+  fNTracks = 0;
+}
+
+//________________________________________________________________________
+
+Bool_t AliFlowQVectorEngine::Fill(AliFlowEventSimple* anEvent, Bool_t useTrackWeights)
+{
+  // build the Q-vectors of the reference particles of anEvent
+  // returns kFALSE if the Q-vectors cached for this event could be reused
+  if (!anEvent) return kFALSE;
+
+  // the cached Q-vectors are reused only if they were built from exactly
+  // the same RPs, since tracks and tags can be changed through GetTrack()
+  // without the event knowing about it
+  Int_t nTracks = anEvent->NumberOfTracks();
+  if (fFilled && fEvent==anEvent && fEventTrackWeights==useTrackWeights)
+  {
+    const Double_t* phi = fPhi.GetArray();
+    const Double_t* weight = fWeight.GetArray();
+    Int_t nRPs = 0;
+    Bool_t same = kTRUE;
+    for (Int_t i=0; i<nTracks && same; i++)
+    {
+      const AliFlowTrackSimple* track = anEvent->GetTrack(i);
+      if (!track || !track->InRPSelection()) continue;
+      same = (nRPs<fNTracks && phi[nRPs]==track->Phi() &&
+              (!useTrackWeights || weight[nRPs]==track->Weight()));
+      nRPs++;
+    }
+    if (same && nRPs==fNTracks) return kFALSE;
+  }
+
+  // gather the RPs into the buffers
+  if (fPhi.GetSize()<nTracks) { fPhi.Set(nTracks); fWeight.Set(nTracks); }
+  Double_t* phi = fPhi.GetArray();
+  Double_t* weight = fWeight.GetArray();
+  Int_t nRPs = 0;
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    const AliFlowTrackSimple* track = anEvent->GetTrack(i);
+    if (!track || !track->InRPSelection()) continue;
+    phi[nRPs] = track->Phi();
+    weight[nRPs] = track->Weight();
+    nRPs++;
+  }
+  Fill(nRPs,phi,useTrackWeights?weight:NULL);
+
+  fEvent = anEvent;
+  fEventTrackWeights = useTrackWeights;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::Fill(Int_t nTracks, const Double_t* phi, const Double_t* weight)
+{
+  // build the Q-vectors from explicit angles and (optional) weights
+  // this invalidates any event cached by Fill(AliFlowEventSimple*)
+  Reset();
+  fEvent = NULL;
+  fUnitWeights = (weight==NULL);
+  for (Int_t first=0; first<nTracks; first+=kBlockSize)
+  {
+    Int_t n = TMath::Min(kBlockSize,nTracks-first);
+    ProcessBlock(n,phi+first,weight?weight+first:NULL);
+  }
+  fNTracks = nTracks;
+  if (fUnitWeights)
+  {
+    // w^p = 1 for all p: copy the p=0 sums
+    for (Int_t h=0; h<=fMaxHarmonic; h++)
+    {
+      Int_t row = h*(fMaxPower+1);
+      for (Int_t p=1; p<=fMaxPower; p++)
+      {
+        fReQ[row+p] = fReQ[row];
+        fImQ[row+p] = fImQ[row];
+      }
+    }
+  }
+  fFilled = kTRUE;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::ProcessBlock(Int_t n, const Double_t* phi, const Double_t* weight)
+{
+  // accumulate up to kBlockSize tracks; the loops over i carry no
+  // dependencies and are left to the compiler to vectorize
+  Double_t c1[kBlockSize], s1[kBlockSize]; // cos(phi), sin(phi)
+  Double_t ch[kBlockSize], sh[kBlockSize]; // cos(h*phi), sin(h*phi)
+  Int_t nPowers = fUnitWeights ? 1 : fMaxPower+1;
+  Double_t wp[kMaxPower+1][kBlockSize];    // w^p
+  for (Int_t i=0; i<n; i++)
+  {
+    c1[i] = TMath::Cos(phi[i]);
+    s1[i] = TMath::Sin(phi[i]);
+    ch[i] = 1.;
+    sh[i] = 0.;
+    wp[0][i] = 1.;
+  }
+  for (Int_t p=1; p<nPowers; p++)
+  {
+    for (Int_t i=0; i<n; i++) wp[p][i] = wp[p-1][i]*weight[i];
+  }
+
+  Double_t* reQ = fReQ.GetArray();
+  Double_t* imQ = fImQ.GetArray();
+  for (Int_t h=0; h<=fMaxHarmonic; h++)
+  {
+    Int_t row = h*(fMaxPower+1);
+    for (Int_t p=0; p<nPowers; p++)
+    {
+      const Double_t* w = wp[p];
+      Double_t re = 0., im = 0.;
+      for (Int_t i=0; i<n; i++)
+      {
+        re += w[i]*ch[i];
+        im += w[i]*sh[i];
+      }
+      reQ[row+p] += re;
+      imQ[row+p] += im;
+    }
+    // angle addition: (h+1)*phi from h*phi and phi
+    for (Int_t i=0; i<n; i++)
+    {
+      Double_t c = ch[i]*c1[i]-sh[i]*s1[i];
+      sh[i] = sh[i]*c1[i]+ch[i]*s1[i];
+      ch[i] = c;
+    }
+  }
+}
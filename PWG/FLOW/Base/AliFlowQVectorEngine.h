@@ -0,0 +1,77 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORENGINE_H
+#define ALIFLOWQVECTORENGINE_H
+
+#include "TObject.h"
+#include "TArrayD.h"
+#include "TComplex.h"
+
+class AliFlowEventSimple;
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Computes the reference particle Q-vectors                         *
+//   Q_{h,p} = sum_i w_i^p exp(i*h*phi_i),  h = 0..H, p = 0..P       *
+// once per event. Higher harmonics are obtained from cos(phi) and   *
+// sin(phi) via angle-addition recurrences and weight powers by      *
+// iterative multiplication, processed in blocks of tracks so that   *
+// the inner loops vectorize. The engine attached to an              *
+// AliFlowEventSimple is shared by all flow methods analysing that   *
+// event, so the per-track cost is paid only once.                   *
+//********************************************************************
+
+class AliFlowQVectorEngine: public TObject {
+
+ public:
+
+  AliFlowQVectorEngine();
+  AliFlowQVectorEngine(Int_t maxHarmonic, Int_t maxPower);
+  virtual ~AliFlowQVectorEngine();
+
+  void     Require(Int_t maxHarmonic, Int_t maxPower);   // grow the harmonic/power range if needed
+  Bool_t   Fill(AliFlowEventSimple* anEvent, Bool_t useTrackWeights=kFALSE); // RPs of anEvent, recomputed only if needed
+  void     Fill(Int_t nTracks, const Double_t* phi, const Double_t* weight=NULL); // explicit angles and weights
+  void     Invalidate() { fFilled=kFALSE; }
+
+  Int_t    GetMaxHarmonic() const                  { return fMaxHarmonic; }
+  Int_t    GetMaxPower() const                     { return fMaxPower; }
+  Int_t    GetNumberOfTracks() const               { return fNTracks; }
+  Double_t ReQ(Int_t h, Int_t p=0) const           { return fReQ[h*(fMaxPower+1)+p]; }
+  Double_t ImQ(Int_t h, Int_t p=0) const           { return fImQ[h*(fMaxPower+1)+p]; }
+  Double_t SumOfWeights(Int_t p=1) const           { return fReQ[p]; } // = Re[Q_{0,p}]
+  TComplex Q(Int_t h, Int_t p=0) const;            // Q_{-h,p} = Q_{h,p}^*
+
+ private:
+
+  AliFlowQVectorEngine(const AliFlowQVectorEngine& other);
+  AliFlowQVectorEngine& operator=(const AliFlowQVectorEngine& other);
+
+  void     Reset();
+  void     ProcessBlock(Int_t nTracks, const Double_t* phi, const Double_t* weight);
+
+  Int_t    fMaxHarmonic;        // highest harmonic H held in the Q-vectors
+  Int_t    fMaxPower;           // highest weight power P held in the Q-vectors
+  TArrayD  fReQ;                // Re[Q_{h,p}], index h*(P+1)+p
+  TArrayD  fImQ;                // Im[Q_{h,p}], index h*(P+1)+p
+  TArrayD  fPhi;                //! buffer of RP azimuthal angles of the current event
+  TArrayD  fWeight;             //! buffer of RP weights of the current event
+  Int_t    fNTracks;            // number of RPs entering the Q-vectors
+  Bool_t   fFilled;             // Q-vectors are valid for the cached event
+  Bool_t   fUnitWeights;        // all weights are one, only p=0 needs to be summed
+  const AliFlowEventSimple* fEvent; //! event the Q-vectors were computed for (not owned)
+  Bool_t   fEventTrackWeights;  //! track weights were used when filling for fEvent
+
+  ClassDef(AliFlowQVectorEngine,2)
+};
+
+inline TComplex AliFlowQVectorEngine::Q(Int_t h, Int_t p) const
+{
+  // Q_{h,p}, using Q_{-h,p} = Q_{h,p}^* for negative harmonics
+  if (h>=0) return TComplex(ReQ(h,p),ImQ(h,p));
+  return TComplex(ReQ(-h,p),-ImQ(-h,p));
+}
+
+#endif
@@ -10,6 +10,9 @@
 #pragma link C++ class AliFlowVector+;
 #pragma link C++ class AliFlowTrackSimple+;
 #pragma link C++ class AliFlowEventSimple+;
+#pragma link C++ class AliFlowQVectorEngine+;
+#pragma link C++ class AliFlowGenericCorrelator+;
+#pragma link C++ class AliFlowBootstrapMoments+;
 
 #pragma link C++ class AliStarTrack+;
 #pragma link C++ class AliStarEvent+;
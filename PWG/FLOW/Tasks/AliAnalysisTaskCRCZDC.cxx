@@ -908,6 +908,7 @@ void AliAnalysisTaskCRCZDC::UserExec(Option_t */*option*/)
   if (numTracks==0) return;
 
   TObject *head = aod->GetHeader();
+  if(head->InheritsFrom("AliNanoAODStorage")) AliNanoAODTrack::UpdateMappingCache(); // the track getters read the cached mapping indices
   Int_t RunBin=-1, bin=0, RunNum=-1;
 
   if(!head->InheritsFrom("AliNanoAODStorage")){ //no nanoAOD
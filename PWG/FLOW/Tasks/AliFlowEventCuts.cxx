@@ -342,6 +342,7 @@ Bool_t AliFlowEventCuts::PassesCuts(AliVEvent *event, AliMCEvent *mcevent)
     //NanoAOD cuts
     if(header && header->InheritsFrom("AliNanoAODStorage")){
         AliNanoAODHeader *nanoAodHeader = (AliNanoAODHeader*) header;
+        AliNanoAODTrack::UpdateMappingCache(); // the track getters read the cached mapping indices
 
         if(fCheckPileUp){
             Int_t pilepIndex = nanoAodHeader->GetVarIndex("cstPileUp");
@@ -32,6 +32,9 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TRandom3.h>
+#include <vector>
+#include <thread>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +175,11 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fRandom(0),
+  fCellStart(),
+  fCellNucleons(),
+  fNucleonCell()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +329,11 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fRandom(in.fRandom),
+  fCellStart(),
+  fCellNucleons(),
+  fNucleonCell()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,6 +464,7 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fRandom=in.fRandom;
   return *this;
 }
 
@@ -511,30 +523,92 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
-  // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
+  // The nucleons of B are sorted into a grid in the transverse plane with cells
+  // at least as large as the largest interaction distance, so that only the 3x3
+  // cells around each nucleon of A have to be checked instead of all fAN x fBN pairs.
+  const Double_t *xA = fANucleus.GetPosX();
+  const Double_t *yA = fANucleus.GetPosY();
+  const Double_t *xB = fBNucleus.GetPosX();
+  const Double_t *yB = fBNucleus.GetPosY();
+  Double_t d2Max = d2;
+  if (fDoFluc) {
+    Double_t sigMax = 0;
+    for (Int_t i = 0; i<fAN; i++)
+      sigMax = TMath::Max(sigMax,((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i)))->GetSigNN());
+    for (Int_t i = 0; i<fBN; i++)
+      sigMax = TMath::Max(sigMax,((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->GetSigNN());
+    d2Max = sigMax/(TMath::Pi()*10);
+    // the pair loop used to leave the cross section of the last pair in fXSect
+    if (fAN>0 && fBN>0)
+      fXSect = TMath::Max(((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fAN-1)))->GetSigNN(),
+                          ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(fBN-1)))->GetSigNN());
+  }
+
+  if (d2Max>0 && fAN>0 && fBN>0)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+    const Int_t kMaxCells = 64; // cells per dimension
+    Double_t xmin = xB[0], xmax = xB[0], ymin = yB[0], ymax = yB[0];
+    for (Int_t i = 1; i<fBN; i++)
+    {
+      xmin = TMath::Min(xmin,xB[i]); xmax = TMath::Max(xmax,xB[i]);
+      ymin = TMath::Min(ymin,yB[i]); ymax = TMath::Max(ymax,yB[i]);
+    }
+    Double_t cell = TMath::Max(TMath::Sqrt(d2Max)*(1+1e-9),TMath::Max(xmax-xmin,ymax-ymin)/kMaxCells);
+    Int_t nx = Int_t((xmax-xmin)/cell)+1;
+    Int_t ny = Int_t((ymax-ymin)/cell)+1;
+
+    // counting sort of the nucleons of B into the cells
+    fCellStart.Set(nx*ny+1);
+    fCellStart.Reset();
+    if (fCellNucleons.GetSize()<fBN) {fCellNucleons.Set(fBN); fNucleonCell.Set(fBN);}
+    Int_t *start = fCellStart.GetArray();
+    Int_t *sorted = fCellNucleons.GetArray();
+    Int_t *cellOf = fNucleonCell.GetArray();
+    for (Int_t i = 0; i<fBN; i++)
+    {
+      Int_t ix = TMath::Min(Int_t((xB[i]-xmin)/cell),nx-1);
+      Int_t iy = TMath::Min(Int_t((yB[i]-ymin)/cell),ny-1);
+      cellOf[i] = iy*nx+ix;
+      start[cellOf[i]+1]++;
+    }
+    for (Int_t c = 0; c<nx*ny; c++) start[c+1] += start[c];
+    for (Int_t i = 0; i<fBN; i++) sorted[start[cellOf[i]]++] = i;
+    for (Int_t c = nx*ny; c>0; c--) start[c] = start[c-1];
+    start[0] = 0;
+
     for (Int_t j = 0 ; j < fAN ; j++)
     {
+      Int_t ix = Int_t(TMath::Floor((xA[j]-xmin)/cell));
+      Int_t iy = Int_t(TMath::Floor((yA[j]-ymin)/cell));
+      if (ix<-1 || ix>nx || iy<-1 || iy>ny) continue;
       AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
+      for (Int_t cy = TMath::Max(iy-1,0); cy <= TMath::Min(iy+1,ny-1); cy++)
       {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
+        for (Int_t cx = TMath::Max(ix-1,0); cx <= TMath::Min(ix+1,nx-1); cx++)
+        {
+          Int_t c = cy*nx+cx;
+          for (Int_t k = start[c]; k < start[c+1]; k++)
+          {
+            Int_t i = sorted[k];
+            Double_t dx = xB[i]-xA[j];
+            Double_t dy = yB[i]-yA[j];
+            Double_t dij = dx*dx+dy*dy;
+            if (dij >= d2Max) continue;
+            AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+            Double_t d2Pair = d2;
+            if (fDoFluc)
+              d2Pair = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN())/(TMath::Pi()*10); // in fm^2
+            if (dij < d2Pair)
+            {
+              bNN += dij;
+              ++Nco;
+              nucleonB->Collide();
+              nucleonA->Collide();
+              if (dij<d2Pair/4)
+                ++Ncohc;
+            }
+          }
+        }
       }
     }
   }
@@ -1267,7 +1341,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = Rnd()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1352,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=Rnd()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1382,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = Rnd()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1580,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*Rnd()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1682,18 +1756,90 @@ Double_t AliGlauberMC::GetPsi4m2() const
 }
 */
 //______________________________________________________________________________
-void AliGlauberMC::Run(Int_t nevents)
+void AliGlauberMC::BookNtuple()
 {
-  //example run
-  cout << "Generating " << nevents << " events..." << endl;
+  //create the result ntuple if needed
+  if (fnt) return;
   TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
-  if (fnt == 0)
+  fnt = new TNtuple(name,title,
+                    "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+  fnt->SetDirectory(0);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FillNtupleRow(Float_t *v)
+{
+  //fill the 48 ntuple variables of the current event
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
   }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::Run(Int_t nevents)
+{
+  //example run
+  cout << "Generating " << nevents << " events..." << endl;
+  BookNtuple();
   Int_t q = 0;
   Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
@@ -1707,67 +1853,7 @@ void AliGlauberMC::Run(Int_t nevents)
 
     q++;
     Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
-    {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
-    }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    FillNtupleRow(v);
 
     //always at the end
     fnt->Fill(v);
@@ -1777,6 +1863,113 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::GenerateEvents(Int_t nevents, Float_t *rows, Int_t &naccepted)
+{
+  //generate nevents events, the ntuple rows of the accepted ones are written to rows
+  naccepted = 0;
+  for (Int_t i = 0; i<nevents; i++)
+  {
+    if(!NextEvent()) continue;
+    FillNtupleRow(rows+48*naccepted);
+    naccepted++;
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunParallel(Int_t nevents, Int_t nworkers, UInt_t seed)
+{
+  // Same as Run(), with the events generated by nworkers threads (0: one per core).
+  // Every worker owns a copy of the generator with its own TRandom3 stream
+  // (seeded with seed+1+worker, or uniquely in space and time for seed=0) and
+  // radii drawn from a tabulated rho(r). The events are produced in rounds and
+  // the rows are appended to the ntuple in worker order, so that the output is
+  // reproducible for a given seed and number of workers.
+  // With fluctuating cross sections TF1::GetRandom (gRandom) is needed per
+  // nucleon, then the events are generated sequentially.
+  if (fDoFluc)
+  {
+    Warning("RunParallel","cross section fluctuations use gRandom, running sequentially");
+    Run(nevents);
+    return;
+  }
+  if (nworkers<=0) nworkers = std::thread::hardware_concurrency();
+  if (nworkers<=0) nworkers = 1;
+  cout << "Generating " << nevents << " events with " << nworkers << " workers..." << endl;
+  BookNtuple();
+
+  // set up the workers in this thread, nothing below touches ROOT globals
+  std::vector<AliGlauberMC*> workers(nworkers);
+  std::vector<TRandom3*> randoms(nworkers);
+  for (Int_t w = 0; w<nworkers; w++)
+  {
+    AliGlauberMC *mc = new AliGlauberMC(fANucleus.GetName(),fBNucleus.GetName(),fXSect);
+    AliGlauberNucleus *nuc[2]   = {&mc->fANucleus,&mc->fBNucleus};
+    AliGlauberNucleus *model[2] = {&fANucleus,&fBNucleus};
+    for (Int_t k = 0; k<2; k++)
+    {
+      nuc[k]->SetR(model[k]->GetR());
+      nuc[k]->SetA(model[k]->GetA());
+      nuc[k]->SetW(model[k]->GetW());
+      nuc[k]->SetMinDist(model[k]->GetMinDist());
+      nuc[k]->TabulateRadius();
+      nuc[k]->CreateNucleons();
+    }
+    mc->fBMin = fBMin;
+    mc->fBMax = fBMax;
+    mc->fMultType = fMultType;
+    memcpy(mc->fdNdEtaParam,fdNdEtaParam,sizeof(fdNdEtaParam));
+    mc->fDoPartProd = fDoPartProd;
+    randoms[w] = new TRandom3(seed ? seed+1+w : 0);
+    mc->SetRandom(randoms[w]);
+    workers[w] = mc;
+  }
+
+  const Int_t kEventsPerRound = 10000; // per worker, bounds the memory for the buffered rows
+  std::vector< std::vector<Float_t> > rows(nworkers,std::vector<Float_t>(48*kEventsPerRound));
+  std::vector<Int_t> accepted(nworkers);
+  Int_t q = 0;
+  Int_t done = 0;
+  while (done<nevents)
+  {
+    Int_t nround = TMath::Min(nevents-done,nworkers*kEventsPerRound);
+    std::vector<std::thread> threads;
+    for (Int_t w = 0; w<nworkers; w++)
+    {
+      Int_t nw = nround/nworkers + (w < nround%nworkers ? 1 : 0);
+      threads.push_back(std::thread([&workers,&rows,&accepted,w,nw]() {
+        workers[w]->GenerateEvents(nw,&rows[w][0],accepted[w]);
+      }));
+    }
+    for (Int_t w = 0; w<nworkers; w++)
+    {
+      threads[w].join();
+      for (Int_t i = 0; i<accepted[w]; i++) fnt->Fill(&rows[w][48*i]);
+      q += accepted[w];
+    }
+    done += nround;
+    std::cout << "Generating Event # " << done << "... \r" << flush;
+  }
+
+  // merge the counters used for the total cross section
+  for (Int_t w = 0; w<nworkers; w++)
+  {
+    fEvents += workers[w]->fEvents;
+    fTotalEvents += workers[w]->fTotalEvents;
+    fMaxNpartFound = TMath::Max(fMaxNpartFound,workers[w]->fMaxNpartFound);
+    delete workers[w];
+    delete randoms[w];
+  }
+  std::cout << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << nevents-q <<"."<< endl;
+}
+
+//______________________________________________________________________________
+TRandom *AliGlauberMC::Rnd() const
+{
+  //random generator of this instance
+  return fRandom ? fRandom : gRandom;
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
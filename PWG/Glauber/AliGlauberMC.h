@@ -16,9 +16,11 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <TArrayI.h>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -39,6 +41,7 @@ public:
    void         Draw(Option_t* option);
 
    void         Run(Int_t nevents);
+   void         RunParallel(Int_t nevents, Int_t nworkers=0, UInt_t seed=0);
    Bool_t       NextEvent(Double_t bgen=-1);
    Bool_t       CalcEvent(Double_t bgen);
 
@@ -96,6 +99,7 @@ public:
    void   SetBmax(Double_t bmax)      {fBMax = bmax;}
    void   SetMinDistance(Double_t d)  {fANucleus.SetMinDist(d); fBNucleus.SetMinDist(d);}
    void   SetDoPartProduction(Bool_t b) { fDoPartProd = b; }
+   void   SetRandom(TRandom *rnd)     {fRandom = rnd; fANucleus.SetRandom(rnd); fBNucleus.SetRandom(rnd);}
    void   Setr(Double_t r)  {fANucleus.SetR(r); fBNucleus.SetR(r);}
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
@@ -251,9 +255,17 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   TRandom     *fRandom;         //!random generator (gRandom if not set), not owned
+   TArrayI      fCellStart;      //!first entry of each grid cell in fCellNucleons
+   TArrayI      fCellNucleons;   //!nucleons of B sorted by grid cell
+   TArrayI      fNucleonCell;    //!grid cell of each nucleon of B
    Bool_t       CalcResults(Double_t bgen);
+   void         BookNtuple();
+   void         FillNtupleRow(Float_t *v);
+   void         GenerateEvents(Int_t nevents, Float_t *rows, Int_t &naccepted);
+   TRandom     *Rnd() const;
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -49,7 +49,12 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fPosX(),
+  fPosY(),
+  fPosZ(),
+  fRadiusCdf(),
+  fRandom(NULL)
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -77,7 +82,12 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fF(in.fF),
   fTrials(in.fTrials),
   fFunction(in.fFunction),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fPosX(in.fPosX),
+  fPosY(in.fPosY),
+  fPosZ(in.fPosZ),
+  fRadiusCdf(in.fRadiusCdf),
+  fRandom(in.fRandom)
 {
   //copy ctor
   if (in.fNucleons)
@@ -97,6 +107,11 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fF=in.fF;
   fTrials=in.fTrials;
   fFunction=in.fFunction;
+  fPosX=in.fPosX;
+  fPosY=in.fPosY;
+  fPosZ=in.fPosZ;
+  fRadiusCdf=in.fRadiusCdf;
+  fRandom=in.fRandom;
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -226,8 +241,50 @@ void AliGlauberNucleus::SetW(Double_t iw)
 }
 
 //______________________________________________________________________________
-void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
+void AliGlauberNucleus::TabulateRadius(Int_t nbins)
+{
+   // Tabulate the cumulative of rho(r) in nbins bins; the radii are then drawn by
+   // inverting the table with fRandom, without going through TF1::GetRandom (which
+   // always uses gRandom). Needed to generate events with independent random streams.
+   if (!fFunction || nbins<1) return;
+   Double_t xmin = fFunction->GetXmin();
+   Double_t xmax = fFunction->GetXmax();
+   Double_t dx = (xmax-xmin)/nbins;
+   fRadiusCdf.Set(nbins+1);
+   fRadiusCdf[0] = 0;
+   Double_t flow = TMath::Max(0.,fFunction->Eval(xmin));
+   for (Int_t i=1; i<=nbins; i++) {
+      Double_t fup = TMath::Max(0.,fFunction->Eval(xmin+i*dx));
+      fRadiusCdf[i] = fRadiusCdf[i-1] + 0.5*(flow+fup)*dx;
+      flow = fup;
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::RandomRadius()
+{
+   // radius distributed according to rho(r)
+   Int_t nbins = fRadiusCdf.GetSize()-1;
+   if (nbins<1) 
+      return fFunction->GetRandom();
+
+   TRandom *rnd = fRandom ? fRandom : gRandom;
+   const Double_t *cdf = fRadiusCdf.GetArray();
+   Double_t u = rnd->Rndm()*cdf[nbins];
+   Int_t bin = TMath::BinarySearch(nbins+1,cdf,u);
+   if (bin<0) bin = 0;
+   if (bin>=nbins) bin = nbins-1;
+   Double_t width = cdf[bin+1]-cdf[bin];
+   Double_t frac = (width>0) ? (u-cdf[bin])/width : 0.5;
+   Double_t xmin = fFunction->GetXmin();
+   Double_t xmax = fFunction->GetXmax();
+   return xmin + (bin+frac)*(xmax-xmin)/nbins;
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::CreateNucleons()
 {
+   // allocate the nucleons and their flat position arrays (done once)
    if (fNucleons==0) {
       fNucleons=new TObjArray(fN);
       fNucleons->SetOwner();
@@ -236,6 +293,17 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 	 fNucleons->Add(nucleon); 
       }
    } 
+   if (fPosX.GetSize()!=fN) {
+      fPosX.Set(fN);
+      fPosY.Set(fN);
+      fPosZ.Set(fN);
+   }
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
+{
+   CreateNucleons();
    
    fTrials = 0;
 
@@ -243,12 +311,17 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Double_t sumy=0;       
    Double_t sumz=0;       
 
+   TRandom *rnd = fRandom ? fRandom : gRandom;
+   Double_t *posx = fPosX.GetArray();
+   Double_t *posy = fPosY.GetArray();
+   Double_t *posz = fPosZ.GetArray();
+
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = RandomRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -261,45 +334,51 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon2->SetXYZ(-nucleon1->GetX() + 2*xshift,
 		       -nucleon1->GetY(),
 		       -nucleon1->GetZ());
+      for (Int_t i = 0; i<2; i++) {
+         AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
+         posx[i] = nucleon->GetX();
+         posy[i] = nucleon->GetY();
+         posz[i] = nucleon->GetZ();
+      }
       fTrials = 1;
       return;
    }
 
+   // the minimum distance check runs over the flat position arrays
+   Double_t minDist2 = fMinDist*fMinDist;
    for (Int_t i = 0; i<fN; i++) {
       AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
       nucleon->Reset();
+      Double_t x = 0, y = 0, z = 0;
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = RandomRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
-         Double_t x = r * stheta * cos(phi) + xshift;
-         Double_t y = r * stheta * sin(phi);      
-         Double_t z = r * ctheta;      
-         nucleon->SetXYZ(x,y,z);
+         x = r * stheta * cos(phi) + xshift;
+         y = r * stheta * sin(phi);      
+         z = r * ctheta;      
          if(fMinDist<0) break;
          Bool_t test=1;
          for (Int_t j = 0; j<i; j++) {
-            AliGlauberNucleon *other=(AliGlauberNucleon*)fNucleons->UncheckedAt(j);
-            Double_t xo=other->GetX();
-            Double_t yo=other->GetY();
-            Double_t zo=other->GetZ();
-            Double_t dist = TMath::Sqrt((x-xo)*(x-xo)+
-                                       (y-yo)*(y-yo)+
-                                       (z-zo)*(z-zo));
-	       
-            if(dist<fMinDist) {
+            Double_t dx = x-posx[j];
+            Double_t dy = y-posy[j];
+            Double_t dz = z-posz[j];
+            if(dx*dx+dy*dy+dz*dz<minDist2) {
                test=0;
                break;
             }
          }
          if (test) break; //found nucleuon outside of mindist
       }
+      posx[i] = x;
+      posy[i] = y;
+      posz[i] = z;
            
-      sumx += nucleon->GetX();
-      sumy += nucleon->GetY();
-      sumz += nucleon->GetZ();
+      sumx += x;
+      sumy += y;
+      sumz += z;
    }
       
    if(1) { // set the centre-of-mass to be at zero (+xshift)
@@ -308,10 +387,10 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       sumz = sumz/fN;  
       for (Int_t i = 0; i<fN; i++) {
          AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
-         nucleon->SetXYZ(nucleon->GetX()-sumx-xshift,
-                         nucleon->GetY()-sumy,
-                         nucleon->GetZ()-sumz);
+         posx[i] = posx[i]-sumx-xshift;
+         posy[i] = posy[i]-sumy;
+         posz[i] = posz[i]-sumz;
+         nucleon->SetXYZ(posx[i],posy[i],posz[i]);
       }
    }
 }
-
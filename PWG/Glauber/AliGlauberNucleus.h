@@ -16,8 +16,10 @@
 
 //class TNamed;
 #include <TNamed.h>
+#include <TArrayD.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,14 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TArrayD    fPosX;       //!x of the nucleons, flat copy kept in sync with fNucleons
+   TArrayD    fPosY;       //!y of the nucleons
+   TArrayD    fPosZ;       //!z of the nucleons
+   TArrayD    fRadiusCdf;  //!tabulated cumulative of fFunction (empty: use TF1::GetRandom)
+   TRandom*   fRandom;     //!random generator (gRandom if not set), not owned
 
    void       Lookup(Option_t* name);
+   Double_t   RandomRadius();
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -46,15 +54,22 @@ public:
    Double_t   GetA()             const {return fA;}
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
+   const Double_t *GetPosX()     const {return fPosX.GetArray();}
+   const Double_t *GetPosY()     const {return fPosY.GetArray();}
+   const Double_t *GetPosZ()     const {return fPosZ.GetArray();}
+   Double_t   GetMinDist()       const {return fMinDist;}
    Int_t      GetTrials()        const {return fTrials;}
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom *rnd)  {fRandom=rnd;}
+   void       TabulateRadius(Int_t nbins=2000);
+   void       CreateNucleons();
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
@@ -20,6 +20,7 @@
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
 #pragma link C++ class THistManager+;
+#pragma link C++ class THistManager::HistHandle;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
 #pragma link C++ class AliJSONValue+;
@@ -37,4 +38,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandles();
 #endif
@@ -39,17 +39,56 @@
 ClassImp(THistManager)
 /// \endcond
 
+namespace {
+
+/**
+ * Masks of histogram types accepted by the Fill methods
+ */
+const UInt_t kTypesTH1 = (1 << THistManager::HistHandle::kTH1) | (1 << THistManager::HistHandle::kTH2) |
+                         (1 << THistManager::HistHandle::kTH3) | (1 << THistManager::HistHandle::kTProfile);
+const UInt_t kTypesTH2 = 1 << THistManager::HistHandle::kTH2;
+const UInt_t kTypesTH3 = 1 << THistManager::HistHandle::kTH3;
+const UInt_t kTypesTHnSparse = 1 << THistManager::HistHandle::kTHnSparse;
+const UInt_t kTypesTProfile = 1 << THistManager::HistHandle::kTProfile;
+
+/**
+ * Convert the bin width option of the Fill methods ("wx", "wy", "wz",
+ * "w0", "w1", ..., "w" alone for x) into a bit mask of axes.
+ */
+UInt_t BinWidthMask(Option_t *opt){
+  UInt_t mask = 0;
+  if(!opt) return mask;
+  for(const char *c = opt; *c; c++){
+    if(*c != 'w' && *c != 'W') continue;
+    char axis = c[1];
+    if(axis == 'x' || axis == 'X') mask |= 1;
+    else if(axis == 'y' || axis == 'Y') mask |= 2;
+    else if(axis == 'z' || axis == 'Z') mask |= 4;
+    else if(axis >= '0' && axis <= '9') mask |= 1 << (axis - '0');
+    else mask |= 1;
+  }
+  return mask;
+}
+
+}
+
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fUseHandleCache(kTRUE),
+		fHandleCache(),
+		fNHandleCache(0)
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fUseHandleCache(kTRUE),
+		fHandleCache(),
+		fNHandleCache(0)
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -354,7 +393,7 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   return hsparse;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+TProfile* THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +401,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+TProfile* THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +412,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+TProfile* THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +423,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return hist;
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+TProfile* THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,222 +451,167 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	TH1 *hist = FindHandle(name, "THistManager::FillTH1", kTypesTH1).GetTH1();
+	if(!hist) return;
+	if(opt && opt[0]){
+	  TString optionstring(opt);
+	  if(optionstring.Contains("w")){
+	    // use bin width as weight
+	    Int_t bin = hist->GetXaxis()->FindBin(x);
+	    // check if not overflow or underflow bin
+	    if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	      weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	  }
 	}
 	hist->Fill(x, weight);
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  // get bin for label
-	  Int_t bin = hist->GetXaxis()->FindBin(label);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+  TH1 *hist = FindHandle(name, "THistManager::FillTH1", kTypesTH1).GetTH1();
+  if(!hist) return;
+	if(opt && opt[0]){
+	  TString optionstring(opt);
+	  if(optionstring.Contains("w")){
+	    // use bin width as weight
+	    // get bin for label
+	    Int_t bin = hist->GetXaxis()->FindBin(label);
+	    // check if not overflow or underflow bin
+	    if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	      weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	  }
 	}
   hist->Fill(label, weight);
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	TH2 *hist = static_cast<TH2 *>(FindHandle(name, "THistManager::FillTH2", kTypesTH2).GetTH1());
+	if(!hist) return;
+	Double_t myweight = weight;
+	if(opt && opt[0]){
+	  TString optstring(opt);
+	  if(optstring.Contains("w")) myweight = 1.;
+	  if(optstring.Contains("wx")){
+	    Int_t binx = hist->GetXaxis()->FindBin(x);
+	    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  }
+	  if(optstring.Contains("wy")){
+	    Int_t biny = hist->GetYaxis()->FindBin(y);
+	    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  }
 	}
 	hist->Fill(x, y, myweight);
 }
 
-void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
+void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *) {
+	TH2 *hist = static_cast<TH2 *>(FindHandle(name, "THistManager::FillTH2", kTypesTH2).GetTH1());
+	if(!hist) return;
+	// the bin width options were never applied for this signature
 	hist->Fill(point[0], point[1], weight);
 }
 
-void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-  }
+void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *) {
+  TH2 *hist = static_cast<TH2 *>(FindHandle(name, "THistManager::FillTH2", kTypesTH2).GetTH1());
+  if(!hist) return;
+  // the bin width options were never applied for this signature
   hist->Fill(labelX, labelY, weight);
 }
 
-void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
+void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *) {
+	TH3 *hist = static_cast<TH3 *>(FindHandle(name, "THistManager::FillTH3", kTypesTH3).GetTH1());
+	if(!hist) return;
+	// the bin width options were never applied for this signature
 	hist->Fill(x, y, z, weight);
 }
 
-void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
+void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *) {
+	TH3 *hist = static_cast<TH3 *>(FindHandle(name, "THistManager::FillTH3", kTypesTH3).GetTH1());
+	if(!hist) return;
+	// the bin width options were never applied for this signature
 	hist->Fill(point[0], point[1], point[2], weight);
 }
 
-void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
-	  }
-	}
-
+void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *) {
+	THnBase *hist = FindHandle(name, "THistManager::FillTHnSparse", kTypesTHnSparse).GetTHn();
+	if(!hist) return;
+	// the bin width options were never applied for this signature
 	hist->Fill(x, weight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+  TProfile *hist = static_cast<TProfile *>(FindHandle(name, "THistManager::FillTProfile", kTypesTProfile).GetTH1());
+  if(!hist) return;
   hist->Fill(x, y, weight);
 }
 
+THistManager::HistHandle THistManager::GetHandle(const char *name, Option_t *opt) const {
+  return HistHandle(ResolveHistogram(name, NULL), BinWidthMask(opt));
+}
+
+void THistManager::ClearHandleCache() {
+  fHandleCache.clear();
+  fNHandleCache = 0;
+}
+
+THistManager::HistHandle THistManager::FindHandle(const char *name, const char *caller, UInt_t types) {
+  UInt_t hash = 0, slot = 0;
+  if(fUseHandleCache && fHandleCache.size()){
+    hash = TString::Hash(name, strlen(name));
+    UInt_t mask = fHandleCache.size() - 1;
+    for(slot = hash & mask; fHandleCache[slot].fHandle.IsValid(); slot = (slot + 1) & mask){
+      const HandleCacheEntry &entry = fHandleCache[slot];
+      if(entry.fHash == hash && entry.fPath == name) {
+        if(types & (1 << entry.fHandle.GetType())) return entry.fHandle;
+        break;
+      }
+    }
+  }
+
+  // Not yet cached: look up the histogram by its path
+  HistHandle handle(ResolveHistogram(name, caller));
+  if(!handle.IsValid()) return HistHandle();
+  if(!(types & (1 << handle.GetType()))){
+    TString dirname(basename(name)), hname(histname(name));
+    Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    return HistHandle();
+  }
+  if(!fUseHandleCache) return handle;
+
+  // Insert, keeping the table at most half filled
+  if(2 * (fNHandleCache + 1) > static_cast<Int_t>(fHandleCache.size())){
+    std::vector<HandleCacheEntry> oldcache;
+    oldcache.swap(fHandleCache);
+    fHandleCache.resize(oldcache.size() ? 2 * oldcache.size() : 64);
+    fNHandleCache = 0;
+    for(std::vector<HandleCacheEntry>::iterator it = oldcache.begin(); it != oldcache.end(); ++it){
+      if(!it->fHandle.IsValid()) continue;
+      UInt_t pos = it->fHash & (fHandleCache.size() - 1);
+      while(fHandleCache[pos].fHandle.IsValid()) pos = (pos + 1) & (fHandleCache.size() - 1);
+      fHandleCache[pos] = *it;
+      fNHandleCache++;
+    }
+  }
+  hash = TString::Hash(name, strlen(name));
+  slot = hash & (fHandleCache.size() - 1);
+  while(fHandleCache[slot].fHandle.IsValid()) slot = (slot + 1) & (fHandleCache.size() - 1);
+  fNHandleCache++;
+  fHandleCache[slot].fHash = hash;
+  fHandleCache[slot].fPath = name;
+  fHandleCache[slot].fHandle = handle;
+  return handle;
+}
+
+TObject *THistManager::ResolveHistogram(const char *name, const char *caller) const {
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		if(caller) Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return NULL;
+	}
+	TObject *hist = parent->FindObject(hname);
+	if(!hist && caller) Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+	return hist;
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -659,6 +646,56 @@ TString THistManager::histname(const TString &path) const {
 	return TString(path(index+1, path.Length() - (index+1)));
 }
 
+//////////////////////////////////////////////////////////
+///                                                    ///
+/// Implementation of THistManager::HistHandle         ///
+///                                                    ///
+//////////////////////////////////////////////////////////
+
+THistManager::HistHandle::HistHandle(TObject *hist, UInt_t binwidthmask):
+    fObject(hist),
+    fTH1(dynamic_cast<TH1 *>(hist)),
+    fTHn(dynamic_cast<THnBase *>(hist)),
+    fType(kUndefined),
+    fBinWidthMask(binwidthmask)
+{
+  if(fTH1){
+    if(dynamic_cast<TProfile *>(hist)) fType = kTProfile;
+    else if(dynamic_cast<TH3 *>(hist)) fType = kTH3;
+    else if(dynamic_cast<TH2 *>(hist)) fType = kTH2;
+    else fType = kTH1;
+  } else if(fTHn) {
+    fType = dynamic_cast<THnSparseD *>(hist) ? kTHnSparse : kTHn;
+  } else {
+    // not a histogram (i.e. a group)
+    fObject = NULL;
+  }
+}
+
+Double_t THistManager::HistHandle::BinWidthWeight(const Double_t *point) const {
+  Int_t ndim = fTH1 ? fTH1->GetDimension() : fTHn->GetNdimensions();
+  Double_t weight = 1.;
+  for(Int_t iaxis = 0; iaxis < ndim && iaxis < 32; iaxis++){
+    if(!(fBinWidthMask & (1 << iaxis))) continue;
+    const TAxis *axis = NULL;
+    if(fTH1) axis = iaxis == 0 ? fTH1->GetXaxis() : (iaxis == 1 ? fTH1->GetYaxis() : fTH1->GetZaxis());
+    else axis = fTHn->GetAxis(iaxis);
+    Int_t bin = axis->FindFixBin(point[iaxis]);
+    // no correction for underflow and overflow
+    if(bin > 0 && bin <= axis->GetNbins()) weight /= axis->GetBinWidth(bin);
+  }
+  return weight;
+}
+
+void THistManager::HistHandle::WrongType(Int_t ndim) const {
+  if(!fObject){
+    ::Fatal("THistManager::HistHandle::Fill", "Handle not connected to a histogram");
+    return;
+  }
+  if(ndim) ::Fatal("THistManager::HistHandle::Fill", "Histogram %s of type %d cannot be filled with %d coordinates", fObject->GetName(), fType, ndim);
+  else ::Fatal("THistManager::HistHandle::Fill", "Histogram %s of type %d cannot be filled with a point", fObject->GetName(), fType);
+}
+
 //////////////////////////////////////////////////////////
 ///                                                    ///
 /// Implementation of THistManager::iterator           ///
@@ -1030,6 +1067,86 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    // Handles from the create methods and from the lookup
+    THistManager::HistHandle h1 = testmgr.CreateTH1("Group1/Test1", "Test handle 1D", 1, 0., 1.);
+    THistManager::HistHandle h2 = testmgr.CreateTH2("Group1/Test2", "Test handle 2D", 1, 0., 1., 1, 0., 1.);
+    THistManager::HistHandle h3 = testmgr.CreateTH3("Group2/Subgroup1/Test3", "Test handle 3D", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("Group2/TestN", "Test handle THnSparse", 4, nbins, min, max);
+    THistManager::HistHandle hN = testmgr.GetHandle("Group2/TestN");
+    THistManager::HistHandle hProfile = testmgr.CreateTProfile("TestProfile", "Test handle Profile", 1, 0., 1.);
+    double binlimits[3] = {0., 1., 3.};
+    THistManager::HistHandle hWidth = testmgr.CreateTH1("Group1/TestWidth", "Test handle bin width", 2, binlimits);
+    hWidth.SetBinWidthCorrection(1);   // x-axis
+    THistManager::HistHandle hWidthLookup = testmgr.GetHandle("Group1/TestWidth", "wx");
+
+    bool success(true);
+    struct { const THistManager::HistHandle *fHandle; THistManager::HistHandle::HistType_t fType; const char *fName; } expected[6] = {
+        {&h1, THistManager::HistHandle::kTH1, "Group1/Test1"},
+        {&h2, THistManager::HistHandle::kTH2, "Group1/Test2"},
+        {&h3, THistManager::HistHandle::kTH3, "Group2/Subgroup1/Test3"},
+        {&hN, THistManager::HistHandle::kTHnSparse, "Group2/TestN"},
+        {&hProfile, THistManager::HistHandle::kTProfile, "TestProfile"},
+        {&hWidthLookup, THistManager::HistHandle::kTH1, "Group1/TestWidth"}
+    };
+    for(int i = 0; i < 6; i++){
+      if(!expected[i].fHandle->IsValid() || expected[i].fHandle->GetType() != expected[i].fType){
+        std::cout << expected[i].fName << ": Handle invalid or type mismatch, expected " << expected[i].fType << ", found " << expected[i].fHandle->GetType() << std::endl;
+        success = false;
+      }
+    }
+    if(testmgr.GetHandle("Group1/NotExisting").IsValid() || testmgr.GetHandle("Group1").IsValid()){
+      std::cout << "Handle valid for non-existing histogram or group" << std::endl;
+      success = false;
+    }
+    if(hWidthLookup.GetBinWidthCorrection() != 1){
+      std::cout << "Group1/TestWidth: Bin width option not converted, expected 1, found " << hWidthLookup.GetBinWidthCorrection() << std::endl;
+      success = false;
+    }
+    if(!success) return 1;
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 50; i++){
+      h1.Fill(0.5);
+      h2.Fill(0.5, 0.5, 1.);
+      h3.Fill(0.5, 0.5, 0.5, 1.);
+      hN.Fill(point);
+      hProfile.Fill(0.5, 1., 1.);
+      testmgr.FillTH1("Group1/Test1", 0.5);
+      testmgr.FillTH2("Group1/Test2", 0.5, 0.5);
+      testmgr.FillTH3("Group2/Subgroup1/Test3", 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse("Group2/TestN", point);
+      testmgr.FillProfile("TestProfile", 0.5, 1.);
+    }
+    hWidth.Fill(0.5);
+    hWidth.Fill(2.);
+    hWidthLookup.Fill(2.);
+    hWidthLookup.Fill(5.);  // overflow, not corrected
+
+    // Evaluate test
+    double content[5] = {h1.GetTH1()->GetBinContent(1), h2.GetTH1()->GetBinContent(1, 1), h3.GetTH1()->GetBinContent(1, 1, 1), 0., hProfile.GetTH1()->GetBinContent(1)};
+    int index[4] = {1,1,1,1};
+    content[3] = hN.GetTHn()->GetBinContent(index);
+    double expectedcontent[5] = {100., 100., 100., 100., 1.};
+    for(int i = 0; i < 5; i++){
+      if(TMath::Abs(content[i] - expectedcontent[i]) > DBL_EPSILON){
+        std::cout << expected[i].fName << ": Value mismatch: expected " << expectedcontent[i] << ", found " << content[i] << std::endl;
+        success = false;
+      }
+    }
+    TH1 *testwidth = hWidth.GetTH1();
+    if(TMath::Abs(testwidth->GetBinContent(1) - 1.) > DBL_EPSILON || TMath::Abs(testwidth->GetBinContent(2) - 1.) > DBL_EPSILON
+        || TMath::Abs(testwidth->GetBinContent(3) - 1.) > DBL_EPSILON){
+      std::cout << "Group1/TestWidth: Value mismatch: expected (1, 1, 1), found (" << testwidth->GetBinContent(1) << ", "
+                << testwidth->GetBinContent(2) << ", " << testwidth->GetBinContent(3) << ")" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1167,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1193,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
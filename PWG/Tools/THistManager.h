@@ -4,19 +4,22 @@
  * See cxx source for full Copyright notice                               */
 
 #include <THashList.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+#include <THnBase.h>
 #include <TIterator.h>
 #include <TNamed.h>
+#include <TProfile.h>
 #include <iterator>
+#include <string>
+#include <vector>
 
 class TArrayD;
 class TAxis;
 class TBinning;
 class TList;
-class TH1;
-class TH2;
-class TH3;
 class THnSparse;
-class TProfile;
 
 /**
  * @defgroup Histmanager
@@ -95,6 +98,23 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via handles
+ *
+ * The Fill methods taking the histogram name look up the histogram by its path.
+ * The result of the lookup is cached per path, so repeated fills of the same
+ * histogram only pay for hashing the name. In loops over tracks or jets the
+ * lookup can be avoided completely using a @ref HistHandle, resolved once (i.e.
+ * in UserCreateOutputObjects) and filled directly:
+ *
+ * ~~~{.cxx}
+ * THistManager::HistHandle hpt = mgr.CreateTH1("tracks/hPt", "pt-distribution", TLinearBinning(100, 0., 100.));
+ * THistManager::HistHandle hetaphi = mgr.GetHandle("tracks/hEtaPhi");
+ * for(auto t : tracks) {
+ *   hpt.Fill(t->Pt());
+ *   hetaphi.Fill(t->Eta(), t->Phi(), 1.);
+ * }
+ * ~~~
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +249,152 @@ public:
     iterator();
   };
 
+  /**
+   * @class HistHandle
+   * @brief Direct access to a histogram of the histogram manager
+   * @ingroup Histmanager
+   *
+   * Lightweight handle to a histogram in the histogram manager. The
+   * histogram type is determined once when the handle is created,
+   * filling dispatches on the stored type without name lookup, string
+   * parsing or dynamic_cast. Handles stay valid as long as the histogram
+   * exists, they are not meant to be streamed.
+   *
+   * Correction for the bin width (see the fill options of the histogram
+   * manager) is defined once per handle as bit mask of axes (bit 0 for x).
+   * Entries in the range of the axis are weighted with the inverse bin width.
+   */
+  class HistHandle {
+  public:
+    /**
+     * @enum HistType_t
+     * @brief Histogram type of the handle, selecting the fill method
+     */
+    enum HistType_t {
+      kUndefined = 0,   //!< No or unsupported object
+      kTH1 = 1,         //!< 1D histogram
+      kTH2 = 2,         //!< 2D histogram
+      kTH3 = 3,         //!< 3D histogram
+      kTProfile = 4,    //!< Profile histogram
+      kTHnSparse = 5,   //!< THnSparse (double precision)
+      kTHn = 6          //!< Other n-dimensional histograms
+    };
+
+    /**
+     * @brief Default constructor, creating an invalid handle
+     */
+    HistHandle(): fObject(nullptr), fTH1(nullptr), fTHn(nullptr), fType(kUndefined), fBinWidthMask(0) { }
+
+    /**
+     * @brief Constructor, determining the histogram type
+     *
+     * Can be used directly with the histogram returned from the Create
+     * methods of the histogram manager.
+     * @param[in] hist Histogram (TH1, TH2, TH3, TProfile or THnBase)
+     * @param[in] binwidthmask Axes for which the weight is corrected by the bin width
+     */
+    HistHandle(TObject *hist, UInt_t binwidthmask = 0);
+
+    /**
+     * @brief Destructor, nothing to do
+     */
+    ~HistHandle() { }
+
+    Bool_t IsValid() const { return fObject != nullptr; }
+    HistType_t GetType() const { return fType; }
+    TObject *GetObject() const { return fObject; }
+    TH1 *GetTH1() const { return fTH1; }
+    THnBase *GetTHn() const { return fTHn; }
+    UInt_t GetBinWidthCorrection() const { return fBinWidthMask; }
+    void SetBinWidthCorrection(UInt_t mask) { fBinWidthMask = mask; }
+
+    /**
+     * @brief Fill a 1D histogram
+     * @param[in] x x-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(Double_t x, Double_t weight = 1.) const {
+      if(fType != kTH1) { WrongType(1); return; }
+      if(fBinWidthMask) weight *= BinWidthWeight(&x);
+      fTH1->Fill(x, weight);
+    }
+
+    /**
+     * @brief Fill a 2D histogram or a profile
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate (value for profiles)
+     * @param[in] weight weight of the entry
+     */
+    void Fill(Double_t x, Double_t y, Double_t weight) const {
+      if(fType == kTProfile) {
+        if(fBinWidthMask) weight *= BinWidthWeight(&x);
+        static_cast<TProfile *>(fTH1)->Fill(x, y, weight);
+        return;
+      }
+      if(fType != kTH2) { WrongType(2); return; }
+      if(fBinWidthMask) {
+        Double_t point[2] = {x, y};
+        weight *= BinWidthWeight(point);
+      }
+      static_cast<TH2 *>(fTH1)->Fill(x, y, weight);
+    }
+
+    /**
+     * @brief Fill a 3D histogram
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] z z-coordinate
+     * @param[in] weight weight of the entry
+     */
+    void Fill(Double_t x, Double_t y, Double_t z, Double_t weight) const {
+      if(fType != kTH3) { WrongType(3); return; }
+      if(fBinWidthMask) {
+        Double_t point[3] = {x, y, z};
+        weight *= BinWidthWeight(point);
+      }
+      static_cast<TH3 *>(fTH1)->Fill(x, y, z, weight);
+    }
+
+    /**
+     * @brief Fill a histogram of any dimension with a point
+     * @param[in] point coordinates of the entry, one per dimension
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const Double_t *point, Double_t weight = 1.) const {
+      if(fType == kTHnSparse || fType == kTHn) {
+        if(fBinWidthMask) weight *= BinWidthWeight(point);
+        fTHn->Fill(point, weight);
+        return;
+      }
+      switch(fType) {
+      case kTH1: Fill(point[0], weight); break;
+      case kTH2: case kTProfile: Fill(point[0], point[1], weight); break;
+      case kTH3: Fill(point[0], point[1], point[2], weight); break;
+      default: WrongType(0); break;
+      };
+    }
+
+  private:
+    /**
+     * @brief Inverse bin width in the axes selected for bin width correction
+     * @param[in] point coordinates of the entry
+     * @return weight factor
+     */
+    Double_t BinWidthWeight(const Double_t *point) const;
+
+    /**
+     * @brief Report fill with the wrong number of coordinates
+     * @param[in] ndim Number of coordinates of the fill (0 for a point)
+     */
+    void WrongType(Int_t ndim) const;
+
+    TObject                     *fObject;             ///< Histogram
+    TH1                         *fTH1;                ///< Histogram as TH1 (TH1, TH2, TH3, TProfile)
+    THnBase                     *fTHn;                ///< Histogram as THnBase (THnSparse, THn)
+    HistType_t                  fType;                ///< Type of the histogram
+    UInt_t                      fBinWidthMask;        ///< Axes with bin width correction
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -481,7 +647,7 @@ public:
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  TProfile* CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -494,7 +660,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  TProfile* CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -506,7 +672,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  TProfile* CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -518,7 +684,7 @@ public:
    * @param[in] xbins User binning
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  TProfile* CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -634,6 +800,33 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Get a handle to a histogram within the container.
+   *
+   * The histogram is looked up once by its name (following the common
+   * group notation), filling via the handle needs no further lookup.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Bin width correction applied in fills via the handle,
+   * same notation as for the Fill methods ("wx", "wy", "wz" or "w0", "w1", ...)
+   * @return handle to the histogram (invalid if not found)
+   */
+  HistHandle GetHandle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Switch the cache of histogram lookups of the Fill methods on or off.
+   *
+   * The cache is on by default. It holds pointers to the histograms,
+   * in case histograms are removed from the list of histograms by hand
+   * the cache needs to be cleared with @ref ClearHandleCache.
+   * @param[in] use If true lookups by name are cached
+   */
+  void SetUseHandleCache(Bool_t use) { fUseHandleCache = use; if(!use) ClearHandleCache(); }
+
+  /**
+   * @brief Forget all cached histogram lookups of the Fill methods.
+   */
+  void ClearHandleCache();
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +898,27 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find histogram for the Fill methods.
+	 *
+	 * Looks up the histogram in the cache of handles, resolving and
+	 * caching it in case it is not yet found. The lookup does not
+	 * allocate memory once the histogram is cached.
+	 * @param[in] name Name of the histogram (common notation)
+	 * @param[in] caller Name of the calling method, for error messages
+	 * @param[in] types Accepted histogram types, bit mask of (1 << HistHandle::HistType_t)
+	 * @return handle to the histogram (invalid if not found or of different type)
+	 */
+	HistHandle FindHandle(const char *name, const char *caller, UInt_t types);
+
+	/**
+	 * @brief Find histogram by path, without cache.
+	 * @param[in] name Name of the histogram (common notation)
+	 * @param[in] caller Name of the calling method, for error messages (no message if NULL)
+	 * @return the histogram (NULL if not found)
+	 */
+	TObject *ResolveHistogram(const char *name, const char *caller) const;
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -719,8 +933,22 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @struct HandleCacheEntry
+	 * @brief Slot of the hash table of histogram lookups
+	 */
+	struct HandleCacheEntry {
+	  HandleCacheEntry(): fHash(0), fPath(), fHandle() { }
+	  UInt_t fHash;                       ///< Hash of the path
+	  std::string fPath;                  ///< Path of the histogram
+	  HistHandle fHandle;                 ///< Handle to the histogram, invalid for empty slots
+	};
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	Bool_t fUseHandleCache;               //!<! Cache the histogram lookups of the Fill methods
+	std::vector<HandleCacheEntry> fHandleCache;  //!<! Hash table (open addressing) of the histogram lookups
+	Int_t fNHandleCache;                  //!<! Number of filled slots in the hash table
 
   /// \cond CLASSIMP
 	ClassDef(THistManager, 1);  // Container for histograms
@@ -845,6 +1073,23 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Test filling via histogram handles and the cached lookup of the Fill methods
+   * Relies on: TestFillSimpleHistograms, TestFillGroupedHistograms
+   *
+   * Creating histograms of all types in groups, obtaining handles from the Create
+   * methods and from GetHandle. Each histogram is filled 50 times via the handle and
+   * 50 times via the name (cached lookup). In addition a 1D histogram with 2 bins of
+   * different width is filled via a handle with bin width correction.
+   *
+   * Test passed:
+   * - All handles are valid and have the expected type
+   * - All Histograms have the expected value (100 for histograms, 1 for profile)
+   * - The bin width corrected entries are weighted with the inverse bin width
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1127,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
@@ -24,6 +24,7 @@
 #include "AliAnalysisMuMuFnorm.h"
 #include "AliAnalysisMuMuGraphUtil.h"
 #include "AliAnalysisMuMuJpsiResult.h"
+#include "AliAnalysisMuMuObjectIndex.h"
 #include "AliAnalysisMuMuSpectra.h"
 #include "AliAnalysisMuMuSpectraProcessorPbPb.h"
 #include "AliAnalysisMuMuSpectraProcessorPbP.h"
@@ -1533,7 +1534,7 @@ TString AliAnalysisMuMu::First(const TString& list) const
 }
 
 //_____________________________________________________________________________
-AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const char* trigger,const char* eventType,const char* pairCut,const char* centrality,const AliAnalysisMuMuBinning& binning,Bool_t corrected,const TString* fitMethod,const char* flavour,const char* histoType)
+AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const char* trigger,const char* eventType,const char* pairCut,const char* centrality,const AliAnalysisMuMuBinning& binning,Bool_t corrected,const TString* fitMethod,const char* flavour,const char* histoType,const TObjArray* histos)
 {
 /**
  * @brief Fit minv histo
@@ -1548,6 +1549,8 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
  * @param binning     [description]
  * @param corrected   [description]
  * @param fitMethod   '' or 'mix'
+ * @param histos      if not null, the histograms to fit, one per bin of binning (see AliAnalysisMuMuObjectIndex::GetObjects),
+ *                    instead of looking them up in the collection
  * @return            AliAnalysisMuMuSpectra to be handled by the owner
  */
   // To avoid bins with error=0 due to low statstics
@@ -1633,8 +1636,10 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
   AliAnalysisMuMuBinning::Range* bin;
   TIter next(bins);
   next.Reset();
+  Int_t ibin(-1);
   while ( ( bin = static_cast<AliAnalysisMuMuBinning::Range*>(next())) )
   {
+    ++ibin;
     Int_t added(0);
     AliAnalysisMuMuJpsiResult* r    = 0x0;
     Bool_t adoptOk           = kFALSE;
@@ -1648,15 +1653,8 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     TString sHistoType(histoType);
 
     // Select name histo
-    TString hname;
-    TString mixflag1 = mix ? "_wbck" : "" ;
-    if( sHistoType.Contains("minv"))
-      hname = corrected ? Form("MinvUS_AccEffCorr+%s%s",bin->AsString().Data(),mixflag1.Data())  : Form("MinvUS+%s%s",bin->AsString().Data(),mixflag1.Data());
-    else if( sHistoType.Contains("mpt") && !sHistoType.Contains("mpt2") )
-      hname = corrected ? Form("MeanPtVsMinvUS_AccEffCorr+%s%s",bin->AsString().Data(),mixflag1.Data()) : Form("MeanPtVsMinvUS+%s%s",bin->AsString().Data(),mixflag1.Data());
-    else if( sHistoType.Contains("mpt2") )
-      hname = corrected ? Form("MeanPtSquareVsMinvUS_AccEffCorr+%s%s",bin->AsString().Data(),mixflag1.Data()) : Form("MeanPtSquareVsMinvUS+%s%s",bin->AsString().Data(),mixflag1.Data());
-    else {
+    TString hname = FitHistoName(histoType,*bin,corrected,mix);
+    if ( hname.IsNull() ) {
       AliError("Wrong spectra type choice: Possibilities are: 'minv' or 'mpt' ");
       continue;
     }
@@ -1668,7 +1666,10 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     std::cout << "Fitting" << isCorr.Data() << sHistoType.Data() << " spectra in " << id->Data() << std::endl;
 
     // Finally gets it
-    if ( OC()->Histo(id->Data(),hname.Data()) ) histo = static_cast<TH1*>(OC()->Histo(id->Data(),hname.Data())->Clone(Form("%s%d",sHistoType.Data(),n++)));
+    TH1* h(0x0);
+    if ( histos ) h = ( ibin < histos->GetEntriesFast() ) ? dynamic_cast<TH1*>(histos->UncheckedAt(ibin)) : 0x0;
+    else          h = OC()->Histo(id->Data(),hname.Data());
+    if ( h ) histo = static_cast<TH1*>(h->Clone(Form("%s%d",sHistoType.Data(),n++)));
     if ( !histo ) {
       AliError(Form("Could not find histo %s/%s",id->Data(),hname.Data()));
       continue;
@@ -2243,6 +2244,24 @@ void AliAnalysisMuMu::GetParametersFromResult(TString& fitType, AliAnalysisMuMuJ
     }
 }
 
+//_____________________________________________________________________________
+TString AliAnalysisMuMu::FitHistoName(const char* histoType, const AliAnalysisMuMuBinning::Range& bin, Bool_t corrected, Bool_t mix) const
+{
+  /// Name of the histogram fitted by FitParticle() in a bin, empty for a wrong histoType ('minv', 'mpt' or 'mpt2')
+
+  TString sHistoType(histoType);
+  TString mixflag1 = mix ? "_wbck" : "" ;
+
+  if( sHistoType.Contains("minv"))
+    return corrected ? Form("MinvUS_AccEffCorr+%s%s",bin.AsString().Data(),mixflag1.Data())  : Form("MinvUS+%s%s",bin.AsString().Data(),mixflag1.Data());
+  else if( sHistoType.Contains("mpt") && !sHistoType.Contains("mpt2") )
+    return corrected ? Form("MeanPtVsMinvUS_AccEffCorr+%s%s",bin.AsString().Data(),mixflag1.Data()) : Form("MeanPtVsMinvUS+%s%s",bin.AsString().Data(),mixflag1.Data());
+  else if( sHistoType.Contains("mpt2") )
+    return corrected ? Form("MeanPtSquareVsMinvUS_AccEffCorr+%s%s",bin.AsString().Data(),mixflag1.Data()) : Form("MeanPtSquareVsMinvUS+%s%s",bin.AsString().Data(),mixflag1.Data());
+
+  return "";
+}
+
 //_____________________________________________________________________________
 ULong64_t AliAnalysisMuMu::GetTriggerScalerCount(const char* triggerList, Int_t runNumber)
 {
@@ -3216,24 +3235,55 @@ Int_t AliAnalysisMuMu::FitJpsi(const char* binType, const char* flavour, const T
 
     StdoutToAliDebug(1,binning->Print(););
 
+    // Look up the histograms of all the configurations at once,
+    // with the same names and identifiers as in FitParticle()
+    Bool_t mix = fitMethod.Contains("mix") && !IsSimulation();
+    TObjArray histoNames;
+    histoNames.SetOwner(kTRUE);
+    TObjArray* bins = binning->CreateBinObjArray(particle);
+    if ( bins ) {
+      TIter nextBin(bins);
+      AliAnalysisMuMuBinning::Range* bin;
+      while ( ( bin = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ) histoNames.Add(new TObjString(FitHistoName(histoType,*bin,kFALSE,mix)));
+      delete bins;
+    }
+
+    // Without a collection or key lists there is nothing to index: FitParticle() then looks the histograms up itself
+    AliAnalysisMuMuObjectIndex histoIndex;
+    Bool_t indexed(kFALSE);
+    if ( OC() && eventTypeArray && TriggerArray && centralityArray && pairCutArray ) {
+      histoIndex.Build(*OC(),mix ? Form("/MIX/%s_%s",refEvent.Data(),refTrigger.Data()) : "",
+                       *eventTypeArray,*TriggerArray,*centralityArray,*pairCutArray,histoNames);
+      indexed = kTRUE;
+    }
+    TObjArray histos;
+
     // Loop over all trigger
+    Int_t itrigger(-1);
     while ( ( trigger = static_cast<TObjString*>(nextTrigger())) ) {
       AliDebug(1,Form("--TRIGGER %s",trigger->String().Data()));
+      ++itrigger;
       nextEventType.Reset();
 
       // Loop over all evenType
+      Int_t ieventType(-1);
       while ( ( eventType = static_cast<TObjString*>(nextEventType())) ){
         AliDebug(1,Form("----EVENTTYPE %s",eventType->String().Data()));
+        ++ieventType;
         nextPairCut.Reset();
 
         // Loop over all paircut
+        Int_t ipairCut(-1);
         while ( ( pairCut = static_cast<TObjString*>(nextPairCut())) ) {
           AliDebug(1,Form("------PAIRCUT %s",pairCut->String().Data()));
+          ++ipairCut;
           nextCentrality.Reset();
 
           // Loop over all centrality
+          Int_t icentrality(-1);
           while ( ( centrality = static_cast<TObjString*>(nextCentrality()) ) ) {
             AliDebug(1,"------Fitting...");
+            ++icentrality;
 
             // Select stored path
             TObject* o;
@@ -3250,7 +3300,8 @@ Int_t AliAnalysisMuMu::FitJpsi(const char* binType, const char* flavour, const T
             // ---- The main part. The fit method is called ----
 
             AliDebug(1,"------Fitting spectra...");
-            spectra = FitParticle(particle,trigger->String().Data(),eventType->String().Data(),pairCut->String().Data(),centrality->String().Data(),*binning,kFALSE,&fitMethod,flavour,histoType);
+            if ( indexed ) histoIndex.GetObjects(ieventType,itrigger,icentrality,ipairCut,histos);
+            spectra = FitParticle(particle,trigger->String().Data(),eventType->String().Data(),pairCut->String().Data(),centrality->String().Data(),*binning,kFALSE,&fitMethod,flavour,histoType,indexed ? &histos : 0x0);
             AliDebug(1,Form("------fitting done spectra = %p",spectra));
 
             // AliDebug(1,"------Fitting corrected spectra...");
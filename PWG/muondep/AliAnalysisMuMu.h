@@ -57,6 +57,7 @@ class TGraph;
 class TGraphErrors;
 class TH1;
 class TMap;
+class TObjArray;
 
 class AliAnalysisMuMu : public TObject, public TQObject
 {
@@ -101,7 +102,8 @@ public:
       Bool_t corrected        =kFALSE,
       const TString* fitMethod = 0x0,
       const char* flavour ="",
-      const char* histoType ="minv");
+      const char* histoType ="minv",
+      const TObjArray* histos = 0x0);
 
     Int_t FitJpsi(
       const char* binType      ="integrated",
@@ -347,6 +349,8 @@ private:
     Bool_t GetParametersFromMC(TString& fitType, const char* pathCentrPairCut, const char* spectraName, AliAnalysisMuMuBinning::Range* bin) const;
     void GetParametersFromResult(TString& fitType, AliAnalysisMuMuJpsiResult* minvResult) const;
 
+    TString FitHistoName(const char* histoType, const AliAnalysisMuMuBinning::Range& bin, Bool_t corrected, Bool_t mix) const;
+
 
     void GetCollectionsFromAnySubdir(TDirectory& dir,
                                     AliMergeableCollection*& oc,
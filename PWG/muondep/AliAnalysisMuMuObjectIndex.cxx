@@ -0,0 +1,157 @@
+/**************************************************************************
+ * Copyright(c) 1996-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include "AliAnalysisMuMuObjectIndex.h"
+
+#include "AliMergeableCollection.h"
+#include "TH1.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TString.h"
+
+ClassImp(AliAnalysisMuMuObjectIndex)
+
+//_____________________________________________________________________________
+AliAnalysisMuMuObjectIndex::AliAnalysisMuMuObjectIndex() : TObject(), fObjects()
+{
+  /// ctor
+  for ( Int_t i = 0; i < kNofKeys; ++i ) fNofKeys[i] = 0;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuObjectIndex::Build(AliMergeableCollection& oc, const char* prefix,
+                                        const TObjArray& eventTypes, const TObjArray& triggers,
+                                        const TObjArray& centralities, const TObjArray& pairCuts,
+                                        const TObjArray& objectNames)
+{
+  /**
+   * @brief Look up the objects prefix/eventType/trigger/centrality/pairCut/objectName
+   *
+   * @param oc the collection
+   * @param prefix beginning of the identifiers, e.g. "" or "/MIX/eventType_trigger"
+   * @param eventTypes,triggers,centralities,pairCuts,objectNames lists of keys (TObjString)
+   * @return the number of objects found
+   */
+
+  const TObjArray* keys[kNofKeys] = { &eventTypes, &triggers, &centralities, &pairCuts, &objectNames };
+
+  Int_t n(1);
+  for ( Int_t i = 0; i < kNofKeys; ++i )
+  {
+    fNofKeys[i] = keys[i]->GetEntriesFast();
+    n *= fNofKeys[i];
+  }
+
+  fObjects.assign(n,static_cast<TObject*>(0x0));
+
+  Int_t nfound(0);
+  Int_t index(0);
+
+  for ( Int_t e = 0; e < fNofKeys[kEventType]; ++e )
+  {
+    for ( Int_t t = 0; t < fNofKeys[kTrigger]; ++t )
+    {
+      for ( Int_t c = 0; c < fNofKeys[kCentrality]; ++c )
+      {
+        for ( Int_t p = 0; p < fNofKeys[kPairCut]; ++p )
+        {
+          TString id(Form("%s/%s/%s/%s/%s",prefix,
+                          static_cast<TObjString*>(eventTypes.UncheckedAt(e))->String().Data(),
+                          static_cast<TObjString*>(triggers.UncheckedAt(t))->String().Data(),
+                          static_cast<TObjString*>(centralities.UncheckedAt(c))->String().Data(),
+                          static_cast<TObjString*>(pairCuts.UncheckedAt(p))->String().Data()));
+
+          for ( Int_t o = 0; o < fNofKeys[kObjectName]; ++o, ++index )
+          {
+            fObjects[index] = oc.GetObject(id.Data(),static_cast<TObjString*>(objectNames.UncheckedAt(o))->String().Data());
+            if ( fObjects[index] ) ++nfound;
+          }
+        }
+      }
+    }
+  }
+
+  return nfound;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuObjectIndex::Clear(Option_t*)
+{
+  /// Forget all the objects (which are not owned)
+  for ( Int_t i = 0; i < kNofKeys; ++i ) fNofKeys[i] = 0;
+  fObjects.clear();
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuObjectIndex::Configuration(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut) const
+{
+  /// Position of the first object of a configuration in fObjects, -1 if a key is out of range
+
+  if ( eventType < 0 || eventType >= fNofKeys[kEventType] ||
+       trigger < 0 || trigger >= fNofKeys[kTrigger] ||
+       centrality < 0 || centrality >= fNofKeys[kCentrality] ||
+       pairCut < 0 || pairCut >= fNofKeys[kPairCut] ) return -1;
+
+  return ( ( ( eventType * fNofKeys[kTrigger] + trigger ) * fNofKeys[kCentrality] + centrality ) * fNofKeys[kPairCut] + pairCut ) * fNofKeys[kObjectName];
+}
+
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuObjectIndex::GetObject(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, Int_t objectName) const
+{
+  /// Object for the given positions of the keys, 0x0 if it does not exist
+
+  Int_t first = Configuration(eventType,trigger,centrality,pairCut);
+
+  if ( first < 0 || objectName < 0 || objectName >= fNofKeys[kObjectName] ) return 0x0;
+
+  return fObjects[first+objectName];
+}
+
+//_____________________________________________________________________________
+TH1* AliAnalysisMuMuObjectIndex::Histo(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, Int_t objectName) const
+{
+  /// Histogram for the given positions of the keys, 0x0 if it does not exist (or is not a histogram)
+  return dynamic_cast<TH1*>(GetObject(eventType,trigger,centrality,pairCut,objectName));
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuObjectIndex::GetObjects(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, TObjArray& objects) const
+{
+  /**
+   * @brief Get the objects of all the object names of one configuration at once
+   *
+   * @param objects filled (not owner) with the object of the i-th object name at position i,
+   * or 0x0 where it does not exist
+   * @return the number of objects found
+   */
+
+  objects.Clear();
+
+  Int_t first = Configuration(eventType,trigger,centrality,pairCut);
+
+  if ( first < 0 ) return 0;
+
+  objects.Expand(fNofKeys[kObjectName]);
+
+  Int_t nfound(0);
+
+  for ( Int_t o = 0; o < fNofKeys[kObjectName]; ++o )
+  {
+    objects.AddAt(fObjects[first+o],o);
+    if ( fObjects[first+o] ) ++nfound;
+  }
+
+  return nfound;
+}
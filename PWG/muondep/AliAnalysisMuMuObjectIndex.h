@@ -0,0 +1,77 @@
+#ifndef ALIANALYSISMUMUOBJECTINDEX_H
+#define ALIANALYSISMUMUOBJECTINDEX_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+
+  @ingroup pwg_muondep_mumu
+
+  @class AliAnalysisMuMuObjectIndex
+
+  @brief Index of the objects of a mergeable collection by integer keys
+
+  @details The objects prefix/eventType/trigger/centrality/pairCut/objectName of
+  a mergeable collection are looked up once, for all the combinations of the given
+  lists of keys, and are then retrieved by the positions of the keys in these lists,
+  without formatting and looking up the identifiers again.
+
+  The index does not own the objects : it must be built again if the collection changes.
+
+*/
+
+#include "TObject.h"
+#include <vector>
+
+class AliMergeableCollection;
+class TH1;
+class TObjArray;
+
+class AliAnalysisMuMuObjectIndex : public TObject
+{
+public:
+
+  /// the keys of an object, in the order of its identifier
+  enum EKey
+  {
+    kEventType,
+    kTrigger,
+    kCentrality,
+    kPairCut,
+    kObjectName,
+    kNofKeys
+  };
+
+  AliAnalysisMuMuObjectIndex();
+  virtual ~AliAnalysisMuMuObjectIndex() {}
+
+  Int_t Build(AliMergeableCollection& oc, const char* prefix,
+              const TObjArray& eventTypes, const TObjArray& triggers,
+              const TObjArray& centralities, const TObjArray& pairCuts,
+              const TObjArray& objectNames);
+
+  virtual void Clear(Option_t* opt="");
+
+  /// number of keys of a given type (EKey)
+  Int_t GetNofKeys(Int_t key) const { return ( key >= 0 && key < kNofKeys ) ? fNofKeys[key] : 0; }
+
+  TObject* GetObject(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, Int_t objectName) const;
+
+  TH1* Histo(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, Int_t objectName) const;
+
+  Int_t GetObjects(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut, TObjArray& objects) const;
+
+private:
+  AliAnalysisMuMuObjectIndex(const AliAnalysisMuMuObjectIndex& rhs); // not implemented on purpose
+  AliAnalysisMuMuObjectIndex& operator=(const AliAnalysisMuMuObjectIndex& rhs); // not implemented on purpose
+
+  Int_t Configuration(Int_t eventType, Int_t trigger, Int_t centrality, Int_t pairCut) const;
+
+  Int_t fNofKeys[kNofKeys]; //! number of keys of each type
+  std::vector<TObject*> fObjects; //! objects (not owned), objectName running fastest, then pairCut, centrality, trigger and eventType
+
+  ClassDef(AliAnalysisMuMuObjectIndex,1) // index of the objects of a mergeable collection by integer keys
+};
+
+#endif
@@ -12,12 +12,160 @@
 #include "TMath.h"
 #include "TParameter.h"
 #include "TTree.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <thread>
+
+namespace {
+
+    const double m2 = 0.1056584*0.1056584;
+
+    /// Rapidity of the pair of (muon) tracks
+    double PairRapidity(const AliMuonCompactTrack& t1, const AliMuonCompactTrack& t2)
+    {
+        double p1square = t1.mPx*t1.mPx +
+            t1.mPy*t1.mPy +
+            t1.mPz*t1.mPz;
+
+        double p2square = t2.mPx*t2.mPx +
+            t2.mPy*t2.mPy +
+            t2.mPz*t2.mPz;
+
+        double e = sqrt(m2+p1square+p2square+2.0*sqrt(p1square)*sqrt(p2square));
+        double pz = t1.mPz+t2.mPz;
+
+        return 0.5*log( (e+pz) / (e-pz) );
+    }
+
+    /// Tracks of the events, indexed by the manus they cross.
+    /// The validity of a track only changes with respect to the one
+    /// it has with all manus good if one of its clusters is on a
+    /// rejected manu, so for each (run,cause) only those tracks
+    /// have to be validated again.
+    struct TrackIndex
+    {
+        std::vector<const AliMuonCompactTrack*> tracks;
+        std::vector<char> allGoodValid; ///< validity of the tracks with all manus good
+        std::vector<UInt_t> manuFirst; ///< tracks crossing manu m are manuTracks[manuFirst[m]..manuFirst[m+1]-1]
+        std::vector<UInt_t> manuTracks;
+        std::vector<std::pair<UInt_t,UInt_t> > pairs; ///< pairs of tracks in the rapidity range
+    };
+
+    /// Number of rejected manus, validated tracks and pairs for one (run,cause)
+    struct RunCauseCount
+    {
+        long nbad;
+        Int_t nValidated;
+        Int_t npairs;
+    };
+
+    void BuildTrackIndex(AliMuonCompactQuickAccEff& qae,
+            const std::vector<AliMuonCompactEvent>& events,
+            std::vector<AliMuonCompactEvent>::size_type maxevents,
+            TrackIndex& index)
+    {
+        int maxManuIndex = -1;
+
+        for ( std::vector<AliMuonCompactEvent>::size_type i = 0; i < maxevents; ++i )
+        {
+            const AliMuonCompactEvent& e = events[i];
+            UInt_t first = index.tracks.size();
+
+            for ( std::vector<AliMuonCompactTrack>::size_type j = 0; j < e.mTracks.size(); ++j )
+            {
+                const AliMuonCompactTrack& t1 = e.mTracks[j];
+                index.tracks.push_back(&t1);
+
+                for ( std::vector<AliMuonCompactTrack>::size_type k = j+1; k < e.mTracks.size(); ++k )
+                {
+                    double y = PairRapidity(t1,e.mTracks[k]);
+                    if (y >= -4 && y <= -2.5 )
+                    {
+                        index.pairs.push_back(std::make_pair(first+j,first+k));
+                    }
+                }
+
+                for ( std::vector<AliMuonCompactCluster>::size_type c = 0; c < t1.mClusters.size(); ++c )
+                {
+                    maxManuIndex = std::max(maxManuIndex,t1.mClusters[c].BendingManuIndex());
+                    maxManuIndex = std::max(maxManuIndex,t1.mClusters[c].NonBendingManuIndex());
+                }
+            }
+        }
+
+        // the status of all manus is good, but not empty (which would validate
+        // all tracks without checking the station requirements)
+        std::vector<UInt_t> allGood(std::max(maxManuIndex+1,1),0);
+        index.allGoodValid.resize(index.tracks.size());
+
+        std::vector<std::vector<UInt_t> > manuTracks(maxManuIndex+1);
+        for ( UInt_t t = 0; t < index.tracks.size(); ++t )
+        {
+            const AliMuonCompactTrack& track = *(index.tracks[t]);
+            index.allGoodValid[t] = qae.ValidateTrack(track,allGood,~0u);
+
+            for ( std::vector<AliMuonCompactCluster>::size_type c = 0; c < track.mClusters.size(); ++c )
+            {
+                int manus[2] = { track.mClusters[c].BendingManuIndex(), track.mClusters[c].NonBendingManuIndex() };
+                for ( int m = 0; m < 2; ++m )
+                {
+                    if ( manus[m] >= 0 && ( manuTracks[manus[m]].empty() || manuTracks[manus[m]].back() != t ) )
+                    {
+                        manuTracks[manus[m]].push_back(t);
+                    }
+                }
+            }
+        }
+
+        index.manuFirst.assign(1,0);
+        for ( std::vector<std::vector<UInt_t> >::size_type m = 0; m < manuTracks.size(); ++m )
+        {
+            index.manuTracks.insert(index.manuTracks.end(),manuTracks[m].begin(),manuTracks[m].end());
+            index.manuFirst.push_back(index.manuTracks.size());
+        }
+    }
+
+    /// Same counts as ComputeMinv, from the track index
+    void CountPairs(AliMuonCompactQuickAccEff& qae,
+            const TrackIndex& index,
+            const std::vector<UInt_t>& manustatus,
+            UInt_t causeMask,
+            std::vector<char>& valid,
+            RunCauseCount& count)
+    {
+        if ( manustatus.empty() || causeMask == 0 )
+        {
+            valid.assign(index.tracks.size(),1);
+        }
+        else
+        {
+            valid = index.allGoodValid;
+
+            UInt_t nmanus = std::min(manustatus.size(),index.manuFirst.size()-1);
+            for ( UInt_t m = 0; m < nmanus; ++m )
+            {
+                if ( ( manustatus[m] & causeMask ) == 0 ) continue;
+                for ( UInt_t k = index.manuFirst[m]; k < index.manuFirst[m+1]; ++k )
+                {
+                    UInt_t t = index.manuTracks[k];
+                    valid[t] = qae.ValidateTrack(*(index.tracks[t]),manustatus,causeMask);
+                }
+            }
+        }
+
+        count.nValidated = std::count(valid.begin(),valid.end(),1);
+        count.npairs = 0;
+        for ( std::vector<std::pair<UInt_t,UInt_t> >::size_type i = 0; i < index.pairs.size(); ++i )
+        {
+            if ( valid[index.pairs[i].first] && valid[index.pairs[i].second] ) ++count.npairs;
+        }
+    }
+}
 
 /// \ingroup compact
-AliMuonCompactQuickAccEff::AliMuonCompactQuickAccEff(int maxevents, bool rejectMonoCathodeClusters)
-    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters)
+AliMuonCompactQuickAccEff::AliMuonCompactQuickAccEff(int maxevents, bool rejectMonoCathodeClusters, int nthreads)
+    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters), fNofThreads(nthreads)
 {
 }
 
@@ -180,7 +328,6 @@ TH1* AliMuonCompactQuickAccEff::ComputeMinv(const std::vector<AliMuonCompactEven
     npairs = 0;
     TH1* h = 0x0; //new TH1F("hminv","hminv",300,0.0,15.0);
 
-    const double m2 = 0.1056584*0.1056584;
     const double m = 0.1056584;
     Int_t nTracks=0;
     Int_t nValidatedTracks = 0;
@@ -226,11 +373,8 @@ TH1* AliMuonCompactQuickAccEff::ComputeMinv(const std::vector<AliMuonCompactEven
                             TMath::Sqrt(m2+p2square)
                             - (t1.mPx*t2.mPx+t1.mPy*t2.mPy+
                                 t1.mPz*t2.mPz)));
-                
-                double e = sqrt(m2+p1square+p2square+2.0*sqrt(p1square)*sqrt(p2square));
-                double pz = t1.mPz+t2.mPz;
 
-                double y = 0.5*log( (e+pz) / (e-pz) );
+                double y = PairRapidity(t1,t2);
 
                 // TLorentzVector v1;
                 // TLorentzVector v2;
@@ -320,42 +464,71 @@ void AliMuonCompactQuickAccEff::ComputeEvolution(const std::vector<AliMuonCompac
         g->SetMarkerSize(1.5);
     }
 
+    uint64_t maxevents = fMaxEvents;
+
+    if (!maxevents || maxevents > events.size())
+    {
+        maxevents = events.size();
+    }
+
+    TrackIndex index;
+    BuildTrackIndex(*this,events,maxevents,index);
+
+    std::vector<RunCauseCount> counts(vrunlist.size()*causes.size());
+
+    // each thread takes one run every nthreads
+    auto countRuns = [&](UInt_t first, UInt_t step)
+    {
+        std::vector<char> valid;
+        for ( std::vector<int>::size_type i = first; i < vrunlist.size(); i += step )
+        {
+            std::map<int, std::vector<UInt_t> >::const_iterator it = manuStatusForRuns.find(vrunlist[i]);
+
+            const std::vector<UInt_t>& manustatus = it->second; 
+
+            for ( std::vector<UInt_t>::size_type icause = 0; icause < causes.size(); ++icause )
+            {
+                RunCauseCount& count = counts[i*causes.size()+icause];
+                count.nbad = std::count_if(manustatus.begin(),
+                        manustatus.end(),
+                        [&](int n) { return (n & causes[icause]); }); 
+                CountPairs(*this,index,manustatus,causes[icause],valid,count);
+            }
+        }
+    };
+
+    UInt_t nthreads = fNofThreads > 0 ? fNofThreads : std::thread::hardware_concurrency();
+    nthreads = std::max(1u,std::min<UInt_t>(nthreads,vrunlist.size()));
+
+    std::vector<std::thread> threads;
+    for ( UInt_t t = 1; t < nthreads; ++t )
+    {
+        threads.push_back(std::thread(countRuns,t,nthreads));
+    }
+    countRuns(0,nthreads);
+    for ( std::vector<std::thread>::size_type t = 0; t < threads.size(); ++t )
+    {
+        threads[t].join();
+    }
+
     for ( std::vector<int>::size_type i = 0; i < vrunlist.size(); ++i )
     {
         Int_t runNumber = vrunlist[i];
 
         std::cout << Form("---- RUN %6d",runNumber) << std::endl;
 
-        std::map<int, std::vector<UInt_t> >::const_iterator it = manuStatusForRuns.find(runNumber);
-
-        const std::vector<UInt_t>& manustatus = it->second; 
-
         for ( std::vector<UInt_t>::size_type icause = 0; icause < causes.size(); ++icause )
         {
-            auto nbad =std::count_if(manustatus.begin(),
-                    manustatus.end(),
-                    [&](int n) { return (n & causes[icause]); }); 
+            const RunCauseCount& count = counts[i*causes.size()+icause];
             std::cout << Form("RUN %6d %30s rejected manus = %6ld => ",
                 runNumber,
                 AliMuonCompactManuStatus::CauseAsString(causes[icause]).c_str(),
-                nbad
+                count.nbad
                 );
-            Int_t npairs(0);
-            TH1* h = ComputeMinv(events,manustatus,causes[icause],npairs);
-            if (h)
-            {
-                h->SetName(Form("hminv%6d%s",runNumber,AliMuonCompactManuStatus::CauseAsString(causes[icause]).c_str()));
-                hminv.push_back(h); 
-            }
-            Double_t drop = 0.0;
-            if ( h) 
-            {
-                drop = 100.0*(1.0-h->Integral(b1,b2)/referenceNofJpsi);
-            }
-            else
-            {
-                drop = 100.0*(1.0 - npairs*1.0/referenceNofJpsi);
-            }
+            std::cout << Form("nTracks %d nValidated %d npairs %d",(Int_t)index.tracks.size(),
+                    count.nValidated,count.npairs) << std::endl;
+            Int_t npairs = count.npairs;
+            Double_t drop = 100.0*(1.0 - npairs*1.0/referenceNofJpsi);
             Double_t relativeError = TMath::Sqrt(1.0/npairs + 1.0/referenceNofJpsi);
             Double_t dropError = drop*relativeError;
             std::cout << Form("RUN %6d %30s AccxEff drop %7.2f %% +- %5.2f %%",
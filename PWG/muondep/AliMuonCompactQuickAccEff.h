@@ -22,6 +22,11 @@ class TTree;
   This class is meant to get a quick computation of
   the evolution of the Acc x Eff for some runs.
 
+  In ComputeEvolution the tracks are indexed by the manus they cross,
+  so that for each (run,cause) only the tracks crossing a rejected manu
+  are validated again, and the runs are processed in parallel
+  (nthreads threads, 0 meaning one per core).
+
 */
 
 
@@ -29,7 +34,7 @@ class AliMuonCompactQuickAccEff
 {
     public:
 
-        AliMuonCompactQuickAccEff(int maxevents=0, bool rejectMonoCathodeClusters=false);
+        AliMuonCompactQuickAccEff(int maxevents=0, bool rejectMonoCathodeClusters=false, int nthreads=0);
 
         void ComputeEvolution(const std::vector<AliMuonCompactEvent>& events, 
                 std::vector<int>& vrunlist,
@@ -64,6 +69,7 @@ class AliMuonCompactQuickAccEff
     private:
         ULong64_t fMaxEvents;
         bool fRejectMonoCathodeClusters;
+        int fNofThreads;
 };
 
 #endif
@@ -16,6 +16,7 @@
 #pragma link C++ class AliAnalysisMuMuConfig+;
 #pragma link C++ class AliAnalysisMuMuResult+;
 #pragma link C++ class AliAnalysisMuMuJpsiResult+;
+#pragma link C++ class AliAnalysisMuMuObjectIndex+;
 #pragma link C++ class AliAnalysisMuMuSpectraProcessor+;
 #pragma link C++ class AliAnalysisMuMuSpectraProcessorPbPb+;
 #pragma link C++ class AliAnalysisMuMuSpectraProcessorPbP+;
@@ -11,6 +11,7 @@
 #include <TComplex.h>
 #include "AliJBaseTrack.h"
 #include "AliJFFlucAnalysis.h"
+#include "AliJFFlucQvectors.h"
 //#include "AliJCorrelations.h"
 #include "AliAnalysisManager.h"
 //#include "AliAODEvent.h"
@@ -48,6 +49,11 @@ AliJFFlucAnalysis::AliJFFlucAnalysis()
 	fNJacek(0),
 	fEffMode(0),
 	fEffFilterBit(0),
+	fQvectors(0),
+	fTrackPhi(),
+	fTrackEta(),
+	fTrackPt(),
+	fTrackWeight(),
 	fHMG(0),
 	fBin_Subset(),
 	fBin_h(),
@@ -98,6 +104,11 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const char *name)
 	fNJacek(0),
 	fEffMode(0),
 	fEffFilterBit(0),
+	fQvectors(0),
+	fTrackPhi(),
+	fTrackEta(),
+	fTrackPt(),
+	fTrackWeight(),
 	fHMG(0),
 	fBin_Subset(),
 	fBin_h(),
@@ -166,6 +177,11 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const AliJFFlucAnalysis& a):
 	fNJacek(a.fNJacek),
 	fEffMode(a.fEffMode),
 	fEffFilterBit(a.fEffFilterBit),
+	fQvectors(0),
+	fTrackPhi(),
+	fTrackEta(),
+	fTrackPt(),
+	fTrackWeight(),
 	fHMG(a.fHMG),
 	fBin_Subset(a.fBin_Subset),
 	fBin_h(a.fBin_h),
@@ -210,6 +226,7 @@ void AliJFFlucAnalysis::UserCreateOutputObjects(){
 	cout << "********" << endl;
 	fEfficiency->SetMode( fEffMode ) ; // 0:NoEff 1:Period 2:RunNum 3:Auto
 	fEfficiency->SetDataPath( "alien:///alice/cern.ch/user/d/djkim/legotrain/efficieny/data" );
+	fQvectors = new AliJFFlucQvectors();
 	
 	fHMG = new AliJHistManager("AliJFFlucHistManager","jfluc");
 	// set AliJBin here //
@@ -380,6 +397,7 @@ AliJFFlucAnalysis::~AliJFFlucAnalysis() {
 	delete fInputList;
 	delete fHMG;
 	delete fEfficiency;
+	delete fQvectors;
 }
 
 //________________________________________________________________________
@@ -405,13 +423,7 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	DEBUG(3, "QA Plot filled");
 
 	enum{kSubA, kSubB, kNSub};
-	enum{kMin, kMax};
-	enum{kReal, kImg, kNPhase};
-	Double_t Eta_config[kNSub][2];
-	Eta_config[kSubA][kMin] = fEta_min;  // 0.4 min for SubA
-	Eta_config[kSubA][kMax] = fEta_max;  // 0.8 max for SubA
-	Eta_config[kSubB][kMin] = -fEta_max; // -0.8  min for SubB
-	Eta_config[kSubB][kMax] = -fEta_min; // -0.4  max for SubB
+	// sub-event A is fEta_min <= eta <= fEta_max, B is -fEta_max <= eta <= -fEta_min (see LoadTracks)
 
 	// use complex variable instead of doulbe Qn //
 	TComplex QnA[kNH];
@@ -419,9 +431,11 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	TComplex QnB_star[kNH];
 
 	//--------------- Calculate Qn--------------------
+	// all harmonics, sub-events and pt bins in one pass
+	LoadTracks();
 	for(int ih=0; ih<kNH; ih++){
-		QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-		QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
+		QnA[ih] = fQvectors->QnSP( AliJFFlucQvectors::kSubA, ih );
+		QnB[ih] = fQvectors->QnSP( AliJFFlucQvectors::kSubB, ih );
 		QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
 	}
 	NSubTracks[kSubA] = QnA[0].Re(); // this is number of tracks in Sub A
@@ -441,11 +455,9 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 	TComplex corr[kNH][nKL];
 
-	for(int ih=2; ih<kNH; ih++){
-		corr[ih][1] = QnA[ih]*QnB_star[ih];
-		for(int ik=2; ik<nKL; ik++)
-			corr[ih][ik] = TComplex::Power(QnA[ih]*QnB_star[ih],ik);
-	}
+	// power tables, corr[ih][ik] = (QnA QnB*)^ik
+	for(int ih=2; ih<kNH; ih++)
+		AliJFFlucQvectors::Powers( QnA[ih]*QnB_star[ih], nKL, corr[ih] );
 	
 	for(int ih=2; ih<kNH; ih++){
 		for(int ik=1; ik<nKL; ik++){ // 2k(0) =1, 2k(1) =2, 2k(2)=4....
@@ -463,17 +475,22 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 	//************************************************************************
 
-	TComplex V4V2starv2_2 =	QnA[4] *TComplex::Power( QnB_star[2] ,2) * vn2[2][1] ;
-	TComplex V4V2starv2_4 = QnA[4] * TComplex::Power( QnB_star[2], 2) * vn2[2][2] ;
-	TComplex V4V2star = QnA[4] * TComplex::Power( QnB_star[2], 2 );
+	TComplex QnB2_star_pow[5]; // (QnB_2*)^k
+	TComplex QnB3_star_pow[3]; // (QnB_3*)^k
+	AliJFFlucQvectors::Powers( QnB_star[2], 5, QnB2_star_pow );
+	AliJFFlucQvectors::Powers( QnB_star[3], 3, QnB3_star_pow );
+
+	TComplex V4V2starv2_2 =	QnA[4] * QnB2_star_pow[2] * vn2[2][1] ;
+	TComplex V4V2starv2_4 = QnA[4] * QnB2_star_pow[2] * vn2[2][2] ;
+	TComplex V4V2star = QnA[4] * QnB2_star_pow[2];
 	TComplex V5V2starV3starv2_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[2][1] ;
 	TComplex V5V2starV3star = QnA[5] * QnB_star[2] * QnB_star[3] ;
 	TComplex V5V2starV3startv3_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[3][1];
-	TComplex V6V2star_3 = QnA[6] * TComplex::Power( QnB_star[2] , 3) ;
-	TComplex V6V3star_2 = QnA[6] * TComplex::Power( QnB_star[3], 2) ;
-	TComplex V7V2star_2V3star = QnA[7] * TComplex::Power( QnB_star[2] , 2) * QnB_star[3];
-	TComplex V8V2starV3star_2 = QnA[8] * QnB_star[2] * TComplex::Power(QnB_star[3],2);
-	TComplex V8V2star_4 = QnA[8] * TComplex::Power(QnB_star[2],4);
+	TComplex V6V2star_3 = QnA[6] * QnB2_star_pow[3] ;
+	TComplex V6V3star_2 = QnA[6] * QnB3_star_pow[2] ;
+	TComplex V7V2star_2V3star = QnA[7] * QnB2_star_pow[2] * QnB_star[3];
+	TComplex V8V2starV3star_2 = QnA[8] * QnB_star[2] * QnB3_star_pow[2];
+	TComplex V8V2star_4 = QnA[8] * QnB2_star_pow[4];
 
 	// New correlators (Modified by You's correction term for self-correlations)
 	TComplex nV4V2star = (QnA[4] * QnB_star[2] * QnB_star[2]) -( 1./(NSubTracks[1]-1) * QnA[4] * QnB_star[4] );
@@ -539,6 +556,7 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	}
 
 	TComplex corr10[kNH][nKL];
+	TComplex four_pow[kNH][nKL];
 
 	for(int ih=2; ih < kNH; ih++){
 		four[ih] = ((Q(ih,1)*Q(ih,1)*Q(-ih,1)*Q(-ih,1)+Q(2*ih,1)*Q(-2*ih,1)-TComplex(2,0)*(Q(2*ih,1)*Q(-ih,1)*Q(-ih,1)).Re())
@@ -546,17 +564,14 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		two[ih] = (Q(ih,1)*Q(-ih,1)-M)/(M*(M-TComplex(1,0)));
 		two_eta10[ih] = (QvectorQCeta10[ih][kSubA]*TComplex::Conjugate(QvectorQCeta10[ih][kSubB])) / qcn_10;
 
-		corr[ih][1] = two[ih];
-		corr10[ih][1] = two_eta10[ih];
-		for(int ik=2; ik < nKL; ik++){
-			corr[ih][ik] = TComplex::Power(two[ih],ik);
-			corr10[ih][ik] = TComplex::Power(two_eta10[ih],ik);
-		}
+		AliJFFlucQvectors::Powers( two[ih], nKL, corr[ih] );
+		AliJFFlucQvectors::Powers( two_eta10[ih], nKL, corr10[ih] );
+		AliJFFlucQvectors::Powers( four[ih], nKL, four_pow[ih] );
 	}
 
 	for(int ih=2; ih < kNH; ih++){
 		for(int ik=1; ik<nKL; ik++){
-			Double_t cn = TComplex::Power(four[ih],ik).Re();
+			Double_t cn = four_pow[ih][ik].Re();
 			fh_cn_4c[ih][ik][fCBin]->Fill(cn,qw1_4);
 			fh_cn_2c[ih][ik][fCBin]->Fill(corr[ih][ik].Re(),qw1);
 			fh_cn_2c_eta10[ih][ik][fCBin]->Fill(corr10[ih][ik].Re(),qw1_10);
@@ -574,34 +589,20 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 	if(IsSCptdep == kTRUE){
 		const int SCNH = 9; // 0, 1, 2(v2), 3(v3), 4(v4), 5(v5)
-		Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
-		//init
 		TComplex QnA_pt[SCNH][N_ptbins];
 		TComplex QnB_pt[SCNH][N_ptbins];
 		TComplex QnB_pt_star[SCNH][N_ptbins];
-		for(int ih=2; ih<SCNH; ih++){
-			for(int ipt=0; ipt<N_ptbins; ipt++){
-				QnA_pt[ih][ipt] = TComplex(0,0);
-				QnB_pt[ih][ipt] = TComplex(0,0);
-				QnB_pt_star[ih][ipt] = TComplex(0,0);
-			}
-		}
-
-		// calculate Qn for each pt bins
-		for(int ih=2; ih<SCNH; ih++){
-			for(int ipt=0; ipt<N_ptbins; ipt++){
-				Double_t pt_bin_min = ptbin_borders[ipt];
-				Double_t pt_bin_max = ptbin_borders[ipt+1];
-				Double_t QAReal=Get_Qn_Real_pt( Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
-				Double_t QAImag=Get_Qn_Img_pt(  Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
-
-				Double_t QBReal=Get_Qn_Real_pt( Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
-				Double_t QBImag=Get_Qn_Img_pt(  Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
 
-				QnA_pt[ih][ipt]= TComplex(QAReal, QAImag);
-				QnB_pt[ih][ipt]= TComplex(QBReal, QBImag);
+		// Qn for each pt bin, filled by LoadTracks
+		for(int ipt=0; ipt<N_ptbins; ipt++){
+			for(int ih=2; ih<SCNH; ih++){
+				QnA_pt[ih][ipt] = fQvectors->QnSPpt( AliJFFlucQvectors::kSubA, ih, ipt );
+				QnB_pt[ih][ipt] = fQvectors->QnSPpt( AliJFFlucQvectors::kSubB, ih, ipt );
 				QnB_pt_star[ih][ipt] = TComplex::Conjugate( QnB_pt[ih][ipt] ) ;
 			}
+			// index 1 is the eta>0 side
+			NSubTracks_pt[1][ipt] = fQvectors->SumWeightsSPpt( AliJFFlucQvectors::kSubA, ipt );
+			NSubTracks_pt[0][ipt] = fQvectors->SumWeightsSPpt( AliJFFlucQvectors::kSubB, ipt );
 		}
 
 		for(int ipt=0; ipt<N_ptbins; ipt++){
@@ -750,41 +751,6 @@ void AliJFFlucAnalysis::Fill_QA_plot( Double_t eta1, Double_t eta2 )
 	fh_TrkQA_FB32_vs_FB32TOF->Fill(fFB32trks,fFB32TOFtrks);
 }
 
-//________________________________________________________________________
-TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int harmonics)
-{
-	int ih=harmonics;
-	TComplex Qn = TComplex(0,0);
-	Double_t Sub_Ntrk = 0; // number of Tracks * effCorr * phi modulation factor
-	Long64_t ntracks = fInputList->GetEntriesFast();
-	for(Long64_t it=0; it< ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t pt = itrack->Pt();
-		Double_t eta = itrack->Eta();
-		Double_t phi = itrack->Phi();
-		if( eta < eta1 || eta > eta2)
-			continue; // eta cut
-
-		Double_t phi_module_corr = 1;
-		int isub = -1;
-		if( eta < 0 )
-			isub = 0;
-		if( eta > 0 )
-			isub = 1;
-		if( IsPhiModule == kTRUE){
-			phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );
-		}
-		Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
-
-		Qn += TComplex( 1./effCorr * phi_module_corr * TMath::Cos(ih*phi), 1./effCorr * phi_module_corr * TMath::Sin(ih*phi) );
-		Sub_Ntrk += 1./effCorr * phi_module_corr ;
-	}
-
-	if( ih !=0)
-		Qn /= Sub_Ntrk; // Use Qn[0] as total number of tracks(*eff)
-
-	return Qn;
-}
 ///________________________________________________________________________
 Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Double_t QnB_real, Double_t QnB_img )
 {
@@ -798,76 +764,43 @@ Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Doubl
 	return QC_Vn;
 }
 //________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Real_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-	if( eta1 > eta2) cout << "ERROR eta1 should be smaller than eta2!!!" << endl;
-	int nh = harmonics;
-	Double_t Qn_real = 0;
-	Double_t Sub_Ntrk =0;
-
-	Long64_t ntracks = fInputList->GetEntriesFast();
-	for( Long64_t it=0; it< ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t eta = itrack->Eta();
-		Double_t pt = itrack->Pt();
-		if( pt > pt_min && pt < pt_max){
-			if( eta>eta1 &&  eta<eta2 ){
-				int isub = -1;
-				if( eta < 0 )
-					isub = 0;
-				if( eta > 0 )
-					isub = 1;
-				Double_t phi = itrack->Phi();
-				Double_t phi_module_corr =1;
-				if( IsPhiModule == kTRUE){
-					phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-				}
-				Double_t pt = itrack->Pt();
-				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-				Qn_real += 1.0 / effCorr * phi_module_corr * TMath::Cos( nh * phi);
-				Sub_Ntrk = Sub_Ntrk + 1.0 / effCorr * phi_module_corr;
-			}
-		}
+void AliJFFlucAnalysis::LoadTracks(){
+	// copy the tracks to flat arrays, evaluate the efficiency and phi modulation
+	// corrections once per track and build all Q-vectors of the event in one pass
+	static const Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
+	int ntracks = fInputList->GetEntriesFast();
+	if( fTrackPhi.GetSize() < ntracks ){
+		fTrackPhi.Set(ntracks);
+		fTrackEta.Set(ntracks);
+		fTrackPt.Set(ntracks);
+		fTrackWeight.Set(ntracks);
 	}
-	Qn_real /= Sub_Ntrk;
-	int iside = 0; // eta -
-	if (eta1 > 0 )
-		iside = 1; // eta +
-	NSubTracks_pt[iside][ptbin] = Sub_Ntrk; // it will be overwrite for each harmonics but should be same.
-
-	return Qn_real;
-}
-//________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Img_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-	int nh = harmonics;
-	Double_t Qn_img = 0;
-	Double_t Sub_Ntrk =0;
-
-	Long64_t ntracks = fInputList->GetEntriesFast();
-	for( Long64_t it=0; it< ntracks; it++){
+	for(int it=0; it<ntracks; it++){
 		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t eta = itrack->Eta();
 		Double_t pt = itrack->Pt();
-		if(pt>pt_min && pt<pt_max){
-			if( eta > eta1 && eta < eta2 ){
-				int isub = -1;
-				if( eta < 0 ) isub = 0;
-				if( eta > 0 ) isub = 1;
-				Double_t phi = itrack->Phi();
-				Double_t phi_module_corr =1;
-				if( IsPhiModule == kTRUE){
-					phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-				}
-				Double_t pt = itrack->Pt();
-				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-				Qn_img += 1./ effCorr * phi_module_corr * TMath::Sin( nh * phi);
-				Sub_Ntrk = Sub_Ntrk + 1./ effCorr * phi_module_corr;
-			}
+		Double_t eta = itrack->Eta();
+		Double_t phi = itrack->Phi();
+		Double_t phi_module_corr = 1;
+		int isub = -1;
+		if( eta < 0 )
+			isub = 0;
+		if( eta > 0 )
+			isub = 1;
+		if( IsPhiModule == kTRUE && isub >= 0 ){
+			phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );
 		}
+		Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
+		fTrackPhi[it] = phi;
+		fTrackEta[it] = eta;
+		fTrackPt[it] = pt;
+		fTrackWeight[it] = 1./effCorr * phi_module_corr;
 	}
-	Qn_img /= Sub_Ntrk;
-	return Qn_img;
+
+	fQvectors->SetSPEtaRange( fEta_min, fEta_max );
+	fQvectors->SetQCEtaRange( fQC_eta_cut_min, fQC_eta_cut_max );
+	fQvectors->SetQCEtaGap( 0.5 );
+	fQvectors->SetPtBins( IsSCptdep == kTRUE ? (int)N_ptbins : 0, ptbin_borders );
+	fQvectors->Fill( ntracks, fTrackPhi.GetArray(), fTrackEta.GetArray(), fTrackPt.GetArray(), fTrackWeight.GetArray() );
 }
 ///________________________________________________________________________
 /* new Function for QC method
@@ -876,56 +809,16 @@ Double_t AliJFFlucAnalysis::Get_Qn_Img_pt(Double_t eta1, Double_t eta2, int harm
 //________________________________________________________________________
 void AliJFFlucAnalysis::CalculateQvectorsQC(){
 	// calcualte Q-vector for QC method ( no subgroup )
-	//init
+	// the Q-vectors come from the one-pass kernel filled in LoadTracks (unit weights,
+	// fQC_eta_cut_min <= eta <= fQC_eta_cut_max, |eta| > 0.5 for the eta gap sub-events).
+	// The track loop used to add every track once per order ik, the factor nKL is
+	// kept so that the QC results do not change.
 	for(int ih=0; ih<kNH; ih++){
-		QvectorQC[ih] = TComplex(0, 0);
+		QvectorQC[ih] = Double_t(nKL) * fQvectors->QnQC(ih);
 		for(int isub=0; isub<2; isub++){
-			QvectorQCeta10[ih][isub] = TComplex(0, 0);
-		}
-	} // for max harmonics
-	//Calculate Q-vector with particle loop
-	Long64_t ntracks = fInputList->GetEntriesFast(); // all tracks from Task input
-	for( Long64_t it=0; it<ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t phi = itrack->Phi();
-		Double_t eta = itrack->Eta();
-		// track Eta cut Note! pt cuts already applied in AliJFFlucTask.cxx
-		// Do we need arbitary Eta cut for QC method?
-		// fixed eta ranged -0.8 < eta < 0.8 for QC
-//				if( TMath::Abs(eta) > fEta_max || TMath::Abs(eta) < fEta_min ) continue; << this is SP cut
-//				if( TMath::Abs(eta) > 0.8 ) continue;  //   << this is old QC cut
-		// we need more configuration for to study eta dep of SC(m,n) with QC method.
-		// eta cut among all tracks (this is not same with SC(m,n) SP method (SP method needs symmetric eta range)//
-		if( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max)
-			continue;
-		/////////////////////////////////////////////////
-
-		for(int ih=0; ih<kNH; ih++){
-			for(int ik=0; ik<nKL; ik++){
-				QvectorQC[ih] += TComplex( TMath::Cos(ih*phi), TMath::Sin(ih*phi) );
-				// this is not working (there are no eta gap for +0.6, +0.61 in this way..
-				// fix this as like SP -> 2 sub event //
-				if( TMath::Abs(eta) > 0.5 ){  // this is for Noramlized SC ( denominator need eta gap )
-					int isub = 0;
-					if( eta > 0 )
-						isub = 1; // what about eta=0?
-					QvectorQCeta10[ih][isub] += TComplex( TMath::Cos(ih*phi), TMath::Sin(ih*phi) );
-				}
-			}
+			QvectorQCeta10[ih][isub] = Double_t(nKL) * fQvectors->QnQCEtaGap(ih, isub);
 		}
-	} // track loop done.
-
-
-	// Q-vector[ih][ik] calculated doen. //(need ik??)
-
-	/*
-	// Save QA plot
-	for(int ih=2; ih<kNH; ih++){
-	fh_QvectorQC[ih][fCBin]->Fill( QvectorQC[ih][1].Re()/QvectorQC[0][1].Re() , QvectorQC[ih][1].Im()/QvectorQC[0][1].Re() ); // fill normalized Q vector
-	fh_QvectorQCphi[ih][fCBin]->Fill( QvectorQC[ih][1].Theta() );
 	}
-	// Q-vector calculated
-	 */
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Q(int n, int p){
@@ -14,10 +14,12 @@
 #include "AliJHistManager.h"
 #include "AliVVertex.h"
 #include <TComplex.h>
+#include <TArrayD.h>
 
 class TClonesArray;
 class AliJBaseTrack;
 class AliJEfficiency;
+class AliJFFlucQvectors;
 
 class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 public:
@@ -55,10 +57,6 @@ public:
 	
 	inline void DEBUG(int level, TString msg){if(level<fDebugLevel) std::cout<<level<<"\t"<<msg<<endl;}
 
-	TComplex CalculateQnSP( double eta1, double eta2, int harmonics);
-
-	double Get_Qn_Real_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
-	double Get_Qn_Img_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
 	double Get_QC_Vn( double QnA_real, double QnA_img, double QnB_real, double QnB_img);
 	void Fill_QA_plot(double eta1, double eta2 );
 
@@ -75,6 +73,8 @@ public:
 	Double_t Get_vn( int ih, int imethod ){ return fSingleVn[ih][imethod]; } // method 0:SP, 1:QC(with eta gap), 2:QC(without eta gap)
 
 private:
+	void LoadTracks(); // flat track arrays and one-pass Q-vectors of the event
+
 	enum{kH0, kH1, kH2, kH3, kH4, kH5, kH6, kH7, kH8, kNH}; //harmonics // do we need vn up to v8? .. yes we need..
 	enum{kK0, kK1, kK2, kK3, kK4, nKL}; // order // do we really need vn^8
 
@@ -113,6 +113,12 @@ private:
 	TComplex QvectorQC[kNH];
 	TComplex QvectorQCeta10[kNH][2]; // ksub
 
+	AliJFFlucQvectors *fQvectors;//! // Q-vector kernel
+	TArrayD fTrackPhi;//!
+	TArrayD fTrackEta;//!
+	TArrayD fTrackPt;//!
+	TArrayD fTrackWeight;//! // phi modulation correction / efficiency
+
 	TH1D *h_phi_module[7][2]; // cent, isub
 	TFile *inclusFile; // pointer for root file
 
@@ -163,7 +169,7 @@ private:
 	AliJTH1D fh_QvectorQCphi;//!
 	AliJTH1D fh_evt_SP_QC_ratio_2p;//! // check SP QC evt by evt ratio
 	AliJTH1D fh_evt_SP_QC_ratio_4p;//! // check SP QC evt by evt ratio
-	ClassDef(AliJFFlucAnalysis, 1); // example of analysis
+	ClassDef(AliJFFlucAnalysis, 2); // example of analysis
 };
 
 #endif
@@ -0,0 +1,213 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//==================================================================
+// One-pass Q-vector kernel for AliJFFlucAnalysis.
+// Tracks are processed in blocks; cos(n*phi) and sin(n*phi) of all
+// harmonics follow from cos(phi), sin(phi) by angle addition and the
+// acceptance of every Q-vector enters as a weight mask, so the inner
+// loops are branch free and can be vectorized by the compiler.
+//==================================================================
+
+#include <TMath.h>
+#include "AliJFFlucQvectors.h"
+
+ClassImp(AliJFFlucQvectors)
+
+namespace {
+	const Int_t kBlockSize = 32; // tracks processed together
+}
+
+//________________________________________________________________________
+AliJFFlucQvectors::AliJFFlucQvectors()
+	: TObject(),
+	fSPEtaMin(0),
+	fSPEtaMax(0),
+	fQCEtaMin(-0.8),
+	fQCEtaMax(0.8),
+	fQCEtaGap(0.5),
+	fNPtBins(0)
+{
+	// constructor
+	for(int i=0; i<=kMaxPtBins; i++)
+		fPtBorders[i] = 0;
+	Reset();
+}
+//________________________________________________________________________
+AliJFFlucQvectors::~AliJFFlucQvectors()
+{
+	// destructor
+}
+//________________________________________________________________________
+void AliJFFlucQvectors::SetPtBins( Int_t nbins, const Double_t *borders )
+{
+	// pt bins (borders excluded) for the pt dependent sub-event Q-vectors
+	if( nbins > kMaxPtBins ){
+		Error("SetPtBins", "at most %d pt bins are supported", kMaxPtBins);
+		nbins = kMaxPtBins;
+	}
+	fNPtBins = nbins > 0 ? nbins : 0;
+	for(int i=0; i<fNPtBins+1 && fNPtBins>0; i++)
+		fPtBorders[i] = borders[i];
+}
+//________________________________________________________________________
+void AliJFFlucQvectors::Reset()
+{
+	// zero all Q-vectors
+	for(int ih=0; ih<kNH; ih++){
+		fReQC[ih] = fImQC[ih] = 0;
+		for(int isub=0; isub<kNSub; isub++){
+			fReSP[isub][ih] = fImSP[isub][ih] = 0;
+			fReQCGap[isub][ih] = fImQCGap[isub][ih] = 0;
+			for(int ipt=0; ipt<kMaxPtBins; ipt++)
+				fReSPpt[isub][ipt][ih] = fImSPpt[isub][ipt][ih] = 0;
+		}
+	}
+	for(int isub=0; isub<kNSub; isub++)
+		for(int ipt=0; ipt<kMaxPtBins; ipt++)
+			fSumSPpt[isub][ipt] = 0;
+}
+//________________________________________________________________________
+void AliJFFlucQvectors::Fill( Int_t ntracks, const Double_t *phi, const Double_t *eta, const Double_t *pt, const Double_t *weight )
+{
+	// build the Q-vectors of all harmonics in one pass over the tracks
+	Reset();
+	Double_t unit[kBlockSize];
+	for(int i=0; i<kBlockSize; i++)
+		unit[i] = 1.;
+	for(int first=0; first<ntracks; first+=kBlockSize){
+		int n = TMath::Min(kBlockSize, ntracks-first);
+		ProcessBlock( n, phi+first, eta+first, pt ? pt+first : 0, weight ? weight+first : unit );
+	}
+
+	// SP Q-vectors are normalized, Qn[0] keeps the sum of weights
+	for(int isub=0; isub<kNSub; isub++){
+		for(int ih=1; ih<kNH; ih++){
+			fReSP[isub][ih] /= fReSP[isub][0];
+			fImSP[isub][ih] /= fReSP[isub][0];
+		}
+		for(int ipt=0; ipt<fNPtBins; ipt++){
+			for(int ih=0; ih<kNH; ih++){
+				fReSPpt[isub][ipt][ih] /= fSumSPpt[isub][ipt];
+				fImSPpt[isub][ipt][ih] /= fSumSPpt[isub][ipt];
+			}
+		}
+	}
+}
+//________________________________________________________________________
+void AliJFFlucQvectors::ProcessBlock( Int_t n, const Double_t *phi, const Double_t *eta, const Double_t *pt, const Double_t *weight )
+{
+	// accumulate up to kBlockSize tracks
+	Double_t c1[kBlockSize], s1[kBlockSize]; // cos(phi), sin(phi)
+	Double_t ch[kBlockSize], sh[kBlockSize]; // cos(h*phi), sin(h*phi)
+	Double_t wA[kBlockSize], wB[kBlockSize]; // weight if in sub-event A (B), else 0
+	Double_t wQC[kBlockSize], wG0[kBlockSize], wG1[kBlockSize]; // 0 or 1
+	Double_t cTab[kNH][kBlockSize], sTab[kNH][kBlockSize]; // for the pt bins
+
+	for(int i=0; i<n; i++){
+		c1[i] = TMath::Cos(phi[i]);
+		s1[i] = TMath::Sin(phi[i]);
+		ch[i] = 1.;
+		sh[i] = 0.;
+		Double_t e = eta[i];
+		wA[i] = ( e >= fSPEtaMin && e <= fSPEtaMax ) ? weight[i] : 0.;
+		wB[i] = ( e >= -fSPEtaMax && e <= -fSPEtaMin ) ? weight[i] : 0.;
+		Bool_t inQC = e >= fQCEtaMin && e <= fQCEtaMax;
+		wQC[i] = inQC ? 1. : 0.;
+		Bool_t inGap = inQC && TMath::Abs(e) > fQCEtaGap;
+		wG0[i] = ( inGap && e <= 0 ) ? 1. : 0.;
+		wG1[i] = ( inGap && e > 0 ) ? 1. : 0.;
+	}
+
+	for(int ih=0; ih<kNH; ih++){
+		Double_t reA = 0, imA = 0, reB = 0, imB = 0, reQC = 0, imQC = 0, reG0 = 0, imG0 = 0, reG1 = 0, imG1 = 0;
+		for(int i=0; i<n; i++){
+			reA += wA[i]*ch[i];
+			imA += wA[i]*sh[i];
+			reB += wB[i]*ch[i];
+			imB += wB[i]*sh[i];
+			reQC += wQC[i]*ch[i];
+			imQC += wQC[i]*sh[i];
+			reG0 += wG0[i]*ch[i];
+			imG0 += wG0[i]*sh[i];
+			reG1 += wG1[i]*ch[i];
+			imG1 += wG1[i]*sh[i];
+		}
+		fReSP[kSubA][ih] += reA;
+		fImSP[kSubA][ih] += imA;
+		fReSP[kSubB][ih] += reB;
+		fImSP[kSubB][ih] += imB;
+		fReQC[ih] += reQC;
+		fImQC[ih] += imQC;
+		fReQCGap[0][ih] += reG0;
+		fImQCGap[0][ih] += imG0;
+		fReQCGap[1][ih] += reG1;
+		fImQCGap[1][ih] += imG1;
+
+		if( fNPtBins > 0 ){
+			for(int i=0; i<n; i++){
+				cTab[ih][i] = ch[i];
+				sTab[ih][i] = sh[i];
+			}
+		}
+		// angle addition: (h+1)*phi from h*phi and phi
+		for(int i=0; i<n; i++){
+			Double_t c = ch[i]*c1[i] - sh[i]*s1[i];
+			sh[i] = sh[i]*c1[i] + ch[i]*s1[i];
+			ch[i] = c;
+		}
+	}
+
+	if( fNPtBins == 0 || !pt )
+		return;
+	// pt dependent sub-events, borders excluded in eta and pt
+	for(int i=0; i<n; i++){
+		Double_t e = eta[i];
+		int isub = -1;
+		if( e > fSPEtaMin && e < fSPEtaMax )
+			isub = kSubA;
+		else if( e > -fSPEtaMax && e < -fSPEtaMin )
+			isub = kSubB;
+		if( isub < 0 )
+			continue;
+		int ipt = -1;
+		for(int ib=0; ib<fNPtBins; ib++){
+			if( pt[i] > fPtBorders[ib] && pt[i] < fPtBorders[ib+1] ){
+				ipt = ib;
+				break;
+			}
+		}
+		if( ipt < 0 )
+			continue;
+		Double_t w = weight[i];
+		Double_t *re = fReSPpt[isub][ipt];
+		Double_t *im = fImSPpt[isub][ipt];
+		for(int ih=0; ih<kNH; ih++){
+			re[ih] += w*cTab[ih][i];
+			im[ih] += w*sTab[ih][i];
+		}
+		fSumSPpt[isub][ipt] += w;
+	}
+}
+//________________________________________________________________________
+void AliJFFlucQvectors::Powers( const TComplex &z, Int_t n, TComplex *powers )
+{
+	// z^0 .. z^(n-1); replaces TComplex::Power, which goes through the polar form
+	if( n <= 0 )
+		return;
+	powers[0] = TComplex(1,0);
+	for(int k=1; k<n; k++)
+		powers[k] = powers[k-1]*z;
+}
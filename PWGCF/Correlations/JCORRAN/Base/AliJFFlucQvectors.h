@@ -0,0 +1,73 @@
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice */
+
+// Q-vector kernel of AliJFFlucAnalysis: the Q-vectors of all harmonics
+// for the scalar product sub-events, the QC range, the QC eta gap
+// sub-events and (optionally) the pt bins of the sub-events are built
+// in one pass over flat track arrays.
+
+#ifndef AliJFFlucQvectors_H
+#define AliJFFlucQvectors_H
+
+#include <TObject.h>
+#include <TComplex.h>
+
+class AliJFFlucQvectors : public TObject {
+public:
+	enum{kNH=9}; // harmonics 0..8, as AliJFFlucAnalysis
+	enum{kSubA, kSubB, kNSub};
+	enum{kMaxPtBins=8};
+
+	AliJFFlucQvectors();
+	virtual ~AliJFFlucQvectors();
+
+	// acceptance of the sub-events; A is [etaMin,etaMax], B is [-etaMax,-etaMin]
+	void SetSPEtaRange( Double_t etaMin, Double_t etaMax ){ fSPEtaMin = etaMin; fSPEtaMax = etaMax; }
+	void SetQCEtaRange( Double_t etaMin, Double_t etaMax ){ fQCEtaMin = etaMin; fQCEtaMax = etaMax; }
+	void SetQCEtaGap( Double_t gap ){ fQCEtaGap = gap; } // |eta| > gap for the QC sub-events
+	void SetPtBins( Int_t nbins, const Double_t *borders ); // nbins=0 switches the pt bins off
+
+	// build all Q-vectors; weight may be NULL (unit weights)
+	void Fill( Int_t ntracks, const Double_t *phi, const Double_t *eta, const Double_t *pt, const Double_t *weight );
+
+	// scalar product Q-vectors, normalized to the sum of weights except for ih=0
+	TComplex QnSP( Int_t isub, Int_t ih ) const { return TComplex(fReSP[isub][ih],fImSP[isub][ih]); }
+	Double_t SumWeightsSP( Int_t isub ) const { return fReSP[isub][0]; }
+	TComplex QnSPpt( Int_t isub, Int_t ih, Int_t ipt ) const { return TComplex(fReSPpt[isub][ipt][ih],fImSPpt[isub][ipt][ih]); }
+	Double_t SumWeightsSPpt( Int_t isub, Int_t ipt ) const { return fSumSPpt[isub][ipt]; }
+	// unweighted QC Q-vectors, not normalized
+	TComplex QnQC( Int_t ih ) const { return TComplex(fReQC[ih],fImQC[ih]); }
+	TComplex QnQCEtaGap( Int_t ih, Int_t isub ) const { return TComplex(fReQCGap[isub][ih],fImQCGap[isub][ih]); }
+
+	// powers[k] = z^k for k<n by repeated multiplication
+	static void Powers( const TComplex &z, Int_t n, TComplex *powers );
+
+private:
+	AliJFFlucQvectors(const AliJFFlucQvectors&);
+	AliJFFlucQvectors& operator=(const AliJFFlucQvectors&);
+
+	void Reset();
+	void ProcessBlock( Int_t n, const Double_t *phi, const Double_t *eta, const Double_t *pt, const Double_t *weight );
+
+	Double_t fSPEtaMin;
+	Double_t fSPEtaMax;
+	Double_t fQCEtaMin;
+	Double_t fQCEtaMax;
+	Double_t fQCEtaGap;
+	Int_t fNPtBins;
+	Double_t fPtBorders[kMaxPtBins+1];
+
+	Double_t fReSP[kNSub][kNH]; //!
+	Double_t fImSP[kNSub][kNH]; //!
+	Double_t fReQC[kNH]; //!
+	Double_t fImQC[kNH]; //!
+	Double_t fReQCGap[kNSub][kNH]; //!
+	Double_t fImQCGap[kNSub][kNH]; //!
+	Double_t fReSPpt[kNSub][kMaxPtBins][kNH]; //!
+	Double_t fImSPpt[kNSub][kMaxPtBins][kNH]; //!
+	Double_t fSumSPpt[kNSub][kMaxPtBins]; //!
+
+	ClassDef(AliJFFlucQvectors, 1); // one-pass Q-vectors for AliJFFlucAnalysis
+};
+
+#endif
@@ -54,6 +54,7 @@ AliAnaParticleIsolation::AliAnaParticleIsolation() :
 AliAnaCaloTrackCorrBaseClass(),
 fIsoDetector(-1),                 fIsoDetectorString(""),
 fReMakeIC(0),                     fMakeSeveralIC(0),
+fUseConeIndex(0),
 fFillTMHisto(0),                  fFillSSHisto(1),                          
 fFillEMCALRegionHistograms(0),    fFillUEBandSubtractHistograms(1), 
 fFillCellHistograms(0),
@@ -6714,6 +6715,7 @@ void AliAnaParticleIsolation::InitParameters()
   
   fReMakeIC = kFALSE ;
   fMakeSeveralIC = kFALSE ;
+  fUseConeIndex = kTRUE ;
   
   fMinCellsAngleOverlap = 3.;
   
@@ -6954,6 +6956,10 @@ void  AliAnaParticleIsolation::MakeAnalysisFillAOD()
     naod  = idLeading+1; // last entry in particle loop
   }
   
+  // Tracks and clusters sorted in eta-phi cells once for all the candidates
+  if(fUseConeIndex)
+    GetIsolationCut()->BuildConeIndex(GetCTSTracks(), pl, GetReader(), GetCaloPID());
+  
   // Check isolation of list of candidate particles or leading particle
   
   for(Int_t iaod = iaod0; iaod < naod; iaod++)
@@ -6991,6 +6997,8 @@ void  AliAnaParticleIsolation::MakeAnalysisFillAOD()
     
     AliDebug(1,Form("Particle isolated? %i; if so with index %d",isolated,iaod));
   } // particle isolation loop
+  
+  if(fUseConeIndex) GetIsolationCut()->ResetConeIndex();
 }
 
 //_________________________________________________________
@@ -7882,7 +7890,7 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
   Float_t ptsumcorg  = GetIsolationCut()->GetSumPtThreshold();
   Float_t rorg       = GetIsolationCut()->GetConeSize();
   
-  Float_t coneptsum = 0, coneptlead = 0;
+  Float_t coneptsum = 0;
   Int_t   n    [10][10];//[fNCones][fNPtThresFrac];
   Int_t   nfrac[10][10];//[fNCones][fNPtThresFrac];
   Bool_t  isolated  = kFALSE;
@@ -7938,19 +7946,26 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
   if(GetReader()->GetDataType() != AliCaloTrackReader::kMC)
     GetReader()->GetVertex(vertex);
   
+  // Recover reference arrays with clusters and tracks
+  TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
+  TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
+  
+  //If too small or too large pt, skip, before computing the cone sums
+  if(ptC < GetMinPt() || ptC > GetMaxPt() ) return ;
+  
+  // Cone and UE band sums for all the cone sizes in one pass over the reference arrays,
+  // the pt thresholds below only change the isolation decision
+  Float_t sums[10*AliIsolationCut::kNConeSums];//[fNCones*kNConeSums]
+  GetIsolationCut()->MakeSeveralConesSums(reftracks, refclusters,
+                                          GetReader(), GetCaloPID(), ph,
+                                          fNCones, fConeSizes, sums);
+  
   // Loop on cone sizes
   for(Int_t icone = 0; icone<fNCones; icone++)
   {
-    // Recover reference arrays with clusters and tracks
-    TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
-    TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
-    
-    //If too small or too large pt, skip
-    if(ptC < GetMinPt() || ptC > GetMaxPt() ) continue ;
-    
     //In case a more strict IC is needed in the produced AOD
     
-    isolated = kFALSE; coneptsum = 0; coneptlead = 0;
+    isolated = kFALSE; coneptsum = 0;
     
     GetIsolationCut()->SetSumPtThreshold(100);
     GetIsolationCut()->SetPtThreshold(100);
@@ -8057,11 +8072,9 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
       GetIsolationCut()->SetPtFraction(fPtFractions[ipt]) ;
       GetIsolationCut()->SetSumPtThreshold(fSumPtThresholds[ipt]);
       
-      GetIsolationCut()->MakeIsolationCut(reftracks, refclusters,
-                                          GetReader(), GetCaloPID(),
-                                          kFALSE, ph, "",
-                                          n[icone][ipt],nfrac[icone][ipt],
-                                          coneptsum, coneptlead, isolated);
+      GetIsolationCut()->CheckIsolation(ph, GetReader(), &sums[icone*AliIsolationCut::kNConeSums],
+                                        n[icone][ipt],nfrac[icone][ipt],
+                                        coneptsum, isolated);
       
       // Normal pT threshold cut
       
@@ -8230,6 +8243,7 @@ void AliAnaParticleIsolation::Print(const Option_t * opt) const
   
   printf("ReMake Isolation          = %d \n",  fReMakeIC) ;
   printf("Make Several Isolation    = %d \n",  fMakeSeveralIC) ;
+  printf("Use cone index            = %d \n",  fUseConeIndex) ;
   printf("Calorimeter for isolation = %s \n",  GetCalorimeterString().Data()) ;
   printf("Detector for candidate isolation = %s \n", fIsoDetectorString.Data()) ;
   printf("Subtract UE from cone sum pT histo fill %d \n",fFillUEBandSubtractHistograms) ;
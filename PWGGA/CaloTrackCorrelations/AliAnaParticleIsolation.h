@@ -131,6 +131,10 @@ class AliAnaParticleIsolation : public AliAnaCaloTrackCorrBaseClass {
   void         SwitchOnSeveralIsolation()            { fMakeSeveralIC = kTRUE    ; }
   void         SwitchOffSeveralIsolation()           { fMakeSeveralIC = kFALSE   ; }
   
+  Bool_t       IsConeIndexOn()                 const { return fUseConeIndex      ; }
+  void         SwitchOnConeIndex()                   { fUseConeIndex  = kTRUE    ; }
+  void         SwitchOffConeIndex()                  { fUseConeIndex  = kFALSE   ; }
+  
   void         SwitchOnTMHistoFill()                 { fFillTMHisto   = kTRUE    ; }
   void         SwitchOffTMHistoFill()                { fFillTMHisto   = kFALSE   ; }
   
@@ -241,6 +245,7 @@ class AliAnaParticleIsolation : public AliAnaCaloTrackCorrBaseClass {
   TString  fIsoDetectorString ;                       ///<  Candidate particle for isolation detector.
   Bool_t   fReMakeIC ;                                ///<  Do isolation analysis.
   Bool_t   fMakeSeveralIC ;                           ///<  Do analysis for different IC.
+  Bool_t   fUseConeIndex ;                            ///<  Fill the eta-phi index of tracks and clusters once per event for the isolation of all candidates.
   Bool_t   fFillTMHisto;                              ///<  Fill track matching plots.
   Bool_t   fFillSSHisto;                              ///<  Fill Shower shape plots.
   Bool_t   fFillEMCALRegionHistograms ;               ///<  Fill histograms in EMCal slices
@@ -877,7 +882,7 @@ class AliAnaParticleIsolation : public AliAnaCaloTrackCorrBaseClass {
   AliAnaParticleIsolation & operator = (const AliAnaParticleIsolation & iso) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaParticleIsolation,40) ;
+  ClassDef(AliAnaParticleIsolation,41) ;
   /// \endcond
 
 } ;
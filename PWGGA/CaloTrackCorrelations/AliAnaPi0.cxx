@@ -51,7 +51,7 @@ ClassImp(AliAnaPi0) ;
 /// Default Constructor. Initialized parameters with default values.
 //______________________________________________________
 AliAnaPi0::AliAnaPi0() : AliAnaCaloTrackCorrBaseClass(),
-fEventsList(0x0),
+fEventPools(0x0),
 fUseAngleCut(kFALSE),        fUseAngleEDepCut(kFALSE),     fAngleCut(0),                 fAngleMaxCut(0.),
 fMultiCutAna(kFALSE),        fMultiCutAnaSim(kFALSE),      fMultiCutAnaAcc(kFALSE),
 fNPtCuts(0),                 fNAsymCuts(0),                fNCellNCuts(0),               fNPIDBits(0), fNAngleCutBins(0),
@@ -239,22 +239,7 @@ AliAnaPi0::~AliAnaPi0()
 {
   // Remove event containers
   
-  if(DoOwnMix() && fEventsList)
-  {
-    for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-    {
-      for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-      {
-        for(Int_t irp=0; irp<GetNRPBin(); irp++)
-        {
-          Int_t bin = GetEventMixBin(ic,iz,irp);
-          fEventsList[bin]->Delete() ;
-          delete fEventsList[bin] ;
-        }
-      }
-    }
-    delete[] fEventsList;
-  }
+  delete [] fEventPools;
 }
 
 //______________________________
@@ -811,7 +796,9 @@ TList * AliAnaPi0::GetCreateOutputObjects()
   //
   // Create mixed event containers
   //
-  fEventsList = new TList*[GetNCentrBin()*GetNZvertBin()*GetNRPBin()] ;
+  // The buffer keeps GetNMaxEvMix()-1 previous events, the current one
+  // completes the GetNMaxEvMix() events of the mixing.
+  fEventPools = new MixedEventPool[GetNCentrBin()*GetNZvertBin()*GetNRPBin()] ;
   
   for(Int_t ic=0; ic<GetNCentrBin(); ic++)
   {
@@ -820,8 +807,7 @@ TList * AliAnaPi0::GetCreateOutputObjects()
       for(Int_t irp=0; irp<GetNRPBin(); irp++)
       {
         Int_t bin = GetEventMixBin(ic,iz,irp);
-        fEventsList[bin] = new TList() ;
-        fEventsList[bin]->SetOwner(kFALSE);
+        fEventPools[bin].SetCapacity(TMath::Max(GetNMaxEvMix()-1,0)) ;
       }
     }
   }
@@ -4500,19 +4486,19 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
     if(eventbin < 0) return ;
     
-    TList * evMixList=fEventsList[eventbin] ;
-    
-    if(!evMixList)
+    if(!fEventPools)
     {
-      AliWarning(Form("Mix event list not available, bin %d",eventbin));
+      AliWarning(Form("Mix event pool not available, bin %d",eventbin));
       return;
     }
     
-    Int_t nMixed = evMixList->GetSize() ;
+    MixedEventPool & evMixPool = fEventPools[eventbin] ;
+    
+    Int_t nMixed = evMixPool.GetNEvents() ;
     for(Int_t ii=0; ii<nMixed; ii++)
     {
-      TClonesArray* ev2= (TClonesArray*) (evMixList->At(ii));
-      Int_t nPhot2=ev2->GetEntriesFast() ;
+      const std::vector<MixedPhoton> & ev2 = evMixPool.GetEvent(ii);
+      Int_t nPhot2=ev2.size() ;
       Double_t m = -999;
       AliDebug(1,Form("Mixed event %d photon entries %d, centrality bin %d",ii, nPhot2, GetEventCentralityBin()));
       
@@ -4540,16 +4526,14 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         //---------------------------------
         for(Int_t i2 = 0; i2 < nPhot2; i2++)
         {
-          AliCaloTrackParticle * p2 = (AliCaloTrackParticle*) (ev2->At(i2)) ;
-          
-          // Select photons within a pT range
-          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+          // Only photons within the pT range are kept in the pool
+          const MixedPhoton & p2 = ev2[i2] ;
           
           // Get kinematics of second cluster and calculate those of the pair
-          fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
+          fPhotonMom2.SetPxPyPzE(p2.fPx,p2.fPy,p2.fPz,p2.fE);
           m           = (fPhotonMom1+fPhotonMom2).M() ;
           Double_t pt = (fPhotonMom1 + fPhotonMom2).Pt();
-          Double_t a  = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+          Double_t a  = TMath::Abs(p1->E()-p2.fE)/(p1->E()+p2.fE) ;
           
           // Check if opening angle is too large or too small compared to what is expected
           Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
@@ -4565,10 +4549,10 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             continue;
           }
           
-          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), p2->Pt(), pt,m,a));
+          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), p2.fPt, pt,m,a));
           
           // In case we want only pairs in same (super) module, check their origin.
-          module2 = GetModuleNumber(p2);
+          module2 = p2.fModule;
                     
           //-------------------------------------------------------------------------------------------------
           // Fill module dependent histograms, put a cut on assymmetry on the first available cut in the array
@@ -4628,7 +4612,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               Bool_t etaside = 0;
               if(   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-                 || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+                 || (p2.fDetectorTag==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
               
               if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhMiSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight());
               else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhMiSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight());
@@ -4670,8 +4654,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check if one of the clusters comes from a conversion
           if(fCheckConversion)
           {
-            if     (p1->IsTagged() && p2->IsTagged()) fhMiConv2->Fill(pt, m, GetEventWeight());
-            else if(p1->IsTagged() || p2->IsTagged()) fhMiConv ->Fill(pt, m, GetEventWeight());
+            if     (p1->IsTagged() && p2.fTagged) fhMiConv2->Fill(pt, m, GetEventWeight());
+            else if(p1->IsTagged() || p2.fTagged) fhMiConv ->Fill(pt, m, GetEventWeight());
           }
           
           //
@@ -4680,7 +4664,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           //
           for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
           {
-            if((p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && (p2->IsPIDOK(ipid,AliCaloPID::kPhoton)))
+            if((p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && (p2.fPIDBits & (1<<ipid)))
             {
               for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
               {
@@ -4695,12 +4679,12 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                   
                   if(fFillBadDistHisto)
                   {
-                    if(p1->DistToBad()>0 && p2->DistToBad()>0)
+                    if(p1->DistToBad()>0 && p2.fDistToBad>0)
                     {
                       fhMi2[index]->Fill(pt, m, GetEventWeight()) ;
                       if(fMakeInvPtPlots)fhMiInvPt2[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
                       
-                      if(p1->DistToBad()>1 && p2->DistToBad()>1)
+                      if(p1->DistToBad()>1 && p2.fDistToBad>1)
                       {
                         fhMi3[index]->Fill(pt, m, GetEventWeight()) ;
                         if(fMakeInvPtPlots)fhMiInvPt3[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
@@ -4730,8 +4714,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                 {
                   Int_t index = ((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym;
                   
-                  if(p1->Pt() >   fPtCuts[ipt]      && p2->Pt() > fPtCuts[ipt]      &&
-                     p1->Pt() <   fPtCutsMax[ipt]   && p2->Pt() < fPtCutsMax[ipt]   &&
+                  if(p1->Pt() >   fPtCuts[ipt]      && p2.fPt > fPtCuts[ipt]      &&
+                     p1->Pt() <   fPtCutsMax[ipt]   && p2.fPt < fPtCutsMax[ipt]   &&
                      a        <   fAsymCuts[iasym]                                  &&
                      ncell1   >=  fCellNCuts[icell] && ncell2   >= fCellNCuts[icell] 
                      )
@@ -4774,7 +4758,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               Float_t e2   = fPhotonMom2.E();
               
               Float_t t1   = p1->GetTime();
-              Float_t t2   = p2->GetTime();
+              Float_t t2   = p2.fTime;
               
               Int_t nc1    = ncell1;
               Int_t nc2    = ncell2;
@@ -4802,7 +4786,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                 e1   = fPhotonMom2.E();
                 e2   = fPhotonMom1.E();
                 
-                t1   = p2->GetTime();
+                t1   = p2.fTime;
                 t2   = p1->GetTime();
                 
                 nc1  = ncell2;
@@ -4863,10 +4847,10 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check cell time content in cluster
           if ( fFillSecondaryCellTiming )
           {
-            if      ( p1->GetFiducialArea() == 0 && p2->GetFiducialArea() == 0 )
+            if      ( p1->GetFiducialArea() == 0 && p2.fFidArea == 0 )
               fhMiSecondaryCellInTimeWindow ->Fill(pt, m, GetEventWeight());
             
-            else if ( p1->GetFiducialArea() != 0 && p2->GetFiducialArea() != 0 )
+            else if ( p1->GetFiducialArea() != 0 && p2.fFidArea != 0 )
               fhMiSecondaryCellOutTimeWindow->Fill(pt, m, GetEventWeight());
           }
                   
@@ -4878,26 +4862,40 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Add the current event to the list of events for mixing
     //--------------------------------------------------------
     
-    //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
-    TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
-    
-    // Add current event to buffer and Remove redundant events
-    if( currentEvent->GetEntriesFast() > 0 )
+    // Events without photons are not kept; the photons outside the pT range
+    // are never used in the mixed pairs and are not copied
+    Int_t nCurrent = secondLoopInputData->GetEntriesFast() ;
+    if( nCurrent > 0 && evMixPool.GetCapacity() > 0 )
     {
-      evMixList->AddFirst(currentEvent) ;
-      currentEvent=0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
-      if( evMixList->GetSize() >= GetNMaxEvMix() )
+      std::vector<MixedPhoton> & currentEvent = evMixPool.AddEvent() ;
+      
+      for(Int_t i2 = 0; i2 < nCurrent; i2++)
       {
-        TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
-        evMixList->RemoveLast() ;
-        delete tmp ;
+        AliCaloTrackParticle * p2 = (AliCaloTrackParticle*) (secondLoopInputData->At(i2)) ;
+        
+        if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+        
+        MixedPhoton photon ;
+        photon.fPx          = p2->Px() ;
+        photon.fPy          = p2->Py() ;
+        photon.fPz          = p2->Pz() ;
+        photon.fE           = p2->E()  ;
+        photon.fPt          = p2->Pt() ;
+        photon.fTime        = p2->GetTime() ;
+        photon.fModule      = GetModuleNumber(p2) ;
+        photon.fDistToBad   = p2->DistToBad() ;
+        photon.fFidArea     = p2->GetFiducialArea() ;
+        photon.fDetectorTag = p2->GetDetectorTag() ;
+        photon.fTagged      = p2->IsTagged() ;
+        photon.fPIDBits     = 0 ;
+        for(Int_t ipid = 0; ipid < fNPIDBits; ipid++)
+        {
+          if(p2->IsPIDOK(ipid,AliCaloPID::kPhoton)) photon.fPIDBits |= (1<<ipid) ;
+        }
+        
+        currentEvent.push_back(photon) ;
       }
     }
-    else
-    { // empty event
-      delete currentEvent ;
-      currentEvent=0 ;
-    }
   }// DoOwnMix
   
   AliDebug(1,"End fill histograms");
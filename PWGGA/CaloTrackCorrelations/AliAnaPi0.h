@@ -25,6 +25,7 @@
 //_________________________________________________________________________
 
 // Root
+#include <vector>
 class TList;
 class TH3F ;
 class TH2F ;
@@ -182,8 +183,54 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
 
   private:
 
-  /// Containers for photons in stored events
-  TList ** fEventsList ;               //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// \struct MixedPhoton
+  /// Kinematics and flags of a photon/cluster kept for the event mixing,
+  /// the information of the AliCaloTrackParticle used in the mixed pairs.
+  struct MixedPhoton
+  {
+    Double_t fPx, fPy, fPz, fE ;       ///<  4-momentum
+    Double_t fPt ;                     ///<  transverse momentum
+    Float_t  fTime ;                   ///<  cluster time
+    Int_t    fModule ;                 ///<  (super) module number
+    Int_t    fDistToBad ;              ///<  distance to bad channel
+    Int_t    fFidArea ;                ///<  fiducial area
+    UInt_t   fDetectorTag ;            ///<  detector of the cluster
+    UShort_t fPIDBits ;                ///<  bit ipid set if IsPIDOK(ipid,AliCaloPID::kPhoton)
+    Bool_t   fTagged ;                 ///<  tagged particle
+  } ;
+
+  /// \class MixedEventPool
+  /// Photons of the last events of one mixing bin, in a ring of fixed capacity.
+  /// A new event takes the slot of the oldest one and reuses its memory.
+  class MixedEventPool
+  {
+   public:
+    MixedEventPool() : fEvents(), fFirst(0), fNEvents(0) { ; }
+
+    void  SetCapacity(Int_t n)        { fEvents.assign(n, std::vector<MixedPhoton>()) ; fFirst = 0 ; fNEvents = 0 ; }
+    Int_t GetCapacity()         const { return fEvents.size() ; }
+    Int_t GetNEvents()          const { return fNEvents ; }
+
+    /// Photons of the i-th stored event, 0 is the most recent one.
+    const std::vector<MixedPhoton> & GetEvent(Int_t i) const { return fEvents[(fFirst+i) % fEvents.size()] ; }
+
+    /// Empty slot for a new event, the oldest event is dropped if the pool is full.
+    std::vector<MixedPhoton> & AddEvent()
+    {
+      fFirst = (fFirst + fEvents.size() - 1) % fEvents.size() ;
+      if ( fNEvents < Int_t(fEvents.size()) ) fNEvents++ ;
+      fEvents[fFirst].clear() ;
+      return fEvents[fFirst] ;
+    }
+
+   private:
+    std::vector< std::vector<MixedPhoton> > fEvents ; ///<  photons of each slot
+    Int_t    fFirst ;                  ///<  slot of the most recent event
+    Int_t    fNEvents ;                ///<  number of stored events
+  } ;
+
+  /// Pools of photons in stored events
+  MixedEventPool * fEventPools ;       //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
   
   Bool_t   fUseAngleCut ;              ///<  Select pairs depending on their opening angle
   Bool_t   fUseAngleEDepCut ;          ///<  Select pairs depending on their opening angle
@@ -605,7 +652,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   AliAnaPi0 & operator = (const AliAnaPi0 & api0) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaPi0,35) ;
+  ClassDef(AliAnaPi0,36) ;
   /// \endcond
   
 } ;
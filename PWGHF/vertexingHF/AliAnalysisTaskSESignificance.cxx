@@ -88,7 +88,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance():
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fCumulativeFill(kFALSE)
 {
   // Default constructor
   SetPDGCodes();
@@ -128,7 +129,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance(const char *name, T
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fCumulativeFill(kFALSE)
 {
 
   SetPDGCodes();
@@ -620,7 +622,8 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
       TString mdvname=Form("multiDimVectorPtBin%d",ptbin);
       AliMultiDimVector* muvec=(AliMultiDimVector*)fCutList->FindObject(mdvname.Data());
 
-      ULong64_t *addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+      Int_t nEntries=1;
+      ULong64_t *addresses = GetAddressesToFill(muvec,(Float_t)d->Pt(),nVals,nEntries);
       if(fDebug>1)printf("nvals = %d\n",nVals);
       for(Int_t ivals=0;ivals<nVals;ivals++){
 	if(addresses[ivals]>=muvec->GetNTotCells()){
@@ -629,7 +632,7 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	  return;
 	}
 	
-	fHistNEvents->Fill(3);
+	fHistNEvents->Fill(3,nEntries);
 	
 	//fill the histograms with the appropriate method
 	switch (fDecChannel){
@@ -664,7 +667,7 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	nVals=0;
 	fRDCuts->GetCutVarsForOpt(d,fVars,fNVars,fPDGdaughters,aod);
 	delete [] addresses;
-	addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
+	addresses = GetAddressesToFill(muvec,(Float_t)d->Pt(),nVals,nEntries);
 	if(fDebug>1)printf("nvals = %d\n",nVals);
 	for(Int_t ivals=0;ivals<nVals;ivals++){
 	  if(addresses[ivals]>=muvec->GetNTotCells()){
@@ -692,6 +695,28 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 
 // Methods used in the UserExec
 
+//________________________________________________________________________
+ULong64_t* AliAnalysisTaskSESignificance::GetAddressesToFill(const AliMultiDimVector* muvec, Float_t pt, Int_t& nVals, Int_t& nEntries) const{
+  // global addresses of the cells to be filled for a candidate: all the
+  // cells with cuts passed by the candidate or, with fCumulativeFill, only
+  // its own cell (nEntries is then the number of cells with cuts passed,
+  // i.e. the entries the candidate will have after FinishTaskOutput)
+  nEntries=1;
+  if(!fCumulativeFill) return muvec->GetGlobalAddressesAboveCuts(fVars,pt,nVals);
+
+  Int_t nCells=0;
+  ULong64_t address=muvec->GetGlobalAddressOfCell(fVars,pt,nCells);
+  if(nCells==0){
+    nVals=0;
+    return 0x0;
+  }
+  ULong64_t* addresses=new ULong64_t[1];
+  addresses[0]=address;
+  nVals=1;
+  nEntries=nCells;
+  return addresses;
+}
+
 
 //********************************************************************************************
 
@@ -966,6 +991,43 @@ void AliAnalysisTaskSESignificance::FillLambdac(AliAODRecoDecayHF* d,TClonesArra
 }
 
 
+//________________________________________________________________________
+void AliAnalysisTaskSESignificance::FinishTaskOutput()
+{
+  // With fCumulativeFill each candidate was filled only in its own cell:
+  // sum up in each cell the cells with looser or equal cuts, which gives
+  // the histograms of the standard filling. The sum is linear, so doing
+  // it on the output of each worker gives the same merged output.
+  if(!fCumulativeFill || !fOutput) return;
+  const AliMultiDimVector* mdv=(AliMultiDimVector*)fCutList->FindObject("multiDimVectorPtBin0");
+  if(!mdv) return;
+  Int_t nHistpermv=mdv->GetNTotCells();
+  for(Int_t ipt=0;ipt<fNPtBins;ipt++){
+    Int_t first=ipt*nHistpermv;
+    IntegrateCells(fMassHist+first,nHistpermv);
+    if(fReadMC){
+      IntegrateCells(fSigHist+first,nHistpermv);
+      IntegrateCells(fBkgHist+first,nHistpermv);
+      if(fDecChannel != AliAnalysisTaskSESignificance::kDplustoKpipi) IntegrateCells(fRflHist+first,nHistpermv);
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskSESignificance::IntegrateCells(TH1F** hist, Int_t nHist) const
+{
+  // N-dimensional cumulative sum of the histograms of the cells of one
+  // AliMultiDimVector, towards the loose cuts (see AliMultiDimVector::Integrate)
+  const AliMultiDimVector* mdv=(AliMultiDimVector*)fCutList->FindObject("multiDimVectorPtBin0");
+  for(Int_t iVar=0;iVar<mdv->GetNVariables();iVar++){
+    Int_t step=mdv->GetAddressStep(iVar);
+    Int_t nSteps=mdv->GetNCutSteps(iVar);
+    for(Int_t i=nHist-1;i>=0;i--){
+      if((i/step)%nSteps<nSteps-1 && hist[i] && hist[i+step]) hist[i]->Add(hist[i+step]);
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskSESignificance::Terminate(Option_t */*option*/)
 {
@@ -46,6 +46,8 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   void SetDsChannel(Int_t chan){fDsChannel=chan;}
   void SetUseSelBit(Bool_t selBit=kTRUE){fUseSelBit=selBit;}
   void SetAODMismatchProtection(Int_t opt=1) {fAODProtection=opt;}
+  /// fill only the cell of each candidate and sum the cells passing the cuts at the end of the job
+  void SetCumulativeFill(Bool_t opt=kTRUE){fCumulativeFill=opt;}
 
   //void SetMultiVector(const AliMultiDimVector *MultiDimVec){fMultiDimVec->CopyStructure(MultiDimVec);}
   Float_t GetUpperMassLimit()const {return fUpmasslimit;}
@@ -55,11 +57,13 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t GetBFeedDown()const {return fBFeedDown;}
   Int_t GetDsChannel()const {return fDsChannel;}
   Bool_t GetUseSelBit()const {return fUseSelBit;}
+  Bool_t GetCumulativeFill()const {return fCumulativeFill;}
 
   /// Implementation of interface methods
   virtual void UserCreateOutputObjects();
   virtual void LocalInit();// {Init();}
   virtual void UserExec(Option_t *option);
+  virtual void FinishTaskOutput();
   virtual void Terminate(Option_t *option);
     
  private:
@@ -85,6 +89,8 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t GetBackgroundHistoIndex(Int_t iPtBin) const { return iPtBin*3+2;}
   Int_t GetLSHistoIndex(Int_t iPtBin)const { return iPtBin*5;}
   Int_t CheckOrigin(const AliAODMCParticle* mcPart, const TClonesArray* mcArray) const;
+  ULong64_t* GetAddressesToFill(const AliMultiDimVector* muvec, Float_t pt, Int_t& nVals, Int_t& nEntries) const;
+  void IntegrateCells(TH1F** hist, Int_t nHist) const;
 
   void FillDplus(AliAODRecoDecayHF* d,TClonesArray *arrayMC,Int_t index,Int_t isSel);
   void FillD02p(AliAODRecoDecayHF* d,TClonesArray *arrayMC,Int_t index, Int_t isSel);
@@ -129,9 +135,10 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t fDsChannel;          /// Ds resonant channel selected
   Int_t fPDGDStarToD0pi[2]; /// PDG codes for the particles in the D* -> pi + D0 decay
   Int_t fPDGD0ToKpi[2];    /// PDG codes for the particles in the D0 -> K + pi decay
+  Bool_t fCumulativeFill;  /// fill only the cell of the candidate, integrate in FinishTaskOutput
 
   /// \cond CLASSIMP    
-  ClassDef(AliAnalysisTaskSESignificance,6); /// AliAnalysisTaskSE for the MC association of heavy-flavour decay candidates
+  ClassDef(AliAnalysisTaskSESignificance,7); /// AliAnalysisTaskSE for the MC association of heavy-flavour decay candidates
   /// \endcond
 };
 
@@ -22,6 +22,11 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <errno.h>
+#include <stdio.h>
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -65,6 +70,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fUseFixSigFixMean(kTRUE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNumOfWorkers(1),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -189,31 +195,62 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // The trials are independent: they are fitted first (in this process
+  // or, with SetNumberOfWorkers, in forked worker processes) and the
+  // results are then filled in the histograms and in the ntuple in the
+  // order of the trials, so the output does not depend on the number
+  // of workers. Individual fits are drawn only when fitting in this process.
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
-  Int_t itrial=0;
-  Int_t types=0;
-  Int_t itrialBC=0;
-  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
-
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
 
+  std::vector<TrialDef> trials;
+  EnumerateTrials(trials);
+  const Int_t nTrials=trials.size();
+  const Int_t nValues=GetNTrialValues();
+
+  // rebinned histograms, one per (rebin, first bin) step
+  std::vector<TH1F*> hRebinned(fNumOfRebinSteps*fNumOfFirstBinSteps,(TH1F*)0x0);
+  for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
+    for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
+      Int_t ih=ir*fNumOfFirstBinSteps+iFirstBin-1;
+      if(fNumOfFirstBinSteps==1) hRebinned[ih]=RebinHisto(hInvMassHisto,fRebinSteps[ir],-1);
+      else hRebinned[ih]=RebinHisto(hInvMassHisto,fRebinSteps[ir],iFirstBin);
+    }
+  }
+
+  std::vector<Double_t> values((size_t)nTrials*nValues,0.);
+  std::vector<Bool_t> done(nTrials,kFALSE);
+  Bool_t drawFits=fDrawIndividualFits && thePad;
+  if(fNumOfWorkers>1 && nTrials>1){
+    if(drawFits) printf("AliHFMultiTrials: individual fits are drawn, the %d trials are fitted in this process\n",nTrials);
+    else FitTrialsInWorkers(trials,hRebinned,hInvMassHisto,values,done);
+  }
+  for(Int_t it=0; it<nTrials; it++){
+    // trials not done by a worker (or all of them, without workers)
+    if(done[it]) continue;
+    const TrialDef& trial=trials[it];
+    FitTrial(trial,hRebinned[trial.fRebinIndex*fNumOfFirstBinSteps+trial.fFirstBin-1],hInvMassHisto,&values[(size_t)it*nValues],drawFits ? thePad : 0x0);
+  }
+  for(Int_t it=0; it<nTrials; it++) FillTrial(trials[it],&values[(size_t)it*nValues]);
+
+  for(size_t ih=0; ih<hRebinned.size(); ih++) delete hRebinned[ih];
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::EnumerateTrials(std::vector<TrialDef>& trials) const{
+  // list the fit configurations in the order of the output
+  trials.clear();
+  Int_t itrial=0;
+  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
-    Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
-        Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
-          Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
             if(typeb==kExpoBkg && !fUseExpoBkg) continue;
@@ -232,205 +269,352 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
               Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==1) fitter->SetUseChi2Fit();
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialDef trial;
+              trial.fRebinIndex=ir;
+              trial.fFirstBin=iFirstBin;
+              trial.fMinMassIndex=iMinMass;
+              trial.fMaxMassIndex=iMaxMass;
+              trial.fBkgFunc=typeb;
+              trial.fFitConf=igs;
+              trial.fTrial=itrial;
+              trial.fGlobBin=itrial+theCase*totTrials;
+              trials.push_back(trial);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
-  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FitTrial(const TrialDef& trial, TH1F* hRebinned, TH1D* hInvMassHisto, Double_t* values, TPad* thePad){
+  // fit one trial and store the results (see ETrialValues) in values;
+  // the fit is drawn in thePad if given
+
+  Int_t rebin=fRebinSteps[trial.fRebinIndex];
+  Int_t typeb=trial.fBkgFunc;
+  Int_t igs=trial.fFitConf;
+  Int_t types=0;
+  Double_t minMassForFit=fLowLimFitSteps[trial.fMinMassIndex];
+  Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+  Double_t maxMassForFit=fUpLimFitSteps[trial.fMaxMassIndex];
+  Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+  for(Int_t j=0; j<GetNTrialValues(); j++) values[j]=0.;
+
+  Bool_t mustDeleteFitter = kTRUE;
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }
+
+  Double_t chisq=-1.;
+  Double_t sigma=0.;
+  Double_t esigma=0.;
+  Double_t pos=.0;
+  Double_t epos=.0;
+  Double_t significance=0.;
+  Double_t erSignif=0.;
+  Double_t bkg=0.;
+  Double_t erbkg=0.;
+  Double_t bkgBEdge=0;
+  Double_t erbkgBEdge=0;
+  printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,trial.fFirstBin,minMassForFit,maxMassForFit,typeb,igs);
+  Bool_t out=fitter->MassFitter(0);
+  chisq=fitter->GetReducedChiSquare();
+  fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+  sigma=fitter->GetSigma();
+  pos=fitter->GetMean();
+  esigma=fitter->GetSigmaUncertainty();
+  if(esigma<0.00001) esigma=0.0001;
+  epos=fitter->GetMeanUncertainty();
+  if(epos<0.00001) epos=0.0001;
+  TF1* fB1=fitter->GetBackgroundFullRangeFunc();
+  fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+  Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+  Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+  fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+  values[kTrFitOK]=out;
+  values[kTrChi2]=chisq;
+  values[kTrSignif]=significance;
+  values[kTrSignifErr]=erSignif;
+  values[kTrMean]=pos;
+  values[kTrMeanErr]=epos;
+  values[kTrSigma]=sigma;
+  values[kTrSigmaErr]=esigma;
+  values[kTrRawYield]=fitter->GetRawYield();
+  values[kTrRawYieldErr]=fitter->GetRawYieldError();
+  values[kTrBkg]=bkg;
+  values[kTrBkgErr]=erbkg;
+  values[kTrBkgBEdge]=bkgBEdge;
+  values[kTrBkgBEdgeErr]=erbkgBEdge;
+
+  if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    // bin counting, with the background function of this fit
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>minMassForFit &&
+          maxMassBC<maxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        Double_t* bc=values+kNTrialValues+3*iStepBC;
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,bc[1],bc[2]);
+        bc[0]=1;
+      }
+    }
+  }
+
+  if(out && thePad){
+    thePad->Clear();
+    fitter->DrawHere(thePad, fnSigmaForBkgEval);
+    fMassFitters.push_back(fitter);
+    mustDeleteFitter = kFALSE;
+    for (auto format : fInvMassFitSaveAsFormats) {
+      thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),trial.fGlobBin, format.c_str()));
+    }
+  }
+  if (mustDeleteFitter) delete fitter;
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FillTrial(const TrialDef& trial, const Double_t* values){
+  // fill the histograms and the ntuple with the results of a trial
+
+  Int_t igs=trial.fFitConf;
+  Int_t theCase=igs*kNBkgFuncCases+trial.fBkgFunc;
+  Int_t itrial=trial.fTrial;
+  Int_t globBin=trial.fGlobBin;
+  Float_t xnt[15];
+  for(Int_t j=0; j<15; j++) xnt[j]=0.;
+  xnt[0]=fRebinSteps[trial.fRebinIndex];
+  xnt[1]=trial.fFirstBin;
+  xnt[2]=fLowLimFitSteps[trial.fMinMassIndex];
+  xnt[3]=fUpLimFitSteps[trial.fMaxMassIndex];
+  xnt[4]=trial.fBkgFunc;
+  if(igs==kFixSigFreeMean || igs==kFixSigFixMean) xnt[5]=1;
+  else if(igs==kFixSigUpFreeMean) xnt[5]=2;
+  else if(igs==kFixSigDownFreeMean) xnt[5]=3;
+  xnt[6]=(igs==kFixSigFixMean || igs==kFreeSigFixMean) ? 1 : 0;
+
+  Bool_t out=values[kTrFitOK]>0.5;
+  Double_t chisq=values[kTrChi2];
+  Double_t sigma=values[kTrSigma];
+  Double_t esigma=values[kTrSigmaErr];
+  Double_t pos=values[kTrMean];
+  Double_t epos=values[kTrMeanErr];
+  Double_t ry=values[kTrRawYield];
+  Double_t ery=values[kTrRawYieldErr];
+  Double_t significance=values[kTrSignif];
+  Double_t erSignif=values[kTrSignifErr];
+  xnt[7]=chisq;
+  if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    xnt[8]=significance;
+    xnt[9]=pos;
+    xnt[10]=epos;
+    xnt[11]=sigma;
+    xnt[12]=esigma;
+    xnt[13]=ry;
+    xnt[14]=ery;
+    fHistoRawYieldDistAll->Fill(ry);
+    fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+    fHistoRawYieldTrialAll->SetBinError(globBin,ery);
+    fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+    fHistoSigmaTrialAll->SetBinError(globBin,esigma);
+    fHistoMeanTrialAll->SetBinContent(globBin,pos);
+    fHistoMeanTrialAll->SetBinError(globBin,epos);
+    fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+    fHistoSignifTrialAll->SetBinContent(globBin,significance);
+    fHistoSignifTrialAll->SetBinError(globBin,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrialAll->SetBinContent(globBin,values[kTrBkg]);
+      fHistoBkgTrialAll->SetBinError(globBin,values[kTrBkgErr]);
+      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,values[kTrBkgBEdge]);
+      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,values[kTrBkgBEdgeErr]);
+    }
+
+    if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+    if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+    fHistoRawYieldDist[theCase]->Fill(ry);
+    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+    fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
+    fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+    fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
+    fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
+    fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
+    fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+    fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
+    fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrial[theCase]->SetBinContent(itrial,values[kTrBkg]);
+      fHistoBkgTrial[theCase]->SetBinError(itrial,values[kTrBkgErr]);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,values[kTrBkgBEdge]);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,values[kTrBkgBEdgeErr]);
+    }
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      const Double_t* bc=values+kNTrialValues+3*iStepBC;
+      if(bc[0]<0.5) continue;
+      Double_t cnts=bc[1];
+      Double_t ecnts=bc[2];
+      fHistoRawYieldDistBinCAll->Fill(cnts);
+      fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
+      fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+    }
+  }
+  fNtupleMultiTrials->Fill(xnt);
+}
+
+//________________________________________________________________________
+Int_t AliHFMultiTrials::FitTrialsInWorkers(const std::vector<TrialDef>& trials, const std::vector<TH1F*>& hRebinned,
+                                           TH1D* hInvMassHisto, std::vector<Double_t>& values, std::vector<Bool_t>& done){
+  // Fit the trials in fNumOfWorkers forked processes, worker iw taking
+  // trials iw, iw+nWorkers, ... and sending their values back through a
+  // pipe. The fitters use global ROOT state (functions looked up by name,
+  // gMinuit), so the fits cannot run in threads of one process.
+  // Trials not received from a worker are left to the caller.
+  // Returns the number of trials done by the workers.
+
+  const Int_t nTrials=trials.size();
+  const Int_t nValues=GetNTrialValues();
+  Int_t nWorkers=TMath::Min(fNumOfWorkers,nTrials);
+  std::vector<int> pipes;
+  std::vector<pid_t> pids;
+  fflush(stdout);
+  fflush(stderr);
+  for(Int_t iw=0; iw<nWorkers; iw++){
+    int fd[2];
+    if(pipe(fd)!=0) break;
+    pid_t pid=fork();
+    if(pid<0){
+      close(fd[0]);
+      close(fd[1]);
+      break;
+    }
+    if(pid==0){
+      // worker: fit its trials, write the values in the order of the trials
+      close(fd[0]);
+      for(size_t ip=0; ip<pipes.size(); ip++) close(pipes[ip]);
+      std::vector<Double_t> trialValues(nValues);
+      for(Int_t it=iw; it<nTrials; it+=nWorkers){
+        const TrialDef& trial=trials[it];
+        FitTrial(trial,hRebinned[trial.fRebinIndex*fNumOfFirstBinSteps+trial.fFirstBin-1],hInvMassHisto,&trialValues[0],0x0);
+        const char* buf=(const char*)&trialValues[0];
+        size_t nLeft=nValues*sizeof(Double_t);
+        while(nLeft>0){
+          ssize_t nw=write(fd[1],buf,nLeft);
+          if(nw<0 && errno==EINTR) continue;
+          if(nw<=0) _exit(1);
+          buf+=nw;
+          nLeft-=nw;
+        }
+      }
+      fflush(stdout);
+      close(fd[1]);
+      _exit(0);
+    }
+    close(fd[1]);
+    pipes.push_back(fd[0]);
+    pids.push_back(pid);
+  }
+  if(pids.empty()){
+    printf("AliHFMultiTrials: could not start worker processes, fitting in this process\n");
+    return 0;
+  }
+
+  // read back from all the workers at once, so that none of them blocks
+  // on a full pipe, into the slots of the trials; the stride is the
+  // number of workers requested, trials of workers that could not be
+  // started stay undone
+  const Int_t stride=nWorkers;
+  const Int_t nStarted=pids.size();
+  const size_t recordSize=nValues*sizeof(Double_t);
+  std::vector<Int_t> nextTrial(nStarted);
+  std::vector<size_t> nRead(nStarted,0);
+  std::vector<struct pollfd> fds(nStarted);
+  for(Int_t iw=0; iw<nStarted; iw++){
+    nextTrial[iw]=iw;
+    fds[iw].fd=pipes[iw];
+    fds[iw].events=POLLIN;
+    fds[iw].revents=0;
+  }
+  Int_t nDone=0;
+  Int_t nOpen=nStarted;
+  while(nOpen>0){
+    int nReady=poll(&fds[0],nStarted,-1);
+    if(nReady<0){
+      if(errno==EINTR) continue;
+      break;
+    }
+    for(Int_t iw=0; iw<nStarted; iw++){
+      if(fds[iw].fd<0 || !(fds[iw].revents&(POLLIN|POLLHUP|POLLERR))) continue;
+      ssize_t nr=0;
+      if(nextTrial[iw]<nTrials){
+        char* buf=(char*)&values[(size_t)nextTrial[iw]*nValues]+nRead[iw];
+        nr=read(fds[iw].fd,buf,recordSize-nRead[iw]);
+        if(nr<0 && errno==EINTR) continue;
+      }
+      if(nr<=0){
+        // all trials of this worker received, or it stopped early
+        close(fds[iw].fd);
+        fds[iw].fd=-1;
+        --nOpen;
+        continue;
+      }
+      nRead[iw]+=nr;
+      if(nRead[iw]==recordSize){
+        done[nextTrial[iw]]=kTRUE;
+        ++nDone;
+        nextTrial[iw]+=stride;
+        nRead[iw]=0;
+      }
+    }
+  }
+  for(Int_t iw=0; iw<nStarted; iw++){
+    if(fds[iw].fd>=0) close(fds[iw].fd);
+    int status=0;
+    waitpid(pids[iw],&status,0);
+  }
+  if(nDone<nTrials) printf("AliHFMultiTrials: %d of %d trials fitted by %d workers, the others are fitted in this process\n",nDone,nTrials,(Int_t)pids.size());
+  return nDone;
 }
 
 //________________________________________________________________________
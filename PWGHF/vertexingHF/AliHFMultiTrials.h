@@ -86,6 +86,10 @@ class AliHFMultiTrials : public TNamed {
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
 
+  /// Distribute the fits over nWorkers processes (see DoMultiTrials).
+  /// The output does not depend on the number of workers.
+  void SetNumberOfWorkers(Int_t nWorkers=4){fNumOfWorkers=nWorkers;}
+
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
   void DrawHistos(TCanvas* cry) const;
@@ -102,7 +106,29 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// One fit configuration: indices of the rebin, first bin, fit range,
+  /// background function and sigma/mean configuration of the trial
+  struct TrialDef {
+    Int_t fRebinIndex;
+    Int_t fFirstBin;
+    Int_t fMinMassIndex;
+    Int_t fMaxMassIndex;
+    Int_t fBkgFunc;
+    Int_t fFitConf;
+    Int_t fTrial;    /// trial number (bin of the per-case histograms)
+    Int_t fGlobBin;  /// bin of the histograms with all cases
+  };
+  /// Fit results of a trial, followed by (done, count, error) for each nsigma step of the bin counting
+  enum ETrialValues { kTrFitOK, kTrChi2, kTrSignif, kTrSignifErr, kTrMean, kTrMeanErr, kTrSigma, kTrSigmaErr,
+                      kTrRawYield, kTrRawYieldErr, kTrBkg, kTrBkgErr, kTrBkgBEdge, kTrBkgBEdgeErr, kNTrialValues };
+
   Bool_t CreateHistos();
+  void EnumerateTrials(std::vector<TrialDef>& trials) const;
+  Int_t GetNTrialValues() const {return kNTrialValues+3*fNumOfnSigmaBinCSteps;}
+  void FitTrial(const TrialDef& trial, TH1F* hRebinned, TH1D* hInvMassHisto, Double_t* values, TPad* thePad);
+  void FillTrial(const TrialDef& trial, const Double_t* values);
+  Int_t FitTrialsInWorkers(const std::vector<TrialDef>& trials, const std::vector<TH1F*>& hRebinned,
+                           TH1D* hInvMassHisto, std::vector<Double_t>& values, std::vector<Bool_t>& done);
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -146,6 +172,7 @@ class AliHFMultiTrials : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNumOfWorkers;        /// number of worker processes for the fits (<=1: fit in this process)
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -180,7 +207,7 @@ class AliHFMultiTrials : public TNamed {
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
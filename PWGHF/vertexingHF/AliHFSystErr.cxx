@@ -29,6 +29,11 @@
 // syst.DrawErrors(); // to see a plot of the error contributions
 // syst.GetTotalSystErr(pt); // to get the total err at pt 
 //
+// The uncertainties of a configuration are filled once per process into
+// a compact table shared by all the objects with the same settings; the
+// TH1F of a contribution is only created when it is drawn, requested
+// with GetHistogram or written to file.
+//
 // Author: A.Dainese, andrea.dainese@pd.infn.it
 /////////////////////////////////////////////////////////////
 
@@ -40,6 +45,9 @@
 #include <TLegend.h>
 #include <TColor.h>
 
+#include <map>
+#include <vector>
+
 #include "AliLog.h"
 #include "AliHFSystErr.h"
 
@@ -68,7 +76,8 @@ AliHFSystErr::AliHFSystErr(const Char_t* name, const Char_t* title) :
   fIs5TeVAnalysis(false),
   fIsBDTAnalysis(false),
   fIsCentScan(false),
-  fIsRapidityScan(false)
+  fIsRapidityScan(false),
+  fTable(0)
 {
   //
   /// Default Constructor
@@ -93,10 +102,120 @@ AliHFSystErr::~AliHFSystErr() {
   */
 }
 
+//--------------------------------------------------------------------------
+/// Uncertainties of one configuration: binning and contents (including
+/// under- and overflow) of each contribution, as filled by the Init* function
+struct AliHFSystErr::Table {
+  struct Contribution {
+    Contribution() : fDefined(kFALSE), fNbins(0), fXmin(0.), fXmax(0.), fEdges(), fContents() {}
+    Int_t FindBin(Double_t x) const {
+      // same as TAxis::FindBin
+      if(x<fXmin) return 0;
+      if(!(x<fXmax)) return fNbins+1;
+      if(fEdges.empty()) return 1+Int_t(fNbins*(x-fXmin)/(fXmax-fXmin));
+      return 1+TMath::BinarySearch(fNbins+1,&fEdges[0],x);
+    }
+    Bool_t fDefined;                 /// histogram created by the Init* function
+    Int_t fNbins;                    /// number of bins
+    Double_t fXmin;                  /// lower edge
+    Double_t fXmax;                  /// upper edge
+    std::vector<Double_t> fEdges;    /// bin edges, empty for equidistant bins
+    std::vector<Float_t> fContents;  /// bin contents, fNbins+2 values
+  };
+  Table() : fSetsName(kFALSE), fName(), fTitle() {}
+  Bool_t fSetsName;                  /// Init* function sets name and title
+  TString fName;                     /// name set by the Init* function
+  TString fTitle;                    /// title set by the Init* function
+  Contribution fContributions[kNContributions];
+};
+
+namespace {
+  const Char_t *gkContributionNames[AliHFSystErr::kNContributions] = {
+    "fNorm","fRawYield","fTrackingEff","fBR","fCutsEff","fPIDEff","fMCPtShape","fPartAntipart"
+  };
+}
+
+//--------------------------------------------------------------------------
+AliHFSystErr::Table*& AliHFSystErr::GetStoredTable(const TString &key) {
+  //
+  /// Table of a configuration key, kept for the lifetime of the process;
+  /// 0 if the configuration was not used yet
+  //
+  static std::map<TString,Table*> store;
+  return store[key];
+}
+
 //--------------------------------------------------------------------------
 void AliHFSystErr::Init(Int_t decay){
   //
-  /// Variables/histos initialization
+  /// Variables/histos initialization.
+  /// The Init* function of the configuration is run only for the first
+  /// object with these settings, its histograms are kept as a compact
+  /// table and deleted; the histograms of this object are created from
+  /// the table when needed.
+  //
+
+  Table *&table=GetStoredTable(GetConfigurationKey(decay));
+  if(!table) {
+    AliHFSystErr scratch("","");
+    scratch.fRunNumber=fRunNumber;
+    scratch.fCollisionType=fCollisionType;
+    scratch.fCentralityClass=fCentralityClass;
+    scratch.fRapidityRange=fRapidityRange;
+    scratch.fIsLowEnergy=fIsLowEnergy;
+    scratch.fIsLowPtAnalysis=fIsLowPtAnalysis;
+    scratch.fIsPass4Analysis=fIsPass4Analysis;
+    scratch.fIs5TeVAnalysis=fIs5TeVAnalysis;
+    scratch.fIsBDTAnalysis=fIsBDTAnalysis;
+    scratch.fIsCentScan=fIsCentScan;
+    scratch.fIsRapidityScan=fIsRapidityScan;
+    Bool_t addDirectory=TH1::AddDirectoryStatus();
+    TH1::AddDirectory(kFALSE);
+    scratch.InitHistos(decay);
+    TH1::AddDirectory(addDirectory);
+
+    table=new Table();
+    table->fName=scratch.GetName();
+    table->fTitle=scratch.GetTitle();
+    table->fSetsName=!(table->fName.IsNull() && table->fTitle.IsNull());
+    for(Int_t ic=0; ic<kNContributions; ic++) {
+      TH1F *&h=scratch.HistoOf(ic);
+      if(!h) continue;
+      Table::Contribution &c=table->fContributions[ic];
+      const TAxis *axis=h->GetXaxis();
+      c.fDefined=kTRUE;
+      c.fNbins=axis->GetNbins();
+      c.fXmin=axis->GetXmin();
+      c.fXmax=axis->GetXmax();
+      if(axis->GetXbins()->GetSize()>0) c.fEdges.assign(axis->GetXbins()->GetArray(),axis->GetXbins()->GetArray()+c.fNbins+1);
+      c.fContents.resize(c.fNbins+2);
+      for(Int_t ib=0; ib<=c.fNbins+1; ib++) c.fContents[ib]=h->GetBinContent(ib);
+      delete h;
+      h=0;
+    }
+  }
+
+  fTable=table;
+  if(table->fSetsName) SetNameTitle(table->fName,table->fTitle);
+  for(Int_t ic=0; ic<kNContributions; ic++) HistoOf(ic)=0;
+}
+
+//--------------------------------------------------------------------------
+TString AliHFSystErr::GetConfigurationKey(Int_t decay) const {
+  //
+  /// Key of the uncertainty table: decay and all the settings used to
+  /// choose the Init* function
+  //
+  return TString::Format("%d_%d_%d_%s_%s_%d%d%d%d%d%d%d",decay,fCollisionType,fRunNumber,
+                         fCentralityClass.Data(),fRapidityRange.Data(),
+                         fIsLowEnergy,fIsLowPtAnalysis,fIsPass4Analysis,fIs5TeVAnalysis,
+                         fIsBDTAnalysis,fIsCentScan,fIsRapidityScan);
+}
+
+//--------------------------------------------------------------------------
+void AliHFSystErr::InitHistos(Int_t decay){
+  //
+  /// Create the histograms with the Init* function of the configuration
   //
 
   //  if ((fRunNumber>11) && fIsLowEnergy==false) {
@@ -7341,9 +7460,7 @@ Double_t AliHFSystErr::GetCutsEffErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fCutsEff->FindBin(pt);
-
-  return fCutsEff->GetBinContent(bin);
+  return GetErr(kCutsEff,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetMCPtShapeErr(Double_t pt) const {
@@ -7351,9 +7468,7 @@ Double_t AliHFSystErr::GetMCPtShapeErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fMCPtShape->FindBin(pt);
-
-  return fMCPtShape->GetBinContent(bin);
+  return GetErr(kMCPtShape,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetSeleEffErr(Double_t pt) const {
@@ -7371,9 +7486,7 @@ Double_t AliHFSystErr::GetPIDEffErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fPIDEff->FindBin(pt);
-
-  return fPIDEff->GetBinContent(bin);
+  return GetErr(kPIDEff,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetTrackingEffErr(Double_t pt) const {
@@ -7381,9 +7494,7 @@ Double_t AliHFSystErr::GetTrackingEffErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fTrackingEff->FindBin(pt);
-
-  return fTrackingEff->GetBinContent(bin);
+  return GetErr(kTrackingEff,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetRawYieldErr(Double_t pt) const {
@@ -7391,9 +7502,7 @@ Double_t AliHFSystErr::GetRawYieldErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fRawYield->FindBin(pt);
-
-  return fRawYield->GetBinContent(bin);
+  return GetErr(kRawYield,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetPartAntipartErr(Double_t pt) const {
@@ -7401,9 +7510,7 @@ Double_t AliHFSystErr::GetPartAntipartErr(Double_t pt) const {
   // Get error
   //
 
-  Int_t bin=fPartAntipart->FindBin(pt);
-
-  return fPartAntipart->GetBinContent(bin);
+  return GetErr(kPartAntipart,pt);
 }
 //--------------------------------------------------------------------------
 Double_t AliHFSystErr::GetTotalSystErr(Double_t pt,Double_t feeddownErr) const {
@@ -7413,13 +7520,13 @@ Double_t AliHFSystErr::GetTotalSystErr(Double_t pt,Double_t feeddownErr) const {
 
   Double_t err=0.;
 
-  if(fRawYield) err += GetRawYieldErr(pt)*GetRawYieldErr(pt);
-  if(fTrackingEff) err += GetTrackingEffErr(pt)*GetTrackingEffErr(pt);
-  //  if(fBR) err += GetBRErr()*GetBRErr();
-  if(fCutsEff) err += GetCutsEffErr(pt)*GetCutsEffErr(pt);
-  if(fPIDEff) err += GetPIDEffErr(pt)*GetPIDEffErr(pt);
-  if(fMCPtShape) err += GetMCPtShapeErr(pt)*GetMCPtShapeErr(pt);
-  if(fPartAntipart) err += GetPartAntipartErr(pt)*GetPartAntipartErr(pt);
+  if(HasContribution(kRawYield)) err += GetRawYieldErr(pt)*GetRawYieldErr(pt);
+  if(HasContribution(kTrackingEff)) err += GetTrackingEffErr(pt)*GetTrackingEffErr(pt);
+  //  if(HasContribution(kBR)) err += GetBRErr()*GetBRErr();
+  if(HasContribution(kCutsEff)) err += GetCutsEffErr(pt)*GetCutsEffErr(pt);
+  if(HasContribution(kPIDEff)) err += GetPIDEffErr(pt)*GetPIDEffErr(pt);
+  if(HasContribution(kMCPtShape)) err += GetMCPtShapeErr(pt)*GetMCPtShapeErr(pt);
+  if(HasContribution(kPartAntipart)) err += GetPartAntipartErr(pt)*GetPartAntipartErr(pt);
 
   err += feeddownErr*feeddownErr;
 
@@ -7430,6 +7537,8 @@ void AliHFSystErr::DrawErrors(TGraphAsymmErrors *grErrFeeddown) const {
   //
   // Draw errors
   //
+  const_cast<AliHFSystErr*>(this)->CreateHistos();
+
   gStyle->SetOptStat(0);
 
   TCanvas *cSystErr = new TCanvas("cSystErr","Systematic Errors",300,80,1000,600);
@@ -7590,5 +7699,91 @@ TH1F* AliHFSystErr::ReflectHisto(TH1F *hin) const {
 
   return hout;
 }
-
-
+//--------------------------------------------------------------------------
+TH1F*& AliHFSystErr::HistoOf(Int_t contribution) {
+  //
+  /// Histogram member of a contribution
+  //
+  switch(contribution) {
+  case kNorm:         return fNorm;
+  case kRawYield:     return fRawYield;
+  case kTrackingEff:  return fTrackingEff;
+  case kBR:           return fBR;
+  case kCutsEff:      return fCutsEff;
+  case kPIDEff:       return fPIDEff;
+  case kMCPtShape:    return fMCPtShape;
+  default:            return fPartAntipart;
+  }
+}
+//--------------------------------------------------------------------------
+Bool_t AliHFSystErr::HasContribution(Int_t contribution) const {
+  //
+  /// Contribution defined either as histogram or in the table
+  //
+  if(HistoOf(contribution)) return kTRUE;
+  return fTable && fTable->fContributions[contribution].fDefined;
+}
+//--------------------------------------------------------------------------
+Double_t AliHFSystErr::GetErr(Int_t contribution, Double_t pt) const {
+  //
+  /// Error of a contribution at pt, from the histogram if it exists,
+  /// otherwise from the table
+  //
+  TH1F *h=HistoOf(contribution);
+  if(h) return h->GetBinContent(h->FindBin(pt));
+  if(!HasContribution(contribution)) return 0.;
+  const Table::Contribution &c=fTable->fContributions[contribution];
+  return c.fContents[c.FindBin(pt)];
+}
+//--------------------------------------------------------------------------
+Double_t AliHFSystErr::GetErrInBin(Int_t contribution, Int_t bin) const {
+  //
+  /// Error of a contribution in a bin
+  //
+  TH1F *h=HistoOf(contribution);
+  if(h) return h->GetBinContent(bin);
+  if(!HasContribution(contribution)) return 0.;
+  return fTable->fContributions[contribution].fContents[bin];
+}
+//--------------------------------------------------------------------------
+TH1F* AliHFSystErr::GetHistogram(EContribution contribution) {
+  //
+  /// Histogram of a contribution, created from the table on first access
+  //
+  TH1F *&h=HistoOf(contribution);
+  if(h || !HasContribution(contribution)) return h;
+
+  const Table::Contribution &c=fTable->fContributions[contribution];
+  const Char_t *name=gkContributionNames[contribution];
+  if(c.fEdges.empty()) h=new TH1F(name,name,c.fNbins,c.fXmin,c.fXmax);
+  else h=new TH1F(name,name,c.fNbins,&c.fEdges[0]);
+  // not attached to gDirectory: this may run while streaming to a file,
+  // which must neither write the histogram as a key nor delete it on Close
+  h->SetDirectory(0);
+  for(Int_t ib=0; ib<=c.fNbins+1; ib++) {
+    if(c.fContents[ib]!=0.) h->SetBinContent(ib,c.fContents[ib]);
+  }
+  return h;
+}
+//--------------------------------------------------------------------------
+void AliHFSystErr::CreateHistos() {
+  //
+  /// Create the histograms of all the contributions of the configuration
+  //
+  for(Int_t ic=0; ic<kNContributions; ic++) GetHistogram(EContribution(ic));
+}
+//--------------------------------------------------------------------------
+void AliHFSystErr::Streamer(TBuffer &R__b) {
+  //
+  /// Stream an object of class AliHFSystErr.
+  /// The histograms are created before writing, so that the object on
+  /// file is the same as with the histograms filled directly by Init.
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliHFSystErr::Class(),this);
+    fTable=0;
+  } else {
+    CreateHistos();
+    R__b.WriteClassBuffer(AliHFSystErr::Class(),this);
+  }
+}
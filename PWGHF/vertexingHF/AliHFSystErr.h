@@ -22,14 +22,21 @@ class AliHFSystErr : public TNamed
 {
  public:
 
+  /// Contributions to the systematic uncertainty
+  enum EContribution {kNorm, kRawYield, kTrackingEff, kBR, kCutsEff, kPIDEff, kMCPtShape, kPartAntipart, kNContributions};
+
   AliHFSystErr(const Char_t* name="HFSystErr", const Char_t* title="");
     
   virtual ~AliHFSystErr();
   
   void DrawErrors(TGraphAsymmErrors *grErrFeeddown=0) const; 
 
-  Double_t GetNormErr() const {return (fNorm ? fNorm->GetBinContent(0) : 0.);}
-  Double_t GetBRErr() const {return (fBR ? fBR->GetBinContent(0) : 0.);}
+  /// Histogram of one contribution (0 if not defined for this configuration),
+  /// created from the uncertainty table on first access
+  TH1F* GetHistogram(EContribution contribution);
+
+  Double_t GetNormErr() const {return GetErrInBin(kNorm,0);}
+  Double_t GetBRErr() const {return GetErrInBin(kBR,0);}
   Double_t GetCutsEffErr(Double_t pt) const;
   Double_t GetMCPtShapeErr(Double_t pt) const;
   Double_t GetSeleEffErr(Double_t pt) const;
@@ -305,6 +312,17 @@ class AliHFSystErr : public TNamed
 
   TH1F* ReflectHisto(TH1F *hin) const;
 
+  struct Table;
+  static Table*& GetStoredTable(const TString &key);
+  void InitHistos(Int_t decay);
+  TString GetConfigurationKey(Int_t decay) const;
+  TH1F*& HistoOf(Int_t contribution);
+  TH1F* HistoOf(Int_t contribution) const { return const_cast<AliHFSystErr*>(this)->HistoOf(contribution); }
+  Bool_t HasContribution(Int_t contribution) const;
+  Double_t GetErr(Int_t contribution, Double_t pt) const;
+  Double_t GetErrInBin(Int_t contribution, Int_t bin) const;
+  void CreateHistos();
+
   TH1F *fNorm;            /// normalization
   TH1F *fRawYield;        /// raw yield 
   TH1F *fTrackingEff;     /// tracking efficiency
@@ -328,8 +346,10 @@ class AliHFSystErr : public TNamed
   Bool_t fIsCentScan;      /// flag fot the PbPb centrality scan
   Bool_t fIsRapidityScan;  /// flag for the pPb vs y measurement
 
+  const Table *fTable;     //!<! uncertainties of the configuration set by Init, shared between objects
+
   /// \cond CLASSIMP    
-  ClassDef(AliHFSystErr,9);  /// class for systematic errors of charm hadrons
+  ClassDef(AliHFSystErr,10);  /// class for systematic errors of charm hadrons
   /// \endcond
 };
 
@@ -542,13 +542,22 @@ void  AliMultiDimVector::GetFillRange(Int_t iVar, Int_t iCell, Int_t& minbin, In
 //_____________________________________________________________________________ 
 void AliMultiDimVector::Integrate(){
   // integrates the matrix
+  // Cumulative sums towards the loose cuts, one variable at a time: after
+  // the pass on variable iVar each cell holds the sum of the cells with the
+  // same indices of the other variables and a tighter or equal cut on iVar,
+  // so after all the passes it holds the counts above the cell (as
+  // CountsAboveCell) with n. of cells x n. of variables additions
   if(fIsIntegrated){
     AliError("MultiDimVector already integrated");
     return;
   }
-  TArrayF integral(fNTotCells);
-  for(ULong64_t i=0;i<fNTotCells;i++) integral[i]=CountsAboveCell(i);
-  for(ULong64_t i=0;i<fNTotCells;i++) fVett[i]= integral[i];
+  for(Int_t iVar=0; iVar<fNVariables; iVar++){
+    ULong64_t step=GetAddressStep(iVar);
+    Int_t lastCell=fNCutSteps[iVar]-1;
+    for(ULong64_t i=fNTotCells; i-->0;){
+      if((Int_t)((i/step)%fNCutSteps[iVar])<lastCell) fVett[i]+=fVett[i+step];
+    }
+  }
   fIsIntegrated=kTRUE;
 }//_____________________________________________________________________________ 
 ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const{
@@ -595,6 +604,22 @@ ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values,
   return indexes;
 }
 //_____________________________________________________________________________ 
+ULong64_t AliMultiDimVector::GetGlobalAddressOfCell(const Float_t *values, Float_t pt, Int_t& nVals) const{
+  // global address of the cell of a candidate, to be used instead of
+  // GetGlobalAddressesAboveCuts when only the cell of the candidate is
+  // filled and the cells passing the cuts are summed up with Integrate.
+  // nVals is the number of cells passing the cuts (as given by
+  // GetGlobalAddressesAboveCuts), 0 if the candidate is out of range
+  nVals=0;
+  Int_t ptbin=GetPtBin(pt);
+  if(ptbin<0) return fNTotCells+999;
+  Int_t ind[fgkMaxNVariables];
+  if(!GetIndicesFromValues(values,ind)) return fNTotCells+999;
+  nVals=1;
+  for(Int_t i=0;i<fNVariables;i++) nVals*=(ind[i]+1);
+  return GetGlobalAddressFromIndices(ind,ptbin);
+}
+//_____________________________________________________________________________ 
 Float_t AliMultiDimVector::CountsAboveCell(ULong64_t globadd) const{
   // integrates the counts of cells above cell with address globadd
   Int_t ind[fgkMaxNVariables];
@@ -78,6 +78,13 @@ class AliMultiDimVector :  public TNamed{
     else return 0x0;
   }
   ULong64_t* GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const;
+  ULong64_t GetGlobalAddressOfCell(const Float_t *values, Float_t pt, Int_t& nVals) const;
+  /// distance in global address between two neighbouring cut steps of variable iVar
+  ULong64_t GetAddressStep(Int_t iVar) const {
+    ULong64_t step=fNPtBins;
+    for(Int_t j=iVar+1; j<fNVariables; j++) step*=fNCutSteps[j];
+    return step;
+  }
   Bool_t    GetGreaterThan(Int_t iVar) const {return fGreaterThan[iVar];}
 
   void SetElement(ULong64_t globadd,Float_t val) {fVett[globadd]=val;}
@@ -38,6 +38,7 @@
 #include <TObjArray.h>
 #include <TString.h>
 #include <TCanvas.h>
+#include <TBuffer.h>
 #include <AliPhysicsSelection.h>
 #include <AliMultiplicity.h>
 
@@ -45,6 +46,15 @@
 ClassImp(AliNormalizationCounter);
 /// \endcond
 
+namespace {
+  /// keywords of the "Event" rubric, indexed by AliNormalizationCounter::ECounterType
+  const char* gkCounterTypeNames[AliNormalizationCounter::kNCounterTypes]={
+    "triggered","V0AND","PileUp","PbPbC0SMH-B-NOPF-ALLNOTRD","Candles0.3","PrimaryV","countForNorm",
+    "noPrimaryV","zvtxGT10","!V0A&Candle03","!V0A&PrimaryV",
+    "Candid(Filter)","Candid(Analysis)","NCandid(Filter)","NCandid(Analysis)"
+  };
+}
+
 //____________________________________________
 AliNormalizationCounter::AliNormalizationCounter(): 
 TNamed(),
@@ -57,7 +67,8 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fPendingCounts()
 {
   // empty constructor
 }
@@ -74,7 +85,8 @@ fSpherocitySteps(100.),
 fHistTrackFilterEvMult(0),
 fHistTrackAnaEvMult(0),
 fHistTrackFilterSpdMult(0),
-fHistTrackAnaSpdMult(0)
+fHistTrackAnaSpdMult(0),
+fPendingCounts()
 {
   ;
 }
@@ -105,7 +117,9 @@ AliNormalizationCounter::~AliNormalizationCounter()
 void AliNormalizationCounter::Init()
 {
   //variables initialization
-  fCounters.AddRubric("Event","triggered/V0AND/PileUp/PbPbC0SMH-B-NOPF-ALLNOTRD/Candles0.3/PrimaryV/countForNorm/noPrimaryV/zvtxGT10/!V0A&Candle03/!V0A&PrimaryV/Candid(Filter)/Candid(Analysis)/NCandid(Filter)/NCandid(Analysis)");
+  TString eventKeys=gkCounterTypeNames[0];
+  for(Int_t i=1;i<kNCounterTypes;i++) eventKeys+=Form("/%s",gkCounterTypeNames[i]);
+  fCounters.AddRubric("Event",eventKeys.Data());
   if(fMultiplicity)  fCounters.AddRubric("Multiplicity", 5000);
   if(fSpherocity)  fCounters.AddRubric("Spherocity", (Int_t)fSpherocitySteps+1);
   fCounters.AddRubric("Run", 1000000);
@@ -140,6 +154,7 @@ Long64_t AliNormalizationCounter::Merge(TCollection* list){
       continue;
     }
 
+    const_cast<AliNormalizationCounter*>(counter)->FlushCounts();
     Add(counter);
 
   }
@@ -148,6 +163,7 @@ Long64_t AliNormalizationCounter::Merge(TCollection* list){
 }
 //_______________________________________
 void AliNormalizationCounter::Add(const AliNormalizationCounter *norm){
+  FlushCounts();
   fCounters.Add(&(norm->fCounters));
   fHistTrackFilterEvMult->Add(norm->fHistTrackFilterEvMult);
   fHistTrackAnaEvMult->Add(norm->fHistTrackAnaEvMult);
@@ -186,7 +202,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   //event must be either physics or MC
   if(!(event->GetEventType() == 7||event->GetEventType() == 0))return;
   
-  FillCounters("triggered",runNumber,multiplicity,spherocity);
+  Count(kTriggered,runNumber,multiplicity,spherocity);
 
   //Find V0AND
   AliTriggerAnalysis trAn; /// Trigger Analysis
@@ -197,7 +213,7 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
     v0B = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0C);
     v0A = trAn.IsOfflineTriggerFired(eventESD , AliTriggerAnalysis::kV0A);
   }
-  if(v0A&&v0B) FillCounters("V0AND",runNumber,multiplicity,spherocity);
+  if(v0A&&v0B) Count(kV0AND,runNumber,multiplicity,spherocity);
   
   //FindPrimary vertex  
   // AliVVertex *vtrc =  (AliVVertex*)event->GetPrimaryVertex();
@@ -210,30 +226,30 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   AliAODEvent *eventAOD = (AliAODEvent*)event;
   TString trigclass=eventAOD->GetFiredTriggerClasses();
   if(trigclass.Contains("C0SMH-B-NOPF-ALLNOTRD")||trigclass.Contains("C0SMH-B-NOPF-ALL")){
-    FillCounters("PbPbC0SMH-B-NOPF-ALLNOTRD",runNumber,multiplicity,spherocity);
+    Count(kPbPbC0SMH,runNumber,multiplicity,spherocity);
   }
 
   //FindPrimary vertex  
   if(isEventSelected){
-    FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+    Count(kPrimaryV,runNumber,multiplicity,spherocity);
     flagPV=kTRUE;
   }else{
     if(rdCut->GetWhyRejection()==0){
-      FillCounters("noPrimaryV",runNumber,multiplicity,spherocity);
+      Count(kNoPrimaryV,runNumber,multiplicity,spherocity);
     }
     //find good vtx outside range
     if(rdCut->GetWhyRejection()==6){
-      FillCounters("zvtxGT10",runNumber,multiplicity,spherocity);
-      FillCounters("PrimaryV",runNumber,multiplicity,spherocity);
+      Count(kZvtxGT10,runNumber,multiplicity,spherocity);
+      Count(kPrimaryV,runNumber,multiplicity,spherocity);
       flagPV=kTRUE;
     }
     if(rdCut->GetWhyRejection()==1){
-      FillCounters("PileUp",runNumber,multiplicity,spherocity);
+      Count(kPileUp,runNumber,multiplicity,spherocity);
     }
   }
   //to be counted for normalization
   if(rdCut->CountEventForNormalization()){
-    FillCounters("countForNorm",runNumber,multiplicity,spherocity);
+    Count(kCountForNorm,runNumber,multiplicity,spherocity);
   }
 
 
@@ -242,17 +258,17 @@ void AliNormalizationCounter::StoreEvent(AliVEvent *event,AliRDHFCuts *rdCut,Boo
   for(Int_t i=0;i<trkEntries&&!flag03;i++){
     AliAODTrack *track=(AliAODTrack*)event->GetTrack(i);
     if((track->Pt()>0.3)&&(!flag03)){
-      FillCounters("Candles0.3",runNumber,multiplicity,spherocity);
+      Count(kCandles03,runNumber,multiplicity,spherocity);
       flag03=kTRUE;
       break;
     }
   }
   
   if(!(v0A&&v0B)&&(flag03)){ 
-    FillCounters("!V0A&Candle03",runNumber,multiplicity,spherocity);
+    Count(kNoV0ACandle03,runNumber,multiplicity,spherocity);
   }
   if(!(v0A&&v0B)&&flagPV){
-    FillCounters("!V0A&PrimaryV",runNumber,multiplicity,spherocity);
+    Count(kNoV0APrimaryV,runNumber,multiplicity,spherocity);
   }
   
   return;
@@ -280,34 +296,21 @@ void AliNormalizationCounter::StoreCandidates(AliVEvent *event,Int_t nCand,Bool_
   Int_t runNumber = event->GetRunNumber();
   Int_t multiplicity = Multiplicity(event);
   if(nCand==0)return;
+  // candidate counters have no spherocity
+  Int_t multBin=fMultiplicity ? multiplicity : fgkNoBin;
   if(flagFilter){
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else 
-      fCounters.Count(Form("Event:Candid(Filter)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else 
-	fCounters.Count(Form("Event:NCandid(Filter)/Run:%d",runNumber));
-    }
+    AddCounts(kCandidFilter,runNumber,multBin,fgkNoBin,1);
+    AddCounts(kNCandidFilter,runNumber,multBin,fgkNoBin,nCand);
   }else{
-    if(fMultiplicity) 
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-    else
-      fCounters.Count(Form("Event:Candid(Analysis)/Run:%d",runNumber));
-    for(Int_t i=0;i<nCand;i++){ 
-      if(fMultiplicity) 
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d/Multiplicity:%d",runNumber,multiplicity));
-      else
-	fCounters.Count(Form("Event:NCandid(Analysis)/Run:%d",runNumber));
-    }
+    AddCounts(kCandidAnalysis,runNumber,multBin,fgkNoBin,1);
+    AddCounts(kNCandidAnalysis,runNumber,multBin,fgkNoBin,nCand);
   }
   return;
 }
 //_______________________________________________________________________
 TH1D* AliNormalizationCounter::DrawAgainstRuns(TString candle,Bool_t drawHist){
   //
+  FlushCounts();
   fCounters.SortRubric("Run");
   TString selection;
   selection.Form("event:%s",candle.Data());
@@ -337,10 +340,12 @@ TH1D* AliNormalizationCounter::DrawRatio(TString candle1,TString candle2){
 }
 //___________________________________________________________________________
 void AliNormalizationCounter::PrintRubrics(){
+  FlushCounts();
   fCounters.PrintKeyWords();
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetSum(TString candle){
+  FlushCounts();
   TString selection="event:";
   selection.Append(candle);
   return fCounters.GetSum(selection.Data());
@@ -372,6 +377,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(){
 }
 //___________________________________________________________________________
 Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t runnumber){
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("RUN");
   if(!listofruns.Contains(Form("%d",runnumber))){
     printf("WARNING: %d is not a valid run number\n",runnumber);
@@ -395,6 +401,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
     return 0.;
   }
 
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
 
   Int_t nmultbins = maxmultiplicity - minmultiplicity;
@@ -426,6 +433,7 @@ Double_t AliNormalizationCounter::GetNEventsForNorm(Int_t minmultiplicity, Int_t
     return 0.;
   }
 
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
   TString listofruns2 = fCounters.GetKeyWords("Spherocity");
   TObjArray* arr=listofruns2.Tokenize(",");
@@ -467,6 +475,7 @@ Double_t AliNormalizationCounter::GetNEventsForNormSpheroOnly(Double_t minsphero
     return 0.;
   }
 
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("Spherocity");
   TObjArray* arr=listofruns.Tokenize(",");
   Int_t nSphVals=arr->GetEntries();
@@ -503,6 +512,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
     return 0.;
   }
 
+  FlushCounts();
   TString listofruns = fCounters.GetKeyWords("Multiplicity");
   Double_t sum=0.;
   for (Int_t ibin=minmultiplicity; ibin<=maxmultiplicity; ibin++) {
@@ -521,6 +531,7 @@ Double_t AliNormalizationCounter::GetSum(TString candle,Int_t minmultiplicity, I
 //___________________________________________________________________________
 TH1D* AliNormalizationCounter::DrawNEventsForNorm(Bool_t drawRatio){
   //usare algebra histos
+  FlushCounts();
   fCounters.SortRubric("Run");
   TString selection;
 
@@ -575,17 +586,61 @@ Int_t AliNormalizationCounter::Multiplicity(AliVEvent* event){
 }
 
 //___________________________________________________________________________
-void AliNormalizationCounter::FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity){
+void AliNormalizationCounter::Count(ECounterType type, Int_t runNumber, Int_t multiplicity, Double_t spherocity, Int_t nCounts){
+  // count an event (or nCounts candidates) of the given type; the
+  // multiplicity and the spherocity are used if activated in the counter
+  Int_t sphToInteger=spherocity*fSpherocitySteps;
+  AddCounts(type,runNumber,fMultiplicity ? multiplicity : fgkNoBin,fSpherocity ? sphToInteger : fgkNoBin,nCounts);
+}
 
+//___________________________________________________________________________
+void AliNormalizationCounter::AddCounts(Int_t type, Int_t runNumber, Int_t multiplicityBin, Int_t spherocityBin, Int_t nCounts){
+  // Counts are accumulated with integer keys and stored in the
+  // AliCounterCollection, which parses a key string for each call, only by
+  // FlushCounts: once per distinct (type, run, multiplicity, spherocity)
+  CountKey key;
+  key.fType=type;
+  key.fRun=runNumber;
+  key.fMultiplicity=multiplicityBin;
+  key.fSpherocity=spherocityBin;
+  fPendingCounts[key]+=nCounts;
+}
 
-  Int_t sphToInteger=spherocity*fSpherocitySteps;
-  if(fMultiplicity  && !fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d",name.Data(),runNumber,multiplicity));
-  else if(fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Multiplicity:%d/Spherocity:%d",name.Data(),runNumber,multiplicity,sphToInteger));
-  else if(!fMultiplicity  && fSpherocity) 
-    fCounters.Count(Form("Event:%s/Run:%d/Spherocity:%d",name.Data(),runNumber,sphToInteger));
-  else 
-    fCounters.Count(Form("Event:%s/Run:%d",name.Data(),runNumber));
-  return;
+//___________________________________________________________________________
+void AliNormalizationCounter::FlushCounts(){
+  // store the accumulated counts in fCounters; called before fCounters is
+  // read, merged or written, so it does not need to be called by the user
+  if(fPendingCounts.empty()) return;
+  TString key;
+  for(std::map<CountKey,Int_t>::const_iterator it=fPendingCounts.begin(); it!=fPendingCounts.end(); ++it){
+    const CountKey& k=it->first;
+    key.Form("Event:%s/Run:%d",gkCounterTypeNames[k.fType],k.fRun);
+    if(k.fMultiplicity!=fgkNoBin) key+=Form("/Multiplicity:%d",k.fMultiplicity);
+    if(k.fSpherocity!=fgkNoBin) key+=Form("/Spherocity:%d",k.fSpherocity);
+    fCounters.Count(key.Data(),it->second);
+  }
+  fPendingCounts.clear();
+}
+
+//___________________________________________________________________________
+const char* AliNormalizationCounter::GetCounterTypeName(Int_t type){
+  // keyword of a counter type in the "Event" rubric
+  if(type<0 || type>=kNCounterTypes) return "";
+  return gkCounterTypeNames[type];
+}
+
+//______________________________________________________________________________
+void AliNormalizationCounter::Streamer(TBuffer &R__b)
+{
+  //
+  // Stream an object of class AliNormalizationCounter, storing the
+  // pending counts in fCounters before writing.
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliNormalizationCounter::Class(),this);
+    fPendingCounts.clear();
+  } else {
+    FlushCounts();
+    R__b.WriteClassBuffer(AliNormalizationCounter::Class(),this);
+  }
 }
@@ -44,17 +44,23 @@
 #include "AliAnalysisDataContainer.h"
 #include "AliRDHFCuts.h"
 //#include "AliAnalysisVertexingHF.h"
+#include <map>
 
 class AliNormalizationCounter : public TNamed
 {
  public:
 
+  /// event and candidate counters, in the order of the keywords of the "Event" rubric
+  enum ECounterType { kTriggered, kV0AND, kPileUp, kPbPbC0SMH, kCandles03, kPrimaryV, kCountForNorm,
+                      kNoPrimaryV, kZvtxGT10, kNoV0ACandle03, kNoV0APrimaryV,
+                      kCandidFilter, kCandidAnalysis, kNCandidFilter, kNCandidAnalysis, kNCounterTypes };
+
   AliNormalizationCounter();
   AliNormalizationCounter(const char *name);
   virtual ~AliNormalizationCounter();
   Long64_t Merge(TCollection* list);
 
-  AliCounterCollection* GetCounter(){return &fCounters;}
+  AliCounterCollection* GetCounter(){FlushCounts(); return &fCounters;}
   void Init();
   void Add(const AliNormalizationCounter*);
   void SetESD(Bool_t flag){fESD=flag;}
@@ -63,6 +69,9 @@ class AliNormalizationCounter : public TNamed
     fSpherocitySteps=nsteps;}
   void StoreEvent(AliVEvent*,AliRDHFCuts *,Bool_t mc=kFALSE, Int_t multiplicity=-9999, Double_t spherocity=-99.);
   void StoreCandidates(AliVEvent*, Int_t nCand=0,Bool_t flagFilter=kTRUE);
+  void Count(ECounterType type, Int_t runNumber, Int_t multiplicity=-9999, Double_t spherocity=-99., Int_t nCounts=1);
+  void FlushCounts();
+  static const char* GetCounterTypeName(Int_t type);
   TH1D* DrawAgainstRuns(TString candle="candid(filter)",Bool_t drawHist=kTRUE);
   TH1D* DrawRatio(TString candle1="candid(filter)",TString candle2="triggered");
   void PrintRubrics();
@@ -83,7 +92,23 @@ class AliNormalizationCounter : public TNamed
   AliNormalizationCounter(const AliNormalizationCounter &source);
   AliNormalizationCounter& operator=(const AliNormalizationCounter& source);
   Int_t Multiplicity(AliVEvent* event);
-  void FillCounters(TString name, Int_t runNumber, Int_t multiplicity, Double_t spherocity);
+  void AddCounts(Int_t type, Int_t runNumber, Int_t multiplicityBin, Int_t spherocityBin, Int_t nCounts);
+
+  static const Int_t fgkNoBin=-2147483647-1; /// marks a rubric absent from the key
+
+  /// key of the counts not yet stored in fCounters
+  struct CountKey {
+    Int_t fType;
+    Int_t fRun;
+    Int_t fMultiplicity;
+    Int_t fSpherocity;
+    Bool_t operator<(const CountKey& other) const {
+      if(fType!=other.fType) return fType<other.fType;
+      if(fRun!=other.fRun) return fRun<other.fRun;
+      if(fMultiplicity!=other.fMultiplicity) return fMultiplicity<other.fMultiplicity;
+      return fSpherocity<other.fSpherocity;
+    }
+  };
 
 
   AliCounterCollection fCounters; /// internal counter
@@ -96,9 +121,10 @@ class AliNormalizationCounter : public TNamed
   TH2F *fHistTrackAnaEvMult;/// hist to store no of analysis candidates vs no of tracks in the event
   TH2F *fHistTrackFilterSpdMult; /// hist to store no of filter candidates vs  SPD multiplicity
   TH2F *fHistTrackAnaSpdMult;/// hist to store no of analysis candidates vs SPD multiplicity 
+  std::map<CountKey,Int_t> fPendingCounts; //!<! counts to be stored in fCounters, see FlushCounts
 
   /// \cond CLASSIMP    
-  ClassDef(AliNormalizationCounter,7);
+  ClassDef(AliNormalizationCounter,8);
   /// \endcond
 };
 #endif
@@ -15,7 +15,7 @@
 #pragma link C++ class AliAODPidHF+;
 #pragma link C++ class AliRDHFCuts+;
 #pragma link C++ class AliVertexingHFUtils+;
-#pragma link C++ class AliHFSystErr+;
+#pragma link C++ class AliHFSystErr-;
 #pragma link C++ class AliRDHFCutsD0toKpi+;
 #pragma link C++ class AliRDHFCutsB0toDStarPi+;
 #pragma link C++ class AliRDHFCutsJpsitoee+;
@@ -78,7 +78,7 @@
 #pragma link C++ class AliHFMassFitter+;
 #pragma link C++ class AliHFPtSpectrum+;
 #pragma link C++ class AliHFsubtractBFDcuts+;
-#pragma link C++ class AliNormalizationCounter+;
+#pragma link C++ class AliNormalizationCounter-;
 #pragma link C++ class AliAnalysisTaskSEMonitNorm+;
 #pragma link C++ class AliAnalysisTaskSEBkgLikeSignD0+;
 #pragma link C++ class AliAnalysisTaskSEImproveITS+;
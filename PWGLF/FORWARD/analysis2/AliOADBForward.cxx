@@ -8,6 +8,8 @@
 #include <TFile.h>
 #include <TError.h>
 #include <TSystem.h>
+#include <TMath.h>
+#include <algorithm>
 
 #ifndef ALIROOT_SVN_REVISION
 # define ALIROOT_SVN_REVISION 0
@@ -146,7 +148,13 @@ AliOADBForward::Entry::Print(Option_t* /*option*/) const
 }
 //====================================================================
 AliOADBForward::Table::Table(TTree* tree, Bool_t isNew, ERunSelectMode mode)
-  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false)
+  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false),
+    fIndexSize(-1), 
+    fIndex(), 
+    fIndexRuns(), 
+    fIndexOrder(), 
+    fCache(), 
+    fCacheSize(10)
 {
   if (!tree) return;
 
@@ -177,10 +185,16 @@ AliOADBForward::Table::Table(const Table& o)
     fEntry(o.fEntry), 
     fVerbose(o.fVerbose),
     fMode(o.fMode), 
-    fFallBack(o.fFallBack)
+    fFallBack(o.fFallBack),
+    fIndexSize(-1), 
+    fIndex(), 
+    fIndexRuns(), 
+    fIndexOrder(), 
+    fCache(), 
+    fCacheSize(o.fCacheSize)
 {
   //
-  // Copy constructor 
+  // Copy constructor.  The index and the kept entries are not copied 
   if (!fTree) return;
   fTree->SetBranchAddress("e", &fEntry);
 }
@@ -201,10 +215,12 @@ AliOADBForward::Table::operator=(const Table& o)
   // Assignment operator 
   // 
   if (this == &o) return *this;
-  fTree    = o.fTree;
-  fEntry   = o.fEntry;
-  fVerbose = o.fVerbose;
-  fMode    = o.fMode;
+  ClearCache();
+  fTree      = o.fTree;
+  fEntry     = o.fEntry;
+  fVerbose   = o.fVerbose;
+  fMode      = o.fMode;
+  fCacheSize = o.fCacheSize;
   if (fTree) fTree->SetBranchAddress("e", &fEntry);
 
   return *this;
@@ -262,6 +278,7 @@ AliOADBForward::Table::Close()
   // 
   // Close the connection 
   //
+  ClearCache();
   if (!IsOpen()) { 
     Error("Close", "No tree associated");
     return false;
@@ -284,8 +301,11 @@ AliOADBForward::Table::Query(ULong_t        runNo,
 			     Bool_t         sat) const
 {
   // 
-  // Query the tree 
+  // Query the tree.  The in-memory index is used if possible, so
+  // that the tree is only scanned once, rather than for every query.
   //
+  if (BuildIndex()) return QueryIndex(runNo, mode, sys, sNN, fld, mc, sat);
+
   return Query(runNo, mode, Conditions(sys, sNN, fld, mc, sat));
 }
 
@@ -343,11 +363,30 @@ AliOADBForward::Table::Query(ULong_t        runNo,
   Int_t nRows = fTree->GetSelectedRows();
   if (nRows <= 0) return -1;
       
+  return SelectEntry(runNo, mode, nRows, fTree->GetV1(), fTree->GetV2(), 
+		     fTree->GetV3(), query, smode);
+}
+
+//____________________________________________________________________
+Int_t
+AliOADBForward::Table::SelectEntry(ULong_t         runNo, 
+				   ERunSelectMode  mode,
+				   Int_t           nRows, 
+				   const Double_t* ents, 
+				   const Double_t* runs, 
+				   const Double_t* tims, 
+				   const char*     query, 
+				   const char*     smode) const
+{
+  // 
+  // Select the best of the entries that matched the query.  The
+  // entries must be given in the order of the tree.
+  //
   if (fVerbose) 
     Printf("Query: %s (%s)\n"
 	   " Entry  |    Run    | Timestamp \n"
 	   "--------+-----------+------------------------", 
-	   query.Data(), smode);
+	   query, smode);
       
   ULong_t  oldRun  = (mode == kNewer ? 0xFFFFFFFF : 0);
   ULong_t  oldTim  = 0;
@@ -355,9 +394,9 @@ AliOADBForward::Table::Query(ULong_t        runNo,
   Int_t    entry  = -1;  
       
   for (Int_t row = 0; row < nRows; row++) {
-    Int_t    ent  = Int_t(fTree->GetV1()[row]);
-    ULong_t  run  = ULong_t(fTree->GetV2()[row]);
-    ULong_t  tim  = ULong_t(fTree->GetV3()[row]);
+    Int_t    ent  = Int_t(ents[row]);
+    ULong_t  run  = ULong_t(runs[row]);
+    ULong_t  tim  = ULong_t(tims[row]);
     ULong_t  dist = (run > runNo ? run - runNo : runNo - run);
 	
     if (fVerbose) {
@@ -407,6 +446,146 @@ AliOADBForward::Table::Query(ULong_t        runNo,
   return entry;
 }
 
+//____________________________________________________________________
+Bool_t
+AliOADBForward::Table::BuildIndex() const
+{
+  // 
+  // Read the run number, timestamp, and conditions of all entries
+  // into memory.  Only these branches are read, not the correction
+  // objects.  The index is made again if entries were added to the
+  // tree.
+  //
+  if (!IsOpen()) return false;
+
+  Int_t n = fTree->GetEntries();
+  if (n == fIndexSize) return true;
+
+  fIndexSize = -1;
+  fIndex.Set(n * kNIndex);
+  fIndexRuns.Set(n);
+  fIndexOrder.Set(n);
+  if (n > 0) {
+    if (n > fTree->GetEstimate()) fTree->SetEstimate(n);
+
+    // TTree::Draw gives at most 4 columns, so we do it in two passes 
+    if (fTree->Draw("fRunNo:fTimestamp:fSys:fSNN", "", "goff") != n) 
+      return false;
+    for (Int_t i = 0; i < n; i++) { 
+      Double_t* row        = &(fIndex[i * kNIndex]);
+      row[kIndexRun]       = fTree->GetV1()[i];
+      row[kIndexTimestamp] = fTree->GetV2()[i];
+      row[kIndexSys]       = fTree->GetV3()[i];
+      row[kIndexSNN]       = fTree->GetV4()[i];
+    }
+    if (fTree->Draw("fField:fMC:fSatellite", "", "goff") != n) 
+      return false;
+    for (Int_t i = 0; i < n; i++) { 
+      Double_t* row        = &(fIndex[i * kNIndex]);
+      row[kIndexField]     = fTree->GetV1()[i];
+      row[kIndexMC]        = fTree->GetV2()[i];
+      row[kIndexSatellite] = fTree->GetV3()[i];
+      fIndexRuns[i]        = row[kIndexRun];
+    }
+
+    // Sort on run number, so that the run range of a query can be
+    // found by bisection
+    TMath::Sort(n, fIndexRuns.GetArray(), fIndexOrder.GetArray(), false);
+    for (Int_t i = 0; i < n; i++) 
+      fIndexRuns[i] = fIndex[fIndexOrder[i] * kNIndex + kIndexRun];
+  }
+  fIndexSize = n;
+  if (fVerbose) 
+    Printf("%s: Indexed %d entries", GetName(), n);
+  return true;
+}
+
+//____________________________________________________________________
+Int_t
+AliOADBForward::Table::QueryIndex(ULong_t        runNo,
+				  ERunSelectMode mode,
+				  UShort_t       sys,
+				  UShort_t       sNN, 
+				  Short_t        fld,
+				  Bool_t         mc,
+				  Bool_t         sat) const
+{
+  // 
+  // Run a query against the in-memory index.  The selections are
+  // evaluated in double precision, like TTree::Draw does for the
+  // query string from Conditions.
+  //
+  const char* smode = "latest";
+  Int_t       first = 0;
+  Int_t       last  = fIndexSize;
+  if (runNo > 0) {
+    if (mode <= kDefault || mode > kNewer) mode = fMode;
+    smode = Mode2String(mode);
+
+    // Range of sorted entries with acceptable run numbers 
+    const Double_t* runs = fIndexRuns.GetArray();
+    const Double_t  run  = runNo;
+    switch (mode) { 
+    case kExact:  
+      first = std::lower_bound(runs, runs+last, run) - runs;
+      last  = std::upper_bound(runs, runs+last, run) - runs;
+      break;
+    case kNewest: 
+      break;
+    case kNear:   
+      first = std::lower_bound(runs, runs+last, run-kMaxNearDistance) - runs;
+      last  = std::upper_bound(runs, runs+last, run+kMaxNearDistance) - runs;
+      break;
+    case kOlder: 
+      last  = std::upper_bound(runs, runs+last, run) - runs;
+      break;
+    case kNewer: 
+      first = std::lower_bound(runs, runs+last, run) - runs;
+      break;
+    case kDefault: 
+      Fatal("Query", "Mode should never be 'default'");
+      break;
+    }
+  }
+
+  TString query;
+  if (fVerbose) {
+    query = Conditions(sys, sNN, fld, mc, sat);
+    Printf("%s: Query is '%s' on run %lu (%s)", 
+	   GetName(), query.Data(), runNo, smode);
+  }
+
+  // Select on the conditions
+  TArrayI sel(TMath::Max(last - first, 0));
+  Int_t   nRows = 0;
+  for (Int_t i = first; i < last; i++) { 
+    Int_t           ent = fIndexOrder[i];
+    const Double_t* row = &(fIndex.GetArray()[ent * kNIndex]);
+    if (sys > 0               && !(row[kIndexSys] == sys))  continue;
+    if (sNN > 0               && 
+	!(TMath::Abs(row[kIndexSNN] - sNN) < 11))            continue;
+    if (TMath::Abs(fld) < 10 && !(row[kIndexField] == fld)) continue;
+    if ((row[kIndexMC]        != 0) != mc)                  continue;
+    if ((row[kIndexSatellite] != 0) != sat)                 continue;
+    sel[nRows++] = ent;
+  }
+  if (nRows <= 0) return -1;
+
+  // The selection of the best entry depends on the order of the
+  // entries in the tree
+  std::sort(sel.GetArray(), sel.GetArray() + nRows);
+  TArrayD ents(nRows);
+  TArrayD runs(nRows);
+  TArrayD tims(nRows);
+  for (Int_t i = 0; i < nRows; i++) { 
+    ents[i] = sel[i];
+    runs[i] = fIndex[sel[i] * kNIndex + kIndexRun];
+    tims[i] = fIndex[sel[i] * kNIndex + kIndexTimestamp];
+  }
+  return SelectEntry(runNo, mode, nRows, ents.GetArray(), runs.GetArray(),
+		     tims.GetArray(), query, smode);
+}
+
 //____________________________________________________________________
 Bool_t
 AliOADBForward::Table::Insert(TObject* o, 
@@ -558,13 +737,55 @@ AliOADBForward::Table::Get(ULong_t        run,
   Int_t entry  = GetEntry(run, mode, sys, sNN, fld, mc, sat);
   if (entry < 0) return 0;
 
+  Entry* e = ReadEntry(entry);
+  if (!e) return 0;
+  if (fVerbose) e->Print();
+  return e;
+}
+//____________________________________________________________________
+AliOADBForward::Entry*
+AliOADBForward::Table::ReadEntry(Int_t entry) const
+{
+  // 
+  // Read an entry from the tree, unless we already have it.  Entries
+  // read are kept, most recently used first, so that asking for the
+  // same correction again does not decode the object again.
+  //
+  TIter next(&fCache);
+  Entry* e = 0;
+  while ((e = static_cast<Entry*>(next()))) { 
+    if (Int_t(e->GetUniqueID()) != entry) continue;
+    if (e != fCache.First()) {
+      fCache.Remove(e);
+      fCache.AddFirst(e);
+    }
+    return e;
+  }
+
   Int_t nBytes = fTree->GetEntry(entry);
   if (nBytes <= 0) { 
     Warning("Get", "Failed to get entry # %d\n", entry);
     return 0;
   }
-  if (fVerbose) fEntry->Print();
-  return fEntry;
+  if (fCacheSize <= 0) return fEntry;
+
+  // Keep a copy of the entry.  The copy takes over the data object,
+  // so that it is not deleted when the next entry is read into
+  // fEntry.
+  e  = new Entry;
+  *e = *fEntry;
+  e->SetUniqueID(entry);
+  fEntry->fData = 0;
+  fCache.AddFirst(e);
+
+  // Drop the least recently used entries.  The data objects are not
+  // deleted, since they may still be in use.
+  while (fCache.GetEntries() > fCacheSize) {
+    TObject* o = fCache.Last();
+    fCache.Remove(o);
+    delete o;
+  }
+  return e;
 }
 //____________________________________________________________________
 TObject*
@@ -617,6 +838,34 @@ AliOADBForward::Table::IsOpen(Bool_t rw) const
   
   return fTree->GetCurrentFile()->IsWritable();
 }
+//____________________________________________________________________
+void
+AliOADBForward::Table::SetCacheSize(Int_t n)
+{
+  // 
+  // Set the number of entries kept in memory 
+  //
+  fCacheSize = TMath::Max(n, 0);
+  while (fCache.GetEntries() > fCacheSize) {
+    TObject* o = fCache.Last();
+    fCache.Remove(o);
+    delete o;
+  }
+}
+//____________________________________________________________________
+void
+AliOADBForward::Table::ClearCache()
+{
+  // 
+  // Forget the index and the kept entries.  The data objects of the
+  // entries are not deleted.
+  //
+  fCache.Delete();
+  fIndexSize = -1;
+  fIndex.Set(0);
+  fIndexRuns.Set(0);
+  fIndexOrder.Set(0);
+}
 //====================================================================
 AliOADBForward::AliOADBForward() 
   : TObject(),
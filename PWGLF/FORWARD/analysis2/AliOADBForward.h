@@ -4,6 +4,9 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TMap.h>
+#include <TList.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
 class TFile;
 class TTree;
 class TBrowser;
@@ -418,12 +421,105 @@ public:
      * @return true if everything is dandy
      */
     Bool_t IsOpen(Bool_t rw=false) const; 
+    /** 
+     * Set the number of entries returned by Get that are kept in
+     * memory.  If 0, entries are read from the tree on every call.
+     * 
+     * @param n Number of entries to keep 
+     */
+    void SetCacheSize(Int_t n);
+    /** 
+     * Forget the in-memory index and the kept entries.  The data
+     * objects of the kept entries are not deleted, since they may
+     * still be used by whoever got them from Get or GetData.
+     */
+    void ClearCache();
 
     TTree*         fTree;     // Our tree
     Entry*         fEntry;    // Entry cache 
     Bool_t         fVerbose;  // To be verbose or not 
     ERunSelectMode fMode;     // Run query mode 
     Bool_t         fFallBack; // Enable fall-back
+  protected:
+    /** 
+     * Columns of the in-memory index 
+     */
+    enum { 
+      kIndexRun, 
+      kIndexTimestamp, 
+      kIndexSys, 
+      kIndexSNN, 
+      kIndexField, 
+      kIndexMC, 
+      kIndexSatellite, 
+      kNIndex
+    };
+    /** 
+     * Read run number, timestamp, and conditions of all entries
+     * (but not the correction objects) into memory.  This is done
+     * once, and again only if entries were added to the tree.
+     * 
+     * @return true if the index is up to date 
+     */
+    Bool_t BuildIndex() const;
+    /** 
+     * Run a query against the in-memory index.  The selection is the
+     * same as for the query string made by Conditions.
+     * 
+     * @param runNo  Run number 
+     * @param mode   Run selection mode 
+     * @param sys    Collision system (1: pp, 2: PbPb, 3: pPb)
+     * @param sNN    Center of mass energy (GeV)
+     * @param fld    L3 magnetic field (kG)
+     * @param mc     For MC only 
+     * @param sat    For satellite events
+     * 
+     * @return Entry number of selected entry 
+     */
+    Int_t QueryIndex(ULong_t        runNo,
+		     ERunSelectMode mode,
+		     UShort_t       sys,
+		     UShort_t       sNN, 
+		     Short_t        fld,
+		     Bool_t         mc,
+		     Bool_t         sat) const;
+    /** 
+     * Select the best entry among the entries that matched a query 
+     * 
+     * @param runNo  The given run number 
+     * @param mode   Run selection mode 
+     * @param nRows  Number of matching entries 
+     * @param ents   Entry numbers, in tree order 
+     * @param runs   Run numbers 
+     * @param tims   Timestamps 
+     * @param query  Query (for verbose printing)
+     * @param smode  Run selection mode (for verbose printing)
+     * 
+     * @return Entry number of selected entry 
+     */
+    Int_t SelectEntry(ULong_t         runNo, 
+		      ERunSelectMode  mode,
+		      Int_t           nRows, 
+		      const Double_t* ents, 
+		      const Double_t* runs, 
+		      const Double_t* tims, 
+		      const char*     query, 
+		      const char*     smode) const;
+    /** 
+     * Read an entry, using the kept entries if possible 
+     * 
+     * @param entry Entry number 
+     * 
+     * @return The entry or null 
+     */
+    Entry* ReadEntry(Int_t entry) const;
+
+    mutable Int_t   fIndexSize;  //! Number of entries in index, -1 if none
+    mutable TArrayD fIndex;      //! kNIndex columns per entry, in tree order
+    mutable TArrayD fIndexRuns;  //! Run numbers of entries, sorted 
+    mutable TArrayI fIndexOrder; //! Entry numbers in order of fIndexRuns
+    mutable TList   fCache;      //! Entries from Get, most recent first
+    Int_t           fCacheSize;  //! Max number of entries in fCache
 
     ClassDef(Table,1); 
   };
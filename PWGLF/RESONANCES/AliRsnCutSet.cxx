@@ -27,7 +27,10 @@ AliRsnCutSet::AliRsnCutSet() :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fCompiled(kFALSE),
+   fProgram(),
+   fChecked()
 {
 //
 // Constructor without name (not recommended)
@@ -48,7 +51,10 @@ AliRsnCutSet::AliRsnCutSet(const char *name, RSNTARGET target) :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fCompiled(kFALSE),
+   fProgram(),
+   fChecked()
 {
 //
 // Constructor with argument name (recommended)
@@ -70,7 +76,10 @@ AliRsnCutSet::AliRsnCutSet(const AliRsnCutSet &copy) :
    fIsScheme(copy.fIsScheme),
    fExpression(copy.fExpression),
    fMonitors(copy.fMonitors),
-   fUseMonitor(copy.fUseMonitor)
+   fUseMonitor(copy.fUseMonitor),
+   fCompiled(copy.fCompiled),
+   fProgram(copy.fProgram),
+   fChecked(copy.fChecked)
 {
 //
 // Copy constructor
@@ -104,6 +113,9 @@ AliRsnCutSet &AliRsnCutSet::operator=(const AliRsnCutSet &copy)
    fExpression = copy.fExpression;
    fMonitors = copy.fMonitors;
    fUseMonitor = copy.fUseMonitor;
+   fCompiled = copy.fCompiled;
+   fProgram = copy.fProgram;
+   fChecked = copy.fChecked;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -151,6 +163,7 @@ void AliRsnCutSet::AddCut(AliRsnCut *cut)
    AliInfo(Form("====> Adding a new cut: [%s]", cut->GetName()));
    //cut->Print();
    fNumOfCuts++;
+   fCompiled = kFALSE;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -188,15 +201,20 @@ Bool_t AliRsnCutSet::IsSelected(TObject *object)
 
    if (!fNumOfCuts) return kTRUE;
 
+   // daughters and mothers: check only the cuts needed by the compiled scheme;
+   // events: check all cuts, since some are used for what they compute
    Bool_t boolReturn = kTRUE;
-   AliRsnCut *cut;
-   for (i = 0; i < fNumOfCuts; i++) {
-      cut = (AliRsnCut *)fCuts.At(i);
-      fBoolValues[i] = cut->IsSelected(object);
+   if (fIsScheme && GetTargetType() != AliRsnTarget::kEvent && Compile()) {
+      boolReturn = Evaluate(object);
+   } else {
+      AliRsnCut *cut;
+      for (i = 0; i < fNumOfCuts; i++) {
+         cut = (AliRsnCut *)fCuts.At(i);
+         fBoolValues[i] = cut->IsSelected(object);
+      }
+      if (fIsScheme) boolReturn = Passed();
    }
 
-   if (fIsScheme) boolReturn = Passed();
-
    // fill monitoring info
    if (boolReturn && fUseMonitor) {
       if (TargetOK(object)) {
@@ -224,6 +242,7 @@ void AliRsnCutSet::SetCutScheme(const char *theValue)
    fCutScheme = theValue;
    SetCutSchemeIndexed(theValue);
    fIsScheme = kTRUE;
+   fCompiled = kFALSE;
    AliDebug(AliLog::kDebug, "->");
 }
 
@@ -278,6 +297,79 @@ Bool_t AliRsnCutSet::Passed()
    return fExpression->Value(*GetCuts());
 }
 
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::Compile()
+{
+//
+// Compiles the cut expression into a program over the cut indexes,
+// once. Returns kFALSE if the expression cannot be compiled,
+// then it is evaluated by AliRsnExpression::Value as before.
+//
+
+   if (fCompiled) return !fProgram.empty();
+   fCompiled = kTRUE;
+
+   AliRsnExpression::fgCutSet = this;
+   if (!fExpression) {
+      fExpression = new AliRsnExpression(fCutSchemeIndexed);
+      AliDebug(AliLog::kDebug, "fExpression was created.");
+   }
+
+   fProgram.clear();
+   if (!fExpression->Compile(fProgram, fNumOfCuts)) {
+      AliWarning(Form("Cut scheme '%s' not compiled, all cuts will be checked", fCutScheme.Data()));
+      fProgram.clear();
+      return kFALSE;
+   }
+   fChecked.assign(fNumOfCuts, kFALSE);
+
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::Evaluate(TObject *object)
+{
+//
+// Runs the compiled cut expression on the object.
+// Each cut is checked when its value is first needed, so the cuts
+// skipped by a short-circuit are not checked, and their entry
+// in fBoolValues keeps the value of a previous object.
+//
+
+   Int_t i, pc = 0, n = fProgram.size();
+   for (i = 0; i < fNumOfCuts; i++) fChecked[i] = kFALSE;
+
+   Bool_t value = kTRUE;
+   while (pc < n) {
+      switch (fProgram[pc]) {
+         case AliRsnExpression::kCodeCut:
+            i = fProgram[pc + 1];
+            if (!fChecked[i]) {
+               fBoolValues[i] = ((AliRsnCut *)fCuts.UncheckedAt(i))->IsSelected(object);
+               fChecked[i] = kTRUE;
+            }
+            value = fBoolValues[i];
+            pc += 2;
+            break;
+         case AliRsnExpression::kCodeNot:
+            value = !value;
+            pc++;
+            break;
+         case AliRsnExpression::kCodeJumpIfFalse:
+            pc = value ? pc + 2 : fProgram[pc + 1];
+            break;
+         case AliRsnExpression::kCodeJumpIfTrue:
+            pc = value ? fProgram[pc + 1] : pc + 2;
+            break;
+         default:
+            AliError("Illegal instruction in compiled cut scheme!");
+            return kFALSE;
+      }
+   }
+
+   return value;
+}
+
 //_____________________________________________________________________________
 Bool_t AliRsnCutSet::IsValidScheme()
 {
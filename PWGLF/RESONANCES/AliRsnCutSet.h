@@ -12,6 +12,8 @@
 #ifndef ALIRSNCUTSET_H
 #define ALIRSNCUTSET_H
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 
@@ -64,6 +66,9 @@ public:
 
 private:
 
+   Bool_t    Compile();
+   Bool_t    Evaluate(TObject *object);
+
    TObjArray         fCuts;                  // array of cuts
    Int_t             fNumOfCuts;             // number of cuts
    TString           fCutScheme;             // cut scheme
@@ -76,7 +81,11 @@ private:
    TObjArray         fMonitors;              // array of monitor object
    Bool_t            fUseMonitor;            // flag if monitoring should be used
 
-   ClassDef(AliRsnCutSet, 3)   // ROOT dictionary
+   Bool_t              fCompiled;            //! compilation of the cut scheme was attempted
+   std::vector<Int_t>  fProgram;             //! compiled cut scheme (see AliRsnExpression::Compile), empty if it failed
+   std::vector<Bool_t> fChecked;             //! cuts already checked for the current object
+
+   ClassDef(AliRsnCutSet, 4)   // ROOT dictionary
 };
 
 #endif
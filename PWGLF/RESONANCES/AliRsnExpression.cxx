@@ -133,6 +133,47 @@ Bool_t AliRsnExpression::Value(TObjArray &vars)
    return kFALSE;
 }
 
+//______________________________________________________________________________
+Bool_t AliRsnExpression::Compile(std::vector<Int_t> &program, Int_t ncuts) const
+{
+   // Append to 'program' the instructions which evaluate the expression
+   // with short-circuits: the right argument of '&' ('|') is skipped
+   // when the left one is false (true), so that its cuts need not be checked.
+   // The value of the expression is the value after the last instruction.
+   // Returns kFALSE for an undefined expression or a cut index not in [0, ncuts).
+
+   if (fArg2 == 0 && fVname.IsNull()) return kFALSE;
+
+   Int_t jump, index;
+   switch (fOperator) {
+
+      case kOpOR :
+      case kOpAND :
+         if (!fArg1 || !fArg1->Compile(program, ncuts)) return kFALSE;
+         program.push_back(fOperator == kOpAND ? kCodeJumpIfFalse : kCodeJumpIfTrue);
+         jump = program.size();
+         program.push_back(-1);
+         if (!fArg2->Compile(program, ncuts)) return kFALSE;
+         program[jump] = program.size();
+         return kTRUE;
+
+      case kOpNOT :
+         if (!fArg2->Compile(program, ncuts)) return kFALSE;
+         program.push_back(kCodeNot);
+         return kTRUE;
+
+      case 0 :
+         if (!fVname.IsDigit()) return kFALSE;
+         index = fVname.Atoi();
+         if (index < 0 || index >= ncuts) return kFALSE;
+         program.push_back(kCodeCut);
+         program.push_back(index);
+         return kTRUE;
+
+      default:
+         return kFALSE;
+   }
+}
 
 //______________________________________________________________________________
 TString AliRsnExpression::Unparse() const
@@ -10,6 +10,8 @@
 #ifndef ALIRSNEXPRESSION_H
 #define ALIRSNEXPRESSION_H
 
+#include <vector>
+
 #include <TObject.h>
 
 class TObjArray;
@@ -27,6 +29,14 @@ public:
       kOpNOT      // Unary negation '!'
    };
 
+   // instructions of the compiled expression (see Compile)
+   enum ECode {
+      kCodeCut,         // value of the cut with the index given by the next word
+      kCodeNot,         // negate the value
+      kCodeJumpIfFalse, // if the value is false, jump to the position given by the next word
+      kCodeJumpIfTrue   // if the value is true, jump to the position given by the next word
+   };
+
    AliRsnExpression() : fVname(0), fArg1(0), fArg2(0), fOperator(0)  {}
    AliRsnExpression(TString exp);
    virtual    ~AliRsnExpression();
@@ -35,6 +45,7 @@ public:
 
    virtual Bool_t     Value(TObjArray &vars);
    virtual TString     Unparse() const;
+   Bool_t              Compile(std::vector<Int_t> &program, Int_t ncuts) const;
 
    void SetCutSet(AliRsnCutSet *const theValue) { fgCutSet = theValue; }
    AliRsnCutSet *GetCutSet() const { return fgCutSet; }
@@ -42,12 +42,50 @@
 #include "AliQnCorrectionsQnVector.h"
 
 #include "AliRsnCutSet.h"
+#include "AliRsnMiniAxis.h"
 #include "AliRsnMiniPair.h"
 #include "AliRsnMiniEvent.h"
+#include "AliRsnMiniEventStore.h"
 #include "AliRsnMiniParticle.h"
 
 #include "AliRsnMiniAnalysisTask.h"
 
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace {
+   //__________________________________________________________________________________________________
+   void MixEvents(Int_t first, Int_t last, Int_t nMix, const Int_t *partners, const Int_t *npartners,
+                  const std::map<Int_t, AliRsnMiniEvent *> *events, TObjArray *defs, TClonesArray *values)
+   {
+   //
+   // Fill the mixing definitions in 'defs' with the main events [first, last)
+   // and their partners, taken from 'events'; events missing there have no
+   // particle for these definitions. Touches only the definitions and
+   // the values passed, so that several calls can run concurrently.
+   //
+
+      Int_t ndefs = defs->GetEntriesFast();
+      std::map<Int_t, AliRsnMiniEvent *>::const_iterator it;
+      for (Int_t ievt = first; ievt < last; ievt++) {
+         if (!npartners[ievt]) continue;
+         if ((it = events->find(ievt)) == events->end()) continue;
+         AliRsnMiniEvent *evMain = it->second;
+         for (Int_t ip = 0; ip < npartners[ievt]; ip++) {
+            if ((it = events->find(partners[(Long64_t)ievt * nMix + ip])) == events->end()) continue;
+            AliRsnMiniEvent *evMix = it->second;
+            for (Int_t idef = 0; idef < ndefs; idef++) {
+               AliRsnMiniOutput *def = (AliRsnMiniOutput *)defs->UncheckedAt(idef);
+               def->FillPair(evMain, evMix, values, kTRUE);
+               if (!def->IsSymmetric()) def->FillPair(evMix, evMain, values, kFALSE);
+            }
+         }
+      }
+   }
+}
+
 
 ClassImp(AliRsnMiniAnalysisTask)
 
@@ -101,7 +139,11 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
    fKeepMotherInAcceptance(kFALSE),
-   fRsnTreeInFile(kFALSE)
+   fRsnTreeInFile(kFALSE),
+   fMixNThreads(1),
+   fUseEventStore(kFALSE),
+   fEventStoreMaxBytes(0),
+   fEvStore(0x0)
 {
 //
 // Dummy constructor ALWAYS needed for I/O.
@@ -158,7 +200,11 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
    fKeepMotherInAcceptance(kFALSE),
-   fRsnTreeInFile(saveRsnTreeInFile)
+   fRsnTreeInFile(saveRsnTreeInFile),
+   fMixNThreads(1),
+   fUseEventStore(kFALSE),
+   fEventStoreMaxBytes(0),
+   fEvStore(0x0)
 {
 //
 // Default constructor.
@@ -221,7 +267,11 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMotherAcceptanceCutMinPt(copy.fMotherAcceptanceCutMinPt),
    fMotherAcceptanceCutMaxEta(copy.fMotherAcceptanceCutMaxEta),
    fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance),
-   fRsnTreeInFile(copy.fRsnTreeInFile)
+   fRsnTreeInFile(copy.fRsnTreeInFile),
+   fMixNThreads(copy.fMixNThreads),
+   fUseEventStore(copy.fUseEventStore),
+   fEventStoreMaxBytes(copy.fEventStoreMaxBytes),
+   fEvStore(0x0)
 {
 //
 // Copy constructor.
@@ -286,6 +336,9 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fMotherAcceptanceCutMaxEta = copy.fMotherAcceptanceCutMaxEta;
    fKeepMotherInAcceptance = copy.fKeepMotherInAcceptance;
    fRsnTreeInFile = copy.fRsnTreeInFile;
+   fMixNThreads = copy.fMixNThreads;
+   fUseEventStore = copy.fUseEventStore;
+   fEventStoreMaxBytes = copy.fEventStoreMaxBytes;
 
    return (*this);
 }
@@ -301,6 +354,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
    if (fOutput && !AliAnalysisManager::GetAnalysisManager()->IsProofMode()) {
       delete fOutput;
       delete fEvBuffer;
+      delete fEvStore;
    }
 }
 
@@ -405,12 +459,18 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
       cs->Init(fOutput);
    }
 
-   // create temporary tree for filtered events
+   // create temporary buffer for filtered events: in memory,
+   // or a tree (always when it is saved in the output file)
    if (fMiniEvent) SafeDelete(fMiniEvent);
-   if (fRsnTreeInFile) OpenFile(2);
-   fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");  
    fMiniEvent = new AliRsnMiniEvent();
-   fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   if (fUseEventStore && fRsnTreeInFile) AliWarning("Event tree saved in file: not using the in-memory event store");
+   if (fUseEventStore && !fRsnTreeInFile) {
+      fEvStore = new AliRsnMiniEventStore(fEventStoreMaxBytes);
+   } else {
+      if (fRsnTreeInFile) OpenFile(2);
+      fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
+      fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   }
    
    // create one histogram per each stored definition (event histograms)
    Int_t i, ndef = fHistograms.GetEntries();
@@ -467,10 +527,13 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
    } else {
-      Int_t id = fEvBuffer->GetEntries();
+      Int_t id = fEvStore ? fEvStore->GetEntries() : (Int_t)fEvBuffer->GetEntries();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
       fMiniEvent->ID() = id;
-      fEvBuffer->Fill();
+      if (fEvStore)
+         fEvStore->Add(fMiniEvent);
+      else
+         fEvBuffer->Fill();
    }
 
    // post data for computed stuff
@@ -489,10 +552,10 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 //
 
    // security code: reassign the buffer to the mini-event cursor
-   fEvBuffer->SetBranchAddress("events", &fMiniEvent);
+   if (fEvBuffer) fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
-   Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
+   Int_t ievt, nEvents = fEvStore ? fEvStore->GetEntries() : (Int_t)fEvBuffer->GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
    Int_t imix, iloop, ifill;
    AliRsnMiniOutput *def = 0x0;
@@ -505,6 +568,10 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       else printNum = 0;
    }
 
+   // event-matching variables and cut bits of the particles, kept in memory for the mixing
+   std::vector<Float_t> evVz(nEvents), evMult(nEvents), evAngle(nEvents);
+   std::vector<UShort_t> evCutBits(nEvents);
+
    // loop on events, and for each one fill all outputs
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
@@ -512,7 +579,11 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
-      fEvBuffer->GetEntry(ievt);
+      ReadEvent(ievt, fMiniEvent);
+      evVz[ievt]    = fMiniEvent->Vz();
+      evMult[ievt]  = fMiniEvent->Mult();
+      evAngle[ievt] = fMiniEvent->Angle();
+      evCutBits[ievt] = fEvStore ? fEvStore->GetCutBits(ievt) : AliRsnMiniEventStore::CutBits(fMiniEvent);
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -562,82 +633,186 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
+   // index of the events by mixing cell: events which can match
+   // are in the same cell (binned mixing) or in neighbouring cells (continuous mixing);
+   // the events of each cell are in increasing order
+   std::map<Long64_t, std::vector<Int_t> > cells;
+   for (ievt = 0; ievt < nEvents; ievt++) cells[MixingCell(evVz[ievt], evMult[ievt], evAngle[ievt])].push_back(ievt);
+   Int_t nNeighbours = fContinuousMix ? 27 : 1;
 
+   // mixing partners: events chosen by each event (at most fNMix),
+   // and number of matches of each event, either chosen or chosen by others
+   std::vector<Int_t> partners((Long64_t)nEvents * fNMix, -1);
+   std::vector<Int_t> npartners(nEvents, 0);
+   std::vector<Int_t> nmatched(nEvents, 0);
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
-   // search for good matchings
+   // search for good matchings, scanning the candidates in the same order
+   // as a loop on all events starting after the main one (ievt+1, ..., nEvents-1, 0, ..., ievt-1)
+   const std::vector<Int_t> *candidates[27];
+   std::vector<Int_t>::const_iterator cursor[27];
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
+      Int_t ncand = 0;
+      for (Int_t in = 0; in < nNeighbours; in++) {
+         Long64_t key = fContinuousMix ? MixingCell(evVz[ievt], evMult[ievt], evAngle[ievt], in % 3 - 1, (in / 3) % 3 - 1, in / 9 - 1)
+                                       : MixingCell(evVz[ievt], evMult[ievt], evAngle[ievt]);
+         std::map<Long64_t, std::vector<Int_t> >::const_iterator cell = cells.find(key);
+         if (cell == cells.end()) continue;
+         // neighbours can coincide when a variable is not binned
+         if (std::find(candidates, candidates + ncand, &cell->second) != candidates + ncand) continue;
+         candidates[ncand] = &cell->second;
+         cursor[ncand] = std::upper_bound(cell->second.begin(), cell->second.end(), ievt);
+         ncand++;
+      }
+      // two passes: events after the main one, then events before it
+      for (Int_t pass = 0; pass < 2 && nmatched[ievt] < fNMix; pass++) {
+         if (pass == 1) for (Int_t ic = 0; ic < ncand; ic++) cursor[ic] = candidates[ic]->begin();
+         while (nmatched[ievt] < fNMix) {
+            // next candidate in increasing order among all cells
+            Int_t inext = -1;
+            for (Int_t ic = 0; ic < ncand; ic++) {
+               if (cursor[ic] == candidates[ic]->end()) continue;
+               if (pass == 1 && *cursor[ic] >= ievt) continue;
+               if (inext < 0 || *cursor[ic] < *cursor[inext]) inext = ic;
+            }
+            if (inext < 0) break;
+            imix = *cursor[inext]++;
+            // skip if events are not matched
+            if (!EventsMatch(evVz[ievt], evMult[ievt], evAngle[ievt], evVz[imix], evMult[imix], evAngle[imix])) continue;
+            // check that the found good event has not enough matches already
+            if (nmatched[imix] >= fNMix) continue;
+            // check that the mixed event has not already chosen the main event
+            Int_t *chosen = &partners[(Long64_t)imix * fNMix];
+            if (std::find(chosen, chosen + npartners[imix], ievt) != chosen + npartners[imix]) continue;
+            // add new mixing candidate
+            partners[(Long64_t)ievt * fNMix + npartners[ievt]++] = imix;
+            nmatched[ievt]++;
+            nmatched[imix]++;
+         }
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
    }
+   cells.clear();
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
-   // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+   // mixing definitions, and those which can be filled in parallel: not the ones
+   // with pair cuts, since cut sets evaluate their expressions through a global pointer,
+   // nor the ones with a PhiV axis, since the pair ordering for it is drawn from gRandom
+   // events without particles passing the cuts used by these definitions need not be read
+   // (all are read if a definition takes all particles or a cut without a bit)
+   TObjArray mixDefs, parallelDefs;
+   Int_t mixCutBits = 0;
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def || !def->IsTrackPairMix()) continue;
+      mixDefs.Add(def);
+      Bool_t parallel = !def->GetPairCuts();
+      for (Int_t iaxis = 0; parallel && def->GetAxis(iaxis); iaxis++) {
+         AliRsnMiniValue *val = (AliRsnMiniValue *)fValues.At(def->GetAxis(iaxis)->GetValueID());
+         if (val && val->GetType() == AliRsnMiniValue::kPhiV) parallel = kFALSE;
       }
-      ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
-               AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
-            }
+      if (parallel) parallelDefs.Add(def);
+      for (Int_t id = 0; id < 2 && mixCutBits >= 0; id++) {
+         Int_t cutID = def->GetCutID(id);
+         if (cutID < 0 || cutID >= 16) mixCutBits = -1;
+         else mixCutBits |= (1 << cutID);
+      }
+   }
+
+   // each thread fills copies of the parallel definitions, with their own
+   // empty copies of the outputs, and its own copy of the values;
+   // the other definitions are filled in this thread meanwhile
+   Int_t nThreads = fMixNThreads;
+   if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+   if (nThreads <= 1 || parallelDefs.IsEmpty()) nThreads = 1;
+   std::vector<TList *> threadOutputs;
+   std::vector<TObjArray *> threadDefs;
+   std::vector<TClonesArray *> threadValues;
+   if (nThreads > 1) {
+      AliInfo(Form("[%s] Filling %d mixing outputs in %d threads", GetName(), parallelDefs.GetEntriesFast(), nThreads));
+      for (Int_t it = 0; it < nThreads; it++) {
+         threadOutputs.push_back(new TList);
+         threadOutputs[it]->SetOwner();
+         threadDefs.push_back(new TObjArray);
+         threadDefs[it]->SetOwner();
+         for (idef = 0; idef < parallelDefs.GetEntriesFast(); idef++) {
+            AliRsnMiniOutput *copy = new AliRsnMiniOutput(*(AliRsnMiniOutput *)parallelDefs[idef]);
+            copy->InitCopy(threadOutputs[it]);
+            threadDefs[it]->Add(copy);
          }
+         threadValues.push_back(new TClonesArray(fValues));
       }
-      delete list;
+      for (idef = 0; idef < parallelDefs.GetEntriesFast(); idef++) mixDefs.Remove(parallelDefs[idef]);
+      mixDefs.Compress();
    }
 
-   delete [] smatched;
+   // perform mixing in blocks of main events; the main events and their
+   // partners are read once per block, in increasing order, and shared by the threads
+   const Int_t kMixBlock = 1000;
+   std::map<Int_t, AliRsnMiniEvent *> events;
+   std::vector<Int_t> needed;
+   for (Int_t first = 0; first < nEvents; first += kMixBlock) {
+      Int_t last = TMath::Min(first + kMixBlock, nEvents);
+      if (printNum && (first / printNum != last / printNum || first == 0)) {
+         AliInfo(Form("[%s] EventMixing %d/%d",GetName(),first,nEvents));
+         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+      }
+      needed.clear();
+      for (ievt = first; ievt < last; ievt++) {
+         if (!npartners[ievt]) continue;
+         needed.push_back(ievt);
+         for (iloop = 0; iloop < npartners[ievt]; iloop++) needed.push_back(partners[(Long64_t)ievt * fNMix + iloop]);
+      }
+      std::sort(needed.begin(), needed.end());
+      needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+      // drop the events of the previous block which are not needed anymore, read the missing ones
+      for (std::map<Int_t, AliRsnMiniEvent *>::iterator it = events.begin(); it != events.end();) {
+         if (std::binary_search(needed.begin(), needed.end(), it->first)) { ++it; continue; }
+         delete it->second;
+         events.erase(it++);
+      }
+      for (std::vector<Int_t>::const_iterator it = needed.begin(); it != needed.end(); ++it) {
+         if (events.count(*it)) continue;
+         if (mixCutBits >= 0 && !(evCutBits[*it] & mixCutBits)) continue;
+         AliRsnMiniEvent *event = new AliRsnMiniEvent();
+         ReadEvent(*it, event);
+         events[*it] = event;
+      }
+      // fill
+      if (nThreads > 1) {
+         std::vector<std::thread> threads;
+         for (Int_t it = 0; it < nThreads; it++) {
+            Int_t tfirst = first + ((last - first) * it) / nThreads;
+            Int_t tlast  = first + ((last - first) * (it + 1)) / nThreads;
+            threads.push_back(std::thread(MixEvents, tfirst, tlast, fNMix, &partners[0], &npartners[0],
+                                          &events, threadDefs[it], threadValues[it]));
+         }
+         MixEvents(first, last, fNMix, &partners[0], &npartners[0], &events, &mixDefs, &fValues);
+         for (Int_t it = 0; it < nThreads; it++) threads[it].join();
+      } else {
+         MixEvents(first, last, fNMix, &partners[0], &npartners[0], &events, &mixDefs, &fValues);
+      }
+   }
+   for (std::map<Int_t, AliRsnMiniEvent *>::iterator it = events.begin(); it != events.end(); ++it) delete it->second;
+   events.clear();
+
+   // add the outputs filled by the threads
+   for (Int_t it = 0; it < (Int_t)threadDefs.size(); it++) {
+      for (idef = 0; idef < parallelDefs.GetEntriesFast(); idef++)
+         ((AliRsnMiniOutput *)parallelDefs[idef])->AddOutput((AliRsnMiniOutput *)threadDefs[it]->At(idef));
+      delete threadDefs[it];
+      delete threadOutputs[it];
+      delete threadValues[it];
+   }
 
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
@@ -1455,33 +1630,43 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
+//
+// Check if two events with the given vz, mult and angle are compatible (see above)
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Vz = %f", dv));
          return kFALSE;
       }
       if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Mult = %f", dm));
          return kFALSE;
       }
       if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Angle = %f", da));
          return kFALSE;
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1489,6 +1674,50 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::ReadEvent(Int_t ievt, AliRsnMiniEvent *event)
+{
+//
+// Read the buffered mini-event with the given index into the passed one,
+// from the in-memory store or from the tree (whose cursor is fMiniEvent)
+//
+
+   if (fEvStore) return fEvStore->GetEvent(ievt, event);
+   if (fEvBuffer->GetEntry(ievt) <= 0) return kFALSE;
+   if (event != fMiniEvent) *event = *fMiniEvent;
+   return kTRUE;
+}
+
+//__________________________________________________________________________________________________
+Long64_t AliRsnMiniAnalysisTask::MixingCell(Float_t vz, Float_t mult, Float_t angle, Int_t dvz, Int_t dmult, Int_t dangle) const
+{
+//
+// Key of the mixing cell of an event, or of one of its neighbours (shifted by dvz, dmult, dangle).
+// Binned mixing: the cell is the mixing bin, so only events in the same cell match.
+// Continuous mixing: the cells are slightly larger than the maximum differences,
+// so that matching events are in the same or in neighbouring cells.
+// Values outside the range of the key end up in the first or last cell.
+//
+
+   const Long64_t kHalfRange = 1 << 20;
+   Float_t  values[3] = {vz, mult, angle};
+   Double_t widths[3] = {fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle};
+   Int_t    shifts[3] = {dvz, dmult, dangle};
+   Long64_t key = 0;
+   for (Int_t i = 0; i < 3; i++) {
+      Long64_t cell = 0;
+      if (widths[i] > 0.) {
+         Double_t x = fContinuousMix ? TMath::Floor(values[i] / (widths[i] * (1.0 + 1E-6))) : (Double_t)(Int_t)(values[i] / widths[i]);
+         x += shifts[i];
+         if (x < -kHalfRange) x = -kHalfRange;
+         if (x > kHalfRange - 1) x = kHalfRange - 1;
+         cell = (Long64_t)x;
+      }
+      key = (key << 21) | (cell + kHalfRange);
+   }
+   return key;
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
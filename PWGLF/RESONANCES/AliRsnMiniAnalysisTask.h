@@ -27,6 +27,7 @@ class TList;
 
 class AliTriggerAnalysis;
 class AliRsnMiniEvent;
+class AliRsnMiniEventStore;
 class AliRsnCutSet;
 class AliQnCorrectionsManager;
 class AliQnCorrectionsQnVector;
@@ -59,6 +60,7 @@ public:
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
+   void                SetMixNThreads(Int_t n)            {fMixNThreads = n;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
    void                SetMaxNDaughters(Short_t n)        {fMaxNDaughters = n;}
    void                SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -69,6 +71,7 @@ public:
    void                SetMotherAcceptanceCutMaxEta(Float_t maxEta){fMotherAcceptanceCutMaxEta = maxEta;}
    void                KeepMotherInAcceptance(Bool_t keepMotherInAcceptance) {fKeepMotherInAcceptance = keepMotherInAcceptance;}
    void                SaveRsnTreeInFile(Bool_t saveInFile=kTRUE) {fRsnTreeInFile = saveInFile;}
+   void                UseEventStore(Bool_t yn = kTRUE, Long64_t maxBytes = 0) {fUseEventStore = yn; fEventStoreMaxBytes = maxBytes;}
    Int_t               AddTrackCuts(AliRsnCutSet *cuts);
    TClonesArray       *Outputs()                          {return &fHistograms;}
    TClonesArray       *Values()                           {return &fValues;}
@@ -101,6 +104,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const;
+   Bool_t   ReadEvent(Int_t ievt, AliRsnMiniEvent *event);
+   Long64_t MixingCell(Float_t vz, Float_t mult, Float_t angle, Int_t dvz = 0, Int_t dmult = 0, Int_t dangle = 0) const;
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -157,8 +163,12 @@ private:
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
    Bool_t               fRsnTreeInFile;  // flag rsn tree should be saved in file instead of memory
+   Int_t                fMixNThreads;     // threads filling the mixing outputs in FinishTaskOutput (0 = one per core)
+   Bool_t               fUseEventStore;   // keep the mini-events in memory (AliRsnMiniEventStore) instead of a tree
+   Long64_t             fEventStoreMaxBytes; // memory budget of the event store, events beyond go to a temporary file (0 = no limit)
+   AliRsnMiniEventStore *fEvStore;        //! in-memory mini-event buffer
 
-   ClassDef(AliRsnMiniAnalysisTask, 15);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 17);   // AliRsnMiniAnalysisTask
 };
 
 
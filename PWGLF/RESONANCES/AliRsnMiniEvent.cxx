@@ -112,9 +112,11 @@ AliRsnMiniParticle *AliRsnMiniEvent::GetParticle(Int_t i)
 // Return the particle
 //
 
-   if (i < 0 || i > fParticles.GetEntriesFast()) return 0x0;
+   if (i < 0 || i >= fParticles.GetEntriesFast()) return 0x0;
 
-   return (AliRsnMiniParticle *)fParticles[i];
+   // UncheckedAt does not modify the array (unlike operator[]),
+   // so that the event can be read by several threads (see AliRsnMiniAnalysisTask::FinishTaskOutput)
+   return (AliRsnMiniParticle *)fParticles.UncheckedAt(i);
 }
 
 //__________________________________________________________________________________________________
@@ -127,7 +129,7 @@ AliRsnMiniParticle *AliRsnMiniEvent::LeadingParticle()
    if (fLeading < 0) return 0x0;
    if (fLeading >= fParticles.GetEntriesFast()) return 0x0;
 
-   return (AliRsnMiniParticle *)fParticles[fLeading];
+   return (AliRsnMiniParticle *)fParticles.UncheckedAt(fLeading);
 }
 
 //__________________________________________________________________________________________________
@@ -146,7 +148,7 @@ Int_t AliRsnMiniEvent::CountParticles(TArrayI &found, Char_t charge, Int_t cutID
    found.Set(npart);
 
    for (i = 0; i < npart; i++) {
-      part = (AliRsnMiniParticle *)fParticles[i];
+      part = (AliRsnMiniParticle *)fParticles.UncheckedAt(i);
       if (charge == '+' || charge == '-' || charge == '0') {
          if (part->Charge() != charge) continue;
       }
@@ -29,6 +29,7 @@ public:
    Float_t            &RefMult()   {return fRefMult;}
    Float_t            &Tracklets() {return fTracklets;}
    Float_t            &Angle()     {return fAngle;}
+   Int_t              &Leading()   {return fLeading;}
    TClonesArray       &Particles() {return fParticles;}
    Bool_t              IsEmpty()   {return fParticles.IsEmpty();}
    void                Clear(Option_t *opt="");
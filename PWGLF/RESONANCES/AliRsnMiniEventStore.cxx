@@ -0,0 +1,283 @@
+//
+// Mini-Event store
+// In-memory alternative to the temporary tree of mini-events
+// used by AliRsnMiniAnalysisTask for the event mixing.
+// Particles of all events are kept in contiguous arrays (one per
+// data member of AliRsnMiniParticle), with the offset of the first
+// particle of each event, the event variables and the OR of the cut
+// bits of its particles.
+// When the memory budget is exceeded, further events are written
+// to a tree in a temporary file, which is removed at the end.
+//
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TSystem.h>
+#include <TDirectory.h>
+#include <TClonesArray.h>
+
+#include "AliLog.h"
+
+#include "AliRsnMiniParticle.h"
+#include "AliRsnMiniEvent.h"
+#include "AliRsnMiniEventStore.h"
+
+ClassImp(AliRsnMiniEventStore)
+
+namespace {
+   // memory used by one event and by one particle in the arrays
+   const Long64_t kEventBytes = sizeof(Long64_t) + 2 * sizeof(Int_t) + 5 * sizeof(Float_t) + sizeof(UShort_t);
+   const Long64_t kParticleBytes = 4 * sizeof(Int_t) + sizeof(Char_t) + 9 * sizeof(Float_t) + 3 * sizeof(Short_t)
+                                   + sizeof(Double_t) + 2 * sizeof(Bool_t) + sizeof(UShort_t);
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::AliRsnMiniEventStore(Long64_t maxBytes) :
+   TObject(),
+   fMaxBytes(maxBytes),
+   fBytes(0),
+   fNInMemory(0),
+   fNSpilled(0),
+   fEvFirst(1, 0),
+   fSpillName(""),
+   fSpillFile(0x0),
+   fSpillTree(0x0),
+   fSpillEvent(0x0)
+{
+//
+// Constructor, with the memory budget in bytes (0 = no limit)
+//
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::~AliRsnMiniEventStore()
+{
+//
+// Destructor, removes the temporary file if any
+//
+
+   Clear();
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEventStore::Clear(Option_t *)
+{
+//
+// Removes all events and the temporary file
+//
+
+   fBytes = 0;
+   fNInMemory = 0;
+   fNSpilled = 0;
+
+   fEvFirst.assign(1, 0);
+   fEvID.clear();
+   fEvVz.clear();
+   fEvMult.clear();
+   fEvRefMult.clear();
+   fEvTracklets.clear();
+   fEvAngle.clear();
+   fEvLeading.clear();
+   fEvCutBits.clear();
+
+   fIndex.clear();
+   fIndexV0Pos.clear();
+   fIndexV0Neg.clear();
+   fCharge.clear();
+   for (Int_t i = 0; i < 3; i++) {
+      fPsim[i].clear();
+      fPrec[i].clear();
+      fPmother[i].clear();
+   }
+   fPDG.clear();
+   fMother.clear();
+   fMotherPDG.clear();
+   fDCA.clear();
+   fNTotSisters.clear();
+   fIsFromB.clear();
+   fIsQuarkFound.clear();
+   fCutBits.clear();
+
+   // the tree belongs to the file
+   if (fSpillFile) {
+      delete fSpillFile;
+      gSystem->Unlink(fSpillName.Data());
+   }
+   delete fSpillEvent;
+   fSpillFile = 0x0;
+   fSpillTree = 0x0;
+   fSpillEvent = 0x0;
+   fSpillName = "";
+}
+
+//__________________________________________________________________________________________________
+UShort_t AliRsnMiniEventStore::CutBits(AliRsnMiniEvent *event)
+{
+//
+// OR of the cut bits of the particles of an event
+//
+
+   UShort_t bits = 0;
+   TClonesArray &particles = event->Particles();
+   Int_t i, n = particles.GetEntriesFast();
+   for (i = 0; i < n; i++) bits |= ((AliRsnMiniParticle *)particles.UncheckedAt(i))->CutBits();
+   return bits;
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniEventStore::Add(AliRsnMiniEvent *event)
+{
+//
+// Stores a copy of the event, returns its index in the store.
+// Once an event did not fit in the memory budget,
+// all further ones go to the spill tree, to keep them in order.
+//
+
+   Int_t i, n = event->Particles().GetEntriesFast();
+   fEvCutBits.push_back(CutBits(event));
+
+   if (fNSpilled || (fMaxBytes > 0 && fBytes + kEventBytes + n * kParticleBytes > fMaxBytes)) {
+      if (!fSpillTree && !OpenSpill()) {
+         fEvCutBits.pop_back();
+         return -1;
+      }
+      *fSpillEvent = *event;
+      fSpillTree->Fill();
+      return fNInMemory + fNSpilled++;
+   }
+
+   fEvID.push_back(event->ID());
+   fEvVz.push_back(event->Vz());
+   fEvMult.push_back(event->Mult());
+   fEvRefMult.push_back(event->RefMult());
+   fEvTracklets.push_back(event->Tracklets());
+   fEvAngle.push_back(event->Angle());
+   fEvLeading.push_back(event->Leading());
+
+   AliRsnMiniParticle *p = 0x0;
+   for (i = 0; i < n; i++) {
+      p = (AliRsnMiniParticle *)event->Particles().UncheckedAt(i);
+      fIndex.push_back(p->Index());
+      fIndexV0Pos.push_back(p->IndexV0Pos());
+      fIndexV0Neg.push_back(p->IndexV0Neg());
+      fCharge.push_back(p->Charge());
+      fPsim[0].push_back(p->PsimX());
+      fPsim[1].push_back(p->PsimY());
+      fPsim[2].push_back(p->PsimZ());
+      fPrec[0].push_back(p->PrecX());
+      fPrec[1].push_back(p->PrecY());
+      fPrec[2].push_back(p->PrecZ());
+      fPmother[0].push_back(p->PmotherX());
+      fPmother[1].push_back(p->PmotherY());
+      fPmother[2].push_back(p->PmotherZ());
+      fPDG.push_back(p->PDG());
+      fMother.push_back(p->Mother());
+      fMotherPDG.push_back(p->MotherPDG());
+      fDCA.push_back(p->DCA());
+      fNTotSisters.push_back(p->NTotSisters());
+      fIsFromB.push_back(p->IsFromB());
+      fIsQuarkFound.push_back(p->IsQuarkFound());
+      fCutBits.push_back(p->CutBits());
+   }
+   fEvFirst.push_back(fEvFirst.back() + n);
+   fBytes += kEventBytes + n * kParticleBytes;
+
+   return fNInMemory++;
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniEventStore::GetEvent(Int_t i, AliRsnMiniEvent *event)
+{
+//
+// Copies the stored event with index 'i' into the passed one.
+// The particles already allocated in the event are reused.
+// Not thread safe for the spilled events, which are read from the tree.
+//
+
+   if (i < 0 || i >= GetEntries()) return kFALSE;
+
+   if (i >= fNInMemory) {
+      if (fSpillTree->GetEntry(i - fNInMemory) <= 0) return kFALSE;
+      *event = *fSpillEvent;
+      event->SetRef(0x0);
+      event->SetRefMC(0x0);
+      event->SetQnVector(0x0);
+      return kTRUE;
+   }
+
+   event->ID() = fEvID[i];
+   event->Vz() = fEvVz[i];
+   event->Mult() = fEvMult[i];
+   event->RefMult() = fEvRefMult[i];
+   event->Tracklets() = fEvTracklets[i];
+   event->Angle() = fEvAngle[i];
+   event->Leading() = fEvLeading[i];
+   event->SetRef(0x0);
+   event->SetRefMC(0x0);
+   event->SetQnVector(0x0);
+
+   TClonesArray &particles = event->Particles();
+   particles.Clear("C");
+   AliRsnMiniParticle *p = 0x0;
+   Long64_t j, first = fEvFirst[i], last = fEvFirst[i + 1];
+   for (j = first; j < last; j++) {
+      p = (AliRsnMiniParticle *)particles.ConstructedAt(j - first);
+      p->Index() = fIndex[j];
+      p->IndexV0Pos() = fIndexV0Pos[j];
+      p->IndexV0Neg() = fIndexV0Neg[j];
+      p->Charge() = fCharge[j];
+      p->PsimX() = fPsim[0][j];
+      p->PsimY() = fPsim[1][j];
+      p->PsimZ() = fPsim[2][j];
+      p->PrecX() = fPrec[0][j];
+      p->PrecY() = fPrec[1][j];
+      p->PrecZ() = fPrec[2][j];
+      p->PmotherX() = fPmother[0][j];
+      p->PmotherY() = fPmother[1][j];
+      p->PmotherZ() = fPmother[2][j];
+      p->PDG() = fPDG[j];
+      p->Mother() = fMother[j];
+      p->MotherPDG() = fMotherPDG[j];
+      p->SetDCA(fDCA[j]);
+      p->SetNTotSisters(fNTotSisters[j]);
+      p->IsFromB() = fIsFromB[j];
+      p->IsQuarkFound() = fIsQuarkFound[j];
+      p->CutBits() = fCutBits[j];
+   }
+
+   return kTRUE;
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniEventStore::OpenSpill()
+{
+//
+// Creates the temporary file and the tree for the events beyond the memory budget
+//
+
+   fSpillName = "AliRsnMiniEventStore";
+   FILE *fp = gSystem->TempFileName(fSpillName);
+   if (!fp) {
+      AliError("Cannot create a temporary file for the mini-events beyond the memory budget");
+      return kFALSE;
+   }
+   fclose(fp);
+
+   TDirectory *savedir = gDirectory;
+   fSpillFile = TFile::Open(fSpillName.Data(), "RECREATE");
+   if (!fSpillFile || fSpillFile->IsZombie()) {
+      AliError(Form("Cannot open the temporary file %s", fSpillName.Data()));
+      delete fSpillFile;
+      fSpillFile = 0x0;
+      gSystem->Unlink(fSpillName.Data());
+      if (savedir) savedir->cd();
+      return kFALSE;
+   }
+   fSpillEvent = new AliRsnMiniEvent();
+   fSpillTree = new TTree("EventSpill", "Mini events beyond the memory budget");
+   fSpillTree->Branch("events", "AliRsnMiniEvent", &fSpillEvent);
+   if (savedir) savedir->cd();
+
+   AliInfo(Form("Memory budget of %lld bytes reached after %d events, next ones go to %s", fMaxBytes, fNInMemory, fSpillName.Data()));
+   return kTRUE;
+}
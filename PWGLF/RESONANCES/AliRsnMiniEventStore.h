@@ -0,0 +1,94 @@
+#ifndef ALIRSNMINIEVENTSTORE_H
+#define ALIRSNMINIEVENTSTORE_H
+
+//
+// Mini-Event store
+// In-memory alternative to the temporary tree of mini-events
+// used by AliRsnMiniAnalysisTask for the event mixing.
+// Particles of all events are kept in contiguous arrays (one per
+// data member of AliRsnMiniParticle), with the offset of the first
+// particle of each event, the event variables and the OR of the cut
+// bits of its particles.
+// When the memory budget is exceeded, further events are written
+// to a tree in a temporary file, which is removed at the end.
+//
+
+#include <vector>
+
+#include <TObject.h>
+#include <TString.h>
+
+class TFile;
+class TTree;
+class AliRsnMiniEvent;
+
+class AliRsnMiniEventStore : public TObject {
+public:
+
+   AliRsnMiniEventStore(Long64_t maxBytes = 0);
+   virtual ~AliRsnMiniEventStore();
+
+   void          SetMaxBytes(Long64_t maxBytes)   {fMaxBytes = maxBytes;}
+   Long64_t      GetMaxBytes()              const {return fMaxBytes;}
+   Long64_t      GetBytes()                 const {return fBytes;}
+   Int_t         GetEntries()               const {return fNInMemory + fNSpilled;}
+   Int_t         GetNInMemory()             const {return fNInMemory;}
+   Int_t         GetNSpilled()              const {return fNSpilled;}
+   UShort_t      GetCutBits(Int_t i)        const {return fEvCutBits[i];}
+
+   Int_t         Add(AliRsnMiniEvent *event);
+   Bool_t        GetEvent(Int_t i, AliRsnMiniEvent *event);
+   virtual void  Clear(Option_t *opt = "");
+
+   static UShort_t CutBits(AliRsnMiniEvent *event);
+
+private:
+
+   AliRsnMiniEventStore(const AliRsnMiniEventStore &copy);
+   AliRsnMiniEventStore &operator=(const AliRsnMiniEventStore &copy);
+
+   Bool_t        OpenSpill();
+
+   Long64_t      fMaxBytes;        //  memory budget for the stored events (0 = no limit)
+   Long64_t      fBytes;           //  memory used by the stored events
+   Int_t         fNInMemory;       //  number of events in memory (the first ones)
+   Int_t         fNSpilled;        //  number of events in the spill tree (the following ones)
+
+   // events
+   std::vector<Long64_t> fEvFirst;     //! index of the first particle of each event (one more entry for the end)
+   std::vector<Int_t>    fEvID;        //! event ID
+   std::vector<Float_t>  fEvVz;        //! z-position of vertex
+   std::vector<Float_t>  fEvMult;      //! multiplicity or centrality
+   std::vector<Float_t>  fEvRefMult;   //! reference multiplicity
+   std::vector<Float_t>  fEvTracklets; //! tracklets
+   std::vector<Float_t>  fEvAngle;     //! reaction plane angle
+   std::vector<Int_t>    fEvLeading;   //! index of leading particle
+   std::vector<UShort_t> fEvCutBits;   //! OR of the cut bits of the particles (also for the spilled events)
+
+   // particles
+   std::vector<Int_t>    fIndex;       //! ID of track in its event
+   std::vector<Int_t>    fIndexV0Pos;  //! V0 positive daughter index
+   std::vector<Int_t>    fIndexV0Neg;  //! V0 negative daughter index
+   std::vector<Char_t>   fCharge;      //! charge character
+   std::vector<Float_t>  fPsim[3];     //! MC momentum
+   std::vector<Float_t>  fPrec[3];     //! reconstructed momentum
+   std::vector<Float_t>  fPmother[3];  //! MC momentum of the mother
+   std::vector<Short_t>  fPDG;         //! PDG code
+   std::vector<Int_t>    fMother;      //! index of mother
+   std::vector<Short_t>  fMotherPDG;   //! PDG code of mother
+   std::vector<Double_t> fDCA;         //! DCA
+   std::vector<Short_t>  fNTotSisters; //! number of daughters
+   std::vector<Bool_t>   fIsFromB;     //! from B meson flag
+   std::vector<Bool_t>   fIsQuarkFound;//! from a quark flag
+   std::vector<UShort_t> fCutBits;     //! cut bits
+
+   // spill
+   TString               fSpillName;   //! name of the temporary file
+   TFile                *fSpillFile;   //! temporary file
+   TTree                *fSpillTree;   //! tree of the events beyond the memory budget
+   AliRsnMiniEvent      *fSpillEvent;  //! cursor of the spill tree, the events are copied to and from it
+
+   ClassDef(AliRsnMiniEventStore, 1)
+};
+
+#endif
@@ -326,6 +326,66 @@ Bool_t AliRsnMiniOutput::Init(const char *prefix, TList *list)
    }
 }
 
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::InitCopy(TList *list)
+{
+//
+// Add an empty copy of the current output object to the argument list,
+// and fill that one from now on. Used on copies of an initialized definition,
+// to fill the same histogram separately (e.g. in parallel) and add it back with AddOutput.
+//
+
+   TObject *out = GetOutput();
+   if (!out || !list) {
+      AliError(Form("[%s] Required an initialized output and an output list", GetName()));
+      return kFALSE;
+   }
+
+   TObject *copy = out->Clone();
+   if (copy->InheritsFrom(TH1::Class())) {
+      ((TH1 *)copy)->SetDirectory(0);
+      ((TH1 *)copy)->Reset();
+   } else if (copy->InheritsFrom(THnBase::Class())) {
+      ((THnBase *)copy)->Reset();
+   }
+   fList = list;
+   fList->Add(copy);
+   fOutputID = fList->IndexOf(copy);
+   return kTRUE;
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::AddOutput(const AliRsnMiniOutput *other)
+{
+//
+// Add the content of the output object of the argument to the one of this definition
+//
+
+   TObject *out = GetOutput();
+   TObject *add = other ? other->GetOutput() : 0x0;
+   if (!out || !add) return kFALSE;
+
+   if (out->InheritsFrom(TH1::Class()) && add->InheritsFrom(TH1::Class())) {
+      return ((TH1 *)out)->Add((TH1 *)add);
+   } else if (out->InheritsFrom(THnBase::Class()) && add->InheritsFrom(THnBase::Class())) {
+      ((THnBase *)out)->Add((THnBase *)add);
+      return kTRUE;
+   }
+   AliError(Form("[%s] Outputs of different types", GetName()));
+   return kFALSE;
+}
+
+//__________________________________________________________________________________________________
+TObject *AliRsnMiniOutput::GetOutput() const
+{
+//
+// Output object of this definition, if initialized
+//
+
+   if (!fList || fOutputID < 0) return 0x0;
+   return fList->At(fOutputID);
+}
+
 //__________________________________________________________________________________________________
 void AliRsnMiniOutput::CreateHistogram(const char *name)
 {
@@ -77,6 +77,8 @@ public:
    Double_t        GetMotherMass()      const {return fMotherMass;}
    Bool_t          GetFillHistogramOnlyInRange() { return fCheckHistRange; }
    Short_t         GetMaxNSisters()           {return fMaxNSisters;}
+   AliRsnCutSet   *GetPairCuts()        const {return fPairCuts;}
+   TObject        *GetOutput()          const;
 
    void            SetOutputType(EOutputType type)    {fOutputType = type;}
    void            SetComputation(EComputation src)   {fComputation = src;}
@@ -101,6 +103,8 @@ public:
 
    AliRsnMiniPair &Pair() {return fPair;}
    Bool_t          Init(const char *prefix, TList *list);
+   Bool_t          InitCopy(TList *list);
+   Bool_t          AddOutput(const AliRsnMiniOutput *other);
    Bool_t          FillMother(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillMotherInAcceptance(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillEvent(AliRsnMiniEvent *event, TClonesArray *valueList);
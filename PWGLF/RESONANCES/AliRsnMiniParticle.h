@@ -46,6 +46,8 @@ public:
    UShort_t      &CutBits()                  {return fCutBits;}
    Double_t       DCA()                      {return fDCA;}
    Short_t        NTotSisters()              {return fNTotSisters;}
+   void           SetDCA(Double_t dca)       {fDCA = dca;}
+   void           SetNTotSisters(Short_t n)  {fNTotSisters = n;}
    Bool_t         HasCutBit(Int_t i)         {UShort_t bit = 1 << i; return ((fCutBits & bit) != 0);}
    void           SetCutBit(Int_t i)         {UShort_t bit = 1 << i; fCutBits |=   bit;}
    void           ClearCutBit(Int_t i)       {UShort_t bit = 1 << i; fCutBits &= (~bit);}
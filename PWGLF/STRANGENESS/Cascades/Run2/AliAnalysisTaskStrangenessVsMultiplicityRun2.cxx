@@ -63,6 +63,7 @@ class AliESDv0;
 class AliAODv0;
 
 #include <numeric>
+#include <algorithm>
 
 #include <Riostream.h>
 #include "TList.h"
@@ -122,6 +123,175 @@ class AliAODv0;
 using std::cout;
 using std::endl;
 
+namespace {
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    // Configuration index: configurations differing in a single one-sided
+    // cut (typically the members of a topological scan) are grouped and
+    // sorted by the value of that cut. A candidate is checked once against
+    // the cuts common to the group, and the configurations it passes are
+    // then found with a binary search on the scanned variable.
+    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    enum EV0ScanCut {
+        kV0ScanNone = -1,
+        kV0ScanV0Radius,
+        kV0ScanDCANegToPV,
+        kV0ScanDCAPosToPV,
+        kV0ScanDCAV0Daughters,
+        kV0ScanV0CosPA,
+        kV0ScanProperLifetime,
+        kV0ScanLeastNbrCrossedRows,
+        kV0ScanTPCdEdx,
+        kV0NScanCuts
+    };
+    enum ECascScanCut {
+        kCascScanNone = -1,
+        kCascScanDCANegToPV,
+        kCascScanDCAPosToPV,
+        kCascScanDCAV0Daughters,
+        kCascScanV0CosPA,
+        kCascScanV0Radius,
+        kCascScanDCAV0ToPV,
+        kCascScanV0Mass,
+        kCascScanDCABachToPV,
+        kCascScanDCACascDaughters,
+        kCascScanCascCosPA,
+        kCascScanCascRadius,
+        kCascScanProperLifetime,
+        kCascScanLeastNbrClusters,
+        kCascScanTPCdEdx,
+        kCascScanDCABachToBaryon,
+        kCascNScanCuts
+    };
+
+    template <class T> struct ScanCut {
+        Double_t (T::*fGet)() const;
+        void (T::*fSet)(Double_t);
+        Bool_t fLowerBound; //candidate passes if above the cut value (else: below)
+        Bool_t fFloat;      //cut value compared in single precision
+    };
+
+    const ScanCut<AliV0Result> kV0ScanCuts[kV0NScanCuts] = {
+        { &AliV0Result::GetCutV0Radius,                 &AliV0Result::SetCutV0Radius,                 kTRUE,  kFALSE },
+        { &AliV0Result::GetCutDCANegToPV,               &AliV0Result::SetCutDCANegToPV,               kTRUE,  kFALSE },
+        { &AliV0Result::GetCutDCAPosToPV,               &AliV0Result::SetCutDCAPosToPV,               kTRUE,  kFALSE },
+        { &AliV0Result::GetCutDCAV0Daughters,           &AliV0Result::SetCutDCAV0Daughters,           kFALSE, kFALSE },
+        { &AliV0Result::GetCutV0CosPA,                  &AliV0Result::SetCutV0CosPA,                  kTRUE,  kTRUE  },
+        { &AliV0Result::GetCutProperLifetime,           &AliV0Result::SetCutProperLifetime,           kFALSE, kFALSE },
+        { &AliV0Result::GetCutLeastNumberOfCrossedRows, &AliV0Result::SetCutLeastNumberOfCrossedRows, kTRUE,  kFALSE },
+        { &AliV0Result::GetCutTPCdEdx,                  &AliV0Result::SetCutTPCdEdx,                  kFALSE, kFALSE }
+    };
+
+    const ScanCut<AliCascadeResult> kCascScanCuts[kCascNScanCuts] = {
+        { &AliCascadeResult::GetCutDCANegToPV,            &AliCascadeResult::SetCutDCANegToPV,            kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutDCAPosToPV,            &AliCascadeResult::SetCutDCAPosToPV,            kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutDCAV0Daughters,        &AliCascadeResult::SetCutDCAV0Daughters,        kFALSE, kFALSE },
+        { &AliCascadeResult::GetCutV0CosPA,               &AliCascadeResult::SetCutV0CosPA,               kTRUE,  kTRUE  },
+        { &AliCascadeResult::GetCutV0Radius,              &AliCascadeResult::SetCutV0Radius,              kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutDCAV0ToPV,             &AliCascadeResult::SetCutDCAV0ToPV,             kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutV0Mass,                &AliCascadeResult::SetCutV0Mass,                kFALSE, kFALSE },
+        { &AliCascadeResult::GetCutDCABachToPV,           &AliCascadeResult::SetCutDCABachToPV,           kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutDCACascDaughters,      &AliCascadeResult::SetCutDCACascDaughters,      kFALSE, kFALSE },
+        { &AliCascadeResult::GetCutCascCosPA,             &AliCascadeResult::SetCutCascCosPA,             kTRUE,  kTRUE  },
+        { &AliCascadeResult::GetCutCascRadius,            &AliCascadeResult::SetCutCascRadius,            kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutProperLifetime,        &AliCascadeResult::SetCutProperLifetime,        kFALSE, kFALSE },
+        { &AliCascadeResult::GetCutLeastNumberOfClusters, &AliCascadeResult::SetCutLeastNumberOfClusters, kTRUE,  kFALSE },
+        { &AliCascadeResult::GetCutTPCdEdx,               &AliCascadeResult::SetCutTPCdEdx,               kFALSE, kFALSE },
+        { &AliCascadeResult::GetCutDCABachToBaryon,       &AliCascadeResult::SetCutDCABachToBaryon,       kTRUE,  kFALSE }
+    };
+
+    //Same selection, exactly (HasSameCuts does not check the bachelor charge swap)
+    Bool_t HaveSameSelection( AliV0Result *lResult, AliV0Result *lCompare ){
+        return lResult->HasSameCuts( lCompare, kTRUE, 0. );
+    }
+    Bool_t HaveSameSelection( AliCascadeResult *lResult, AliCascadeResult *lCompare ){
+        return lResult->HasSameCuts( lCompare, kTRUE, 0. ) &&
+        lResult->GetSwapBachelorCharge() == lCompare->GetSwapBachelorCharge();
+    }
+
+    //Same selection apart from the value of lCut
+    template <class T> Bool_t DiffersOnlyIn( T *lResult, T *lCompare, const ScanCut<T> &lCut ){
+        Double_t lValue        = (lResult->*lCut.fGet)();
+        Double_t lCompareValue = (lCompare->*lCut.fGet)();
+        if( TMath::IsNaN(lValue) || TMath::IsNaN(lCompareValue) ) return kFALSE;
+        (lResult->*lCut.fSet)( lCompareValue );
+        Bool_t lSame = HaveSameSelection( lResult, lCompare );
+        (lResult->*lCut.fSet)( lValue );
+        return lSame;
+    }
+
+    template <class T> void BuildConfigurationIndex( TList *lList, const ScanCut<T> *lCuts, Int_t lNCuts,
+                                                     std::vector<T*> &lConfig, std::vector<Double_t> &lThreshold,
+                                                     std::vector<Int_t> &lGroupCut, std::vector<Int_t> &lGroupFirst ){
+        //Members of a scan are added one after the other: only compare with the latest groups
+        const Int_t lLookBack = 100;
+        std::vector< std::vector<T*> > lMembers;
+        std::vector<Int_t> lCut;
+
+        TIter lNext( lList );
+        T *lResult = 0x0;
+        while( ( lResult = (T*) lNext() ) ){
+            Int_t lGroup = -1;
+            Int_t lNGroups = lMembers.size();
+            for(Int_t igr=lNGroups-1; igr>=0 && igr>=lNGroups-lLookBack && lGroup<0; igr--){
+                if( lCut[igr] >= 0 ){
+                    if( DiffersOnlyIn( lResult, lMembers[igr][0], lCuts[lCut[igr]] ) ) lGroup = igr;
+                    continue;
+                }
+                //Single configuration so far: find the cut, if any, in which they differ
+                for(Int_t icut=0; icut<lNCuts && lGroup<0; icut++){
+                    if( DiffersOnlyIn( lResult, lMembers[igr][0], lCuts[icut] ) ){
+                        lCut[igr] = icut;
+                        lGroup = igr;
+                    }
+                }
+            }
+            if( lGroup < 0 ){
+                lGroup = lNGroups;
+                lMembers.push_back( std::vector<T*>() );
+                lCut.push_back( -1 );
+            }
+            lMembers[lGroup].push_back( lResult );
+        }
+
+        lConfig.clear();
+        lThreshold.clear();
+        lGroupCut = lCut;
+        lGroupFirst.assign( 1, 0 );
+        std::vector< std::pair<Double_t,T*> > lSorted;
+        for(UInt_t igr=0; igr<lMembers.size(); igr++){
+            lSorted.clear();
+            for(UInt_t icfg=0; icfg<lMembers[igr].size(); icfg++){
+                Double_t lValue = 0;
+                if( lCut[igr] >= 0 ){
+                    lValue = (lMembers[igr][icfg]->*lCuts[lCut[igr]].fGet)();
+                    if( lCuts[lCut[igr]].fFloat ) lValue = (Float_t) lValue;
+                }
+                lSorted.push_back( std::make_pair( lValue, lMembers[igr][icfg] ) );
+            }
+            std::stable_sort( lSorted.begin(), lSorted.end(),
+                             []( const std::pair<Double_t,T*> &a, const std::pair<Double_t,T*> &b ){ return a.first < b.first; } );
+            for(UInt_t icfg=0; icfg<lSorted.size(); icfg++){
+                lThreshold.push_back( lSorted[icfg].first );
+                lConfig.push_back( lSorted[icfg].second );
+            }
+            lGroupFirst.push_back( lConfig.size() );
+        }
+    }
+
+    //Restrict [lFirst, lLast) to the configurations of a group passed by a candidate with value lValue
+    void PassedRange( const std::vector<Double_t> &lThreshold, Bool_t lLowerBound, Double_t lValue, Int_t &lFirst, Int_t &lLast ){
+        std::vector<Double_t>::const_iterator lBegin = lThreshold.begin();
+        if( lLowerBound ) lLast  = std::lower_bound( lBegin+lFirst, lBegin+lLast, lValue ) - lBegin;
+        else              lFirst = std::upper_bound( lBegin+lFirst, lBegin+lLast, lValue ) - lBegin;
+    }
+
+    //Largest absolute value, NaN if any is NaN (so that no upper cut is passed)
+    Double_t MaxAbs( Float_t lA, Float_t lB, Float_t lC = 0 ){
+        if( TMath::IsNaN(lA) || TMath::IsNaN(lB) || TMath::IsNaN(lC) ) return TMath::QuietNaN();
+        return TMath::Max( TMath::Max( TMath::Abs(lA), TMath::Abs(lB) ), TMath::Abs(lC) );
+    }
+}
+
 ClassImp(AliAnalysisTaskStrangenessVsMultiplicityRun2)
 
 AliAnalysisTaskStrangenessVsMultiplicityRun2::AliAnalysisTaskStrangenessVsMultiplicityRun2()
@@ -151,6 +321,7 @@ fkRunVertexers    ( kFALSE ),
 fkUseLightVertexer ( kTRUE ),
 fkDoV0Refit       ( kTRUE ),
 fkExtraCleanup    ( kTRUE ),
+fkUseConfigurationIndex ( kTRUE ),
 
 //---> Flag controlling trigger selection
 fTrigType(AliVEvent::kMB),
@@ -357,6 +528,7 @@ fkRunVertexers    ( kFALSE ),
 fkUseLightVertexer ( kTRUE ),
 fkDoV0Refit       ( kTRUE ),
 fkExtraCleanup    ( kTRUE ),
+fkUseConfigurationIndex ( kTRUE ),
 
 //---> Flag controlling trigger selection
 fTrigType(AliVEvent::kMB),
@@ -1409,13 +1581,11 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         //Step 1: Sweep members of the output object TList and fill all of them as appropriate
         Int_t lNumberOfConfigurations = fListV0->GetEntries();
         //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
 
-            Float_t lMass = 0;
+        //Selections of a configuration, but for lScanCut (if not kV0ScanNone): then
+        //lScanValue is the value of the candidate to compare with that cut
+        auto lSelectV0 = [&]( AliV0Result *lV0Result, Int_t lScanCut, Float_t &lMass, Double_t &lScanValue ) -> Bool_t {
+            lMass = 0;
             Float_t lRap  = 0;
             Float_t lPDGMass = -1;
             Float_t lNegdEdx = 100;
@@ -1465,7 +1635,20 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 lBaryonMomentum = fTreeVariableNegInnerP;
             }
 
-            if (
+            //Value of the candidate to compare with the scanned cut, if any
+            switch( lScanCut ){
+                case kV0ScanV0Radius:            lScanValue = fTreeVariableV0Radius; break;
+                case kV0ScanDCANegToPV:          lScanValue = fTreeVariableDcaNegToPrimVertex; break;
+                case kV0ScanDCAPosToPV:          lScanValue = fTreeVariableDcaPosToPrimVertex; break;
+                case kV0ScanDCAV0Daughters:      lScanValue = fTreeVariableDcaV0Daughters; break;
+                case kV0ScanV0CosPA:             lScanValue = fTreeVariableV0CosineOfPointingAngle; break;
+                case kV0ScanProperLifetime:      lScanValue = (Float_t) (fTreeVariableDistOverTotMom*lPDGMass); break;
+                case kV0ScanLeastNbrCrossedRows: lScanValue = fTreeVariableLeastNbrCrossedRows; break;
+                case kV0ScanTPCdEdx:             lScanValue = MaxAbs( lNegdEdx, lPosdEdx ); break;
+                default: break;
+            }
+
+            return (
                 //Check 1: Offline Vertexer
                 lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
 
@@ -1476,21 +1659,25 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 lRap < lV0Result->GetCutMaxRapidity() &&
                 
                 //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
+                ( lScanCut == kV0ScanV0Radius || fTreeVariableV0Radius > lV0Result->GetCutV0Radius() ) &&
+                ( lScanCut == kV0ScanDCANegToPV || fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() ) &&
+                ( lScanCut == kV0ScanDCAPosToPV || fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() ) &&
+                ( lScanCut == kV0ScanDCAV0Daughters || fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() ) &&
+                //(if scanned, only the variable part remains: the fixed one is the scanned threshold)
+                ( lScanCut == kV0ScanV0CosPA ?
+                 ( !lV0Result->GetCutUseVarV0CosPA() || TMath::IsNaN(lVarV0CosPA) || fTreeVariableV0CosineOfPointingAngle > lVarV0CosPA ) :
+                 fTreeVariableV0CosineOfPointingAngle > lV0CosPACut ) &&
+                ( lScanCut == kV0ScanProperLifetime || fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() ) &&
+                ( lScanCut == kV0ScanLeastNbrCrossedRows || fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() ) &&
                 fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
 
                 //Check 4: Minimum momentum of baryon daughter
                 ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
 
                 //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
+                ( lScanCut == kV0ScanTPCdEdx || (
+                 TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
+                 TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() ) ) &&
 
                 //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
                 ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0>lV0Result->GetCutArmenterosParameter()*TMath::Abs(fTreeVariableAlphaV0) ) ) &&
@@ -1511,10 +1698,32 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
                  fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
                  )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
+                );
+        };
+
+        Float_t lMass = 0;
+        Double_t lScanValue = 0;
+        if( fkUseConfigurationIndex ){
+            if( (Int_t) fV0IndexConfig.size() != lNumberOfConfigurations )
+                BuildConfigurationIndex( fListV0, kV0ScanCuts, kV0NScanCuts, fV0IndexConfig, fV0IndexThreshold, fV0IndexGroupCut, fV0IndexGroupFirst );
+            for(Int_t lgrp=0; lgrp<(Int_t) fV0IndexGroupCut.size(); lgrp++){
+                Int_t lFirst   = fV0IndexGroupFirst[lgrp];
+                Int_t lLast    = fV0IndexGroupFirst[lgrp+1];
+                Int_t lScanCut = fV0IndexGroupCut[lgrp];
+                if( !lSelectV0( fV0IndexConfig[lFirst], lScanCut, lMass, lScanValue ) ) continue;
+                if( lScanCut != kV0ScanNone )
+                    PassedRange( fV0IndexThreshold, kV0ScanCuts[lScanCut].fLowerBound, lScanValue, lFirst, lLast );
+                for(Int_t lcfg=lFirst; lcfg<lLast; lcfg++)
+                    fV0IndexConfig[lcfg]->GetHistogram() -> Fill ( fCentrality, fTreeVariablePt, lMass );
+            }
+        }else{
+            for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
+                AliV0Result *lV0Result = (AliV0Result*) fListV0->At(lcfg);
+                TH3F *histoout = lV0Result->GetHistogram();
+                if( lSelectV0( lV0Result, kV0ScanNone, lMass, lScanValue ) ){
+                    //This satisfies all my conditionals! Fill histogram
+                    histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
+                }
             }
         }
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2183,13 +2392,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         //Step 1: Sweep members of the output object TList and fill all of them as appropriate
         Int_t lNumberOfConfigurationsCascade = fListCascade->GetEntries();
         //AliWarning(Form("[Cascade Analyses] Processing different configurations (%i detected)",lNumberOfConfigurationsCascade));
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
-            lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
-            histoout  = lCascadeResult->GetHistogram();
-
-            Float_t lMass = 0;
+        //Selections of a configuration, but for lScanCut (if not kCascScanNone): then
+        //lScanValue is the value of the candidate to compare with that cut
+        auto lSelectCascade = [&]( AliCascadeResult *lCascadeResult, Int_t lScanCut, Float_t &lMass, Double_t &lScanValue ) -> Bool_t {
+            lMass = 0;
             Float_t lV0Mass = 0; 
             Float_t lRap  = 0;
             Float_t lPDGMass = -1;
@@ -2343,7 +2549,27 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 lprpz = fTreeCascVarNegPz;
             }
             
-            if (
+            //Value of the candidate to compare with the scanned cut, if any
+            switch( lScanCut ){
+                case kCascScanDCANegToPV:       lScanValue = fTreeCascVarDCANegToPrimVtx; break;
+                case kCascScanDCAPosToPV:       lScanValue = fTreeCascVarDCAPosToPrimVtx; break;
+                case kCascScanDCAV0Daughters:   lScanValue = fTreeCascVarDCAV0Daughters; break;
+                case kCascScanV0CosPA:          lScanValue = fTreeCascVarV0CosPointingAngle; break;
+                case kCascScanV0Radius:         lScanValue = fTreeCascVarV0Radius; break;
+                case kCascScanDCAV0ToPV:        lScanValue = fTreeCascVarDCAV0ToPrimVtx; break;
+                case kCascScanV0Mass:           lScanValue = TMath::Abs(lV0Mass-1.116); break;
+                case kCascScanDCABachToPV:      lScanValue = fTreeCascVarDCABachToPrimVtx; break;
+                case kCascScanDCACascDaughters: lScanValue = fTreeCascVarDCACascDaughters; break;
+                case kCascScanCascCosPA:        lScanValue = fTreeCascVarCascCosPointingAngle; break;
+                case kCascScanCascRadius:       lScanValue = fTreeCascVarCascRadius; break;
+                case kCascScanProperLifetime:   lScanValue = (Float_t) (fTreeCascVarDistOverTotMom*lPDGMass); break;
+                case kCascScanLeastNbrClusters: lScanValue = fTreeCascVarLeastNbrClusters; break;
+                case kCascScanTPCdEdx:          lScanValue = MaxAbs( lNegdEdx, lPosdEdx, lBachdEdx ); break;
+                case kCascScanDCABachToBaryon:  lScanValue = fTreeCascVarDCABachToBaryon; break;
+                default: break;
+            }
+
+            return (
                 //Check 1: Charge consistent with expectations
                 fTreeCascVarCharge == lCharge &&
                 
@@ -2356,18 +2582,23 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 
                 //Check 3: Topological Variables
                 // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
+                ( lScanCut == kCascScanDCANegToPV || fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() ) &&
+                ( lScanCut == kCascScanDCAPosToPV || fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() ) &&
+                ( lScanCut == kCascScanDCAV0Daughters || fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() ) &&
+                //(if scanned, only the variable part remains: the fixed one is the scanned threshold)
+                ( lScanCut == kCascScanV0CosPA ?
+                 ( !lCascadeResult->GetCutUseVarV0CosPA() || TMath::IsNaN(lVarV0CosPA) || fTreeCascVarV0CosPointingAngle > lVarV0CosPA ) :
+                 fTreeCascVarV0CosPointingAngle > lV0CosPACut ) &&
+                ( lScanCut == kCascScanV0Radius || fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() ) &&
                 // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lCascadeResult->GetCutDCACascDaughters() &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
+                ( lScanCut == kCascScanDCAV0ToPV || fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() ) &&
+                ( lScanCut == kCascScanV0Mass || TMath::Abs(lV0Mass-1.116) < lCascadeResult->GetCutV0Mass() ) &&
+                ( lScanCut == kCascScanDCABachToPV || fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() ) &&
+                ( lScanCut == kCascScanDCACascDaughters || fTreeCascVarDCACascDaughters < lCascadeResult->GetCutDCACascDaughters() ) &&
+                ( lScanCut == kCascScanCascCosPA ?
+                 ( !lCascadeResult->GetCutUseVarCascCosPA() || TMath::IsNaN(lVarCascCosPA) || fTreeCascVarCascCosPointingAngle > lVarCascCosPA ) :
+                 fTreeCascVarCascCosPointingAngle > lCascCosPACut ) &&
+                ( lScanCut == kCascScanCascRadius || fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() ) &&
                 
                 // - Implementation of a parametric V0 Mass cut if requested
                 (
@@ -2376,19 +2607,20 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                  ) &&
                 
                 // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
+                ( lScanCut == kCascScanProperLifetime || fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() ) &&
+                ( lScanCut == kCascScanLeastNbrClusters || fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() ) &&
                 
                 //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
+                ( lScanCut == kCascScanTPCdEdx || (
+                 TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
+                 TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
+                 TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() ) ) &&
                 
                 //Check 5: Xi rejection for Omega analysis
                 ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
                 
                 //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
+                ( lScanCut == kCascScanDCABachToBaryon || fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
                 
                 //Check 7: Experimental Bach Baryon CosPA
                 ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
@@ -2423,9 +2655,32 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
                 ( lCascadeResult->GetCutUse276TeVV0CosPA()==kFALSE ||
                  fTreeCascVarV0CosPointingAngle>l276TeVV0CosPA
                  )
-                ){
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
+                );
+        };
+
+        Float_t lMass = 0;
+        Double_t lScanValue = 0;
+        if( fkUseConfigurationIndex ){
+            if( (Int_t) fCascIndexConfig.size() != lNumberOfConfigurationsCascade )
+                BuildConfigurationIndex( fListCascade, kCascScanCuts, kCascNScanCuts, fCascIndexConfig, fCascIndexThreshold, fCascIndexGroupCut, fCascIndexGroupFirst );
+            for(Int_t lgrp=0; lgrp<(Int_t) fCascIndexGroupCut.size(); lgrp++){
+                Int_t lFirst   = fCascIndexGroupFirst[lgrp];
+                Int_t lLast    = fCascIndexGroupFirst[lgrp+1];
+                Int_t lScanCut = fCascIndexGroupCut[lgrp];
+                if( !lSelectCascade( fCascIndexConfig[lFirst], lScanCut, lMass, lScanValue ) ) continue;
+                if( lScanCut != kCascScanNone )
+                    PassedRange( fCascIndexThreshold, kCascScanCuts[lScanCut].fLowerBound, lScanValue, lFirst, lLast );
+                for(Int_t lcfg=lFirst; lcfg<lLast; lcfg++)
+                    fCascIndexConfig[lcfg]->GetHistogram() -> Fill ( fCentrality, fTreeCascVarPt, lMass );
+            }
+        }else{
+            for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
+                AliCascadeResult *lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
+                TH3F *histoout = lCascadeResult->GetHistogram();
+                if( lSelectCascade( lCascadeResult, kCascScanNone, lMass, lScanValue ) ){
+                    //This satisfies all my conditionals! Fill histogram
+                    histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
+                }
             }
         }
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -47,6 +47,8 @@ class AliCascadeResult;
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
 //#include "AliAnalysisTaskSE.h"
+#include <vector>
+
 #include "AliEventCuts.h"
 
 class AliAnalysisTaskStrangenessVsMultiplicityRun2 : public AliAnalysisTaskSE {
@@ -94,6 +96,9 @@ public:
     void SetExtraCleanup ( Bool_t lExtraCleanup = kTRUE) {
         fkExtraCleanup = lExtraCleanup;
     }
+    void SetUseConfigurationIndex ( Bool_t lUseConfigurationIndex = kTRUE) {
+        fkUseConfigurationIndex = lUseConfigurationIndex;
+    }
 //---------------------------------------------------------------------------------------
     void SetUseExtraEvSels ( Bool_t lUseExtraEvSels = kTRUE) {
         fkDoExtraEvSels = lUseExtraEvSels;
@@ -266,6 +271,7 @@ private:
     Bool_t    fkUseLightVertexer;       // if true, use AliLightVertexers instead of regular ones
     Bool_t    fkDoV0Refit;              // if true, will invoke AliESDv0::Refit in the vertexing procedure
     Bool_t    fkExtraCleanup;           //if true, perform pre-rejection of useless candidates before going through configs
+    Bool_t    fkUseConfigurationIndex;  //if true, group configs differing in a single cut and fill them via sorted thresholds
 
     AliVEvent::EOfflineTriggerTypes fTrigType; // trigger type
 
@@ -484,11 +490,24 @@ private:
     TH1D *fHistEventCounter; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Configuration index (built at the first candidate, see SetUseConfigurationIndex)
+//===========================================================================================
+    std::vector<AliV0Result*> fV0IndexConfig;     //! V0 configs, sorted by threshold within each group
+    std::vector<Double_t> fV0IndexThreshold;      //! cut value of each V0 config on the cut scanned by its group
+    std::vector<Int_t> fV0IndexGroupCut;          //! cut scanned by each group of V0 configs (-1: single config)
+    std::vector<Int_t> fV0IndexGroupFirst;        //! first V0 config of each group, plus end of the last group
+    std::vector<AliCascadeResult*> fCascIndexConfig; //! same for the cascade configs
+    std::vector<Double_t> fCascIndexThreshold;    //!
+    std::vector<Int_t> fCascIndexGroupCut;        //!
+    std::vector<Int_t> fCascIndexGroupFirst;      //!
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
     //1: first implementation
+    //3: configuration index
 };
 
 #endif
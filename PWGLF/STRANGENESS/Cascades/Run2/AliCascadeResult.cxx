@@ -624,9 +624,9 @@ Long64_t AliCascadeResult::Merge(TCollection *hlist)
     return (Long64_t) GetHistogram()->GetEntries();
 }
 //________________________________________________________________
-Bool_t AliCascadeResult::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx )
+Bool_t AliCascadeResult::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx, Double_t lTolerance )
 //Function to compare the cuts contained in this result with another
-//Returns kTRUE if all selection cuts are identical within 1e-6
+//Returns kTRUE if all selection cuts are identical within lTolerance (default: 1e-6)
 //WARNING: Does not check MC association flags 
 {
     Bool_t lReturnValue = kTRUE;
@@ -641,68 +641,68 @@ Bool_t AliCascadeResult::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx
     if( fMassHypo != lCompareCascade->GetMassHypothesis() ) lReturnValue = kFALSE;
 
     //Acceptance
-    if( TMath::Abs( fCutMinRapidity - lCompareCascade->GetCutMinRapidity() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxRapidity - lCompareCascade->GetCutMaxRapidity() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinRapidity - lCompareCascade->GetCutMinRapidity() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxRapidity - lCompareCascade->GetCutMaxRapidity() ) > lTolerance ) lReturnValue = kFALSE;
     
     //V0 Selection Criteria
-    if( TMath::Abs( fCutDCANegToPV - lCompareCascade->GetCutDCANegToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCAPosToPV - lCompareCascade->GetCutDCAPosToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCAV0Daughters - lCompareCascade->GetCutDCAV0Daughters() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0CosPA - lCompareCascade->GetCutV0CosPA() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0Radius - lCompareCascade->GetCutV0Radius() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCANegToPV - lCompareCascade->GetCutDCANegToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCAPosToPV - lCompareCascade->GetCutDCAPosToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCAV0Daughters - lCompareCascade->GetCutDCAV0Daughters() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0CosPA - lCompareCascade->GetCutV0CosPA() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0Radius - lCompareCascade->GetCutV0Radius() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Cascade Selection Criteria
-    if( TMath::Abs( fCutDCAV0ToPV - lCompareCascade->GetCutDCAV0ToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0Mass - lCompareCascade->GetCutV0Mass() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0MassSigma - lCompareCascade->GetCutV0MassSigma() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCABachToPV - lCompareCascade->GetCutDCABachToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCACascDaughters - lCompareCascade->GetCutDCACascDaughters() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutCascCosPA - lCompareCascade->GetCutCascCosPA() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutCascRadius - lCompareCascade->GetCutCascRadius() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCABachToBaryon - lCompareCascade->GetCutDCABachToBaryon() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutBachBaryonCosPA - lCompareCascade->GetCutBachBaryonCosPA() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMinV0Lifetime - lCompareCascade->GetCutMinV0Lifetime() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxV0Lifetime - lCompareCascade->GetCutMaxV0Lifetime() ) > 1e-6 ) lReturnValue = kFALSE;
-    
-    if( TMath::Abs( fCutProperLifetime - lCompareCascade->GetCutProperLifetime() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutTPCdEdx - lCompareCascade->GetCutTPCdEdx() ) > 1e-6 && lCheckdEdx ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutXiRejection - lCompareCascade->GetCutXiRejection() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCAV0ToPV - lCompareCascade->GetCutDCAV0ToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0Mass - lCompareCascade->GetCutV0Mass() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0MassSigma - lCompareCascade->GetCutV0MassSigma() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCABachToPV - lCompareCascade->GetCutDCABachToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCACascDaughters - lCompareCascade->GetCutDCACascDaughters() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutCascCosPA - lCompareCascade->GetCutCascCosPA() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutCascRadius - lCompareCascade->GetCutCascRadius() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCABachToBaryon - lCompareCascade->GetCutDCABachToBaryon() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutBachBaryonCosPA - lCompareCascade->GetCutBachBaryonCosPA() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinV0Lifetime - lCompareCascade->GetCutMinV0Lifetime() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxV0Lifetime - lCompareCascade->GetCutMaxV0Lifetime() ) > lTolerance ) lReturnValue = kFALSE;
+    
+    if( TMath::Abs( fCutProperLifetime - lCompareCascade->GetCutProperLifetime() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutTPCdEdx - lCompareCascade->GetCutTPCdEdx() ) > lTolerance && lCheckdEdx ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutXiRejection - lCompareCascade->GetCutXiRejection() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Track cuts
-    if( TMath::Abs( fCutLeastNumberOfClusters - lCompareCascade->GetCutLeastNumberOfClusters() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutUseITSRefitTracks - lCompareCascade->GetCutUseITSRefitTracks() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutLeastNumberOfClusters - lCompareCascade->GetCutLeastNumberOfClusters() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutUseITSRefitTracks - lCompareCascade->GetCutUseITSRefitTracks() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Check if parametric V0 CosPA (as in 2.76 analysis) used
     if( fCutUse276TeVV0CosPA != lCompareCascade->GetCutUse276TeVV0CosPA() ) lReturnValue = kFALSE;
     
-    if( TMath::Abs( fCutMinEtaTracks - lCompareCascade->GetCutMinEtaTracks() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxEtaTracks - lCompareCascade->GetCutMaxEtaTracks() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxChi2PerCluster - lCompareCascade->GetCutMaxChi2PerCluster() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMinTrackLength - lCompareCascade->GetCutMinTrackLength() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinEtaTracks - lCompareCascade->GetCutMinEtaTracks() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxEtaTracks - lCompareCascade->GetCutMaxEtaTracks() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxChi2PerCluster - lCompareCascade->GetCutMaxChi2PerCluster() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinTrackLength - lCompareCascade->GetCutMinTrackLength() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Variable CascCosPA
-    if ( TMath::Abs(fCutUseVariableCascCosPA - lCompareCascade->GetCutUseVarCascCosPA()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarCascCosPA_Exp0Const - lCompareCascade->GetCutVarCascCosPAExp0Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarCascCosPA_Exp0Slope - lCompareCascade->GetCutVarCascCosPAExp0Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarCascCosPA_Exp1Const - lCompareCascade->GetCutVarCascCosPAExp1Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarCascCosPA_Exp1Slope - lCompareCascade->GetCutVarCascCosPAExp1Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarCascCosPA_Const  - lCompareCascade->GetCutVarCascCosPAConst()) > 1e-6 ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutUseVariableCascCosPA - lCompareCascade->GetCutUseVarCascCosPA()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarCascCosPA_Exp0Const - lCompareCascade->GetCutVarCascCosPAExp0Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarCascCosPA_Exp0Slope - lCompareCascade->GetCutVarCascCosPAExp0Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarCascCosPA_Exp1Const - lCompareCascade->GetCutVarCascCosPAExp1Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarCascCosPA_Exp1Slope - lCompareCascade->GetCutVarCascCosPAExp1Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarCascCosPA_Const  - lCompareCascade->GetCutVarCascCosPAConst()) > lTolerance ) lReturnValue = kFALSE;
     
     //Variable V0CosPA
-    if ( TMath::Abs(fCutUseVariableV0CosPA - lCompareCascade->GetCutUseVarV0CosPA()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp0Const - lCompareCascade->GetCutVarV0CosPAExp0Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp0Slope - lCompareCascade->GetCutVarV0CosPAExp0Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp1Const - lCompareCascade->GetCutVarV0CosPAExp1Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp1Slope - lCompareCascade->GetCutVarV0CosPAExp1Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Const  - lCompareCascade->GetCutVarV0CosPAConst()) > 1e-6 ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutUseVariableV0CosPA - lCompareCascade->GetCutUseVarV0CosPA()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp0Const - lCompareCascade->GetCutVarV0CosPAExp0Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp0Slope - lCompareCascade->GetCutVarV0CosPAExp0Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp1Const - lCompareCascade->GetCutVarV0CosPAExp1Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp1Slope - lCompareCascade->GetCutVarV0CosPAExp1Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Const  - lCompareCascade->GetCutVarV0CosPAConst()) > lTolerance ) lReturnValue = kFALSE;
     
     //Variable BBCosPA
-    if ( TMath::Abs(fCutUseVariableBBCosPA - lCompareCascade->GetCutUseVarBBCosPA()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarBBCosPA_Exp0Const - lCompareCascade->GetCutVarBBCosPAExp0Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarBBCosPA_Exp0Slope - lCompareCascade->GetCutVarBBCosPAExp0Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarBBCosPA_Exp1Const - lCompareCascade->GetCutVarBBCosPAExp1Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarBBCosPA_Exp1Slope - lCompareCascade->GetCutVarBBCosPAExp1Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarBBCosPA_Const  - lCompareCascade->GetCutVarBBCosPAConst()) > 1e-6 ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutUseVariableBBCosPA - lCompareCascade->GetCutUseVarBBCosPA()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarBBCosPA_Exp0Const - lCompareCascade->GetCutVarBBCosPAExp0Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarBBCosPA_Exp0Slope - lCompareCascade->GetCutVarBBCosPAExp0Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarBBCosPA_Exp1Const - lCompareCascade->GetCutVarBBCosPAExp1Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarBBCosPA_Exp1Slope - lCompareCascade->GetCutVarBBCosPAExp1Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarBBCosPA_Const  - lCompareCascade->GetCutVarBBCosPAConst()) > lTolerance ) lReturnValue = kFALSE;
     
     return lReturnValue;
 }
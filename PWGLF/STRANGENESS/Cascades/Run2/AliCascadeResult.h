@@ -235,7 +235,7 @@ public:
     TH3F* GetHistogramFeeddown       ()       { return 0x0; }
     TH3F* GetHistogramFeeddownToCopy () const { return 0x0; }
     
-    Bool_t HasSameCuts( AliVWeakResult *lCompare, Bool_t lCheckdEdx = kTRUE );
+    Bool_t HasSameCuts( AliVWeakResult *lCompare, Bool_t lCheckdEdx = kTRUE, Double_t lTolerance = 1e-6 );
     void Print();
     
     
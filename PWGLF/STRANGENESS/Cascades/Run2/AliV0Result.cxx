@@ -446,9 +446,9 @@ Long64_t AliV0Result::Merge(TCollection *hlist)
     return (Long64_t) GetHistogram()->GetEntries();
 }
 //________________________________________________________________
-Bool_t AliV0Result::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx )
+Bool_t AliV0Result::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx, Double_t lTolerance )
 //Function to compare the cuts contained in this result with another
-//Returns kTRUE if all selection cuts are identical within 1e-6
+//Returns kTRUE if all selection cuts are identical within lTolerance (default: 1e-6)
 //WARNING: Does not check MC association flags
 {
     Bool_t lReturnValue = kTRUE;
@@ -463,40 +463,40 @@ Bool_t AliV0Result::HasSameCuts(AliVWeakResult *lCompare, Bool_t lCheckdEdx )
     if( fMassHypo != lCompareV0->GetMassHypothesis() ) lReturnValue = kFALSE;
     
     //Acceptance
-    if( TMath::Abs( fCutMinRapidity - lCompareV0->GetCutMinRapidity() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxRapidity - lCompareV0->GetCutMaxRapidity() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinRapidity - lCompareV0->GetCutMinRapidity() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxRapidity - lCompareV0->GetCutMaxRapidity() ) > lTolerance ) lReturnValue = kFALSE;
     
     //V0 Selection Criteria
-    if( TMath::Abs( fCutDCANegToPV - lCompareV0->GetCutDCANegToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCAPosToPV - lCompareV0->GetCutDCAPosToPV() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutDCAV0Daughters - lCompareV0->GetCutDCAV0Daughters() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0CosPA - lCompareV0->GetCutV0CosPA() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutV0Radius - lCompareV0->GetCutV0Radius() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCANegToPV - lCompareV0->GetCutDCANegToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCAPosToPV - lCompareV0->GetCutDCAPosToPV() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutDCAV0Daughters - lCompareV0->GetCutDCAV0Daughters() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0CosPA - lCompareV0->GetCutV0CosPA() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutV0Radius - lCompareV0->GetCutV0Radius() ) > lTolerance ) lReturnValue = kFALSE;
     
-    if( TMath::Abs( fCutProperLifetime - lCompareV0->GetCutProperLifetime() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutProperLifetime - lCompareV0->GetCutProperLifetime() ) > lTolerance ) lReturnValue = kFALSE;
 
     //if( fCutCompetingV0Rejection != lCompareV0->GetCutCompetingV0Rejection() ) lReturnValue = kFALSE;
     if( fCutArmenteros != lCompareV0->GetCutArmenteros() ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutArmenterosParameter - lCompareV0->GetCutArmenterosParameter() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutTPCdEdx - lCompareV0->GetCutTPCdEdx() ) > 1e-6 && lCheckdEdx ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMinBaryonMomentum - lCompareV0->GetCutMinBaryonMomentum() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutArmenterosParameter - lCompareV0->GetCutArmenterosParameter() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutTPCdEdx - lCompareV0->GetCutTPCdEdx() ) > lTolerance && lCheckdEdx ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinBaryonMomentum - lCompareV0->GetCutMinBaryonMomentum() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Track Selections
-    if( TMath::Abs( fCutUseITSRefitTracks - lCompareV0->GetCutUseITSRefitTracks() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutLeastNumberOfCrossedRows - lCompareV0->GetCutLeastNumberOfCrossedRows() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutLeastNumberOfCrossedRowsOverFindable - lCompareV0->GetCutLeastNumberOfCrossedRowsOverFindable() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMinEtaTracks - lCompareV0->GetCutMinEtaTracks() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxEtaTracks - lCompareV0->GetCutMaxEtaTracks() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMaxChi2PerCluster - lCompareV0->GetCutMaxChi2PerCluster() ) > 1e-6 ) lReturnValue = kFALSE;
-    if( TMath::Abs( fCutMinTrackLength - lCompareV0->GetCutMinTrackLength() ) > 1e-6 ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutUseITSRefitTracks - lCompareV0->GetCutUseITSRefitTracks() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutLeastNumberOfCrossedRows - lCompareV0->GetCutLeastNumberOfCrossedRows() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutLeastNumberOfCrossedRowsOverFindable - lCompareV0->GetCutLeastNumberOfCrossedRowsOverFindable() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinEtaTracks - lCompareV0->GetCutMinEtaTracks() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxEtaTracks - lCompareV0->GetCutMaxEtaTracks() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMaxChi2PerCluster - lCompareV0->GetCutMaxChi2PerCluster() ) > lTolerance ) lReturnValue = kFALSE;
+    if( TMath::Abs( fCutMinTrackLength - lCompareV0->GetCutMinTrackLength() ) > lTolerance ) lReturnValue = kFALSE;
     
     //Variable V0CosPA
-    if ( TMath::Abs(fCutUseVariableV0CosPA - lCompareV0->GetCutUseVarV0CosPA()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp0Const - lCompareV0->GetCutVarV0CosPAExp0Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp0Slope - lCompareV0->GetCutVarV0CosPAExp0Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp1Const - lCompareV0->GetCutVarV0CosPAExp1Const()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Exp1Slope - lCompareV0->GetCutVarV0CosPAExp1Slope()) > 1e-6 ) lReturnValue = kFALSE;
-    if ( TMath::Abs(fCutVarV0CosPA_Const  - lCompareV0->GetCutVarV0CosPAConst()) > 1e-6 ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutUseVariableV0CosPA - lCompareV0->GetCutUseVarV0CosPA()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp0Const - lCompareV0->GetCutVarV0CosPAExp0Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp0Slope - lCompareV0->GetCutVarV0CosPAExp0Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp1Const - lCompareV0->GetCutVarV0CosPAExp1Const()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Exp1Slope - lCompareV0->GetCutVarV0CosPAExp1Slope()) > lTolerance ) lReturnValue = kFALSE;
+    if ( TMath::Abs(fCutVarV0CosPA_Const  - lCompareV0->GetCutVarV0CosPAConst()) > lTolerance ) lReturnValue = kFALSE;
     
     //Use OTF
     if( fUseOnTheFly != lCompareV0->GetUseOnTheFly() ) lReturnValue = kFALSE;
@@ -40,7 +40,7 @@ public:
     //Feeddown matrix
     virtual TH3F* GetHistogramFeeddown       ()       { return 0x0; }
     virtual TH3F* GetHistogramFeeddownToCopy () const { return 0x0; }
-    virtual Bool_t HasSameCuts( AliVWeakResult *lCompare, Bool_t lCheckdEdx = kTRUE ) { return kFALSE; }
+    virtual Bool_t HasSameCuts( AliVWeakResult *lCompare, Bool_t lCheckdEdx = kTRUE, Double_t lTolerance = 1e-6 ) { return kFALSE; }
     virtual void Print() {};
     
 private:
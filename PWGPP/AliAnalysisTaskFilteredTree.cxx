@@ -32,6 +32,8 @@
    3.) "Laser"      - dump laser tracks with space points if exists
    4.) "CosmicTree" - cosmic track candidate (random or triggered) + esdTracks(up/down)+ optional points
    5.) "dEdx"       - tree with high dEdx tpc tracks
+   With SetFlatHighPtTree(kTRUE) the highPt tracks are written instead to the flat tree "highPtFlat"
+   (see AliFilteredTreeFlatWriter and CreateHighPtFlatWriter for the columns)
 */
 
 #include "iostream"
@@ -79,6 +81,7 @@
 #include "AliMCEventHandler.h"
 #include "AliFilteredTreeEventCuts.h"
 #include "AliFilteredTreeAcceptanceCuts.h"
+#include "AliFilteredTreeFlatWriter.h"
 
 #include "AliAnalysisTaskFilteredTree.h"
 #include "AliKFParticle.h"
@@ -103,6 +106,7 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fUseESDfriends(kFALSE)
   , fReducePileUp(kTRUE)
   , fFillTree(kTRUE)
+  , fFlatHighPtTree(kFALSE)
   , fFilteredTreeEventCuts(0)
   , fFilteredTreeAcceptanceCuts(0)
   , fFilteredTreeRecAcceptanceCuts(0)
@@ -110,6 +114,7 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fHighPtFlatWriter(0)
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -201,7 +206,16 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   //
   // Create trees
   fV0Tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-  fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
+  if (fFlatHighPtTree && !fProcessAll) {
+    // only ProcessAll() fills the flat tree, Process() keeps writing the "highPt" tree
+    AliWarning("flat highPt tree requires SetProcessAll(kTRUE), writing the highPt tree instead");
+    fFlatHighPtTree = kFALSE;
+  }
+  if (fFlatHighPtTree) {
+    fHighPtFlatWriter = CreateHighPtFlatWriter();
+    fHighPtTree = fHighPtFlatWriter->Init();
+  }
+  else fHighPtTree = ((*fTreeSRedirector)<<"highPt").GetTree();
   fdEdxTree = ((*fTreeSRedirector)<<"dEdx").GetTree();
   fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
@@ -1376,7 +1390,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	if (fFriendDownscaling>=1){  // downscaling number of friend tracks
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
-	if (fFriendDownscaling<=0){
+	if (fFriendDownscaling<=0 && !fHighPtFlatWriter){
 	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
 	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
 	    if (tree){
@@ -1431,7 +1445,63 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTPC, track, nSpecies, tpcPID.GetMatrixArray());
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTOF, track, nSpecies, tofPID.GetMatrixArray());	    
 	}
-        if(fTreeSRedirector && dumpToTree && fFillTree) {
+        if(fHighPtFlatWriter && dumpToTree && fFillTree) {
+	  // same content as the highPt tree below, without the friend track and the MC information
+	  downscaleCounter++;
+	  AliFilteredTreeFlatWriter &writer = *fHighPtFlatWriter;
+	  writer.Push(downscaleCounter);
+	  writer.Push(Long64_t(gid));
+	  writer.Push(runNumber);
+	  writer.Push(evtTimeStamp);
+	  writer.Push(evtNumberInFile);
+	  writer.Push(bz);
+	  writer.Push(vtxESD->GetX());
+	  writer.Push(vtxESD->GetY());
+	  writer.Push(vtxESD->GetZ());
+	  writer.Push(ir1);
+	  writer.Push(ir2);
+	  writer.Push(mult);
+	  writer.Push(ntracks);
+	  writer.Push(contTPC);
+	  writer.Push(contSPD);
+	  writer.PushArray(vertexPosTPC.GetMatrixArray());
+	  writer.PushArray(vertexPosSPD.GetMatrixArray());
+	  writer.Push(ntracksTPC);
+	  writer.Push(ntracksITS);
+	  writer.PushParam(track);
+	  writer.Push(Long64_t(track->GetStatus()));
+	  writer.Push(track->GetLabel());
+	  writer.Push(Int_t(track->GetTPCNcls()));
+	  writer.Push(Int_t(track->GetTPCNclsF()));
+	  writer.Push(track->GetTPCchi2());
+	  writer.Push(Int_t(track->GetNcls(0)));
+	  writer.Push(track->GetITSchi2());
+	  writer.Push(track->GetTPCsignal());
+	  writer.Push(Int_t(track->GetTPCsignalN()));
+	  writer.PushArray(tofClInfo.GetMatrixArray());
+	  writer.PushArray(tofNsigma.GetMatrixArray());
+	  writer.PushArray(tpcNsigma.GetMatrixArray());
+	  writer.PushArray(tofPID.GetMatrixArray());
+	  writer.PushArray(tpcPID.GetMatrixArray());
+	  writer.PushParam(tpcInnerC);
+	  writer.PushParam(trackInnerV);
+	  writer.PushParam(trackInnerC);
+	  writer.PushParam(trackInnerC2);
+	  writer.PushParam(outerITSc);
+	  writer.PushParam(trackInnerC3);
+	  writer.Push(chi2(0,0));
+	  writer.Push(chi2trackC(0,0));
+	  writer.Push(chi2OuterITS(0,0));
+	  writer.Push(centralityF);
+	  writer.PushParam(&paramITS);
+	  writer.PushParam(&paramITSC);
+	  writer.PushParam(&paramComb);
+	  writer.Push(indexNearestITS);
+	  writer.Push(indexNearestITSC);
+	  writer.Push(indexNearestComb);
+	  writer.Fill();
+        }
+        else if(fTreeSRedirector && dumpToTree && fFillTree) {
 	  downscaleCounter++;
           (*fTreeSRedirector)<<"highPt"<<
 	    "downscaleCounter="<<downscaleCounter<<   
@@ -2565,6 +2635,73 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
+  if (fHighPtFlatWriter) {
+    fHighPtFlatWriter->WriteTree();
+    delete fHighPtFlatWriter;
+    fHighPtFlatWriter=NULL;
+  }
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter* AliAnalysisTaskFilteredTree::CreateHighPtFlatWriter(const char *name)
+{
+  //
+  // Writer with the columns of the flat highPt tree, in the order they
+  // are filled in Process. Track parameterisations are written as
+  // <name>_fX, <name>_fAlpha, <name>_fP[5] and <name>_fC[15].
+  //
+  AliFilteredTreeFlatWriter *writer = new AliFilteredTreeFlatWriter(name,"highPt tracks, flat");
+  writer->AddColumn("downscaleCounter",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("gid",AliFilteredTreeFlatWriter::kLong64);
+  writer->AddColumn("runNumber",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("evtTimeStamp",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("evtNumberInFile",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("Bz");
+  writer->AddColumn("vtxESD_fX");
+  writer->AddColumn("vtxESD_fY");
+  writer->AddColumn("vtxESD_fZ");
+  writer->AddColumn("IRtot",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("IRint2",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("mult",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("ntracks",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("contTPC",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("contSPD",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("vertexPosTPC",AliFilteredTreeFlatWriter::kFloat,3);
+  writer->AddColumn("vertexPosSPD",AliFilteredTreeFlatWriter::kFloat,3);
+  writer->AddColumn("ntracksTPC",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("ntracksITS",AliFilteredTreeFlatWriter::kInt);
+  writer->AddParamColumns("esdTrack",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddColumn("esdTrack_fFlags",AliFilteredTreeFlatWriter::kLong64);
+  writer->AddColumn("esdTrack_fLabel",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("esdTrack_fTPCncls",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("esdTrack_fTPCnclsF",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("esdTrack_fTPCchi2");
+  writer->AddColumn("esdTrack_fITSncls",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("esdTrack_fITSchi2");
+  writer->AddColumn("esdTrack_fTPCsignal");
+  writer->AddColumn("esdTrack_fTPCsignalN",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("tofClInfo",AliFilteredTreeFlatWriter::kFloat,5);
+  writer->AddColumn("tofNsigma",AliFilteredTreeFlatWriter::kFloat,AliPID::kSPECIES);
+  writer->AddColumn("tpcNsigma",AliFilteredTreeFlatWriter::kFloat,AliPID::kSPECIES);
+  writer->AddColumn("tofPID",AliFilteredTreeFlatWriter::kFloat,AliPID::kSPECIES);
+  writer->AddColumn("tpcPID",AliFilteredTreeFlatWriter::kFloat,AliPID::kSPECIES);
+  writer->AddParamColumns("extTPCInnerC",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("extInnerParamV",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("extInnerParamC",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("extInnerParam",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("extOuterITS",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("extInnerParamRef",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddColumn("chi2TPCInnerC");
+  writer->AddColumn("chi2InnerC");
+  writer->AddColumn("chi2OuterITS");
+  writer->AddColumn("centralityF");
+  writer->AddParamColumns("paramITS",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("paramITSC",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddParamColumns("paramComb",AliFilteredTreeFlatWriter::kDouble);
+  writer->AddColumn("indexNearestITS",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("indexNearestITSC",AliFilteredTreeFlatWriter::kInt);
+  writer->AddColumn("indexNearestComb",AliFilteredTreeFlatWriter::kInt);
+  return writer;
 }
 
 //_____________________________________________________________________________
@@ -28,6 +28,7 @@ class TList;
 class TObjArray;
 class TTree;
 class TTreeSRedirector;
+class AliFilteredTreeFlatWriter;
 class TParticle;
 class TH3D;
 #include <string>
@@ -114,6 +115,11 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
   Bool_t GetFillTrees() { return fFillTree ;}
+  // write the highPt tracks to a flat tree "highPtFlat" (no objects, friends and MC info) instead of the "highPt" tree
+  // (ProcessAll mode only, ignored otherwise)
+  void SetFlatHighPtTree(Bool_t flat) { fFlatHighPtTree = flat; }
+  Bool_t GetFlatHighPtTree() const { return fFlatHighPtTree; }
+  static AliFilteredTreeFlatWriter *CreateHighPtFlatWriter(const char *name="highPtFlat");
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
@@ -134,6 +140,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Bool_t fUseESDfriends;    // use esd friends
   Bool_t fReducePileUp;     // downscale the information for the pile-up TPC tracks
   Bool_t fFillTree;         // do not fill trees
+  Bool_t fFlatHighPtTree;   // write highPt tracks to a flat tree
 
   AliFilteredTreeEventCuts      *fFilteredTreeEventCuts;      // event cuts
   AliFilteredTreeAcceptanceCuts *fFilteredTreeAcceptanceCuts; // acceptance cuts  
@@ -143,6 +150,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  AliFilteredTreeFlatWriter* fHighPtFlatWriter; //! writer of the flat highPt tree
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -177,7 +185,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
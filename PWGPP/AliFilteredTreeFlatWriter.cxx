@@ -0,0 +1,240 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*
+   Flat tree writer for AliAnalysisTaskFilteredTree, see the header for the usage.
+   Branches are plain leaves ("name/F") or fixed length arrays ("name[n]/F"),
+   so the trees can be read without the AliRoot libraries.
+*/
+
+#include "RVersion.h"
+#include "RConfigure.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TDirectory.h"
+#include "AliLog.h"
+#include "AliExternalTrackParam.h"
+
+#include "AliFilteredTreeFlatWriter.h"
+
+ClassImp(AliFilteredTreeFlatWriter)
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::AliFilteredTreeFlatWriter(const Char_t *name, const Char_t *title)
+  : TNamed(name,title)
+  , fColumns()
+  , fRowF()
+  , fRowD()
+  , fRowI()
+  , fRowL()
+  , fCursor(0)
+  , fTree(0)
+  , fBasketSize(128000)
+  , fAutoFlush(-30000000)
+  , fCompressionSettings(-1)
+  , fImplicitMT(kFALSE)
+{
+  //
+  // Constructor
+  //
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeFlatWriter::~AliFilteredTreeFlatWriter()
+{
+  //
+  // Destructor, the tree belongs to its directory
+  //
+  if (fTree) fTree->ResetBranchAddresses();
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeFlatWriter::AddColumn(const Char_t *name, EColumnType type, Int_t size)
+{
+  //
+  // Declare a column of size values of the given type, returns its index
+  //
+  if (fTree) {
+    AliError(Form("Column %s declared after Init, ignored",name));
+    return -1;
+  }
+  if (type<0 || type>=kNColumnTypes || size<1) {
+    AliError(Form("Column %s: invalid type %d or size %d",name,type,size));
+    return -1;
+  }
+  Column column;
+  column.fName = name;
+  column.fType = type;
+  column.fSize = size;
+  std::vector<Int_t> sizes(kNColumnTypes,0);
+  sizes[kFloat] = fRowF.size();
+  sizes[kDouble] = fRowD.size();
+  sizes[kInt] = fRowI.size();
+  sizes[kLong64] = fRowL.size();
+  column.fOffset = sizes[type];
+  switch (type) {
+    case kFloat:  fRowF.resize(fRowF.size()+size,0); break;
+    case kDouble: fRowD.resize(fRowD.size()+size,0); break;
+    case kInt:    fRowI.resize(fRowI.size()+size,0); break;
+    default:      fRowL.resize(fRowL.size()+size,0); break;
+  }
+  fColumns.push_back(column);
+  return fColumns.size()-1;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeFlatWriter::AddParamColumns(const Char_t *prefix, EColumnType type)
+{
+  //
+  // Declare the kNParamColumns columns of an AliExternalTrackParam:
+  // prefix_fX, prefix_fAlpha, prefix_fP[5], prefix_fC[15]
+  // returns the index of the first one
+  //
+  Int_t first = AddColumn(Form("%s_fX",prefix),type);
+  AddColumn(Form("%s_fAlpha",prefix),type);
+  AddColumn(Form("%s_fP",prefix),type,5);
+  AddColumn(Form("%s_fC",prefix),type,15);
+  return first;
+}
+
+//_____________________________________________________________________________
+Int_t AliFilteredTreeFlatWriter::GetColumnIndex(const Char_t *name) const
+{
+  //
+  // Index of a column, -1 if not declared
+  //
+  for (UInt_t i=0; i<fColumns.size(); i++) {
+    if (fColumns[i].fName==name) return i;
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+TTree *AliFilteredTreeFlatWriter::Init()
+{
+  //
+  // Create the tree in the current directory, one branch per column
+  //
+  if (fTree) return fTree;
+  static const Char_t kLeafType[kNColumnTypes] = {'F','D','I','L'};
+
+  fTree = new TTree(GetName(),GetTitle());
+  fTree->SetAutoFlush(fAutoFlush);
+  for (UInt_t i=0; i<fColumns.size(); i++) {
+    const Column &column = fColumns[i];
+    void *address = 0;
+    switch (column.fType) {
+      case kFloat:  address = &fRowF[column.fOffset]; break;
+      case kDouble: address = &fRowD[column.fOffset]; break;
+      case kInt:    address = &fRowI[column.fOffset]; break;
+      default:      address = &fRowL[column.fOffset]; break;
+    }
+    TString leaves = column.fName;
+    if (column.fSize>1) leaves += Form("[%d]",column.fSize);
+    leaves += Form("/%c",kLeafType[column.fType]);
+    TBranch *branch = fTree->Branch(column.fName,address,leaves,fBasketSize);
+    if (fCompressionSettings>=0) branch->SetCompressionSettings(fCompressionSettings);
+  }
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && defined(R__USE_IMT)
+  fTree->SetImplicitMT(fImplicitMT);
+#else
+  if (fImplicitMT) AliWarning("ROOT without implicit multi-threading, baskets are compressed serially");
+#endif
+  fCursor = 0;
+  return fTree;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::Set(Int_t column, Double_t value, Int_t index)
+{
+  //
+  // Set the index-th value of a column
+  //
+  const Column &c = fColumns[column];
+  switch (c.fType) {
+    case kFloat:  fRowF[c.fOffset+index] = value; break;
+    case kDouble: fRowD[c.fOffset+index] = value; break;
+    case kInt:    fRowI[c.fOffset+index] = Int_t(value); break;
+    default:      fRowL[c.fOffset+index] = Long64_t(value); break;
+  }
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::Set(Int_t column, Long64_t value, Int_t index)
+{
+  //
+  // Set the index-th value of a column, without the rounding of a double
+  //
+  const Column &c = fColumns[column];
+  if (c.fType==kLong64) fRowL[c.fOffset+index] = value;
+  else Set(column,Double_t(value),index);
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetArray(Int_t column, const Double_t *values)
+{
+  //
+  // Set all the values of a column
+  //
+  for (Int_t i=0; i<fColumns[column].fSize; i++) Set(column,values[i],i);
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::SetParam(Int_t column, const AliExternalTrackParam *param)
+{
+  //
+  // Set the kNParamColumns columns of a track parameterisation,
+  // zeros for a missing one
+  //
+  static const Double_t kZeros[15] = {0};
+  Set(column,param ? param->GetX() : 0.);
+  Set(column+1,param ? param->GetAlpha() : 0.);
+  SetArray(column+2,param ? param->GetParameter() : kZeros);
+  SetArray(column+3,param ? param->GetCovariance() : kZeros);
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeFlatWriter::Fill()
+{
+  //
+  // Commit the current entry. If the values were pushed, all the
+  // columns have to be set, otherwise the entry is not written.
+  //
+  if (!fTree) {
+    AliError("Fill called before Init");
+    return kFALSE;
+  }
+  if (fCursor!=0 && fCursor!=Int_t(fColumns.size())) {
+    AliError(Form("%d values pushed for %d columns, entry not written",fCursor,Int_t(fColumns.size())));
+    fCursor = 0;
+    return kFALSE;
+  }
+  fCursor = 0;
+  fTree->Fill();
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeFlatWriter::WriteTree()
+{
+  //
+  // Write the tree in its directory
+  //
+  if (!fTree || !fTree->GetDirectory()) return;
+  TDirectory *saveDir = gDirectory;
+  fTree->GetDirectory()->cd();
+  fTree->Write(0,TObject::kOverwrite);
+  if (saveDir) saveDir->cd();
+}
@@ -0,0 +1,101 @@
+#ifndef ALIFILTEREDTREEFLATWRITER_H
+#define ALIFILTEREDTREEFLATWRITER_H
+
+//------------------------------------------------------------------------------
+// Writer of flat trees for the filtering task.
+//
+// The schema (name, type and length of each column) is declared once before
+// Init. Each branch points to a typed row buffer of the writer; an entry is
+// filled by pushing the values in the order of the declaration (or by column
+// index) and committed with Fill. No object is streamed and no branch is
+// looked up by name per entry, as it is done by the TTreeSRedirector streams.
+// Basket size, auto-flush and compression of the branches are set by the
+// writer. With ROOT built with imt, SetImplicitMT lets ROOT compress the
+// baskets in its thread pool when ROOT::EnableImplicitMT() was called.
+//
+// Usage:
+//   AliFilteredTreeFlatWriter writer("highPtFlat");
+//   writer.AddColumn("runNumber",AliFilteredTreeFlatWriter::kInt);
+//   writer.AddParamColumns("esdTrack");
+//   writer.Init();              // tree in gDirectory
+//   per entry: writer.Push(runNumber); writer.PushParam(track); writer.Fill();
+//   at the end: writer.WriteTree();
+//------------------------------------------------------------------------------
+
+#include "TNamed.h"
+#include "TString.h"
+#include <vector>
+
+class TTree;
+class AliExternalTrackParam;
+
+class AliFilteredTreeFlatWriter : public TNamed
+{
+public:
+  enum EColumnType { kFloat=0, kDouble, kInt, kLong64, kNColumnTypes };
+
+  AliFilteredTreeFlatWriter(const Char_t *name="flatTree", const Char_t *title="");
+  virtual ~AliFilteredTreeFlatWriter();
+
+  // schema, before Init
+  Int_t AddColumn(const Char_t *name, EColumnType type=kFloat, Int_t size=1);
+  Int_t AddParamColumns(const Char_t *prefix, EColumnType type=kFloat);
+  Int_t GetNColumns() const { return fColumns.size(); }
+  Int_t GetColumnIndex(const Char_t *name) const;
+
+  // output settings, before Init
+  void SetBasketSize(Int_t size)              { fBasketSize = size; }
+  void SetAutoFlush(Long64_t autoFlush)       { fAutoFlush = autoFlush; }
+  void SetCompressionSettings(Int_t settings) { fCompressionSettings = settings; }
+  void SetImplicitMT(Bool_t flag)             { fImplicitMT = flag; }
+
+  TTree *Init();
+  TTree *GetTree() const { return fTree; }
+
+  // values of the current entry, by column index
+  void Set(Int_t column, Double_t value, Int_t index=0);
+  void Set(Int_t column, Long64_t value, Int_t index=0);
+  void Set(Int_t column, Int_t value, Int_t index=0) { Set(column,Double_t(value),index); }
+  void SetArray(Int_t column, const Double_t *values);
+  void SetParam(Int_t column, const AliExternalTrackParam *param);
+
+  // values of the current entry, in the order of the declaration
+  void Push(Double_t value)                   { Set(fCursor++,value); }
+  void Push(Long64_t value)                   { Set(fCursor++,value); }
+  void Push(Int_t value)                      { Set(fCursor++,Double_t(value)); }
+  void PushArray(const Double_t *values)      { SetArray(fCursor++,values); }
+  void PushParam(const AliExternalTrackParam *param) { SetParam(fCursor,param); fCursor+=kNParamColumns; }
+
+  Bool_t Fill();
+  void   WriteTree();
+
+  enum { kNParamColumns=4 };  // fX, fAlpha, fP[5], fC[15]
+
+private:
+  struct Column {
+    TString fName;   // branch name
+    Int_t   fType;   // EColumnType
+    Int_t   fSize;   // number of values
+    Int_t   fOffset; // first value in the row buffer of its type
+  };
+
+  AliFilteredTreeFlatWriter(const AliFilteredTreeFlatWriter&); // not implemented
+  AliFilteredTreeFlatWriter& operator=(const AliFilteredTreeFlatWriter&); // not implemented
+
+  std::vector<Column>   fColumns;   //! declared columns
+  std::vector<Float_t>  fRowF;      //! values of the current entry, float columns
+  std::vector<Double_t> fRowD;      //! values of the current entry, double columns
+  std::vector<Int_t>    fRowI;      //! values of the current entry, int columns
+  std::vector<Long64_t> fRowL;      //! values of the current entry, long columns
+  Int_t    fCursor;                 //! next column for Push
+  TTree   *fTree;                   //! output tree, owned by its directory
+
+  Int_t    fBasketSize;             // basket size of the branches (bytes)
+  Long64_t fAutoFlush;              // auto flush of the tree (see TTree::SetAutoFlush)
+  Int_t    fCompressionSettings;    // compression of the branches, -1 for the file settings
+  Bool_t   fImplicitMT;             // compress the baskets with the ROOT implicit multi-threading
+
+  ClassDef(AliFilteredTreeFlatWriter, 1); // flat tree writer for the filtering task
+};
+
+#endif
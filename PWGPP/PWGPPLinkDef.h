@@ -89,6 +89,7 @@
 #pragma link C++ class AliAnalysisTaskFilteredTree+;
 #pragma link C++ class AliFilteredTreeEventCuts+;
 #pragma link C++ class AliFilteredTreeAcceptanceCuts+;
+#pragma link C++ class AliFilteredTreeFlatWriter+;
 
 #pragma link C++ class AliTaskConfigOCDB+;
 